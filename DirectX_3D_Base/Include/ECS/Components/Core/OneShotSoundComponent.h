@@ -25,6 +25,7 @@
 // ===== CN[h =====
 #include <string>
 #include <DirectXMath.h>
+#include "Systems/AssetResidency.h"
 
 /**
  * @struct	OneShotSoundComponent
@@ -36,6 +37,7 @@ struct OneShotSoundComponent
 	// Đwf[^
 	// ----------------------------------------
 	std::string assetID = "";	// AssetManagerɓo^ꂽTEhID
+	Asset::AssetRef assetRef;	// ς݂̃TEhւ̎Q
 	float volume = 1.0f;		// Đ{[i0.0f - 1.0fj
 
 	// 3DԃTEhΉlAʒuێ
@@ -25,6 +25,7 @@
 // ===== CN[h =====
 #include <string>
 #include <xaudio2.h>
+#include "Systems/AssetResidency.h"
 
 /**
  * @enum    SoundType
@@ -47,6 +48,7 @@ struct SoundComponent
     // Đwf[^
     // ----------------------------------------
     std::string assetID = "";       // AssetManagerɓo^ꂽTEhID
+    Asset::AssetRef assetRef; // ς݂̃TEhւ̎Q (assetID ς Reset )
     SoundType type = SoundType::SE; // TEh̎ށiSE/BGM/Ambientj
     float volume = 1.0f;            // Đ{[i0.0f - 1.0f)
     UINT32 loopCount = 0;           // [v񐔁i0: Đ, XAUDIO2_LOOP_INFINITE: [vj
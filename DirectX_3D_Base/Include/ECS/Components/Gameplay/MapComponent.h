@@ -22,8 +22,14 @@
 
 // ===== CN[h =====
 #include <DirectXMath.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
+class MapVisibility;
+
 /**
  * @enum    CellType
  * @brief   }bvvf̗񋓑
@@ -49,18 +55,90 @@ enum class CellType
 
 /**
  * @struct  Cell
- * @brief   H̃Zێ\
+ * @brief   H̃Zێ\ (2oCg)
  */
 struct Cell
 {
     CellType type = CellType::Wall; // Ԃ͑Sĕ
     bool visited = false;           // HtO
+};
+static_assert(sizeof(Cell) == 2, "Cell should stay packed for cache-friendly grid scans");
 
-    // ͂̕ǂ̗LiHŒʘH@i߂̕ǂ̎cێj
-    bool hasWallNorth = true;
-    bool hasWallSouth = true;
-    bool hasWallEast = true;
-    bool hasWallWest = true;
+/**
+ * @class   MapGrid
+ * @brief   H̃ZsD̈ꎟzŕێObh
+ *
+ * sƂ vector H炸ɍςނ悤AZ y * sizeX + x ̈ʒuɘAzuB
+ * oHT⃌CLXgȂǖt[锻́A1Z1rbg̒ʍs\}XNQƂB
+ */
+class MapGrid
+{
+public:
+    /// @brief ObhwTCYŊmۂASZl()Ŗ߂
+    void Assign(int sizeX, int sizeY)
+    {
+        m_sizeX = sizeX;
+        m_sizeY = sizeY;
+        m_cells.assign((size_t)sizeX * sizeY, Cell());
+        m_walkable.assign(((size_t)sizeX * sizeY + 63) / 64, 0ull);
+    }
+
+    int GetSizeX() const { return m_sizeX; }
+    int GetSizeY() const { return m_sizeY; }
+    int GetCellCount() const { return (int)m_cells.size(); }
+    bool Empty() const { return m_cells.empty(); }
+
+    bool InBounds(int x, int y) const { return x >= 0 && x < m_sizeX && y >= 0 && y < m_sizeY; }
+    int GetIndex(int x, int y) const { return y * m_sizeX + x; }
+
+    /// @brief ͈̓`FbNt̃ZQ (͈͊O std::out_of_range)
+    Cell& At(int x, int y)
+    {
+        if (!InBounds(x, y)) throw std::out_of_range("MapGrid::At out of range");
+        return m_cells[(size_t)GetIndex(x, y)];
+    }
+    const Cell& At(int x, int y) const
+    {
+        if (!InBounds(x, y)) throw std::out_of_range("MapGrid::At out of range");
+        return m_cells[(size_t)GetIndex(x, y)];
+    }
+
+    /// @brief Zʂ̎擾 (͈͊O͕ǂƂĈ)
+    CellType GetType(int x, int y) const
+    {
+        return InBounds(x, y) ? m_cells[(size_t)GetIndex(x, y)].type : CellType::Wall;
+    }
+
+    /**
+     * @brief   ʍs\}XN̎Q (͈͊OEǁEK false)
+     * @note    RebuildWalkableMask() ȍ~ɏZ͔fȂ
+     */
+    bool IsWalkable(int x, int y) const
+    {
+        if (!InBounds(x, y)) return false;
+        const int index = GetIndex(x, y);
+        return (m_walkable[(size_t)index >> 6] >> (index & 63)) & 1ull;
+    }
+
+    /// @brief Zʂʍs\}XN蒼 (}bv̊ɌĂ)
+    void RebuildWalkableMask()
+    {
+        std::fill(m_walkable.begin(), m_walkable.end(), 0ull);
+        for (size_t i = 0; i < m_cells.size(); ++i)
+        {
+            const CellType type = m_cells[i].type;
+            if (type != CellType::Wall && type != CellType::Unvisited)
+            {
+                m_walkable[i >> 6] |= (1ull << (i & 63));
+            }
+        }
+    }
+
+private:
+    int m_sizeX = 0;
+    int m_sizeY = 0;
+    std::vector<Cell> m_cells;              // sDŘAzuZ
+    std::vector<std::uint64_t> m_walkable;  // ʍs\rbg}XN
 };
 
 /**
@@ -74,9 +152,10 @@ struct MapComponent
     int gridSizeY = 0;
     float tileSize = 0.0f;
     float wallHeight = 0.0f;
+    std::uint32_t seed = 0;     // ɎgpV[h
 
     // }bṽObhf[^
-    std::vector<std::vector<Cell>> grid;
+    MapGrid grid;
 
     // }bvɕKvȍW
     DirectX::XMINT2 startPos = { 0, 0 }; // vC[ʒu
@@ -85,6 +164,9 @@ struct MapComponent
     struct TeleportPair { DirectX::XMINT2 posA; DirectX::XMINT2 posB; };
     std::vector<TeleportPair> teleportPairs;
 
+    // ZԂ̉e[u (Ƀ[J[Xbhō\z)
+    std::shared_ptr<MapVisibility> visibility;
+
     MapComponent()
     {
 
@@ -25,10 +25,12 @@
 #include <string>
 #include <DirectXMath.h>
 #include <Effekseer/Effekseer.h>
+#include "Systems/AssetResidency.h"
 
 struct EffectComponent
 {
 	std::string assetID;            // ĐGtFNg̃AZbgID
+	Asset::AssetRef assetRef; // ς݂̃GtFNgւ̎Q (assetID ς Reset )
 	Effekseer::Handle handle = -1;  // Đ/I -1 ɓ
 
 	bool playOnAwake = true;        // ɍĐ邩
@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <memory>
 #include "Systems/Model.h"
+#include "Systems/ModelInstance.h"
 #include "Systems/DirectX/ShaderList.h"
 #include "Systems/AssetManager.h"
 
@@ -36,6 +37,17 @@ struct ModelComponent
 	Model* pModel = nullptr;
 	std::string assetID;
 
+	// ǂݍݗv (񓯊œǂݍނ߁A܂ pModel  nullptr)
+	Asset::AssetInfo* pAssetInfo = nullptr;
+	// fւ̎Q (̃R|[lgԂ̓fȂ)
+	Asset::AssetRef assetRef;
+
+	// GeBeBŗL̍ĐԂƎp (Aj[VĐ鎞̂ݐ)
+	std::unique_ptr<ModelInstance> pInstance;
+
+	// O`悵ڍדx (RenderSystem ʏ̑傫疈t[Iђ)
+	int lod = 0;
+
 	/**
 	 * @brief RXgN^
 	 */
@@ -46,19 +58,30 @@ struct ModelComponent
 	{
 		assetID = id;
 
-		Asset::AssetInfo* pAssetInfo = Asset::AssetManager::GetInstance().LoadModel(id, scale, flip);
+		// ǂݍ݂̓[J[XbhōsA Resolve Ŏ擾ł
+		pAssetInfo = Asset::AssetManager::GetInstance().RequestModel(id, scale, flip);
+		assetRef = Asset::AssetManager::GetInstance().MakeRef(pAssetInfo);
 
-		if (pAssetInfo != nullptr && pAssetInfo->pResource != nullptr)
+		if (pAssetInfo == nullptr)
 		{
-			// LbVꂽ\[X|C^擾AModel*ɃLXg
-			pModel = static_cast<Model*>(pAssetInfo->pResource);
+			MessageBox(NULL, "AssetManager̃f̃[h/擾Ɏs", "Error", MB_OK);
 		}
-		else
+		// pModel->Load()AssetManager::RequestModel()̒ŌĂяo邽߁A폜
+	}
+
+	/**
+	 * [Model* - Resolve]
+	 * @brief	ǂݍ݂Ă΃f擾
+	 * @return	ǂݍݒEs nullptr
+	 */
+	Model* Resolve()
+	{
+		if (!pModel && pAssetInfo && pAssetInfo->state == Asset::LoadState::Ready)
 		{
-			MessageBox(NULL, "AssetManager̃f̃[h/擾Ɏs", "Error", MB_OK);
-			pModel = nullptr;
+			// LbVꂽ\[X|C^擾AModel*ɃLXg
+			pModel = static_cast<Model*>(pAssetInfo->pResource);
 		}
-		// pModel->Load()AssetManager::LoadModel()̒ŌĂяo邽߁A폜
+		return pModel;
 	}
 
 	ModelComponent(const ModelComponent&) = delete;
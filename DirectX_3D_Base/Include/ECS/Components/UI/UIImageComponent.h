@@ -25,6 +25,9 @@
 // ===== CN[h =====
 #include <string>
 #include <DirectXMath.h>
+#include "Systems/AssetResidency.h"
+
+namespace Asset { struct AtlasRegion; }
 
 /**
  * @struct	UIImageComponent
@@ -36,9 +39,12 @@ struct UIImageComponent
 	// `wf[^
 	// ----------------------------------------
 	std::string assetID = "";				// AssetManagerɓo^ꂽeNX`ID
+	Asset::AssetRef assetRef;				// ς݂̃eNX`ւ̎Q (assetID ς Reset )
+	const Asset::AtlasRegion* atlasRegion = nullptr;	// AgXɂ܂Ƃ߂Ăꍇ̃y[W͈̔ (assetRef ƈꏏɉ)
 	DirectX::XMFLOAT4 color = { 1.0f, 1.0f, 1.0f, 1.0f }; // `F (R, G, B, A)
 
 	// `悷eNX`̐؂o͈ (UV)
+	// AgXɂ܂Ƃ߂ĂẴeNX`̒lŎw肷 (y[W UV ւ UIRenderSystem ϊ)
 	DirectX::XMFLOAT2 uvPos = { 0.0f, 0.0f };		// UV̊Jnʒu (0.0f - 1.0f)
 	DirectX::XMFLOAT2 uvScale = { 1.0f, 1.0f };		// UṼTCY/XP[ (0.0f - 1.0f)
 
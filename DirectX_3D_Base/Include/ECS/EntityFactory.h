@@ -25,6 +25,10 @@
 #include "Coordinator.h"
 #include "Types.h"
 #include <DirectXMath.h> // R|[lg̏lݒɕKv
+#include <string>
+#include <vector>
+
+namespace Asset { struct AssetManifest; }
 
 namespace ECS
 {
@@ -72,6 +76,13 @@ namespace ECS
 		static ECS::EntityID CreateCeilingFan(ECS::Coordinator* coordinator, const DirectX::XMFLOAT3& position);
 		static ECS::EntityID CreateSecurityCamera(ECS::Coordinator* coordinator, const DirectX::XMFLOAT3& position, float rotationY);
 		static ECS::EntityID CreateWallPainting(ECS::Coordinator* coordinator, const DirectX::XMFLOAT3& position, float rotationY, const std::string& modelName);
+
+		// Xe[WŎgAZbg}bvݒ肩񋓂 (LoadingScene ł̐ǂݗp)
+		static void CollectStageAssets(const std::string& stageId, Asset::AssetManifest& manifest);
+		// ACeIDɑΉ郂f̃AZbgID
+		static std::string GetCollectableModelID(const std::string& itemID);
+		// ǂɏG惂f̃AZbgIDꗗ
+		static const std::vector<std::string>& GetWallPaintingModelIDs();
 	private:
 		// ÓINX̂߁AvCx[gRXgN^ŃCX^X֎~
 		EntityFactory() = delete;
@@ -5,6 +5,7 @@
  * @details	
  * SoundComponent̗vɊÂAAssetManagerSoundEffect擾A
  * ĐA~A[vǗB
+ * P SE ̓GeBeB炸 PlayOneShot Œږ点 ( SE d˂Ė点)B
  * 
  * ------------------------------------------------------------
  * @author	Iwai Shogo
@@ -47,6 +48,13 @@ private:
 	ECS::Coordinator* m_coordinator = nullptr;
 
 public:
+	// P SE ̗Dx̖ڈ ({CXȂɁAႢ̂~߂)
+	static const int PRIORITY_AMBIENT = 0;	// ȂǁAĂڗȂ
+	static const int PRIORITY_DEFAULT = 50;
+	static const int PRIORITY_UI = 100;		// ւ̉
+
+	~AudioSystem();
+
 	void Init(ECS::Coordinator* coordinator) override
 	{
 		m_coordinator = coordinator;
@@ -56,6 +64,18 @@ public:
 
 	void OnEntityDestroyed(ECS::EntityID entity);
 
+	/**
+	 * [bool - PlayOneShot]
+	 * @brief	P SE 𒼐ږ炷 (GeBeBȂBǂݍݍς݂Ȃ烁mۂȂ)
+	 * @param	[in] handle Asset::AssetManager::FindSoundHandle Ŏ擾nh (ێĎg)
+	 * @param	[in] volume {[
+	 * @param	[in] pitch Đx̔{
+	 * @param	[in] priority {CXȂ̗Dx (PRIORITY_*)
+	 * @return	false: ǂݍ (ǂݍ݂n߁A͖炳Ȃ)EDxȂ
+	 * @note	V[̏I (AudioSystem ̔j) ɁAĂ͎̂~߂
+	 */
+	bool PlayOneShot(const Asset::AssetHandle& handle, float volume = 1.0f, float pitch = 1.0f, int priority = PRIORITY_DEFAULT);
+
 private:
 	/**
 	 * @brief	SoundComponentiiTEhj̍XVWbN
@@ -9,6 +9,7 @@
  // ===== インクルード =====
 #include "ECS/ECS.h"
 #include "Scene/SceneManager.h" 
+#include "Systems/AssetHandle.h"
 #include <unordered_map>
 #include <unordered_set>
 #include <DirectXMath.h>
@@ -201,6 +202,9 @@ private:
     int m_prevCollectedCount = 0;       // アイテム取得音判定用
     ECS::EntityID m_lastHoveredID = ECS::INVALID_ENTITY_ID; // カーソル音用
     float m_sliderSoundTimer = 0.0f;    // スライダー音の間隔
+    // 頻繁に鳴らす SE のハンドル (初回に解決する)
+    Asset::AssetHandle m_runSoundHandle;
+    Asset::AssetHandle m_cursorSoundHandle;
 
     // --- ★追加: テレポートエフェクト管理用 ---
     struct TeleporterEffectSet {
@@ -226,6 +230,8 @@ private:
     void PlayBGM(const std::string& assetID, float volume = 0.15f);
     void StopBGM();
     void PlayStopableSE(const std::string& assetID, float volume);
+    // エンティティを作らずにボイスプールで鳴らす (重ねて鳴らせる)
+    void PlayOneShotSE(Asset::AssetHandle& handle, const char* assetID, float volume, float pitch, int priority);
 };
 
 #endif // !___GAME_CONTROL_SYSTEM_H___
\ No newline at end of file
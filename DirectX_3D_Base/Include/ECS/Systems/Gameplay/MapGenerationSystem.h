@@ -22,10 +22,13 @@
 
 // ===== インクルード =====
 #include "ECS/ECS.h"
+#include <cstdint>
+#include <future>
 #include <random>
 #include <stack>
 #include <fstream>
 #include <iostream>
+#include <string>
 #include "External/JSON/json.hpp"
 
 #include "ECS/Components/Gameplay/MapComponent.h"
@@ -50,6 +53,8 @@ struct MapStageConfig
 
 	int guardCount = 1;			// 配置する警備員の総数
 
+	std::uint32_t seed = 0;		// 乱数シード (0 の場合は起動毎にランダム)
+
     //アイテム順序モードオン/オフ
 	float minPathPercentage = 0.25f;
     bool useOrderedCollection = false;
@@ -111,6 +116,7 @@ public:
 				config.maxRoomCount = val.value("maxRoomCount", 5);
 
 				config.guardCount = val.value("guardCount", 1);
+				config.seed = val.value("seed", 0u);
 				config.minPathPercentage = val.value("minPathPercentage", 0.3f);
 				config.useOrderedCollection = val.value("useOrderedCollection", false);
 
@@ -160,20 +166,107 @@ public:
 	}
 };
 
+/**
+ * @struct	MazeGenerationStats
+ * @brief	MazeGenerator::Generate の実行統計 (計測・チューニング用)
+ */
+struct MazeGenerationStats
+{
+	int attempts = 0;			// 実行した生成試行の回数
+	int wallsCarved = 0;		// 連結のために掘った壁の数 (全試行の合計)
+	int retriesSkipped = 0;		// 設定上達成不能と判定して省略した再試行の回数
+};
+
 class MazeGenerator final
 {
 public:
 	// C++11/14で標準的な乱数生成機
-	static std::mt19937 s_generator;
+	// マップ生成と配置物の抽選は全てこの生成機を経由させ、シードから結果を再現できるようにする
+	// (ワーカースレッドでの先行生成と競合しないよう、スレッド毎に持つ)
+	static thread_local std::mt19937 s_generator;
+
+	/**
+	 * [void - SetSeedOverride]
+	 * @brief	ステージ設定より優先するシードを指定する (起動引数 -seed など)
+	 *
+	 * @param	[in] seed 0 を指定すると上書きを解除する
+	 */
+	static void SetSeedOverride(std::uint32_t seed) { s_seedOverride = seed; }
+
+	/**
+	 * [std::uint32_t - ResolveSeed]
+	 * @brief	使用するシードを決定する (上書き > ステージ設定 > random_device の順)
+	 */
+	static std::uint32_t ResolveSeed(const MapStageConfig& config);
+
+	/// @brief 生成機をシードで初期化する
+	static void Seed(std::uint32_t seed) { s_generator.seed(seed); }
+
+	/// @brief [minValue, maxValue] の一様乱数 (rand() の代わりに使用する)
+	static int RandomInt(int minValue, int maxValue)
+	{
+		std::uniform_int_distribution<int> dist(minValue, maxValue);
+		return dist(s_generator);
+	}
 
 	/**
 	 * @brief 迷路生成ロジックの本体。MapComponentのgridを書き換える。
 	 * @param mapComp - 迷路データを書き込むMapComponentへの参照
+	 * @param outStats - 実行統計の出力先 (不要なら nullptr)
 	 */
-	static void Generate(MapComponent& mapComp, ItemTrackerComponent& trackerComp, const MapStageConfig& config);
+	static void Generate(MapComponent& mapComp, ItemTrackerComponent& trackerComp, const MapStageConfig& config, MazeGenerationStats* outStats = nullptr);
 private:
 	// 再帰的バックトラッカーのヘルパー関数
 	static void RecursiveBacktracker(MapComponent& mapComp, const MapStageConfig& config, int x, int y);
+
+	static std::uint32_t s_seedOverride;	// 0 以外ならステージ設定のシードより優先
+};
+
+/**
+ * @struct	StagedMap
+ * @brief	ワーカースレッドで生成したマップ一式 (メインスレッドでMapComponentと入れ替える)
+ */
+struct StagedMap
+{
+	std::string stageID;
+	MapStageConfig config;
+	MapComponent map;
+	ItemTrackerComponent tracker;
+	std::mt19937 generator;		// 生成直後の乱数状態 (Entity配置でこの続きから引く)
+	float generateMs = 0.0f;
+};
+
+/**
+ * @class	MapPrefetcher
+ * @brief	ステージの迷路データをワーカースレッドで先行生成して保持する
+ *
+ * ステージ選択中に Request() しておくと、GameScene の CreateMap() は生成済みの
+ * バッファを受け取ってEntity配置だけを行う。呼び出しはメインスレッドからのみ行うこと。
+ */
+class MapPrefetcher final
+{
+public:
+	/**
+	 * [void - Request]
+	 * @brief	指定ステージの生成をワーカースレッドで開始する (同じステージが生成中なら何もしない)
+	 */
+	static void Request(const std::string& stageID);
+
+	/**
+	 * [StagedMap - Take]
+	 * @brief	指定ステージの生成結果を受け取る。先行生成が無ければこの場で生成する
+	 */
+	static StagedMap Take(const std::string& stageID);
+
+	/**
+	 * [StagedMap - Build]
+	 * @brief	設定の読込から迷路生成までを行う (どのスレッドからでも呼べる)
+	 */
+	static StagedMap Build(const std::string& stageID);
+
+private:
+	static std::string s_pendingStageID;
+	static std::future<StagedMap> s_pending;
 };
 
 /**
@@ -0,0 +1,71 @@
+﻿/*****************************************************************//**
+ * @file	MapSnapshot.h
+ * @brief	生成済みMapComponentをバイナリ形式で保存・復元する
+ *
+ * @details	シード指定で生成したステージを固定のファイルとして残し、
+ *			不具合の再現や生成処理の回帰比較に使用する。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：MapSnapshotを作成。MapComponentのバイナリ保存・読込とハッシュ計算を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+#ifndef ___MAP_SNAPSHOT_H___
+#define ___MAP_SNAPSHOT_H___
+
+// ===== インクルード =====
+#include <cstdint>
+#include <string>
+
+struct MapComponent;
+
+/**
+ * @class	MapSnapshot
+ * @brief	MapComponentのレイアウトをバージョン付きのバイナリで読み書きする
+ *
+ * 保存形式 (リトルエンディアン、全て固定幅):
+ *	ヘッダ    : "MAPS" / バージョン / シード / グリッドサイズ / タイルサイズ / 壁の高さ
+ *	座標情報  : スタート / ゴール / アイテム配置 / テレポーター対
+ *	セル      : gridSizeX * gridSizeY 個の CellType (1バイト/セル、行優先)
+ *	末尾      : 以上の内容の FNV-1a ハッシュ
+ * 可視テーブルなどの派生データは保存せず、読込後に呼び出し側で作り直す。
+ */
+class MapSnapshot final
+{
+public:
+	/**
+	 * [bool - Save]
+	 * @brief	MapComponentをファイルへ書き出す
+	 *
+	 * @param	[in] mapComp 保存するマップ
+	 * @param	[in] filePath 出力先
+	 * @return	成功したらtrue
+	 */
+	static bool Save(const MapComponent& mapComp, const std::string& filePath);
+
+	/**
+	 * [bool - Load]
+	 * @brief	ファイルからMapComponentを復元する (通行可能マスクも再構築する)
+	 *
+	 * @param	[out] mapComp 復元先 (失敗時は変更しない)
+	 * @param	[in] filePath 読込元
+	 * @return	成功したらtrue
+	 */
+	static bool Load(MapComponent& mapComp, const std::string& filePath);
+
+	/**
+	 * [std::uint64_t - ComputeHash]
+	 * @brief	保存対象の内容から FNV-1a ハッシュを計算する (同一レイアウトかの比較用)
+	 */
+	static std::uint64_t ComputeHash(const MapComponent& mapComp);
+};
+
+#endif // !___MAP_SNAPSHOT_H___
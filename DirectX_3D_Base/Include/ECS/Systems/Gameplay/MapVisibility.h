@@ -0,0 +1,104 @@
+﻿/*****************************************************************//**
+ * @file	MapVisibility.h
+ * @brief	迷路のセル間可視判定を事前計算して保持するテーブル
+ *
+ * @details	マップ生成後にワーカースレッドで全セル対の見通しを計算し、
+ *			警備員の視界判定をビット参照だけで行えるようにする。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：MapVisibilityを作成。セル間可視ビットセットの非同期構築を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+#ifndef ___MAP_VISIBILITY_H___
+#define ___MAP_VISIBILITY_H___
+
+// ===== インクルード =====
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+struct MapComponent;
+
+/**
+ * @class	MapVisibility
+ * @brief	セル中心同士を結ぶ線分が壁を通過しないかを全セル対について保持する
+ *
+ * 壁セル以外のセル数をNとすると N x N ビットを使用する (35x20 のステージで約60KB)。
+ * 構築完了までは IsReady() が false を返すため、呼び出し側はレイキャストで代替すること。
+ */
+class MapVisibility final
+{
+public:
+	/**
+	 * [std::shared_ptr<MapVisibility> - BuildAsync]
+	 * @brief	MapComponentの壁配置を複製し、ワーカースレッドで可視テーブルの構築を開始する
+	 *
+	 * @param	[in] mapComp 生成済みのマップ
+	 * @return	構築中のテーブル (IsReady() で完了を確認する)
+	 */
+	static std::shared_ptr<MapVisibility> BuildAsync(const MapComponent& mapComp);
+
+	~MapVisibility();
+
+	/// @brief 構築が完了しているか
+	bool IsReady() const { return m_isReady.load(std::memory_order_acquire); }
+
+	/// @brief グリッド座標をセルインデックスに変換する (範囲外は -1)
+	int GetCellIndex(int x, int y) const
+	{
+		if (x < 0 || x >= m_sizeX || y < 0 || y >= m_sizeY) return -1;
+		return y * m_sizeX + x;
+	}
+
+	/**
+	 * [bool - IsVisible]
+	 * @brief	2セル間の見通しをビット参照で返す。IsReady() が true の時のみ有効
+	 */
+	bool IsVisible(int fromCell, int toCell) const
+	{
+		if (fromCell < 0 || toCell < 0) return false;
+		const std::uint64_t word = m_bits[(size_t)fromCell * m_wordsPerRow + (toCell >> 6)];
+		return (word >> (toCell & 63)) & 1ull;
+	}
+
+	/// @brief テーブルが使用するメモリ量 (バイト)
+	size_t GetMemoryBytes() const { return m_bits.size() * sizeof(std::uint64_t) + m_isWall.size(); }
+
+	/// @brief 構築に要した時間 (ミリ秒)
+	float GetBuildTimeMs() const { return m_buildTimeMs; }
+
+private:
+	MapVisibility() = default;
+
+	// 全セル対の見通しを計算する (ワーカースレッドで実行)
+	void Build();
+
+	// セル中心間の線分が通過する全セルを調べ、壁が無ければtrue
+	bool TraceLine(int ax, int ay, int bx, int by) const;
+
+	bool IsWall(int x, int y) const { return m_isWall[(size_t)y * m_sizeX + x] != 0; }
+
+	int m_sizeX = 0;
+	int m_sizeY = 0;
+	int m_wordsPerRow = 0;
+
+	std::vector<std::uint8_t> m_isWall;		// 構築用に複製した壁フラグ
+	std::vector<std::uint64_t> m_bits;		// 行 = 視点セル、列 = 対象セル
+
+	std::atomic<bool> m_isReady{ false };
+	std::future<void> m_buildTask;
+	float m_buildTimeMs = 0.0f;
+};
+
+#endif // !___MAP_VISIBILITY_H___
@@ -25,6 +25,9 @@
 #include "ECS/Components/Core/TransformComponent.h"
 #include "ECS/Components/Gimmick/GuardComponent.h"
 
+#include <cstdint>
+#include <vector>
+
 /**
  * struct   AStarNode
  * @brief   A*TŎgpm[h
@@ -89,7 +92,32 @@ private:
 
     bool RaycastHitWall(const DirectX::XMFLOAT3& start, const DirectX::XMFLOAT3& end, const MapComponent& mapComp);
 
-    bool IsTargetInSight(const TransformComponent& guardTransform, const GuardComponent& guardInfo, const TransformComponent& targetTransform, const MapComponent& mapComp);
+    /**
+     * @struct  SightBatch
+     * @brief   Sx̎Eꊇōs߂SoAobt@it[ėpj
+     */
+    struct SightBatch
+    {
+        std::vector<float> posX, posZ;         // ẍʒu
+        std::vector<float> forwardX, forwardZ; // x̐ʕ
+        std::vector<float> rangeSq;            // F̓
+        std::vector<float> cosHalfAngle;       // p̔cos
+        std::vector<int> cellIndex;            // xĂZ
+        std::vector<std::uint8_t> inSight;     // 茋
+
+        void Clear()
+        {
+            posX.clear(); posZ.clear(); forwardX.clear(); forwardZ.clear();
+            rangeSq.clear(); cosHalfAngle.clear(); cellIndex.clear(); inSight.clear();
+        }
+    };
+    SightBatch m_sightBatch;
+
+    // A*̃m[hz (ZCfbNXAFindPathĂяoԂōėp)
+    std::vector<AStarNode> m_pathNodes;
+
+    // m_entities ̏ɑSx̎EsAm_sightBatch.inSight Ɋi[
+    void EvaluateSightBatch(const TransformComponent& targetTransform, const MapComponent& mapComp);
 
 public:
     void Init(ECS::Coordinator* coordinator) override
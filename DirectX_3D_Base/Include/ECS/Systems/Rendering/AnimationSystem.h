@@ -15,6 +15,9 @@
 #include <DirectXMath.h>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
+
+class ModelInstance;
 
 class AnimationSystem : public ECS::System
 {
@@ -26,6 +29,9 @@ private:
     std::unordered_map<ECS::EntityID, DirectX::XMFLOAT3> m_prevNodeAnimRot;
     std::unordered_set<ECS::EntityID> m_resetNodeAnimPos;
 
+    // Instances stepped together this frame (sorted by shared Model for the 4-wide path)
+    std::vector<ModelInstance*> m_stepBatch;
+
 public:
     void Init(ECS::Coordinator* coordinator) override
     {
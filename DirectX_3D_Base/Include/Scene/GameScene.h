@@ -71,6 +71,7 @@ public:
 	void Uninit() override;
 	void Update(float deltaTime) override;
 	void Draw() override;
+	void CollectAssets(Asset::AssetManifest& manifest) const override;
 
 	void UpdateFadeIn(float deltaTime);
 
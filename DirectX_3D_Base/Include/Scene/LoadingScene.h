@@ -1,6 +1,9 @@
 /*****************************************************************//**
  * @file    LoadingScene.h
- * @brief   ロード画面（LOADING文字表示 + 右下UVアニメ）
+ * @brief   ロード画面（LOADING文字表示 + 右下UVアニメ + 進捗バー）
+ *
+ * @details 次のシーンの CollectAssets で列挙されたアセットを裏で読み込み、
+ *          全て揃ってから次のシーンへ切り替える（SceneManager::ChangeSceneWithLoading）。
  *********************************************************************/
 
 #ifndef ___LOADING_SCENE_H___
@@ -12,8 +15,10 @@
  // EntityHandle 推論のため、CreateEntity に渡すコンポーネント型を完全型で参照する
 #include "ECS/Components/Core/TransformComponent.h"
 #include "ECS/Components/UI/UIImageComponent.h"
+#include "Systems/AssetManifest.h"
 
 #include <memory>
+#include <functional>
 #include <utility> // std::declval
 #include <vector>  // 追加：Entity管理用
 
@@ -27,6 +32,12 @@ public:
     void Update(float deltaTime) override;
     void Draw() override;
 
+    /**
+     * @brief ロード後に切り替えるシーンを設定する（未設定なら TitleScene）
+     * @param[in] factory 次のシーンのファクトリ関数（Init 前に CollectAssets を呼ぶ）
+     */
+    static void SetNextScene(std::function<Scene* ()> factory) { s_nextSceneFactory = factory; }
+
 private:
     /**
      * @brief CreateEntity() の戻り型を推論して保持（ECS::Entity が無い環境向け）
@@ -47,12 +58,26 @@ private:
     /** @brief UI_LOAD_ANIM のUVフレームを設定（1枚を横30分割） */
     void SetLoadAnimFrame(int frameIndex);
 
+    /** @brief 進捗バーの長さを設定（左端固定） */
+    void SetProgressBar(float ratio);
+
 private:
     std::shared_ptr<ECS::Coordinator> m_coordinator;
 
     float m_elapsed = 0.0f;
     float m_minDisplaySec = 1.0f;
 
+    // ---- 次のシーンと先読みの進捗 ----
+    static std::function<Scene* ()> s_nextSceneFactory;
+    std::unique_ptr<Scene> m_nextScene;
+    std::shared_ptr<Asset::ManifestProgress> m_progress;
+    bool m_needsWait = false;   // 読み込みが発生した場合だけ最低表示時間を待つ
+
+    EntityHandle m_progressBarEntity;
+    bool  m_hasProgressBar = false;
+    float m_progressBarLeft = 0.0f;
+    float m_progressBarWidth = 0.0f;
+
     // ---- 追加: 文字アニメーション用データ ----
     std::vector<EntityHandle> m_textEntities; // 各文字のEntityID
     std::vector<float>        m_textBaseY;    // 各文字の基準Y座標
@@ -20,6 +20,8 @@
 #ifndef ___SCENE_H___
 #define ___SCENE_H___
 
+namespace Asset { struct AssetManifest; }
+
 /**
  * @class   Scene
  * @brief   V[Ǘ̂߂̒ۊNX
@@ -52,6 +54,13 @@ public:
      * @brief V[̏I
      */
     virtual void Uninit() = 0;
+
+    /**
+     * @brief V[gpAZbg񋓂iInit OɌĂ΂j
+     * @param[out] manifest gpAZbg̒ǉ
+     * @note LoadingScene oRŐ؂ւꍇA񋓂AZbgǂݍݏIĂ Init Ă΂
+     */
+    virtual void CollectAssets(Asset::AssetManifest& manifest) const {}
 };
 
 #endif // !___SCENE_H___
\ No newline at end of file
@@ -50,6 +50,12 @@ private:
 	// V[𐶐邽߂̃t@Ng֐̃}bvi^ID -> t@Ng֐j
 	static std::unordered_map<std::type_index, std::function<Scene* ()>> s_sceneFactories;
 
+	// LoadingScene ŐEǂݍς݂̎̃V[it@NgD悳j
+	static std::unique_ptr<Scene> s_preparedScene;
+
+	// ؂ւ̃t[Ԃv邽߂̃tOiqb`̊mFpj
+	static bool s_isFirstFrame;
+
 	// @brief ݂̃V[jÃV[𐶐E
 	static void ProcessSceneChange();
 
@@ -90,6 +96,7 @@ public:
 		if (s_sceneFactories.count(type))
 		{
 			s_nextSceneFactory = s_sceneFactories[type];
+			s_preparedScene.reset();
 		}
 		else
 		{
@@ -97,6 +104,28 @@ public:
 			// O𓊂邩AOɏo
 		}
 	}
+
+	/**
+	 * @brief ς݂̃V[ւ̐؂ւNGXgiUpdate() Init j
+	 * @param[in] scene - Init ÕV[iLoadingScene ǂ݂Ɏǵj
+	 */
+	static void ChangeScene(std::unique_ptr<Scene> scene);
+
+	/**
+	 * @brief LoadingScene oRăV[؂ւ
+	 * @tparam T - ؂ւScene̋ی^
+	 * @note T::CollectAssets ŗ񋓂AZbgSēǂݍ܂Ă T::Init Ă΂
+	 */
+	template<typename T>
+	static void ChangeSceneWithLoading()
+	{
+		std::type_index type = std::type_index(typeid(T));
+		if (s_sceneFactories.count(type))
+		{
+			LoadingScene::SetNextScene(s_sceneFactories[type]);
+			ChangeScene<LoadingScene>();
+		}
+	}
 };
 
 #endif // !___SCENE_MANAGER_H___
\ No newline at end of file
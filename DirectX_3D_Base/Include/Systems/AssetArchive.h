@@ -0,0 +1,76 @@
+﻿/*****************************************************************//**
+ * @file	AssetArchive.h
+ * @brief	アセットアーカイブ (.pak) のマウントと索引の検索
+ *
+ * @details	アーカイブ全体を読み取り専用でメモリへマップし、索引を二分探索して
+ *			各ファイルの範囲 (FileView) をコピーせずに返す。
+ *			返した範囲はアンマウントするまで有効で、複数のスレッドから同時に読み込める。
+ *			マウントしていない・索引に無い場合は空の FileView を返すため、
+ *			呼び出し側は元ファイルの読み込みへ切り替える (開発中はアーカイブを作らずに使える)。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：マウント・索引の検索を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	マウント・アンマウントはメインスレッドで、読み込みが行われていない時に行うこと
+ *********************************************************************/
+
+#ifndef ___ASSET_ARCHIVE_H___
+#define ___ASSET_ARCHIVE_H___
+
+// ===== インクルード =====
+#include <string>
+#include "Systems/AssetArchiveFormat.h"
+#include "Systems/MappedFile.h"
+
+namespace Asset
+{
+	/**
+	 * @class	AssetArchive
+	 * @brief	マップしたアーカイブから索引でファイルの範囲を引く
+	 */
+	class AssetArchive
+	{
+	public:
+		AssetArchive() = default;
+		~AssetArchive() { Unmount(); }
+
+		AssetArchive(const AssetArchive&) = delete;
+		AssetArchive& operator=(const AssetArchive&) = delete;
+
+		/**
+		 * [bool - Mount]
+		 * @brief	アーカイブをマップし、ヘッダーと全ての索引の範囲を確認する
+		 * @return	false : ファイルが無い・形式が違う・壊れている (何もマウントしない)
+		 */
+		bool Mount(const char* file);
+		void Unmount();
+		bool IsMounted() const { return m_pEntries != nullptr; }
+
+		// CSV のアセットを ID のハッシュで引く (type は Pack::EntryType)
+		FileView Find(std::uint8_t type, AssetHash key) const;
+		// ファイルをパスで引く (パスは正規化してから比較する)
+		FileView FindFile(const std::string& path) const;
+
+		std::uint32_t GetEntryNum() const { return m_entryNum; }
+		std::size_t GetSize() const { return m_file.GetSize(); }
+
+	private:
+		const Pack::EntryRecord* FindEntry(std::uint8_t type, AssetHash key) const;
+		FileView GetView(const Pack::EntryRecord& entry) const;
+
+		MappedFile m_file;
+		const Pack::EntryRecord* m_pEntries = nullptr;
+		std::uint32_t m_entryNum = 0;
+		const char* m_pStrings = nullptr;
+		std::uint32_t m_stringsSize = 0;
+	};
+}
+
+#endif // !___ASSET_ARCHIVE_H___
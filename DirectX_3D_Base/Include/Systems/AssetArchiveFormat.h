@@ -0,0 +1,140 @@
+﻿/*****************************************************************//**
+ * @file	AssetArchiveFormat.h
+ * @brief	アセットアーカイブ (Tools/AssetPacker の出力) のバイナリ形式
+ *
+ * @details	ヘッダー・索引・文字列・データの順に並べた1つのファイル。
+ *			索引はキー (アセットIDまたは正規化したパスの FNV-1a) と種類の順に並べ、
+ *			二分探索で引く。CSV に登録されたアセットの索引は、同じファイルのパスの索引と
+ *			同じデータを指すため、データは一度だけ格納される。
+ *			各データは DATA_ALIGN 境界に置き、マップした領域をそのまま読み込みに渡せるようにする。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：.pak の形式を定義。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	レコードの構成を変更した場合は VERSION を上げること (古いアーカイブはマウントせずに元ファイルを読む)
+ *********************************************************************/
+
+#ifndef ___ASSET_ARCHIVE_FORMAT_H___
+#define ___ASSET_ARCHIVE_FORMAT_H___
+
+// ===== インクルード =====
+#include <cstdint>
+#include <string>
+#include "Systems/AssetHandle.h"
+
+namespace Asset
+{
+	namespace Pack
+	{
+		const std::uint32_t MAGIC = 0x4B415041u;	// "APAK"
+		const std::uint32_t VERSION = 1;
+		const std::uint32_t DATA_ALIGN = 16;		// 各データの先頭の境界
+		const std::uint32_t NO_PATH = 0xFFFFFFFFu;
+
+		/// @brief 索引の種類 (CSV のアセットは AssetType と同じ値)
+		enum EntryType : std::uint8_t
+		{
+			ENTRY_MODEL,
+			ENTRY_TEXTURE,
+			ENTRY_SOUND,
+			ENTRY_ANIMATION,
+			ENTRY_EFFECT,
+			ENTRY_FILE = 0xFF,	// パスで引くファイル (モデルのテクスチャ・変換済みバイナリなど)
+		};
+
+		/// @brief データの圧縮形式 (ゼロコピーで渡すため、現在は無圧縮のみ)
+		enum Compression : std::uint8_t
+		{
+			COMPRESSION_NONE,
+		};
+
+		struct ArchiveHeader
+		{
+			std::uint32_t	magic;
+			std::uint32_t	version;
+			std::uint32_t	entryNum;		// 索引の数
+			std::uint32_t	stringsSize;	// 文字列セクションのバイト数
+			std::uint64_t	indexOffset;	// EntryRecord × entryNum
+			std::uint64_t	stringsOffset;	// 終端付き文字列の連結
+			std::uint64_t	dataSize;		// データ部分の合計 (統計用)
+		};
+
+		struct EntryRecord
+		{
+			AssetHash		key;			// アセットID か NormalizePath したパスのハッシュ
+			std::uint8_t	type;			// EntryType
+			std::uint8_t	compression;	// Compression
+			std::uint16_t	reserved;
+			std::uint32_t	path;			// 文字列セクション上の元のパス (正規化済み)
+			std::uint64_t	offset;			// ファイル先頭からのバイト数
+			std::uint64_t	size;			// 格納したバイト数
+			std::uint64_t	rawSize;		// 展開後のバイト数 (無圧縮なら size と同じ)
+		};
+
+		/// @brief 索引の並び順 (キー → 種類)
+		inline bool operator<(const EntryRecord& a, const EntryRecord& b)
+		{
+			return (a.key != b.key) ? (a.key < b.key) : (a.type < b.type);
+		}
+
+		/**
+		 * [std::string - NormalizePath]
+		 * @brief	パスを索引用に正規化する ('\' → '/'、英字は小文字、"." と "dir/.." の区切りを除く)
+		 * @note	Windows のファイル名は大文字小文字を区別しないため、どちらで書かれていても同じ索引を引く
+		 */
+		inline std::string NormalizePath(const std::string& path)
+		{
+			std::string result;
+			result.reserve(path.size());
+			size_t begin = 0;
+			while (begin <= path.size())
+			{
+				// 区切り文字までを1つの要素として取り出す
+				size_t end = path.find_first_of("/\\", begin);
+				if (end == std::string::npos) end = path.size();
+				std::string part = path.substr(begin, end - begin);
+				for (char& c : part)
+				{
+					if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+				}
+				begin = end + 1;
+
+				if (part.empty() || part == ".")
+				{
+					if (end == 0) result = "/";	// 絶対パスの先頭
+					continue;
+				}
+				if (part == "..")
+				{
+					// 直前の要素を取り除く (取り除けなければ残す)
+					const size_t last = result.find_last_of('/', result.size() >= 2 ? result.size() - 2 : 0);
+					const std::string prev = result.substr(last == std::string::npos ? 0 : last + 1);
+					if (!result.empty() && prev != "../" && prev != "/")
+					{
+						result.resize(last == std::string::npos ? 0 : last + 1);
+						continue;
+					}
+				}
+				result += part;
+				if (end < path.size()) result += '/';
+			}
+			// 末尾の区切りは除く
+			if (result.size() > 1 && result.back() == '/') result.pop_back();
+			return result;
+		}
+
+		inline AssetHash HashPath(const std::string& path)
+		{
+			return HashAssetID(NormalizePath(path));
+		}
+	}
+}
+
+#endif // !___ASSET_ARCHIVE_FORMAT_H___
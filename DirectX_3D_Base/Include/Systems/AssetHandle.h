@@ -0,0 +1,69 @@
+﻿/*****************************************************************//**
+ * @file	AssetHandle.h
+ * @brief	アセットIDのハッシュとハンドルの定義
+ *
+ * @details	アセットIDの文字列は CSV 読み込み時に FNV-1a (64bit) でハッシュ化し、
+ *			種類ごとの配列の添え字 (AssetHandle) に変換する。
+ *			コンポーネントは解決済みのハンドルを保持し、毎フレームの文字列比較を避ける。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ハッシュ関数とハンドルを定義。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	ハッシュの衝突は AssetManager が CSV 読み込み時に検出する
+ *********************************************************************/
+
+#ifndef ___ASSET_HANDLE_H___
+#define ___ASSET_HANDLE_H___
+
+// ===== インクルード =====
+#include <cstdint>
+#include <string>
+
+namespace Asset
+{
+	using AssetHash = std::uint64_t;
+
+	/**
+	 * [AssetHash - HashAssetID]
+	 * @brief	アセットIDを FNV-1a (64bit) でハッシュ化する (コンパイル時にも使える)
+	 */
+	constexpr AssetHash HashAssetID(const char* assetID)
+	{
+		AssetHash hash = 14695981039346656037ull;
+		while (*assetID != '\0')
+		{
+			hash ^= static_cast<unsigned char>(*assetID++);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	inline AssetHash HashAssetID(const std::string& assetID)
+	{
+		return HashAssetID(assetID.c_str());
+	}
+
+	/**
+	 * @struct	AssetHandle
+	 * @brief	種類ごとのアセット表の添え字 (表を作り直すと世代が変わり、古いハンドルは無効になる)
+	 */
+	struct AssetHandle
+	{
+		static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+		std::uint32_t index = INVALID_INDEX;
+		std::uint32_t generation = 0;
+
+		bool IsValid() const { return index != INVALID_INDEX; }
+		void Reset() { index = INVALID_INDEX; generation = 0; }
+	};
+}
+
+#endif // !___ASSET_HANDLE_H___
@@ -0,0 +1,155 @@
+﻿/*****************************************************************//**
+ * @file	AssetLoader.h
+ * @brief	アセットの非同期読み込み (ワーカースレッドのジョブキュー)
+ *
+ * @details	読み込みを2段階に分けて実行する。
+ *			  Work   : ワーカースレッドで実行 (ファイル読み込み・assimp・画像/WAV の展開)
+ *			  Finish : メインスレッドの Update で実行 (GPU リソース・ボイスの作成と完了通知)
+ *			Direct3D / XAudio2 に依存しないため、デバイスを使わない Finish を渡せば Linux 上でも動作を確認できる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ジョブキュー・メインスレッドでの完了処理・待機を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	Submit / Update / Wait / Stop はメインスレッドからのみ呼び出すこと
+ *********************************************************************/
+
+#ifndef ___ASSET_LOADER_H___
+#define ___ASSET_LOADER_H___
+
+// ===== インクルード =====
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Asset
+{
+	/**
+	 * @enum	LoadState
+	 * @brief	アセットの読み込み状態
+	 */
+	enum class LoadState
+	{
+		Unloaded,	// 未要求
+		Pending,	// 読み込み中
+		Ready,		// 使用可能
+		Failed,		// 読み込み失敗 (再要求しても読み直さない)
+	};
+
+	/**
+	 * @class	AssetLoader
+	 * @brief	読み込みジョブをワーカースレッドで実行し、完了処理をメインスレッドへ戻す
+	 */
+	class AssetLoader
+	{
+	public:
+		using JobID = std::uint64_t;
+		using Work = std::function<bool()>;				// ワーカースレッドで実行 (戻り値は成否)
+		using Finish = std::function<void(bool)>;		// メインスレッドで実行 (引数は Work の成否)
+		using ThreadHook = std::function<void()>;		// ワーカースレッドの開始・終了時に実行
+
+		static const JobID JOB_NONE = 0;
+
+	public:
+		AssetLoader() = default;
+		~AssetLoader();
+
+		AssetLoader(const AssetLoader&) = delete;
+		AssetLoader& operator=(const AssetLoader&) = delete;
+
+		/**
+		 * [void - Start]
+		 * @brief	ワーカースレッドを起動する (0 の場合は Update の中でメインスレッドが Work も実行する)
+		 *
+		 * @param	[in] threadNum スレッド数
+		 * @param	[in] onThreadStart 各スレッドの開始時に実行する処理 (COM の初期化など)
+		 * @param	[in] onThreadEnd 各スレッドの終了時に実行する処理
+		 */
+		void Start(unsigned int threadNum, ThreadHook onThreadStart = nullptr, ThreadHook onThreadEnd = nullptr);
+
+		/**
+		 * [void - Stop]
+		 * @brief	ワーカースレッドを終了する
+		 * @details	実行中のジョブは Work の完了を待ち、Finish が済んでいない全てのジョブに Finish(false) を呼ぶ
+		 *			(未着手のジョブの Work は実行しない)
+		 */
+		void Stop();
+
+		/**
+		 * [JobID - Submit]
+		 * @brief	ジョブを登録する
+		 */
+		JobID Submit(Work work, Finish finish);
+
+		/**
+		 * [size_t - Update]
+		 * @brief	Work が完了したジョブの Finish を完了した順に実行する
+		 *
+		 * @param	[in] budgetMs この時間を超えたら残りは次回に回す (0 以下で全て実行)
+		 * @return	Finish を実行したジョブ数
+		 */
+		size_t Update(float budgetMs = 0.0f);
+
+		/**
+		 * [void - Wait]
+		 * @brief	指定したジョブの完了を待ち、Finish を実行する
+		 * @details	未着手のジョブはキューから取り出してこのスレッドで Work を実行する (後ろに並んだジョブを待たない)
+		 */
+		void Wait(JobID id);
+
+		/**
+		 * [size_t - GetPendingNum]
+		 * @brief	Finish が済んでいないジョブ数
+		 */
+		size_t GetPendingNum() const;
+
+		unsigned int GetThreadNum() const { return static_cast<unsigned int>(m_threads.size()); }
+
+	private:
+		enum class JobState
+		{
+			Queued,		// 未着手
+			Running,	// Work 実行中
+			Done,		// Work 完了 (Finish 待ち)
+		};
+
+		struct Job
+		{
+			JobID		id;
+			Work		work;
+			Finish		finish;
+			JobState	state;
+			bool		result;
+		};
+		using JobPtr = std::shared_ptr<Job>;
+
+		void WorkerMain(ThreadHook onThreadStart, ThreadHook onThreadEnd);
+		// Finish を実行して一覧から除く (メインスレッド)
+		void Complete(const JobPtr& pJob);
+
+	private:
+		mutable std::mutex			m_mutex;
+		std::condition_variable		m_queueCv;		// ジョブ追加・終了要求の通知 (ワーカー向け)
+		std::condition_variable		m_doneCv;		// Work 完了の通知 (Wait 向け)
+		std::deque<JobPtr>			m_queue;		// 未着手のジョブ
+		std::deque<JobPtr>			m_done;			// Work 完了順のジョブ
+		std::unordered_map<JobID, JobPtr>	m_jobs;	// Finish が済んでいない全ジョブ
+		std::vector<std::thread>	m_threads;
+		JobID						m_nextID = 1;
+		bool						m_isStopping = false;
+	};
+}
+
+#endif // !___ASSET_LOADER_H___
@@ -24,11 +24,20 @@
 #include <iostream>
 #include <string>
 #include <map>
+#include <functional>
+#include <vector>
 #include <stdexcept>
+#include <memory>
+#include <unordered_map>
 #include "Utility/CSVLoader.h"
 #include "Systems/Model.h"
 #include "Systems/DirectX/Texture.h"
 #include "Systems/XAudio2/SoundEffect.h"
+#include "Systems/AssetLoader.h"
+#include "Systems/AssetHandle.h"
+#include "Systems/AssetResidency.h"
+#include "Systems/AssetManifest.h"
+#include "Systems/AssetArchive.h"
 #include <Effekseer/Effekseer.h>
 #include <Effekseer/EffekseerRendererDX11.h>
 
@@ -55,11 +64,77 @@ namespace Asset
 	struct AssetInfo
 	{
 		std::string assetID;	// CSV1sځiIDj
+		AssetHash hash = 0;		// assetID ̃nbV
+		AssetHandle handle;		// \̒̈ʒu (o^ɐݒ肳)
 		std::string filePath;	// CSV3sځit@CpXj
 		AssetType type = AssetType::Unknown;
 
 		// [hς݃\[XLbV邽߂̃|C^
 		void* pResource = nullptr;
+
+		// 񓯊ǂݍ݂̏ (pResource  Ready ɂȂĂݒ肳)
+		LoadState state = LoadState::Unloaded;
+		AssetLoader::JobID jobID = AssetLoader::JOB_NONE;
+		// ǂݍ݊ (EsƂ) ɃCXbhŌĂ΂R[obN
+		std::vector<std::function<void(AssetInfo&)>> callbacks;
+
+		// QƐE풓 (AssetResidency Ǘ)
+		ResidencyEntry residency;
+	};
+
+	/**
+	 * @class	AssetTable
+	 * @brief	ނƂ̃AZbg\ (nbV -> Y -> AssetInfo)
+	 * @note	AssetInfo ͌ʂɊmۂ邽߁Ao^ǉĂ|C^͕ςȂ
+	 */
+	class AssetTable
+	{
+	public:
+		enum class AddResult
+		{
+			Added,
+			Duplicate,	// IDo^ς
+			Collision	// ʂIDƃnbVՓ
+		};
+
+		AddResult Add(const AssetInfo& info, const AssetInfo** ppExisting = nullptr);
+		void Clear();
+
+		// 񂩂̌ (nbVňAÔIDr)
+		AssetInfo* Find(const std::string& assetID);
+		const AssetInfo* Find(const std::string& assetID) const;
+		AssetHandle FindHandle(const std::string& assetID) const;
+
+		// nh̎擾 (EÂnh nullptr)
+		AssetInfo* Get(const AssetHandle& handle)
+		{
+			if (handle.index >= m_infos.size() || handle.generation != m_generation) return nullptr;
+			return m_infos[handle.index].get();
+		}
+
+		size_t size() const { return m_infos.size(); }
+		std::vector<std::unique_ptr<AssetInfo>>::iterator begin() { return m_infos.begin(); }
+		std::vector<std::unique_ptr<AssetInfo>>::iterator end() { return m_infos.end(); }
+
+	private:
+		std::vector<std::unique_ptr<AssetInfo>> m_infos;
+		std::unordered_map<AssetHash, std::uint32_t> m_indexMap;
+		std::uint32_t m_generation = 1;
+	};
+
+	// ǂݍ݊̒ʒm (info.state  Ready Ȃ琬AFailed Ȃ玸s)
+	using ReadyCallback = std::function<void(AssetInfo&)>;
+
+	/**
+	 * @struct	AtlasRegion
+	 * @brief	AgX (Tools/AtlasPacker) ɂ܂Ƃ߂eNX`́Ay[W͈̔
+	 */
+	struct AtlasRegion
+	{
+		std::string assetID;		// ܂Ƃ߂ÕeNX`ID
+		std::string pageID;			// y[W̃eNX`ID (eNX`̕\ɓo^)
+		DirectX::XMFLOAT2 uvPos;	// y[W̍ (0.0f - 1.0f)
+		DirectX::XMFLOAT2 uvScale;	// y[W̑傫 (0.0f - 1.0f)
 	};
 
 	/**
@@ -72,26 +147,38 @@ namespace Asset
 		static AssetManager* s_instance;
 
 		// --------------------------------------------------
-		// CSVǂݍ񂾃AZbg̃}bv
-		// AssetID (string) -> AssetInfo
+		// CSVǂݍ񂾃AZbg̕\
+		// AssetID (nbV) -> AssetInfo
 		// --------------------------------------------------
-		std::map<std::string, AssetInfo> m_modelMap;
-		std::map<std::string, AssetInfo> m_textureMap;
-		std::map<std::string, AssetInfo> m_soundMap;
-		std::map<std::string, AssetInfo> m_animationMap;
-		std::map<std::string, AssetInfo> m_effectMap;
+		AssetTable m_modelTable;
+		AssetTable m_textureTable;
+		AssetTable m_soundTable;
+		AssetTable m_animationTable;
+		AssetTable m_effectTable;
 
 	private:
 		// ÕCX^X֎~
-		AssetManager() = default;
+		AssetManager();
 		// Rs[A[u֎~
 		AssetManager(const AssetManager&) = delete;
 		AssetManager& operator=(const AssetManager&) = delete;
 		AssetManager(AssetManager&&) = delete;
 		AssetManager& operator=(AssetManager&&) = delete;
 
+		// AZbgA[JCu (ǂݍݒ̃WuETEh}bv̈QƂ邽߁Aɐ錾)
+		AssetArchive m_archive;
+
 		Effekseer::ManagerRef m_effekseerManager = nullptr;
-		std::map<std::string, Effekseer::EffectRef> m_effectRefMap;
+		std::unordered_map<AssetHash, Effekseer::EffectRef> m_effectRefMap;
+
+		// AgXɂ܂Ƃ߂eNX` ( assetID ̃nbV -> y[W͈̔)
+		std::unordered_map<AssetHash, AtlasRegion> m_atlasMap;
+
+		// 񓯊ǂݍ (}bvQƂ邽߁A}bvɐ錾Đɔj)
+		AssetLoader m_loader;
+
+		// QƐE\ZELRU 
+		AssetResidency m_residency;
 
 	public:
 		/**
@@ -127,7 +214,7 @@ namespace Asset
 		// ----------------------------------------
 		// wp[֐
 		// ----------------------------------------
-		bool LoadAssetListInternal(const std::string& csvPath, std::map<std::string, AssetInfo>& targetMap, AssetType type);
+		bool LoadAssetListInternal(const std::string& csvPath, AssetTable& targetTable, AssetType type);
 
 		// ----------------------------------------
 		// CSVǂݍ݊֘ÃC^[tF[X
@@ -137,6 +224,29 @@ namespace Asset
 		bool LoadSoundList(const std::string& csvPath);
 		bool LoadAnimationList(const std::string& csvPath);
 		bool LoadEffectList(const std::string& csvPath);
+		/**
+		 * [bool - LoadAtlasList]
+		 * @brief	Tools/AtlasPacker oAgẌꗗǂݍ
+		 * @details	y[WeNX`Ƃēo^A܂Ƃ߂O ID y[W͈̔͂悤ɂB
+		 *			TextureList ̌ɌĂԂ (܂Ƃ߂ÕeNX`̂܂ܓǂݍ߂)B
+		 * @return	false : ꗗ (AgXg킸ɕ`悷)
+		 */
+		bool LoadAtlasList(const std::string& csvPath);
+
+		// ----------------------------------------
+		// AZbgA[JCu
+		// ----------------------------------------
+		/**
+		 * [bool - MountArchive]
+		 * @brief	Tools/AssetPacker ō쐬A[JCu}Eg
+		 * @details	}Eg̓A[JCũf[^Rs[ɓǂݍ݂֓nA
+		 *			A[JCuɖ (}EgĂȂꍇ͑S) ͌t@CǂݍށB
+		 * @return	false : A[JCuEĂ (t@Cǂݍ)
+		 * @note	ǂݍ݂n߂OɌĂԂ
+		 */
+		bool MountArchive(const std::string& archivePath);
+		// A[JCũt@CpXň (΋B[J[XbhĂяo)
+		FileView FindArchiveFile(const std::string& path) const { return m_archive.FindFile(path); }
 
 		// ----------------------------------------
 		// AZbgpX擾C^[tFX
@@ -151,14 +261,109 @@ namespace Asset
 		// \[X[hC^tF[X
 		// ----------------------------------------
 		// [h֐ AssetInfo* ԂAŃLbV̗L`FbN
+		// ǂݍ݂I܂ő҂ (s nullptr)
 		AssetInfo* LoadModel(const std::string& assetID, float scale, Model::Flip flip);
 		AssetInfo* LoadTexture(const std::string& assetID);
 		AssetInfo* LoadSound(const std::string& assetID);
 		Effekseer::EffectRef LoadEffect(const std::string& assetID);
 
+		// ----------------------------------------
+		// 񓯊[hC^tF[X
+		// ----------------------------------------
+		// t@C̓ǂݍ݁EWJ[J[XbhōsAGPU \[XE{CX̍쐬 Update ̒ōsB
+		// ߂l state  Ready ɂȂ܂ pResource  nullptr (o^ ID  nullptr Ԃ)B
+		//  Ready / Failed ̃AZbg̓R[obN̏ŌĂяoBsAZbg͍ėvĂǂݒȂB
+		AssetInfo* RequestModel(const std::string& assetID, float scale, Model::Flip flip, ReadyCallback callback = nullptr);
+		AssetInfo* RequestTexture(const std::string& assetID, ReadyCallback callback = nullptr);
+		AssetInfo* RequestSound(const std::string& assetID, ReadyCallback callback = nullptr);
+		AssetInfo* RequestEffect(const std::string& assetID, ReadyCallback callback = nullptr);
+		// ǂݍݍς݂̃GtFNg擾 (Ȃ nullptr)
+		Effekseer::EffectRef GetEffect(const std::string& assetID) const;
+		Effekseer::EffectRef GetEffect(const AssetInfo* pInfo) const;
+
+		// ----------------------------------------
+		// nhł̔񓯊[hC^tF[X
+		// ----------------------------------------
+		// ref  (܂͌Â) ꍇ assetID AQƂď߂B
+		// R|[lgɎQƂĂ΁At[̌Ăяoŕ킸A
+		// R|[lgj܂ŃAZbg͉ȂB
+		AssetInfo* RequestTexture(AssetRef& ref, const std::string& assetID, ReadyCallback callback = nullptr);
+		AssetInfo* RequestSound(AssetRef& ref, const std::string& assetID, ReadyCallback callback = nullptr);
+		AssetInfo* RequestEffect(AssetRef& ref, const std::string& assetID, ReadyCallback callback = nullptr);
+		// QƂɃnhŗv (P SE ̂悤ɖ炷̌BÂnh nullptr Ԃ)
+		AssetHandle FindSoundHandle(const std::string& assetID) const { return m_soundTable.FindHandle(assetID); }
+		AssetInfo* RequestSound(const AssetHandle& handle, ReadyCallback callback = nullptr);
+
+		// ----------------------------------------
+		// AgXC^tF[X
+		// ----------------------------------------
+		// AgXɂ܂Ƃ߂eNX`̃y[W͈̔ (܂Ƃ߂ĂȂ nullptr)
+		const AtlasRegion* FindAtlasRegion(const std::string& assetID) const;
+		// UI p̃eNX`vBassetID AgXɂ܂Ƃ߂Ă΃y[WvApRegion ɔ͈͂
+		// (܂Ƃ߂ĂȂ pRegion  nullptr)Bref ς݂̊Ԃ pRegion ̂܂܎gB
+		AssetInfo* RequestSpriteTexture(AssetRef& ref, const AtlasRegion*& pRegion, const std::string& assetID, ReadyCallback callback = nullptr);
+
+		// ----------------------------------------
+		// QƐE풓ǗC^tF[X
+		// ----------------------------------------
+		// AZbgւ̎QƂ (QƂԂ͉Ȃ)
+		AssetRef MakeRef(AssetInfo* pInfo);
+		// ނƂ̃\Z (0 Ŗ)BƎQƂĂȂ̂Âɉ
+		void SetBudget(AssetType type, size_t bytes) { m_residency.SetBudget(static_cast<int>(type), bytes); }
+		const ResidencyStats& GetStats(AssetType type) const { return m_residency.GetStats(static_cast<int>(type)); }
+
+		/**
+		 * [void - OnSceneChanged]
+		 * @brief	V[؂ւ (VV[ Init ̌) ɌĂсAgȂȂAZbg
+		 * @note	ÕV[Ŏĝ͎c (LoadingScene ̐ǂ݁EgC̍ėp̂)
+		 */
+		void OnSceneChanged();
+
+		/**
+		 * [std::shared_ptr<ManifestProgress> - RequestManifest]
+		 * @brief	}jtFXgɍڂĂSAZbg܂Ƃ߂ėv
+		 * @return	i (Update ̒ŊʒmƂɍXVBo^ ID ͎sƂĐ)
+		 * @note	fɊ֘AtAj[V́Af̓ǂݍ݊ AddAnimation 
+		 */
+		std::shared_ptr<ManifestProgress> RequestManifest(const AssetManifest& manifest);
+
+		/**
+		 * [void - Update]
+		 * @brief	[J[Xbhœǂݍ݂IAZbg̊s (t[ACXbhĂ)
+		 * @param	[in] budgetMs 1t[ŊɎgԂ̖ڈ (͎̃t[ɉ)
+		 */
+		void Update(float budgetMs = 4.0f);
+
+		/**
+		 * [void - Wait]
+		 * @brief	w肵AZbg̓ǂݍ݊҂ (Ȃ炱̃Xbhœǂݍ)
+		 */
+		void Wait(AssetInfo* pInfo);
+
+		// ςłȂǂݍݐ
+		size_t GetPendingNum() const { return m_loader.GetPendingNum(); }
+
 		// LbV֐ (̃XebvŎ)
 		void UnloadAll();
 		void UnloadEffects();
+
+	private:
+		// 񓯊ǂݍ݂̋ʏ
+		void StartLoader();
+		AssetInfo* FindAsset(AssetTable& targetTable, const std::string& assetID, const char* typeName);
+		AssetInfo* ResolveRef(AssetTable& targetTable, AssetRef& ref, const std::string& assetID, const char* typeName);
+		// o^ς݂̃AZbg̓ǂݍ݂v (pInfo  nullptr Ȃ牽Ȃ)
+		AssetInfo* RequestModelInfo(AssetInfo* pInfo, float scale, Model::Flip flip, ReadyCallback callback);
+		AssetInfo* RequestTextureInfo(AssetInfo* pInfo, ReadyCallback callback);
+		AssetInfo* RequestSoundInfo(AssetInfo* pInfo, ReadyCallback callback);
+		AssetInfo* RequestEffectInfo(AssetInfo* pInfo, ReadyCallback callback);
+		// Vǂݍ݂n߂Kv true (Pending ɂ)Bςł΃R[obNĂ
+		bool BeginRequest(AssetInfo& info, ReadyCallback callback);
+		// ǂݍ݌ʂ𔽉fAR[obNĂ
+		// bytes: 풓郁 (\ŽvZɎg)
+		void FinishRequest(AssetInfo& info, bool isSucceeded, size_t bytes = 0);
+		// QƂȂȂAZbg̃\[X (AssetResidency Ă΂)
+		void Evict(AssetInfo& info);
 	};
 }
 
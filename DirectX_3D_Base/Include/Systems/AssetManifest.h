@@ -0,0 +1,103 @@
+﻿/*****************************************************************//**
+ * @file	AssetManifest.h
+ * @brief	シーンが使用するアセットの一覧 (先読み用)
+ *
+ * @details	各シーンは Scene::CollectAssets で使用するアセット ID を列挙し、
+ *			LoadingScene がそれを AssetManager::RequestManifest でまとめて要求する。
+ *			全て読み込み終わってからシーンを切り替えることで、シーン開始直後の読み込みを無くす。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：マニフェストと読み込み進捗を定義。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	モデルはスケール・反転ごとにではなく ID ごとに1つだけ読み込まれる (最初の要求の設定が使われる)
+ *********************************************************************/
+
+#ifndef ___ASSET_MANIFEST_H___
+#define ___ASSET_MANIFEST_H___
+
+// ===== インクルード =====
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "Systems/Model.h"
+#include "Systems/AssetResidency.h"
+
+namespace Asset
+{
+	/**
+	 * @struct	AssetManifest
+	 * @brief	シーンが使用するアセット ID の一覧 (重複は追加時に除く)
+	 */
+	struct AssetManifest
+	{
+		struct ModelEntry
+		{
+			std::string assetID;
+			float scale;
+			Model::Flip flip;
+			std::vector<std::string> animations;	// 読み込み後に関連付けるアニメーション ID
+		};
+
+		std::vector<ModelEntry> models;
+		std::vector<std::string> textures;
+		std::vector<std::string> sounds;
+		std::vector<std::string> effects;
+
+		void AddModel(const std::string& assetID, float scale, Model::Flip flip, const std::vector<std::string>& animations = {})
+		{
+			auto it = std::find_if(models.begin(), models.end(),
+				[&assetID](const ModelEntry& entry) { return entry.assetID == assetID; });
+			if (it == models.end())
+			{
+				models.push_back({ assetID, scale, flip, animations });
+				return;
+			}
+			for (const auto& animeID : animations)
+			{
+				AddUnique(it->animations, animeID);
+			}
+		}
+		void AddTexture(const std::string& assetID) { AddUnique(textures, assetID); }
+		void AddSound(const std::string& assetID) { AddUnique(sounds, assetID); }
+		void AddEffect(const std::string& assetID) { AddUnique(effects, assetID); }
+
+		// 読み込み単位の総数 (アニメーションの関連付けはモデルに含める)
+		size_t GetTotalNum() const { return models.size() + textures.size() + sounds.size() + effects.size(); }
+
+	private:
+		static void AddUnique(std::vector<std::string>& list, const std::string& assetID)
+		{
+			if (std::find(list.begin(), list.end(), assetID) == list.end())
+			{
+				list.push_back(assetID);
+			}
+		}
+	};
+
+	/**
+	 * @struct	ManifestProgress
+	 * @brief	AssetManager::RequestManifest の進捗 (完了通知から更新される)
+	 */
+	struct ManifestProgress
+	{
+		size_t totalNum = 0;	// 要求したアセット数
+		size_t doneNum = 0;		// 完了したアセット数 (失敗を含む)
+		size_t failedNum = 0;	// 失敗したアセット数
+		float elapsedMs = 0.0f;	// 要求から全て完了するまでの時間
+
+		// 要求したアセットへの参照 (進捗を破棄するまで解放されない)
+		std::vector<AssetRef> refs;
+
+		bool IsDone() const { return doneNum >= totalNum; }
+		float GetRatio() const { return totalNum > 0 ? static_cast<float>(doneNum) / static_cast<float>(totalNum) : 1.0f; }
+	};
+}
+
+#endif // !___ASSET_MANIFEST_H___
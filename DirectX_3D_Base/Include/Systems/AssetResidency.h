@@ -0,0 +1,154 @@
+﻿/*****************************************************************//**
+ * @file	AssetResidency.h
+ * @brief	アセットの参照数・常駐メモリ量の管理と LRU による解放
+ *
+ * @details	AssetManager の各アセットは ResidencyEntry を1つ持ち、
+ *			コンポーネントは AssetRef を通して参照数を増減する。
+ *			参照されていない常駐アセットは最後に使われた順に並べておき、
+ *			種類ごとの予算を超えた時とシーン切り替え時に古いものから解放する。
+ *			実際のリソースの解放は登録した関数に任せるため、D3D を使わずに検証できる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：参照数・予算・LRU 解放・統計を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	メインスレッドからのみ使用する
+ *********************************************************************/
+
+#ifndef ___ASSET_RESIDENCY_H___
+#define ___ASSET_RESIDENCY_H___
+
+// ===== インクルード =====
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include "Systems/AssetHandle.h"
+
+namespace Asset
+{
+	/**
+	 * @struct	ResidencyEntry
+	 * @brief	アセット1つ分の常駐情報 (AssetInfo が保持する)
+	 */
+	struct ResidencyEntry
+	{
+		void* pOwner = nullptr;			// 解放時に渡す持ち主 (AssetInfo*)
+		int slot = 0;					// 予算・統計の区分 (アセットの種類)
+		std::size_t bytes = 0;			// 常駐しているメモリ量
+		std::uint32_t refCount = 0;		// AssetRef による参照数
+		std::uint64_t lastUseFrame = 0;	// 最後に要求されたフレーム
+		bool isResident = false;
+
+		// 参照されていない常駐アセットの LRU 上の位置
+		bool isInLRU = false;
+		std::list<ResidencyEntry*>::iterator lruIt;
+	};
+
+	/**
+	 * @struct	ResidencyStats
+	 * @brief	種類ごとの統計
+	 */
+	struct ResidencyStats
+	{
+		std::size_t residentBytes = 0;	// 常駐しているメモリ量
+		std::size_t residentNum = 0;	// 常駐しているアセット数
+		std::size_t budgetBytes = 0;	// 予算 (0 なら無制限)
+		std::uint64_t hitNum = 0;		// 読み込み済みだった要求の数
+		std::uint64_t missNum = 0;		// 読み込みを始めた要求の数
+		std::uint64_t evictNum = 0;		// 解放したアセット数
+		std::size_t evictedBytes = 0;	// 解放したメモリ量の累計
+	};
+
+	class AssetResidency;
+
+	/**
+	 * @class	AssetRef
+	 * @brief	アセットの参照を保持する (コピーで参照数+1、破棄で-1)
+	 * @note	コンポーネントに持たせ、エンティティの寿命と参照数を連動させる
+	 */
+	class AssetRef
+	{
+	public:
+		AssetRef() = default;
+		AssetRef(AssetResidency* pResidency, ResidencyEntry* pEntry, const AssetHandle& handle);
+		AssetRef(const AssetRef& other);
+		AssetRef(AssetRef&& other) noexcept;
+		AssetRef& operator=(const AssetRef& other);
+		AssetRef& operator=(AssetRef&& other) noexcept;
+		~AssetRef() { Reset(); }
+
+		void Reset();
+		bool IsValid() const { return m_pEntry != nullptr; }
+		const AssetHandle& GetHandle() const { return m_handle; }
+
+	private:
+		AssetResidency* m_pResidency = nullptr;
+		ResidencyEntry* m_pEntry = nullptr;
+		AssetHandle m_handle;
+	};
+
+	/**
+	 * @class	AssetResidency
+	 * @brief	参照数と常駐メモリ量を数え、予算を超えたら参照されていないアセットを古い順に解放する
+	 */
+	class AssetResidency
+	{
+	public:
+		static constexpr int SLOT_NUM = 8;
+		using EvictFunc = std::function<void(ResidencyEntry&)>;
+
+		void SetEvictFunc(EvictFunc func) { m_evictFunc = func; }
+		// 予算の設定 (0 で無制限)。超えていれば即座に解放する
+		void SetBudget(int slot, std::size_t bytes);
+
+		// 毎フレームの最初に呼ぶ (このフレームで使われたアセットは予算超過でも解放しない)
+		void BeginFrame() { m_frame++; }
+
+		// 要求の記録 (isHit: 読み込み済みだったか)
+		void Touch(ResidencyEntry& entry, bool isHit);
+		// 読み込みが完了して常駐した
+		void OnResident(ResidencyEntry& entry, std::size_t bytes);
+		// 外部で解放された (登録した関数は呼ばない)
+		void Forget(ResidencyEntry& entry);
+
+		void AddRef(ResidencyEntry& entry);
+		void Release(ResidencyEntry& entry);
+
+		/**
+		 * [size_t - OnSceneChanged]
+		 * @brief	前回のシーン切り替えより前から使われていない、参照されていないアセットを全て解放する
+		 * @return	解放したアセット数
+		 * @note	新しいシーンの Init の後に呼ぶ。直前のシーン (LoadingScene など) で使ったものは1回分残す
+		 */
+		std::size_t OnSceneChanged();
+
+		const ResidencyStats& GetStats(int slot) const { return m_slots[slot].stats; }
+
+	private:
+		struct Slot
+		{
+			ResidencyStats stats;
+			std::list<ResidencyEntry*> lru;	// 先頭が最近使われたもの
+			bool isOverBudget = false;
+		};
+
+		void Evict(ResidencyEntry& entry);
+		void EnforceBudget(int slot);
+		void PushLRU(ResidencyEntry& entry);
+		void RemoveLRU(ResidencyEntry& entry);
+
+		Slot m_slots[SLOT_NUM];
+		EvictFunc m_evictFunc;
+		std::uint64_t m_frame = 1;
+		std::uint64_t m_sceneMarkFrame = 0;	// 前回のシーン切り替え時のフレーム
+	};
+}
+
+#endif // !___ASSET_RESIDENCY_H___
@@ -0,0 +1,149 @@
+﻿/*****************************************************************//**
+ * @file	AudioBackend.h
+ * @brief	サウンドの出力先 (XAudio2・ソフトウェアミキサー) を差し替えるためのインタフェース
+ *
+ * @details	SoundEffect などはボイスを AudioBackend から作り、AudioVoice を通して操作する。
+ *			ゲームでは XAudio2Backend を使い、Windows 以外ではソフトウェアミキサー (SoftwareMixer) で
+ *			同じ処理を動かして確認・計測できる。
+ *
+ *			ボイスの振る舞いは XAudio2 のソースボイスに合わせる。
+ *			  - Submit したバッファを順に再生し、再生し終えるたびに Callback::OnBufferEnd を呼ぶ
+ *			  - Stop は再生を止めてキューを空にする (捨てたバッファにも OnBufferEnd を呼ぶ)
+ *			  - OnBufferEnd は再生スレッドから呼ばれることがあるため、中でボイスを操作しないこと
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ボイスと出力先のインタフェースを定義。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+#ifndef ___AUDIO_BACKEND_H___
+#define ___AUDIO_BACKEND_H___
+
+// ===== インクルード =====
+#include <cstdint>
+#include <memory>
+
+namespace Audio
+{
+	// WAVE のフォーマットタグ (mmreg.h と同じ値)
+	const std::uint16_t WAVE_TAG_PCM = 0x0001;
+	const std::uint16_t WAVE_TAG_ADPCM = 0x0002;
+	const std::uint16_t WAVE_TAG_IEEE_FLOAT = 0x0003;
+	const std::uint16_t WAVE_TAG_EXTENSIBLE = 0xFFFE;
+
+	// 止めるまで繰り返す (XAUDIO2_LOOP_INFINITE と同じ値)
+	const std::uint32_t AUDIO_LOOP_INFINITE = 255;
+
+#pragma pack(push, 1)
+	/**
+	 * @struct	WaveFormat
+	 * @brief	WAVEFORMATEX と同じ並びのフォーマット情報 (extraSize バイトの追加情報が後ろに続く)
+	 */
+	struct WaveFormat
+	{
+		std::uint16_t formatTag;
+		std::uint16_t channels;
+		std::uint32_t sampleRate;
+		std::uint32_t avgBytesPerSec;
+		std::uint16_t blockAlign;
+		std::uint16_t bitsPerSample;
+		std::uint16_t extraSize;
+	};
+#pragma pack(pop)
+	static_assert(sizeof(WaveFormat) == 18, "WaveFormat must match the layout of WAVEFORMATEX");
+
+	/**
+	 * @struct	AudioBuffer
+	 * @brief	ボイスへ積む波形 (pData は再生し終える・Stop するまで保持すること)
+	 */
+	struct AudioBuffer
+	{
+		const std::uint8_t* pData = nullptr;
+		std::uint32_t bytes = 0;
+		std::uint32_t loopCount = 0;	// 先頭へ戻る回数 (AUDIO_LOOP_INFINITE : 止めるまで繰り返す)
+		bool isEnd = true;				// この後に続くデータが無い
+	};
+
+	/**
+	 * @class	AudioVoice
+	 * @brief	1つの音を鳴らすボイス (破棄すると止まる)
+	 */
+	class AudioVoice
+	{
+	public:
+		/// @brief 再生の通知先
+		class Callback
+		{
+		public:
+			virtual ~Callback() = default;
+			// バッファを1つ再生し終えた (または Stop で捨てた)。Submit した順に呼ばれる
+			virtual void OnBufferEnd() = 0;
+		};
+
+	public:
+		virtual ~AudioVoice() = default;
+
+		// 再生キューへ積む。積めなければ false
+		virtual bool Submit(const AudioBuffer& buffer) = 0;
+		virtual bool Start() = 0;
+		// 止めてキューを空にする
+		virtual void Stop() = 0;
+		// 再生するバッファが残っているか
+		virtual bool IsActive() const = 0;
+
+		virtual void SetVolume(float volume) = 0;
+		// 左右の振り分け (-1.0f : 左のみ ～ 0.0f : そのまま ～ 1.0f : 右のみ)。反対側を絞るだけで中央の音量は変えない
+		virtual void SetPan(float pan) = 0;
+		// 再生速度の倍率 (AudioBackend::MIN_PITCH - MAX_PITCH)
+		virtual void SetPitch(float pitch) = 0;
+	};
+
+	/**
+	 * @class	AudioBackend
+	 * @brief	ボイスを作る出力先
+	 */
+	class AudioBackend
+	{
+	public:
+		static constexpr float MIN_PITCH = 1.0f / 1024.0f;
+		static constexpr float MAX_PITCH = 2.0f;
+
+		virtual ~AudioBackend() = default;
+
+		/**
+		 * [std::unique_ptr<AudioVoice> - CreateVoice]
+		 * @brief	format のデータを鳴らすボイスを作る (ボイスは AudioBackend より先に破棄すること)
+		 * @param	[in] format フォーマット (後ろに extraSize バイトの追加情報が続くこと)
+		 * @param	[in] pCallback 再生の通知先 (nullptr 可)
+		 * @return	扱えないフォーマット・失敗なら nullptr
+		 */
+		virtual std::unique_ptr<AudioVoice> CreateVoice(const WaveFormat& format, AudioVoice::Callback* pCallback) = 0;
+	};
+
+	// ピッチを扱える範囲に収める
+	inline float ClampPitch(float pitch)
+	{
+		return (pitch < AudioBackend::MIN_PITCH) ? AudioBackend::MIN_PITCH : (pitch > AudioBackend::MAX_PITCH) ? AudioBackend::MAX_PITCH : pitch;
+	}
+
+	/**
+	 * [void - CalcPanGains]
+	 * @brief	SetPan の値から左右の倍率を求める (中央では左右とも 1)
+	 */
+	inline void CalcPanGains(float pan, float* pLeft, float* pRight)
+	{
+		pan = (pan < -1.0f) ? -1.0f : (pan > 1.0f) ? 1.0f : pan;
+		*pLeft = (pan > 0.0f) ? 1.0f - pan : 1.0f;
+		*pRight = (pan < 0.0f) ? 1.0f + pan : 1.0f;
+	}
+}
+
+#endif // !___AUDIO_BACKEND_H___
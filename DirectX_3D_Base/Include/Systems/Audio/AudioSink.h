@@ -0,0 +1,79 @@
+﻿/*****************************************************************//**
+ * @file	AudioSink.h
+ * @brief	ソフトウェアミキサーの出力を受け取る先 (何もしない・WAV ファイルへ書く)
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：出力を捨てる NullAudioSink と、WAV に書き出す WavFileAudioSink を追加。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+#ifndef ___AUDIO_SINK_H___
+#define ___AUDIO_SINK_H___
+
+// ===== インクルード =====
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace Audio
+{
+	/**
+	 * @class	AudioSink
+	 * @brief	ミックスした波形 (float、チャンネルごとに交互に並ぶ) の受け取り先
+	 */
+	class AudioSink
+	{
+	public:
+		virtual ~AudioSink() = default;
+		// frames フレーム分を受け取る。書けなければ false
+		virtual bool Write(const float* pFrames, std::uint32_t frames) = 0;
+	};
+
+	/**
+	 * @class	NullAudioSink
+	 * @brief	受け取ったフレーム数だけ数えて捨てる (計測・確認用)
+	 */
+	class NullAudioSink : public AudioSink
+	{
+	public:
+		bool Write(const float* pFrames, std::uint32_t frames) override
+		{
+			(void)pFrames;
+			m_frames += frames;
+			return true;
+		}
+		std::uint64_t GetFrames() const { return m_frames; }
+
+	private:
+		std::uint64_t m_frames = 0;
+	};
+
+	/**
+	 * @class	WavFileAudioSink
+	 * @brief	32bit float の WAV ファイルへ書き出す (Close でヘッダーの大きさを確定する)
+	 */
+	class WavFileAudioSink : public AudioSink
+	{
+	public:
+		~WavFileAudioSink() override { Close(); }
+
+		bool Open(const std::string& filePath, std::uint32_t sampleRate, std::uint16_t channels);
+		void Close();
+		bool Write(const float* pFrames, std::uint32_t frames) override;
+
+	private:
+		FILE* m_pFile = nullptr;
+		std::uint16_t m_channels = 0;
+		std::uint32_t m_dataBytes = 0;
+	};
+}
+
+#endif // !___AUDIO_SINK_H___
@@ -0,0 +1,109 @@
+﻿/*****************************************************************//**
+ * @file	SoftwareMixer.h
+ * @brief	XAudio2 を使わずに CPU でボイスを混ぜる AudioBackend
+ *
+ * @details	各ボイスを出力のサンプリングレートへ線形補間で変換し (ピッチもここで反映する)、
+ *			音量・左右の振り分けを掛けて float のステレオ出力へ足し込む。
+ *			足し込みは SSE / AVX で行い、使える命令は実行時に調べて選ぶ。
+ *
+ *			扱えるフォーマットは PCM (8 / 16bit) と 32bit float の、モノラル・ステレオのみ (ADPCM は扱えない)。
+ *			出力は Mix で取り出すか、StartOutput で AudioSink (WAV ファイル・何もしない先) へ書き続ける。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：リサンプル・音量・パン・SIMD による足し込みを行うミキサーを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	ボイスの操作と Mix は内部でロックして排他する (OnBufferEnd はロック中に呼ばれる)
+ *********************************************************************/
+
+#ifndef ___SOFTWARE_MIXER_H___
+#define ___SOFTWARE_MIXER_H___
+
+// ===== インクルード =====
+#include "Systems/Audio/AudioBackend.h"
+#include "Systems/Audio/AudioSink.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Audio
+{
+	/**
+	 * @class	SoftwareMixer
+	 * @brief	ボイスを CPU で混ぜてステレオの float 波形を作る
+	 */
+	class SoftwareMixer : public AudioBackend
+	{
+	public:
+		static const int CHANNEL_NUM = 2;					// 出力は常にステレオ
+		static const std::uint32_t BLOCK_FRAMES = 256;		// 1回に混ぜるフレーム数 (StartOutput の書き出し単位)
+		static const int MAX_QUEUED_BUFFERS = 64;			// ボイスごとに積めるバッファの数 (XAudio2 と同じ)
+
+		// 足し込みに使う命令
+		enum class SimdLevel
+		{
+			Scalar,
+			SSE,
+			AVX,
+		};
+
+	public:
+		explicit SoftwareMixer(std::uint32_t sampleRate = 48000);
+		~SoftwareMixer() override;
+		SoftwareMixer(const SoftwareMixer&) = delete;
+		SoftwareMixer& operator=(const SoftwareMixer&) = delete;
+
+		std::unique_ptr<AudioVoice> CreateVoice(const WaveFormat& format, AudioVoice::Callback* pCallback) override;
+
+		/**
+		 * [void - Mix]
+		 * @brief	frames フレーム分を混ぜて pOut へ書く (上書き。左右が交互に並ぶ)
+		 */
+		void Mix(float* pOut, std::uint32_t frames);
+
+		/**
+		 * [bool - StartOutput]
+		 * @brief	別スレッドで混ぜ続け、pSink へ書き出す
+		 * @param	[in] pSink 書き出し先 (StopOutput まで保持すること)
+		 * @param	[in] isRealTime true : 再生時間に合わせて書く / false : 待たずに書き続ける
+		 */
+		bool StartOutput(AudioSink* pSink, bool isRealTime);
+		void StopOutput();
+
+		std::uint32_t GetSampleRate() const { return m_sampleRate; }
+		// 再生中 (Start 済みでバッファが残っている) のボイス数
+		int GetActiveVoiceNum();
+
+		// 使う命令を選ぶ (CPU が対応していなければ対応している中で最も上のものになる)
+		void SetSimdLevel(SimdLevel level);
+		SimdLevel GetSimdLevel() const { return m_simdLevel; }
+		// この CPU で使える最も上の命令
+		static SimdLevel GetSupportedSimdLevel();
+
+	private:
+		class Voice;
+		friend class Voice;
+
+		void OutputThreadMain(AudioSink* pSink, bool isRealTime);
+
+	private:
+		const std::uint32_t m_sampleRate;
+		SimdLevel m_simdLevel;
+
+		std::mutex m_mutex;					// m_voices とボイスの状態、Mix の実行
+		std::vector<Voice*> m_voices;
+		std::vector<float> m_scratch;		// 1ボイス分を出力のレートへ変換した波形
+
+		std::thread m_outputThread;
+		std::atomic<bool> m_isOutputStopping{ false };
+	};
+}
+
+#endif // !___SOFTWARE_MIXER_H___
@@ -1,7 +1,7 @@
 #ifndef __DIRECTX_H__
 #define __DIRECTX_H__
 
-#include <d3d11.h>
+#include <d3d11_1.h>
 
 #pragma comment(lib, "d3d11.lib")
 
@@ -32,6 +32,7 @@ enum SamplerState
 
 ID3D11Device* GetDevice();
 ID3D11DeviceContext* GetContext();
+ID3D11DeviceContext1* GetContext1();	// 萔obt@̕XVɖΉȂ nullptr
 IDXGISwapChain* GetSwapChain();
 RenderTarget* GetDefaultRTV();
 DepthStencil* GetDefaultDSV();
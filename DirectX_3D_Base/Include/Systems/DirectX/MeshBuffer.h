@@ -6,6 +6,16 @@
 class MeshBuffer
 {
 public:
+	static const UINT MAX_STREAM = 3;	// _Xg[ (pVtx Xbg0Astreams Xbg1ȍ~Ɏgp)
+
+	// ǉ̒_Xg[ (_ vtxCount ƓBCPU ɕ͎cȂ)
+	struct Stream
+	{
+		const void* pData;	// nullptr Ȃ疢gp (VF[_[0ǂݎ)
+		UINT size;			// 1_̃oCg
+		bool isShared;		// pData ̐擪1vfS_ŋL (XgCh0ŎQ)
+	};
+
 	struct Description
 	{
 		const void* pVtx;
@@ -16,23 +26,26 @@ public:
 		UINT idxSize;
 		UINT idxCount;
 		D3D11_PRIMITIVE_TOPOLOGY topology;
+		Stream streams[MAX_STREAM - 1];
 	};
 public:
 	MeshBuffer();
 	~MeshBuffer();
 
 	HRESULT Create(const Description& desc);
-	void Draw(int count = 0);
+	// startIndex : CfbNXobt@̕`Jnʒu (LOD Ȃ1̃obt@ɕ͈̔͂ꍇ)
+	void Draw(int count = 0, UINT startIndex = 0);
 	HRESULT Write(void* pVtx);
 
 	Description GetDesc();
 
 private:
-	HRESULT CreateVertexBuffer(const void* pIdx, UINT size, UINT count, bool isWrite);
+	HRESULT CreateVertexBuffer(const void* pIdx, UINT size, UINT count, bool isWrite, ID3D11Buffer** ppBuffer);
 	HRESULT CreateIndexBuffer(const void* pVtx, UINT size, UINT count);
 
 private:
 	ID3D11Buffer* m_pVtxBuffer;
+	ID3D11Buffer* m_pStreamBuffers[MAX_STREAM - 1];
 	ID3D11Buffer* m_pIdxBuffer;
 	Description m_desc;
 
@@ -29,6 +29,8 @@ public:
 
 	// 萔̏
 	void WriteBuffer(UINT slot, void* pData);
+	// 擪 size oCg (size 16̔{)
+	void WriteBuffer(UINT slot, const void* pData, UINT size);
 	// eNX`̐ݒ
 	void SetTexture(UINT slot, Texture* tex);
 	// VF[_[`Ɏgp
@@ -55,12 +57,16 @@ public:
 	VertexShader();
 	~VertexShader();
 	void Bind(void);
+	// ̓CAEg𖾎 (Load / Compile ̑Oɐݒ肷BݒȂVF[_[tNV쐬)
+	// pDesc  SemanticName ͓ǂݍ݂I܂ŗLȕł邱
+	void SetInputLayout(const D3D11_INPUT_ELEMENT_DESC* pDesc, UINT num);
 protected:
 	HRESULT MakeShader(void* pData, UINT size);
 
 private:
 	ID3D11VertexShader* m_pVS;
 	ID3D11InputLayout* m_pInputLayout;
+	std::vector<D3D11_INPUT_ELEMENT_DESC> m_inputDesc;	// ̓CAEg
 };
 //----------
 // sNZVF[_
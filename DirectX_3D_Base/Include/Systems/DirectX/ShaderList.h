@@ -50,6 +50,8 @@ public:
 	// 萔obt@ւ̐ݒ
 	static void SetWVP(DirectX::XMFLOAT4X4* wvp);
 	static void SetBones(DirectX::XMFLOAT4X4* bones200);
+	// gp count ݂̂]BOƓpbg (pBones  revision v) Ȃ]Ȃ
+	static void SetBones(const DirectX::XMFLOAT4X4* pBones, UINT count, std::uint64_t revision);
 	static void SetMaterial(const Model::Material& material);
 	static void SetLight(DirectX::XMFLOAT4 color, DirectX::XMFLOAT3 dir);
 	static void SetCameraPos(const DirectX::XMFLOAT3 pos);
@@ -70,6 +72,11 @@ private:
 private:
 	static VertexShader* m_pVS[VS_KIND_MAX];
 	static PixelShader* m_pPS[PS_KIND_MAX];
+
+	// Ōɓ]{[pbg
+	static const DirectX::XMFLOAT4X4* m_pLastBones;
+	static UINT m_lastBoneCount;
+	static std::uint64_t m_lastBoneRevision;
 	
 };
 
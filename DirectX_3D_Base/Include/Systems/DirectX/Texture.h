@@ -2,6 +2,9 @@
 #define __TEXTURE_H__
 
 #include "DirectX.h"
+#include <memory>
+
+namespace DirectX { class ScratchImage; }
 
 /// <summary>
 /// eNX`
@@ -12,10 +15,20 @@ public:
 	Texture();
 	virtual ~Texture();
 	HRESULT Create(const char* fileName);
+	// Create(fileName) 2iKɕ (񓯊ǂݍݗp)
+	// Decode : 摜t@CǂݍŃɓWJ (foCXgȂ߃[J[XbhĂяo)
+	//          TextureCooker ŕϊ .dds ꏊɂ΂ǂ
+	// Upload : WJ摜VF[_[\[X쐬AWJ摜j (CXbh)
+	HRESULT Decode(const char* fileName);
+	// ̃t@CeWJ (.dds ͒gŔ肷BfileName ͂ȊǑ`̔ƃOp)
+	HRESULT Decode(const void* pData, size_t size, const char* fileName);
+	HRESULT Upload();
 	HRESULT Create(DXGI_FORMAT format, UINT width, UINT height, const void* pData = nullptr);
 
 	UINT GetWidth() const;
 	UINT GetHeight() const;
+	// Upload ō쐬摜̃ (~bv}bv܂)
+	size_t GetMemorySize() const { return m_memorySize; }
 	ID3D11ShaderResourceView* GetResource() const;
 
 protected:
@@ -27,6 +40,8 @@ protected:
 	UINT m_height;	///< c
 	ID3D11ShaderResourceView *m_pSRV;
 	ID3D11Texture2D* m_pTex;
+	std::unique_ptr<DirectX::ScratchImage> m_pImage;	///< Decode œWJ摜 (Upload ܂ŕێ)
+	size_t m_memorySize;	///< Upload œ]摜̃oCg
 };
 
 /// <summary>
@@ -0,0 +1,74 @@
+﻿/*****************************************************************//**
+ * @file	MappedFile.h
+ * @brief	ファイル全体の読み取り専用メモリマップと、その範囲の参照
+ *
+ * @details	変換済みモデル (.mdl / .anm) とアセットアーカイブの読み込みで共有する。
+ *			FileView はマップした領域の一部をコピーせずに指すだけで、寿命は持ち主
+ *			(MappedFile / AssetArchive) に従う。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ModelCooked.cpp から MappedFile を移動し、FileView を追加。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	Windows / Linux の両方で使用するため、標準ライブラリ以外に依存しない
+ *********************************************************************/
+
+#ifndef ___MAPPED_FILE_H___
+#define ___MAPPED_FILE_H___
+
+// ===== インクルード =====
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct	FileView
+ * @brief	メモリ上のファイル内容 (の一部) への参照
+ */
+struct FileView
+{
+	const std::uint8_t* pData = nullptr;
+	std::size_t size = 0;
+
+	FileView() = default;
+	FileView(const std::uint8_t* data, std::size_t dataSize) : pData(data), size(dataSize) {}
+
+	explicit operator bool() const { return pData != nullptr; }
+};
+
+/**
+ * @class	MappedFile
+ * @brief	ファイル全体を読み取り専用でメモリへマップする
+ */
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	explicit MappedFile(const char* file) { Open(file); }
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// ファイルをマップする (空のファイル・存在しないファイルは失敗)
+	bool Open(const char* file);
+	void Close();
+
+	const std::uint8_t* GetData() const { return m_pData; }
+	std::size_t GetSize() const { return m_size; }
+	FileView GetView() const { return FileView(m_pData, m_size); }
+
+private:
+	const std::uint8_t* m_pData = nullptr;
+	std::size_t m_size = 0;
+#ifdef _WIN32
+	void* m_hMapping = nullptr;
+#endif
+};
+
+#endif // !___MAPPED_FILE_H___
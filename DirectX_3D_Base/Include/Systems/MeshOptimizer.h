@@ -0,0 +1,111 @@
+﻿/*****************************************************************//**
+ * @file	MeshOptimizer.h
+ * @brief	メッシュのインデックス・頂点の並び替え (頂点キャッシュ・オーバードロー・頂点フェッチ)
+ *
+ * @details	読み込み時 (ModelCooker による変換時を含む) に以下の順で適用する。
+ *			  1. 同じ内容の頂点を結合する (GenerateVertexRemap)
+ *			  2. 頂点キャッシュの再利用が増えるよう三角形を並べ替える (Forsyth 法)
+ *			  3. キャッシュ効率を保てる範囲で、外側を向いたまとまりを先に描くよう並べ替える
+ *			  4. 頂点を初めて参照される順に並べ替え、参照されない頂点を除く
+ *			Direct3D に依存しないため、統計 (ACMR / ATVR) は Linux 上でも計算できる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：頂点の結合・三角形/頂点の並び替え・キャッシュ統計を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	ACMR : 三角形あたりの頂点シェーダー実行数 (0.5 ～ 3.0、小さいほど良い)
+ *			ATVR : 頂点あたりの頂点シェーダー実行数 (1.0 が最小)
+ *********************************************************************/
+
+#ifndef ___MESH_OPTIMIZER_H___
+#define ___MESH_OPTIMIZER_H___
+
+// ===== インクルード =====
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MeshOptimizer
+{
+	const std::uint32_t REMAP_UNUSED = 0xFFFFFFFFu;	// 参照されない頂点 (並び替え後に除く)
+	const unsigned int	STATS_CACHE_SIZE = 16;		// 統計に使う FIFO キャッシュの大きさ
+
+	/// @brief 頂点キャッシュの統計
+	struct VertexCacheStats
+	{
+		size_t	transformed;	// 頂点シェーダーの実行数 (キャッシュミス数)
+		float	acmr;			// transformed / 三角形数
+		float	atvr;			// transformed / 頂点数
+	};
+
+	/**
+	 * [size_t - GenerateVertexRemap]
+	 * @brief	バイト単位で同じ内容の頂点を1つにまとめる対応表を作る
+	 *
+	 * @param	[out] pRemap 元の頂点番号 → 新しい頂点番号 (vertexCount 要素。参照されない頂点は REMAP_UNUSED)
+	 * @param	[in] pIndices インデックス
+	 * @param	[in] pVertices 頂点 (stride バイト間隔、詰め物を含まない型であること)
+	 * @return	結合後の頂点数
+	 */
+	size_t GenerateVertexRemap(std::uint32_t* pRemap, const std::uint32_t* pIndices, size_t indexCount,
+		const void* pVertices, size_t vertexCount, size_t stride);
+
+	/**
+	 * [void - OptimizeVertexCache]
+	 * @brief	頂点キャッシュの再利用が増えるよう三角形の順番を並べ替える (Forsyth 法)
+	 */
+	void OptimizeVertexCache(std::uint32_t* pIndices, size_t indexCount, size_t vertexCount);
+
+	/**
+	 * [void - OptimizeOverdraw]
+	 * @brief	キャッシュ効率を threshold 倍まで許して、外側を向いた三角形のまとまりを先に並べる
+	 *
+	 * @details	OptimizeVertexCache の後に呼び出す。キャッシュが一巡する位置でまとまりに区切り、
+	 *			中心からの向きと面の向きが揃っているまとまりほど先に描く (視点に依らない近似)。
+	 * @param	[in] pPositions 頂点座標 (float3、positionStride バイト間隔)
+	 * @param	[in] threshold 並び替え前に対して許容する ACMR の比率 (1.05 なら5%まで)
+	 */
+	void OptimizeOverdraw(std::uint32_t* pIndices, size_t indexCount, const float* pPositions,
+		size_t vertexCount, size_t positionStride, float threshold);
+
+	/**
+	 * [size_t - GenerateFetchRemap]
+	 * @brief	インデックスで初めて参照される順に頂点を並べる対応表を作る
+	 *
+	 * @param	[out] pRemap 元の頂点番号 → 新しい頂点番号 (参照されない頂点は REMAP_UNUSED)
+	 * @return	参照される頂点数
+	 */
+	size_t GenerateFetchRemap(std::uint32_t* pRemap, const std::uint32_t* pIndices, size_t indexCount, size_t vertexCount);
+
+	/// @brief インデックスを対応表で書き換える
+	void RemapIndices(std::uint32_t* pIndices, size_t indexCount, const std::uint32_t* pRemap);
+
+	/// @brief 頂点を対応表に従って並べ替える (REMAP_UNUSED の頂点は除く)
+	template<class Vertex>
+	void RemapVertices(std::vector<Vertex>* pVertices, const std::uint32_t* pRemap, size_t newCount)
+	{
+		std::vector<Vertex> result(newCount);
+		for (size_t i = 0; i < pVertices->size(); ++i)
+		{
+			if (pRemap[i] != REMAP_UNUSED) result[pRemap[i]] = (*pVertices)[i];
+		}
+		pVertices->swap(result);
+	}
+
+	/**
+	 * [VertexCacheStats - AnalyzeVertexCache]
+	 * @brief	FIFO キャッシュを再現して頂点シェーダーの実行数を数える
+	 *
+	 * @param	[in] cacheSize キャッシュに残る頂点数
+	 */
+	VertexCacheStats AnalyzeVertexCache(const std::uint32_t* pIndices, size_t indexCount, size_t vertexCount,
+		unsigned int cacheSize = STATS_CACHE_SIZE);
+}
+
+#endif // !___MESH_OPTIMIZER_H___
@@ -0,0 +1,67 @@
+﻿/*****************************************************************//**
+ * @file	MeshSimplifier.h
+ * @brief	二次誤差 (QEM) による辺の縮約でメッシュを簡略化する
+ *
+ * @details	頂点を既存の頂点へ寄せるだけで新しい頂点は作らないため、簡略化したメッシュは
+ *			元の頂点バッファを共有し、インデックスだけを持てばよい (LOD 用)。
+ *			以下の頂点は形やテクスチャが崩れないよう動かし方を制限する。
+ *			  UV・法線の継ぎ目 (同じ位置に別の頂点がある) : 動かさない
+ *			  穴の縁 : 縁に沿ってのみ寄せる
+ *			スキンウェイトが大きく異なる頂点同士の縮約には誤差を上乗せする。
+ *			Direct3D に依存しないため、三角形数・誤差は Linux 上でも確認できる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：辺の縮約による簡略化を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	誤差はメッシュの大きさ (バウンディングボックスの最大辺) に対する比率で指定する
+ *********************************************************************/
+
+#ifndef ___MESH_SIMPLIFIER_H___
+#define ___MESH_SIMPLIFIER_H___
+
+// ===== インクルード =====
+#include <cstddef>
+#include <cstdint>
+
+namespace MeshSimplifier
+{
+	/// @brief 簡略化する頂点の情報 (各配列は stride バイト間隔で参照する)
+	struct VertexData
+	{
+		const float*		pPositions;		// float3
+		const float*		pWeights;		// float x 4 (nullptr ならスキンなし)
+		const unsigned int*	pBoneIndices;	// uint x 4
+		size_t				stride;
+		size_t				vertexCount;
+	};
+
+	/// @brief 簡略化の結果
+	struct Result
+	{
+		size_t	indexCount;		// 簡略化後のインデックス数
+		float	error;			// 縮約した頂点の最大誤差 (メッシュの大きさに対する比率)
+		float	extent;			// メッシュの大きさ (error * extent でモデル空間の距離になる)
+	};
+
+	/**
+	 * [Result - Simplify]
+	 * @brief	三角形数が目標以下になるか、誤差が上限に達するまで辺を縮約する
+	 *
+	 * @param	[out] pDestination 簡略化後のインデックス (indexCount 要素を確保しておくこと)
+	 * @param	[in] pIndices 元のインデックス
+	 * @param	[in] vertices 頂点
+	 * @param	[in] targetIndexCount 目標のインデックス数
+	 * @param	[in] targetError 許容する誤差 (メッシュの大きさに対する比率)
+	 */
+	Result Simplify(std::uint32_t* pDestination, const std::uint32_t* pIndices, size_t indexCount,
+		const VertexData& vertices, size_t targetIndexCount, float targetError);
+}
+
+#endif // !___MESH_SIMPLIFIER_H___
@@ -7,12 +7,32 @@
 
 #include <DirectXMath.h>
 #include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#ifndef MODEL_COOKER
 #include "Systems/DirectX/Shader.h"
 #include "Systems/DirectX/MeshBuffer.h"
+#else
+// ϊc[ (Tools/ModelCooker) ł Direct3D gpȂ߁AGPU \[X͐錾̂
+class VertexShader;
+class PixelShader;
+class MeshBuffer;
+class Texture;
+using UINT = unsigned int;
+#endif
+#include "Systems/ModelCookedFormat.h"
+#include "Systems/MappedFile.h"
 #include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
 class Model
 {
+	friend class ModelInstance;	// Lf[^ǂݎĎpvZ
+
 public:
 	// f]ݒ
 	enum Flip
@@ -23,17 +43,6 @@ public:
 		ZFlipUseAnime,	// DirecX(Aj[Vꍇ
 	};
 
-private:
-	// Aj[VvZ̈
-	enum AnimeTransform
-	{
-		MAIN,			// ʏĐ
-		BLEND,			// uhĐ
-		PARAMETRIC0,	// A
-		PARAMETRIC1,	// B
-		MAX_TRANSFORM
-	};
-
 public:
 	// ^`
 	using NodeIndex = int;	// {[(Kw)ԍ
@@ -44,40 +53,14 @@ public:
 	static const AnimeNo	ANIME_NONE = -1;		// YAj[VȂ
 	static const AnimeNo	PARAMETRIC_ANIME = -2;	// Aj[V
 
-	// ECSpFAj[VĐԍ\
-	// Modelk鈟BjԂƂĎĂϐɈړ
-	struct AnimationState
-	{
-		AnimeNo		playNo = ANIME_NONE;			// ݍĐ̃Ajԍ
-		AnimeNo		blendNo = ANIME_NONE;			// uhĐsAjԍ
-		AnimeNo		parametric[2] = { ANIME_NONE, ANIME_NONE };	// ĐsAjԍ
-
-		float		blendTime = 0.0f;				// ݂̑Jڌoߎ
-		float		blendTotalTime = 0.0f;			// AjJڂɂ鍇v
-		float		parametricBlend = 0.0f;			// pgbN̍Đ
-
-		// Aj[VƂ̍ĐԁExE[vݒ
-		// ModelŋLAnimationf[^ł͂ȂACX^XƂ̏
-		struct Info {
-			float nowTime = 0.0f;
-			float speed = 1.0f;
-			bool  isLoop = false;
-		};
-		// őœɊǗAj[ViCAuhApgbN0/1Ȃǁj
-		// ł͊ȈՓIɁAAj[VԍL[ɂ}bvA
-		// s̃XbgƂĊǗB
-		// Ƃ̌݊̂߁AplayNopAblendNopAparametricp̏Ԃێ
-		Info infoMain;
-		Info infoBlend;
-		Info infoParametric[2];
-	};
-
 private:
 	// ^`
 	using Children = std::vector<NodeIndex>;	// m[hKw
 
 	// 萔`
-	static const UINT		MAX_BONE = 200;	// PbV̍ő{[(ύXꍇ.hlsl̒`ύX
+	static const UINT		MAX_BONE = 200;	// Ppbg̍ő{[(ύXꍇ.hlsl̒`ύX
+	static_assert(MAX_BONE <= 256, "_̃{[ԍ uint8 ɋl߂邽256ȉɂ邱");
+	static const int		MAX_LOD = 3;	// LOD0 ȗ̍ői
 
 	// Aj[V̕ϊ
 	struct Transform
@@ -86,15 +69,47 @@ private:
 		DirectX::XMFLOAT4	quaternion;
 		DirectX::XMFLOAT3	scale;
 	};
-	using Key = std::pair<float, Transform>;
-	using Timeline = std::map<float, Transform>;
 	using Transforms = std::vector<Transform>;
 
-	// Aj[Vƃ{[̊֘At
+	// 16bit x 3 ɗʎqL[l
+	struct PackedKey
+	{
+		std::uint16_t	v[3];
+	};
+
+	// L[ (ǂݍݎɈkAʎqL[Azŕێ)
+	// ʒuEgk͔͈͂16bitɗʎqA]͍ő听Ȃ315bit (smallest-three, 48bit) ŕێ
+	struct KeyTrack
+	{
+		std::vector<std::uint16_t>	frames;		// cL[̃t[ԍ (ȂSt[ɃL[)
+		std::vector<PackedKey>		values;		// ʎqL[l
+		float				startTime = 0.0f;	// 擪L[̎
+		float				keyRate = 0.0f;		// 1b̃t[
+		DirectX::XMFLOAT3	rangeMin = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);		// ʎq͈͂̍ŏl (ʒuEgk̂)
+		DirectX::XMFLOAT3	rangeExtent = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);	// ʎq͈͂̕ (ʒuEgk̂)
+	};
+
+	// m[h1̃L[ (Ώۃm[h̓f AnimeBinding Ŋ֘At)
 	struct Channel
 	{
-		NodeIndex	index;
-		Timeline	timeline;
+		KeyTrack		translate;	// ʒu
+		KeyTrack		rotation;	// ]
+		KeyTrack		scale;		// gk
+		bool			sharedTiming;	// L[vf̃L[Sē (Ԃ̌1ōς܂)
+	};
+
+	// ǂݍݒ̔񈳏kL[ (kO̍Ɨp)
+	struct RawTrack
+	{
+		std::vector<float>				times;
+		std::vector<DirectX::XMFLOAT4>	values;	// ʒuEgk xyz ̂ݎgp
+	};
+
+	// L[ (key  key + 1 ̊Ԃ rate ŕԂ)
+	struct KeySpan
+	{
+		std::uint32_t	key;
+		float			rate;
 	};
 	using Channels = std::vector<Channel>;
 
@@ -121,16 +136,26 @@ public:
 		unsigned int		index[4];
 	};
 	using Vertices = std::vector<Vertex>;
-	using Indices = std::vector<unsigned long>;
+	using Indices = std::vector<std::uint32_t>;
 
 	// _̍ό`
 	struct Bone
 	{
 		NodeIndex index;
 		DirectX::XMMATRIX invOffset;
+		bool isSkin;	// XLjOp̃ItZbgs (false Ȃm[hɒڕtbV)
 	};
 	using Bones = std::vector<Bone>;
 
+	// ȗbV (_ LOD0 ƋLACfbNX)
+	struct MeshLod
+	{
+		Indices			indices;
+		float			error;		// LOD0 ̌덷 (fԂ̋)
+		unsigned int	indexStart;	// CfbNXobt@̊Jnʒu (CreateResources Őݒ)
+	};
+	using MeshLods = std::vector<MeshLod>;
+
 	// bV
 	struct Mesh
 	{
@@ -138,10 +163,20 @@ public:
 		Indices			indices;
 		unsigned int	materialID;
 		Bones			bones;
+		unsigned int	paletteNo;	// gp{[pbgԍ (_̃{[ԍ̓pbg̈ʒu)
+		MeshLods		lods;		// LOD1 ȍ~ (ȗłȂbV͋)
 		MeshBuffer* pMesh;
 	};
 	using Meshes = std::vector<Mesh>;
 
+	// {[pbg (XPggbVԂŋLXLjOs͈̔)
+	struct Palette
+	{
+		unsigned int	offset;	// pbgz̐擪ʒu
+		unsigned int	count;	// s
+	};
+	using Palettes = std::vector<Palette>;
+
 	// }eA
 	struct Material
 	{
@@ -152,16 +187,26 @@ public:
 	};
 	using Materials = std::vector<Material>;
 
-	// Aj[V
+	// Aj[V (ĐʒuExȂǂ̍ĐԂ ModelInstance )
 	struct Animation
 	{
-		float		nowTime;	// ݂̍Đ
 		float		totalTime;	// őĐ
-		float		speed;		// Đx
-		bool		isLoop;		// [vw
+		float		sampleRate;	// ǂݍݎɍăTvO[g (0ȂI[TÕL[)
+		size_t		rawBytes;	// kÕL[f[^
+		size_t		packedBytes;	// k̃L[f[^
+		float		maxError[3];	// kɂő덷 (ʒuE][rad]Egk)
 		Channels	channels;	// ϊ
+		std::vector<std::string>	channelNames;	// `l̑Ώۃm[h
 	};
-	using Animations = std::vector<Animation>;
+	using AnimationPtr = std::shared_ptr<const Animation>;
+
+	// fɊ֘AtNbv (Nbv{͓̂ ID ǂݍ񂾑SfŋL)
+	struct AnimeBinding
+	{
+		AnimationPtr			pClip;
+		std::vector<NodeIndex>	channelNodes;	// `l̑Ώۃm[h (YȂ INDEX_NONE)
+	};
+	using AnimeBindings = std::vector<AnimeBinding>;
 
 public:
 	Model();
@@ -169,8 +214,38 @@ public:
 	void Reset();
 	void SetVertexShader(VertexShader* vs);
 	void SetPixelShader(PixelShader* ps);
+	// fp̒_VF[_[ɃpbNςݒ_ (VertexPacking.h) ̓̓CAEgݒ肷 (Compile / Load ̑OɌĂяo)
+	static void SetInputLayout(VertexShader* vs);
 	bool Load(const char* file, float scale = 1.0f, Flip flip = Flip::None);
-	void Draw(int meshNo = -1);
+	// Load 2iKɕ (񓯊ǂݍݗpBLoadData ̌ CreateDeviceResources Ă)
+	// LoadData ̓foCXgȂ߃[J[XbhĂяo (t@Cǂݍ݁EϊEeNX`̓WJ)
+	// CreateDeviceResources ̓bVobt@EeNX`쐬邽߃CXbhŌĂяo
+	bool LoadData(const char* file, float scale = 1.0f, Flip flip = Flip::None);
+	bool CreateDeviceResources();
+	// pNodeMatrices w肷Ƃ̎pŁAwȂoCh|[Yŕ`悷
+	// lod  SelectLod őI񂾏ڍדx (̃bVɖ΍łe LOD `)
+	void Draw(int meshNo = -1, const DirectX::XMMATRIX* pNodeMatrices = nullptr, int lod = 0);
+	// BuildPalette ŌvZς݂̃pbgŕ`悷
+	// (revision Oɓ]̂Ɠpbg͓]ȗ)
+	void Draw(int meshNo, const DirectX::XMFLOAT4X4* pPalette, std::uint64_t revision, int lod = 0);
+
+	//--- ڍדx (LOD)
+	// LOD ̒i (LOD0 ܂)
+	int GetLodNum() const;
+	// ʏ̑傫 (E̔a / ʂ̍̔)  LOD I
+	// (currentLod ͑OI LODBEt߂Ő؂ւJԂȂ悤)
+	int SelectLod(float screenSize, int currentLod) const;
+	// oCh|[Y̋E (ǂݍݎ̃XP[E]Kpς)
+	const DirectX::XMFLOAT3& GetBoundsCenter() const { return m_boundsCenter; }
+	float GetBoundsRadius() const { return m_boundsRadius; }
+
+	//--- XLjOs
+	// Spbg̍s
+	uint32_t GetPaletteSize() const { return static_cast<uint32_t>(m_paletteBones.size()); }
+	// m[hs񂩂XLjOs (]uς) vZ (pNodeMatrices  nullptr ȂoCh|[Y)
+	void BuildPalette(const DirectX::XMMATRIX* pNodeMatrices, DirectX::XMFLOAT4X4* pOut) const;
+	// pbgۂɕtʔԍ (0͎gpȂ)
+	static std::uint64_t IssuePaletteRevision() { return ++m_paletteRevision; }
 
 	//--- e擾
 	const Mesh* GetMesh(unsigned int index);
@@ -179,87 +254,215 @@ public:
 	uint32_t GetMaterialNum();
 	DirectX::XMMATRIX GetBone(NodeIndex index);
 	const Animation* GetAnimation(AnimeNo no);
+	uint32_t GetAnimationNum() const { return static_cast<uint32_t>(m_animes.size()); }
+	uint32_t GetNodeNum() const { return static_cast<uint32_t>(m_nodes.size()); }
+	float GetLoadScale() const { return m_loadScale; }
+	// GPU ̃ (_ECfbNXobt@ƃeNX`̍vBAssetManager ̗\ZvZp)
+	size_t GetMemorySize() const;
+
+	//--- ϊς݃oCi (Tools/ModelCooker ō쐬 .mdl / .anm)
+	// Load / AddAnimation ͌t@CƓꏊɐVϊς݃oCiΎŎgp
+	// assimp œǂݍ (XP[E]̓Kp GPU \[X̍쐬͍sȂ)
+	// (packed nƃt@CJɃ̓eǂݍ)
+	bool Import(const char* file, const FileView& packed = FileView());
+	AnimeNo ImportAnimation(const char* file, const FileView& packed = FileView());
+	// ϊς݃oCiǂݍ (sourceFile ϊɍXVĂΓǂݍ܂Ȃ)
+	bool LoadCooked(const char* file, const char* sourceFile);
+	AnimeNo LoadCookedAnimation(const char* file, const char* sourceFile);
+	// ̕ϊς݃oCiǂݍ (sourceFile  nullptr ȂXV̊mFȂ)
+	bool LoadCooked(const FileView& data, const char* file, const char* sourceFile);
+	AnimeNo LoadCookedAnimation(const FileView& data, const char* file, const char* sourceFile);
+	// ϊς݃oCio (Import / ImportAnimation ̏Ԃۑ)
+	bool SaveCooked(const char* file, const ModelCooked::SourceStamp& source) const;
+	bool SaveCookedAnimation(const char* file, AnimeNo no, const ModelCooked::SourceStamp& source) const;
 
 	//--- Aj[V
-	// Aj[V̓ǂݍ
+	// Aj[V̓ǂݍ (ǂݍ񂾃Nbv͑SCX^XŋL)
+	// ̃f ID (ID ȂȂpX) ǂݍݍς݂ȂAt@Cǂ܂ɂ̃Nbv֘At
+	// (̏ꍇ̍ăTvOEk̐ݒ͍ŏɓǂݍ񂾎̂)
 	AnimeNo AddAnimation(const std::string& assetID);
 	AnimeNo AddAnimation(const char* file, const std::string& aliasID = "");
-	// Aj[V̍XV
-	void Step(float tick);
-
-	// Aj[V̍Đ
-	void Play(AnimeNo no, bool loop, float speed = 1.0f);
-	void Play(const std::string& assetID, bool loop, float speed = 1.0f);
-	// Aj[ṼuhĐ
-	void PlayBlend(AnimeNo no, float blendTime, bool loop, float speed = 1.0f);
-	void PlayBlend(const std::string& animeID, float blendTime, bool loop = true, float speed = 1.0f);
-	// Aj[V̍ݒ
-	void SetParametric(AnimeNo no1, AnimeNo no2);
-	// Aj[V̍ݒ
-	void SetParametricBlend(float blendRate);
-	// Aj[V̌ݍĐԂύX
-	void SetAnimationTime(AnimeNo no, float time);
-
-	// ĐtO
-	bool IsPlay(AnimeNo no);
-	// ݍĐ̃Ajԍ
-	AnimeNo GetPlayNo();
-	// uh̃Ajԍ
-	AnimeNo GetBlendNo();
+	// ǂݍݍς݂̃Nbṽf̃m[h֖OŊ֘At (ʃXPg̃Nbv)
+	AnimeNo BindAnimation(const AnimationPtr& pClip);
+	// ID Aj[Vԍ (o^Ȃ ANIME_NONE)
+	AnimeNo FindAnimation(const std::string& assetID) const;
+	// ȍ~ɓǂݍރAj[VŒ背[gōăTvO (0ŃI[TÕL[Ԋu)
+	static void SetAnimationSampleRate(float rate) { m_animeSampleRate = rate; }
+	// ȍ~ɓǂݍރAj[V̈ke덷 (0ŃL[̍폜s킸ʎq̂)
+	static void SetAnimationTolerance(float translate, float rotateRad, float scale)
+	{
+		m_animeTolerance[0] = translate;
+		m_animeTolerance[1] = rotateRad;
+		m_animeTolerance[2] = scale;
+	}
+
+	// ĐEpvZ ModelInstance ōs
+	// (Model ̓bVEXPgENbvێǂݎp̋Lf[^)
 
 #ifdef _DEBUG
 	static std::string GetError();
 	void DrawBone();
 #endif
 
-	bool GetAnimatedTransform(DirectX::XMFLOAT3& outPos, DirectX::XMFLOAT3& outRot, DirectX::XMFLOAT3& outScale);
-
 private:
 	// e퐶
-	void MakeMesh(const void* ptr, float scale, Flip flip);
-	void MakeMaterial(const void* ptr, std::string directory);
+	void MakeMesh(const void* ptr);
+	void MakeMaterial(const void* ptr);
 	void MakeBoneNodes(const void* ptr);
 	void MakeWeight(const void* ptr, int meshIdx);
-
-	// vZ
-	bool AnimeNoCheck(AnimeNo no);
-	void InitAnime(AnimeNo no);
-	void CalcAnime(AnimeTransform kind, AnimeNo no);
-	void UpdateAnime(AnimeNo no, float tick);
-	void CalcBones(NodeIndex node, const DirectX::XMMATRIX parent);
-	void LerpTransform(Transform* pOut, const Transform& a, const Transform& b, float rate);
-
+	void AssignPalette(int meshIdx);
+	// _̌ƁA_LbVEI[o[h[E_tFb`lёւ
+	void OptimizeMeshes(const char* file);
+	// ȗ LOD ̍쐬
+	void GenerateLods(const char* file);
+	// oCh|[Y̋E߂
+	void ComputeBounds();
+	// m[hԍւ̑Ή\ (Nbv̊֘AtpÂ)
+	void BuildNodeNameMap();
+	// m[hԍ (Sv "mixamorig:" Ȃǂ̐ړOŒT)
+	NodeIndex FindNodeByName(const std::string& name) const;
+	// ǂݍݎ̃XP[E]Kp
+	void ApplyLoadTransform();
+	// eNX`t@CWJ (GPU ւ̓] CreateResources ōs)
+	void DecodeTextures(const std::string& directory);
+	// bVobt@EeNX`쐬 (߂l͒_ECfbNXobt@̍voCg)
+	size_t CreateResources();
+
+	// L[̃TvO
+	// cursor ɂ͑ŐԈʒuێĂAĐ͐֐i߂邾ŋԂ܂
+	static KeySpan FindSpan(const KeyTrack& track, float time, std::uint32_t& cursor);
+	static DirectX::XMVECTOR SampleVector(const KeyTrack& track, const KeySpan& span);
+	static DirectX::XMVECTOR SampleQuaternion(const KeyTrack& track, const KeySpan& span);
+	static DirectX::XMVECTOR DecodeVector(const KeyTrack& track, std::uint32_t key);
+	static DirectX::XMVECTOR DecodeQuaternion(const PackedKey& key);
+
+	// ǂݍ񂾃L[𓙊Ԋũt[֑A璷ȃL[̍폜Ɨʎqs
+	static void CompressTrack(const RawTrack& raw, bool isRotation, float tolerance, KeyTrack* pOut);
+	// k̃L[̃L[ŃTvOAő덷߂ (]̓WA)
+	static float MeasureError(const RawTrack& raw, const KeyTrack& track, bool isRotation);
+	static bool IsSameTiming(const KeyTrack& a, const KeyTrack& b);
+	static float QuaternionAngle(DirectX::FXMVECTOR a, DirectX::FXMVECTOR b);
 
 private:
 	static VertexShader* m_pDefVS;		// ftHg_VF[_[
 	static PixelShader* m_pDefPS;		// ftHgsNZVF[_[
 	static unsigned int		m_shaderRef;	// VF[_[QƐ
+	static float			m_animeSampleRate;	// Aj[Vǂݍݎ̍ăTvO[g
+	static float			m_animeTolerance[3];	// Aj[Vk̋e덷 (ʒuE][rad]Egk)
+	static std::uint64_t	m_paletteRevision;	// Ōɔspbg̎ʔԍ
+	// ǂݍݍς݃Nbv (ID Bgp̃fȂΉ)
+	static std::unordered_map<std::string, std::weak_ptr<const Animation>>	m_clipCache;
 #ifdef _DEBUG
-	static std::string m_errorStr;
+	static thread_local std::string m_errorStr;	// [J[Xbhł̓ǂݍ݂ƍȂ悤XbhɎ
 #endif
 
 private:
 	float			m_loadScale;	// 
 	Flip			m_loadFlip;		// 
+	std::string		m_loadFile;		// LoadData œǂݍ񂾃t@C (Op)
+	bool			m_isCooked;		// ϊς݃oCiǂݍ񂾂
+	float			m_loadDataMs;	// LoadData ɂ
+	size_t			m_bufferBytes;	// _ECfbNXobt@̍voCg
 
 	Meshes			m_meshes;		// bVz
 	Materials		m_materials;	// }eAz
+	std::vector<std::string>	m_texturePaths;	// }eÃeNX`pX (ȂeNX`Ȃ)
+	Palettes		m_palettes;		// {[pbg
+	Bones			m_paletteBones;	// pbgɕԃ{[ (SpbgAŕێ)
+	std::vector<DirectX::XMFLOAT4X4>	m_bindPalette;	// oCh|[Ỹpbg
+	std::uint64_t	m_bindPaletteRevision;
+	DirectX::XMFLOAT3	m_boundsCenter;	// oCh|[Y̋E
+	float			m_boundsRadius;
 	Nodes			m_nodes;		// Kw
-	Animations		m_animes;		// Ajz
+	std::vector<NodeIndex>	m_nodeParents;	// m[h̐eԍ (e͕KqOɕ)
+	AnimeBindings	m_animes;		// Ajz
+	std::unordered_map<std::string, NodeIndex>	m_nodeNameMap;	// m[h  ԍ (ړO܂)
 	VertexShader* m_pVS;			// ݒ蒆̒_VF[_
 	PixelShader* m_pPS;			// ݒ蒆̃sNZVF[_
 
-	AnimeNo			m_playNo;			// ݍĐ̃Ajԍ
-	AnimeNo			m_blendNo;			// uhĐsAjԍ
-	AnimeNo			m_parametric[2];	// ĐsAjԍ
-	float			m_blendTime;		// ݂̑Jڌoߎ
-	float			m_blendTotalTime;	// AjJڂɂ鍇v
-	float			m_parametricBlend;	// pgbN̍Đ
-
-	Transforms		m_nodeTransform[MAX_TRANSFORM];	// Aj[Vʕό`
-
 	std::map<std::string, AnimeNo> m_animeIdMap;
 };
 
 
+inline Model::KeySpan Model::FindSpan(const KeyTrack& track, float time, std::uint32_t& cursor)
+{
+	const std::uint32_t keyNum = static_cast<std::uint32_t>(track.values.size());
+	KeySpan span = { 0, 0.0f };
+	if (keyNum <= 1) { return span; }
+
+	// 擪L[OAŏIL[Ȃ[̒lgp
+	const float pos = (time - track.startTime) * track.keyRate;
+	const std::vector<std::uint16_t>& frames = track.frames;
+	const float lastFrame = frames.empty() ? static_cast<float>(keyNum - 1) : static_cast<float>(frames[keyNum - 1]);
+	if (pos <= 0.0f) { cursor = 0; return span; }
+	if (pos >= lastFrame) { span.key = keyNum - 2; span.rate = 1.0f; return span; }
+
+	if (frames.empty())
+	{
+		// St[ɃL[Ύ璼ڋԂ߂
+		span.key = static_cast<std::uint32_t>(pos);
+		span.rate = pos - static_cast<float>(span.key);
+		return span;
+	}
+
+	std::uint32_t key = cursor;
+	if (key >= keyNum - 1 || pos < frames[key])
+	{
+		// ߂ ([vEĐ) ̂ݓ񕪒TŒT
+		key = static_cast<std::uint32_t>(std::upper_bound(frames.begin(), frames.end(), pos,
+			[](float p, std::uint16_t f) { return p < static_cast<float>(f); }) - frames.begin()) - 1;
+	}
+	else
+	{
+		while (frames[key + 1] <= pos) { ++key; }
+	}
+	cursor = key;
+	span.key = key;
+	span.rate = (pos - frames[key]) / static_cast<float>(frames[key + 1] - frames[key]);
+	return span;
+}
+
+inline DirectX::XMVECTOR Model::DecodeVector(const KeyTrack& track, std::uint32_t key)
+{
+	const PackedKey& packed = track.values[key];
+	DirectX::XMVECTOR q = DirectX::XMVectorSet(packed.v[0], packed.v[1], packed.v[2], 0.0f);
+	DirectX::XMVECTOR extent = DirectX::XMVectorScale(DirectX::XMLoadFloat3(&track.rangeExtent), 1.0f / 65535.0f);
+	return DirectX::XMVectorMultiplyAdd(q, extent, DirectX::XMLoadFloat3(&track.rangeMin));
+}
+
+inline DirectX::XMVECTOR Model::DecodeQuaternion(const PackedKey& key)
+{
+	// 2bit: Ȃő听̔ԍAc 15bit x 3: ̐ [-1/2, 1/2] ŗʎq
+	const std::uint64_t bits = (static_cast<std::uint64_t>(key.v[0]) << 32) | (static_cast<std::uint64_t>(key.v[1]) << 16) | key.v[2];
+	const int largest = static_cast<int>((bits >> 45) & 3);
+	const float kScale = 1.41421356f / 32767.0f;
+	const float a = static_cast<float>((bits >> 30) & 0x7fff) * kScale - 0.70710678f;
+	const float b = static_cast<float>((bits >> 15) & 0x7fff) * kScale - 0.70710678f;
+	const float c = static_cast<float>(bits & 0x7fff) * kScale - 0.70710678f;
+	const float d = std::sqrt(std::max(0.0f, 1.0f - a * a - b * b - c * c));
+	switch (largest)
+	{
+	case 0: return DirectX::XMVectorSet(d, a, b, c);
+	case 1: return DirectX::XMVectorSet(a, d, b, c);
+	case 2: return DirectX::XMVectorSet(a, b, d, c);
+	default: return DirectX::XMVectorSet(a, b, c, d);
+	}
+}
+
+inline DirectX::XMVECTOR Model::SampleVector(const KeyTrack& track, const KeySpan& span)
+{
+	if (track.values.size() == 1) { return DecodeVector(track, 0); }
+	return DirectX::XMVectorLerp(DecodeVector(track, span.key), DecodeVector(track, span.key + 1), span.rate);
+}
+
+inline DirectX::XMVECTOR Model::SampleQuaternion(const KeyTrack& track, const KeySpan& span)
+{
+	if (track.values.size() == 1) { return DecodeQuaternion(track.values[0]); }
+	DirectX::XMVECTOR q0 = DecodeQuaternion(track.values[span.key]);
+	DirectX::XMVECTOR q1 = DecodeQuaternion(track.values[span.key + 1]);
+	// ʎqŕĂȂ߁A߂֕Ԃ
+	if (DirectX::XMVectorGetX(DirectX::XMVector4Dot(q0, q1)) < 0.0f) { q1 = DirectX::XMVectorNegate(q1); }
+	return DirectX::XMQuaternionNormalize(DirectX::XMVectorLerp(q0, q1, span.rate));
+}
+
 #endif // __MODEL_H__
\ No newline at end of file
@@ -0,0 +1,197 @@
+﻿/*****************************************************************//**
+ * @file	ModelCookedFormat.h
+ * @brief	変換済みモデル・アニメーション (ModelCooker の出力) のバイナリ形式
+ *
+ * @details	ファイル全体をメモリへマップし、各セクションの配列をそのまま参照できるよう
+ *			固定長のレコードだけで構成する。文字列は STRINGS セクションにまとめ、
+ *			レコードからはその先頭位置で参照する。
+ *			Windows / Linux の両方で読み書きするため、標準ライブラリ以外に依存しない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：.mdl / .anm の形式を定義。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	レコードの構成を変更した場合は VERSION を上げること (古いファイルは FBX から読み直す)
+ *********************************************************************/
+
+#ifndef ___MODEL_COOKED_FORMAT_H___
+#define ___MODEL_COOKED_FORMAT_H___
+
+// ===== インクルード =====
+#include <cstdint>
+#include <string>
+
+namespace ModelCooked
+{
+	const std::uint32_t MODEL_MAGIC = 0x434C444Du;	// "MDLC"
+	const std::uint32_t ANIME_MAGIC = 0x434D4E41u;	// "ANMC"
+	const std::uint32_t VERSION = 3;	// 2 : メッシュを最適化 (MeshOptimizer) した状態で保存 / 3 : LOD を追加
+	const std::uint32_t NO_STRING = 0xFFFFFFFFu;	// 文字列なし
+
+	/**
+	 * @struct	SourceStamp
+	 * @brief	変換元ファイルのサイズと更新日時 (変換後に元ファイルが更新されていないかの確認用)
+	 */
+	struct SourceStamp
+	{
+		std::uint64_t	size;
+		std::int64_t	time;
+	};
+
+	/// @brief セクションの位置 (ファイル先頭からのバイト数と要素数)
+	struct Section
+	{
+		std::uint32_t	offset;
+		std::uint32_t	count;
+	};
+
+	//--- モデル (.mdl)
+	enum ModelSection
+	{
+		MODEL_NODES,			// NodeRecord
+		MODEL_MESHES,			// MeshRecord
+		MODEL_BONES,			// BoneRecord (メッシュ毎のボーン)
+		MODEL_PALETTES,			// PaletteRecord
+		MODEL_PALETTE_BONES,	// BoneRecord (パレットに並ぶボーン)
+		MODEL_MATERIALS,		// MaterialRecord
+		MODEL_VERTICES,			// VertexRecord
+		MODEL_INDICES,			// uint32_t (LOD0 と各 LOD のインデックス)
+		MODEL_LODS,				// LodRecord
+		MODEL_STRINGS,			// char (終端付き文字列の連結)
+		MODEL_SECTION_MAX
+	};
+
+	struct ModelHeader
+	{
+		std::uint32_t	magic;
+		std::uint32_t	version;
+		SourceStamp		source;
+		Section			sections[MODEL_SECTION_MAX];
+	};
+
+	struct NodeRecord
+	{
+		std::uint32_t	name;		// STRINGS 上の位置
+		std::int32_t	parent;		// 親ノード番号 (親は必ず子より前に並ぶ)
+		float			mat[16];
+	};
+
+	struct MeshRecord
+	{
+		std::uint32_t	vertexOffset;
+		std::uint32_t	vertexCount;
+		std::uint32_t	indexOffset;
+		std::uint32_t	indexCount;
+		std::uint32_t	boneOffset;
+		std::uint32_t	boneCount;
+		std::uint32_t	materialID;
+		std::uint32_t	paletteNo;
+		std::uint32_t	lodOffset;		// LODS 上の位置
+		std::uint32_t	lodCount;
+	};
+
+	struct LodRecord
+	{
+		std::uint32_t	indexOffset;	// INDICES 上の位置
+		std::uint32_t	indexCount;
+		float			error;
+	};
+
+	struct BoneRecord
+	{
+		std::int32_t	index;
+		std::uint32_t	isSkin;
+		float			invOffset[16];
+	};
+
+	struct PaletteRecord
+	{
+		std::uint32_t	offset;
+		std::uint32_t	count;
+	};
+
+	struct MaterialRecord
+	{
+		float			diffuse[4];
+		float			ambient[4];
+		float			specular[4];
+		std::uint32_t	texturePath;	// STRINGS 上の位置 (テクスチャが無ければ NO_STRING)
+	};
+
+	struct VertexRecord
+	{
+		float			pos[3];
+		float			normal[3];
+		float			uv[2];
+		float			color[4];
+		float			weight[4];
+		std::uint32_t	index[4];
+	};
+
+	//--- アニメーション (.anm)
+	enum AnimeSection
+	{
+		ANIME_CHANNELS,		// ChannelRecord
+		ANIME_TRACKS,		// TrackRecord (チャンネル毎に 位置・回転・拡縮 の3つ)
+		ANIME_FRAMES,		// uint16_t
+		ANIME_KEYS,			// uint16_t x 3
+		ANIME_STRINGS,		// char
+		ANIME_SECTION_MAX
+	};
+
+	struct AnimeHeader
+	{
+		std::uint32_t	magic;
+		std::uint32_t	version;
+		SourceStamp		source;
+		float			totalTime;
+		float			sampleRate;		// 変換時の再サンプリングレート
+		float			tolerance[3];	// 変換時の圧縮許容誤差
+		float			maxError[3];
+		std::uint32_t	rawBytes;
+		std::uint32_t	packedBytes;
+		Section			sections[ANIME_SECTION_MAX];
+	};
+
+	struct ChannelRecord
+	{
+		std::uint32_t	name;			// 対象ノード名
+		std::uint32_t	sharedTiming;
+	};
+
+	struct TrackRecord
+	{
+		float			startTime;
+		float			keyRate;
+		float			rangeMin[3];
+		float			rangeExtent[3];
+		std::uint32_t	frameOffset;
+		std::uint32_t	frameCount;
+		std::uint32_t	keyOffset;
+		std::uint32_t	keyCount;
+	};
+
+	/**
+	 * [bool - GetSourceStamp]
+	 * @brief	ファイルのサイズと更新日時を取得する
+	 *
+	 * @param	[in] file ファイルパス
+	 * @param	[out] pOut 取得結果
+	 * @return	ファイルが存在すればtrue
+	 */
+	bool GetSourceStamp(const char* file, SourceStamp* pOut);
+
+	/**
+	 * [std::string - GetCookedPath]
+	 * @brief	変換元のパスから変換後のパスを求める (拡張子を .mdl / .anm に置き換える)
+	 */
+	std::string GetCookedPath(const std::string& file, bool isAnimation);
+}
+
+#endif // !___MODEL_COOKED_FORMAT_H___
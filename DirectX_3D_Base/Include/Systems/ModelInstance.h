@@ -0,0 +1,140 @@
+﻿/*****************************************************************//**
+ * @file	ModelInstance.h
+ * @brief	エンティティ毎のアニメーション再生状態と姿勢バッファ
+ *
+ * @details	Model (メッシュ・スケルトン・クリップ) は AssetManager が1つだけ保持して
+ *			全エンティティで共有し、再生時間やブレンド状態、計算済みのボーン行列は
+ *			ModelInstance にエンティティ毎に持たせる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：Modelから再生状態を分離し、ModelInstanceを作成。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+#ifndef ___MODEL_INSTANCE_H___
+#define ___MODEL_INSTANCE_H___
+
+// ===== インクルード =====
+#include <DirectXMath.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Systems/Model.h"
+
+/**
+ * @class	ModelInstance
+ * @brief	共有Modelを参照し、自分専用の再生状態と姿勢でアニメーション・描画を行う
+ *
+ * 同じモデルの敵を複数体出しても、各インスタンスが自分の姿勢を1回ずつ計算する。
+ * 参照する Model のデータは書き換えない (描画時のシェーダー設定を除く)。
+ */
+class ModelInstance final
+{
+public:
+	using NodeIndex = Model::NodeIndex;
+	using AnimeNo = Model::AnimeNo;
+
+	explicit ModelInstance(Model* pModel);
+
+	Model* GetModel() const { return m_pModel; }
+
+	//--- アニメーション
+	// アニメーションの更新 (再生時間を進め、姿勢を計算する)
+	void Step(float tick);
+	// 複数インスタンスの更新 (同じモデルが並んでいれば4体ずつまとめて姿勢を計算する)
+	static void StepBatch(ModelInstance* const* ppInstances, size_t count, float tick);
+
+	// アニメーションの再生
+	void Play(AnimeNo no, bool loop, float speed = 1.0f);
+	void Play(const std::string& animeID, bool loop, float speed = 1.0f);
+	// アニメーションのブレンド再生
+	void PlayBlend(AnimeNo no, float blendTime, bool loop, float speed = 1.0f);
+	void PlayBlend(const std::string& animeID, float blendTime, bool loop = true, float speed = 1.0f);
+	// アニメーションの合成設定
+	void SetParametric(AnimeNo no1, AnimeNo no2);
+	// アニメーションの合成割合設定
+	void SetParametricBlend(float blendRate);
+	// アニメーションの現在再生時間を変更
+	void SetAnimationTime(AnimeNo no, float time);
+
+	// 再生フラグ
+	bool IsPlay(AnimeNo no) const;
+	// 現在再生中のアニメ番号
+	AnimeNo GetPlayNo() const { return m_playNo; }
+	// ブレンド中のアニメ番号
+	AnimeNo GetBlendNo() const { return m_blendNo; }
+
+	//--- 姿勢
+	// 計算済みのノード行列 (Step前はバインドポーズ)
+	DirectX::XMMATRIX GetBone(NodeIndex index) const;
+	// ノードアニメーション(ボーン無しモデル)のルート姿勢を取得
+	bool GetAnimatedTransform(DirectX::XMFLOAT3& outPos, DirectX::XMFLOAT3& outRot, DirectX::XMFLOAT3& outScale) const;
+
+	//--- 描画
+	// このインスタンスの姿勢で共有モデルを描画する
+	// (スキニング行列は姿勢の更新後に最初に描画する時に一度だけ計算し、全メッシュで使い回す)
+	void Draw(int meshNo = -1, int lod = 0);
+
+private:
+	// アニメーション計算領域
+	enum AnimeTransform
+	{
+		MAIN,			// 通常再生
+		BLEND,			// ブレンド再生
+		PARAMETRIC0,	// 合成A
+		PARAMETRIC1,	// 合成B
+		MAX_TRANSFORM
+	};
+
+	// クリップ毎の再生状態 (クリップ本体は Model 側で共有)
+	struct PlaybackInfo
+	{
+		float	nowTime = 0.0f;	// 現在の再生時間
+		float	speed = 1.0f;	// 再生速度
+		bool	isLoop = false;	// ループ指定
+		std::vector<std::uint32_t> cursors;	// チャンネル毎 (位置・回転・拡縮) の前回のキー区間
+	};
+
+	using Transform = Model::Transform;
+
+	// 内部計算
+	bool AnimeNoCheck(AnimeNo no) const;
+	PlaybackInfo& GetInfo(AnimeNo no);
+	void InitAnime(AnimeNo no);
+	void CalcAnime(AnimeTransform kind, AnimeNo no);
+	void UpdateAnime(AnimeNo no, float tick);
+	void SampleLayers();
+	void Advance(float tick);
+	void CalcBones();
+	static void CalcBonesX4(ModelInstance* const* ppInstances);
+	void SyncNodeCount();
+	static DirectX::XMMATRIX MakeLocalMatrix(const Transform& transform);
+	static void LerpTransform(Transform* pOut, const Transform& a, const Transform& b, float rate);
+
+private:
+	Model* m_pModel;					// 共有モデル (読み取り専用として扱う)
+
+	AnimeNo		m_playNo;				// 現在再生中のアニメ番号
+	AnimeNo		m_blendNo;				// ブレンド再生を行うアニメ番号
+	AnimeNo		m_parametric[2];		// 合成再生を行うアニメ番号
+	float		m_blendTime;			// 現在の遷移経過時間
+	float		m_blendTotalTime;		// アニメ遷移にかかる合計時間
+	float		m_parametricBlend;		// パラメトリックの再生割合
+
+	std::vector<PlaybackInfo>		m_animeInfo;						// クリップ毎の再生状態
+	std::vector<Transform>			m_nodeTransform[MAX_TRANSFORM];		// アニメーション別変形情報
+	std::vector<Transform>			m_localTransforms;					// 合成後のローカル姿勢
+	std::vector<DirectX::XMMATRIX>	m_nodeMatrices;						// 計算済みのノード行列 (姿勢バッファ)
+	std::vector<DirectX::XMFLOAT4X4>	m_palette;						// 計算済みのスキニング行列
+	std::uint64_t					m_paletteRevision;					// パレットの識別番号 (0なら再計算が必要)
+};
+
+#endif // !___MODEL_INSTANCE_H___
@@ -0,0 +1,135 @@
+﻿/*****************************************************************//**
+ * @file	TextureCookedFormat.h
+ * @brief	変換済みテクスチャ (TextureCooker の出力) の形式
+ *
+ * @details	中身は通常の .dds (DXT1 = BC1 / DXT5 = BC3 / 32bit RGBA) で、ミップマップを全段持つ。
+ *			DirectXTex の LoadFromDDSMemory でそのまま読み込めるよう、独自の情報は
+ *			DDS ヘッダーの予約領域 (reserved1) にだけ書き込む。
+ *			Windows / Linux の両方で読み書きするため、標準ライブラリ以外に依存しない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：.dds の変換情報 (CookTag) を定義。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	CookTag の構成を変更した場合は VERSION を上げること (古いファイルは元画像から読み直す)
+ *********************************************************************/
+
+#ifndef ___TEXTURE_COOKED_FORMAT_H___
+#define ___TEXTURE_COOKED_FORMAT_H___
+
+// ===== インクルード =====
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "Systems/ModelCookedFormat.h"
+
+namespace TextureCooked
+{
+	const std::uint32_t DDS_MAGIC = 0x20534444u;	// "DDS "
+	const std::uint32_t TAG_MAGIC = 0x4B435854u;	// "TXCK"
+	const std::uint32_t VERSION = 1;
+
+	/// @brief 格納形式
+	enum Format : std::uint32_t
+	{
+		FORMAT_RGBA8,	// 32bit RGBA (ブロック圧縮できない大きさ・画質が落ちすぎるもの)
+		FORMAT_BC1,		// 不透明 (4bit / 画素)
+		FORMAT_BC3,		// アルファあり (8bit / 画素)
+	};
+
+	//--- DDS (https://learn.microsoft.com/windows/win32/direct3ddds/dds-header)
+	const std::uint32_t DDSD_CAPS = 0x1;
+	const std::uint32_t DDSD_HEIGHT = 0x2;
+	const std::uint32_t DDSD_WIDTH = 0x4;
+	const std::uint32_t DDSD_PITCH = 0x8;
+	const std::uint32_t DDSD_PIXELFORMAT = 0x1000;
+	const std::uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+	const std::uint32_t DDSD_LINEARSIZE = 0x80000;
+	const std::uint32_t DDPF_ALPHAPIXELS = 0x1;
+	const std::uint32_t DDPF_FOURCC = 0x4;
+	const std::uint32_t DDPF_RGB = 0x40;
+	const std::uint32_t DDSCAPS_COMPLEX = 0x8;
+	const std::uint32_t DDSCAPS_TEXTURE = 0x1000;
+	const std::uint32_t DDSCAPS_MIPMAP = 0x400000;
+	const std::uint32_t FOURCC_DXT1 = 0x31545844u;	// "DXT1"
+	const std::uint32_t FOURCC_DXT5 = 0x35545844u;	// "DXT5"
+
+	struct PixelFormat
+	{
+		std::uint32_t	size;			// 32
+		std::uint32_t	flags;
+		std::uint32_t	fourCC;
+		std::uint32_t	rgbBitCount;
+		std::uint32_t	bitMask[4];		// R, G, B, A
+	};
+
+	struct Header
+	{
+		std::uint32_t	size;			// 124
+		std::uint32_t	flags;
+		std::uint32_t	height;
+		std::uint32_t	width;
+		std::uint32_t	pitchOrLinearSize;
+		std::uint32_t	depth;
+		std::uint32_t	mipMapCount;
+		std::uint32_t	reserved1[11];	// CookTag を格納する
+		PixelFormat		format;
+		std::uint32_t	caps[4];
+		std::uint32_t	reserved2;
+	};
+	static_assert(sizeof(Header) == 124, "DDS header must be 124 bytes");
+
+	/**
+	 * @struct	CookTag
+	 * @brief	変換時の情報 (Header::reserved1 へ memcpy で読み書きする)
+	 */
+	struct CookTag
+	{
+		std::uint32_t				magic;			// TAG_MAGIC
+		std::uint32_t				version;
+		std::uint32_t				format;			// Format
+		float						sourceDecodeMs;	// 変換元の画像の展開にかかった時間
+		float						psnr;			// 最上段の圧縮前後の PSNR (dB。RGBA は 99)
+		std::uint16_t				sourceWidth;	// 変換元の画像の大きさ (縮小した場合は Header と異なる)
+		std::uint16_t				sourceHeight;
+		ModelCooked::SourceStamp	source;
+	};
+	static_assert(sizeof(CookTag) <= sizeof(Header::reserved1), "CookTag must fit in DDS reserved1");
+
+	/**
+	 * [bool - ReadHeader]
+	 * @brief	メモリ上の .dds から DDS ヘッダーと CookTag を取り出す
+	 *
+	 * @return	TextureCooker が書き出した、現在の VERSION のファイルならtrue
+	 */
+	inline bool ReadHeader(const void* pData, std::size_t size, Header* pHeader, CookTag* pTag)
+	{
+		if (!pData || size < sizeof(std::uint32_t) + sizeof(Header)) return false;
+		std::uint32_t magic;
+		std::memcpy(&magic, pData, sizeof(magic));
+		if (magic != DDS_MAGIC) return false;
+		std::memcpy(pHeader, static_cast<const std::uint8_t*>(pData) + sizeof(magic), sizeof(Header));
+		std::memcpy(pTag, pHeader->reserved1, sizeof(CookTag));
+		return pHeader->size == sizeof(Header) && pTag->magic == TAG_MAGIC && pTag->version == VERSION;
+	}
+
+	/**
+	 * [std::string - GetCookedPath]
+	 * @brief	変換元のパスから変換後のパスを求める (拡張子を .dds に置き換える)
+	 */
+	inline std::string GetCookedPath(const std::string& file)
+	{
+		const std::size_t slash = file.find_last_of("/\\");
+		std::size_t dot = file.find_last_of('.');
+		if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) dot = file.size();
+		return file.substr(0, dot) + ".dds";
+	}
+}
+
+#endif // !___TEXTURE_COOKED_FORMAT_H___
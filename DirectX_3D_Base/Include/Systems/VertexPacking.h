@@ -0,0 +1,221 @@
+﻿/*****************************************************************//**
+ * @file	VertexPacking.h
+ * @brief	モデル頂点の圧縮・展開 (GPU 転送用のパック形式)
+ *
+ * @details	Model::Vertex (80バイト) を GPU へ転送する際の詰め込み処理。
+ *			位置は float3 のまま別ストリームに置き、残りを以下の形式にする。
+ *			  法線 : 八面体 (oct) 写像した2成分を snorm16 x 2
+ *			  UV   : half x 2
+ *			  色   : unorm8 x 4
+ *			  ウェイト / ボーン番号 : unorm8 x 4 / uint8 x 4 (ボーンを持つメッシュのみ)
+ *			Direct3D に依存しないため、展開関数と組み合わせて CPU 上で誤差を確認できる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：法線・UV・色・スキン情報の圧縮/展開を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	シェーダー側の展開は ShaderList / Model の頂点シェーダーの DecodeNormal と合わせること
+ *********************************************************************/
+
+#ifndef ___VERTEX_PACKING_H___
+#define ___VERTEX_PACKING_H___
+
+// ===== インクルード =====
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace VertexPacking
+{
+	/// @brief 法線・UV・色 (ストリーム1 : 12バイト)
+	struct Attribute
+	{
+		std::int16_t	normal[2];	// 八面体写像した法線 (R16G16_SNORM)
+		std::uint16_t	uv[2];		// R16G16_FLOAT
+		std::uint8_t	color[4];	// R8G8B8A8_UNORM
+	};
+
+	/// @brief スキニング情報 (ストリーム2 : 8バイト、ボーンを持つメッシュのみ)
+	struct Skin
+	{
+		std::uint8_t	weight[4];	// R8G8B8A8_UNORM (合計が255になるよう丸める)
+		std::uint8_t	index[4];	// R8G8B8A8_UINT (パレット上の位置)
+	};
+
+	static_assert(sizeof(Attribute) == 12, "Attribute must be 12 bytes");
+	static_assert(sizeof(Skin) == 8, "Skin must be 8 bytes");
+
+	//--- 基本の変換
+
+	/// @brief [-1, 1] を snorm16 へ
+	inline std::int16_t PackSnorm16(float v)
+	{
+		v = std::max(-1.0f, std::min(1.0f, v));
+		return static_cast<std::int16_t>(std::lround(v * 32767.0f));
+	}
+	/// @brief snorm16 を [-1, 1] へ (GPU と同じく -32768 は -1 として扱う)
+	inline float UnpackSnorm16(std::int16_t v)
+	{
+		return std::max(-1.0f, static_cast<float>(v) / 32767.0f);
+	}
+
+	/// @brief [0, 1] を unorm8 へ
+	inline std::uint8_t PackUnorm8(float v)
+	{
+		v = std::max(0.0f, std::min(1.0f, v));
+		return static_cast<std::uint8_t>(std::lround(v * 255.0f));
+	}
+	inline float UnpackUnorm8(std::uint8_t v)
+	{
+		return static_cast<float>(v) / 255.0f;
+	}
+
+	/// @brief float を half へ (最近接偶数丸め、範囲外は無限大)
+	inline std::uint16_t FloatToHalf(float value)
+	{
+		std::uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		const std::uint32_t sign = (bits >> 16) & 0x8000u;
+		const std::uint32_t absBits = bits & 0x7fffffffu;
+
+		if (absBits >= 0x7f800000u)
+		{
+			// 無限大・NaN
+			return static_cast<std::uint16_t>(sign | 0x7c00u | (absBits > 0x7f800000u ? 0x200u : 0u));
+		}
+		if (absBits >= 0x477ff000u)
+		{
+			// half の最大値 (65504) を丸めで超える値は無限大
+			return static_cast<std::uint16_t>(sign | 0x7c00u);
+		}
+		if (absBits < 0x38800000u)
+		{
+			// half の非正規化数 (2^-14 未満)
+			if (absBits < 0x33000000u) return static_cast<std::uint16_t>(sign);	// 2^-25 以下は0
+			const std::uint32_t mantissa = (absBits & 0x007fffffu) | 0x00800000u;
+			const std::uint32_t shift = 126u - (absBits >> 23);	// 14 + (127 - 1 - exp) の残り
+			std::uint32_t half = mantissa >> shift;
+			const std::uint32_t rest = mantissa & ((1u << shift) - 1u);
+			const std::uint32_t halfway = 1u << (shift - 1u);
+			if (rest > halfway || (rest == halfway && (half & 1u))) ++half;
+			return static_cast<std::uint16_t>(sign | half);
+		}
+
+		// 正規化数 : 指数を付け替え、下位13bitを最近接偶数で丸める
+		std::uint32_t half = ((absBits - 0x38000000u) >> 13);
+		const std::uint32_t rest = absBits & 0x1fffu;
+		if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) ++half;
+		return static_cast<std::uint16_t>(sign | half);
+	}
+
+	/// @brief half を float へ
+	inline float HalfToFloat(std::uint16_t half)
+	{
+		const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+		const std::uint32_t exponent = (half >> 10) & 0x1fu;
+		std::uint32_t mantissa = half & 0x3ffu;
+		std::uint32_t bits;
+		if (exponent == 0)
+		{
+			if (mantissa == 0)
+			{
+				bits = sign;
+			}
+			else
+			{
+				// 非正規化数は正規化し直す
+				int e = -1;
+				do { ++e; mantissa <<= 1; } while ((mantissa & 0x400u) == 0);
+				bits = sign | (static_cast<std::uint32_t>(112 - e) << 23) | ((mantissa & 0x3ffu) << 13);
+			}
+		}
+		else if (exponent == 0x1f)
+		{
+			bits = sign | 0x7f800000u | (mantissa << 13);
+		}
+		else
+		{
+			bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+		}
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	//--- 法線
+
+	/// @brief 単位ベクトルを八面体写像で2成分 ([-1, 1]) に変換して snorm16 に詰める
+	inline void PackOctNormal(float x, float y, float z, std::int16_t out[2])
+	{
+		const float len = std::fabs(x) + std::fabs(y) + std::fabs(z);
+		if (len <= 0.0f)
+		{
+			out[0] = out[1] = 0;	// 長さ0の法線は +Z とする
+			return;
+		}
+		float u = x / len;
+		float v = y / len;
+		if (z < 0.0f)
+		{
+			// 下半球は対角線で折り返す
+			const float fu = (1.0f - std::fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+			const float fv = (1.0f - std::fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+			u = fu;
+			v = fv;
+		}
+		out[0] = PackSnorm16(u);
+		out[1] = PackSnorm16(v);
+	}
+
+	/// @brief PackOctNormal で詰めた法線を単位ベクトルに戻す
+	inline void UnpackOctNormal(const std::int16_t in[2], float out[3])
+	{
+		float x = UnpackSnorm16(in[0]);
+		float y = UnpackSnorm16(in[1]);
+		const float z = 1.0f - std::fabs(x) - std::fabs(y);
+		const float t = std::max(-z, 0.0f);
+		x += (x >= 0.0f) ? -t : t;
+		y += (y >= 0.0f) ? -t : t;
+		const float len = std::sqrt(x * x + y * y + z * z);
+		out[0] = x / len;
+		out[1] = y / len;
+		out[2] = z / len;
+	}
+
+	//--- スキニング情報
+
+	/// @brief ウェイトを unorm8 x 4 に詰める (合計が元と同じく1になるよう、誤差は最大のウェイトへ寄せる)
+	inline void PackWeights(const float weight[4], std::uint8_t out[4])
+	{
+		int sum = 0;
+		int largest = 0;
+		float total = 0.0f;
+		for (int i = 0; i < 4; ++i)
+		{
+			out[i] = PackUnorm8(weight[i]);
+			sum += out[i];
+			total += weight[i];
+			if (weight[i] > weight[largest]) largest = i;
+		}
+		const int target = static_cast<int>(std::lround(std::max(0.0f, std::min(1.0f, total)) * 255.0f));
+		out[largest] = static_cast<std::uint8_t>(std::max(0, std::min(255, out[largest] + target - sum)));
+	}
+
+	/// @brief ボーン番号を uint8 x 4 に詰める (パレットの最大ボーン数は256未満であること)
+	inline void PackIndices(const unsigned int index[4], std::uint8_t out[4])
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			out[i] = static_cast<std::uint8_t>(std::min(index[i], 255u));
+		}
+	}
+}
+
+#endif // !___VERTEX_PACKING_H___
@@ -4,7 +4,9 @@
  * 
  * @details	
  * AssetManagerɂĊǗ̂łA
- * XAudio2̃\[X{CXpčĐsBSE/BGM̗ɑΉB
+ * SoundEngine  AudioBackend (XAudio2 ̃\[X{CX) {CXōĐsBSE/BGM̗ɑΉB
+ * BGM ̂悤ȒTEh LoadStream œǂݍނƁAŜɒuɍĐȂǂݍށB
+ * P SE  PlayOneShot œtH[}bg̃{CXv[炷ƁAỎ؂炸ɏd˂B
  * 
  * ------------------------------------------------------------
  * @author	Iwai Shogo
@@ -24,8 +26,10 @@
 
 // ===== CN[h =====
 #include "Systems/XAudio2/SoundEngine.h"
+#include "Systems/XAudio2/SoundStream.h"
 #include <string>
 #include <iostream>
+#include <memory>
 #include <xaudio2.h>
 
 namespace Audio
@@ -38,36 +42,49 @@ namespace Audio
 	class SoundEffect
 	{
 	private:
-		// XAudio2 {CX
-		IXAudio2SourceVoice* m_pSourceVoice = nullptr;
+		// ĐɎg{CX
+		std::unique_ptr<AudioVoice> m_pVoice;
 		// TEhf[^i[pobt@
-		XAUDIO2_BUFFER m_buffer = { 0 };
+		AudioBuffer m_buffer;
 		// WAVt@C̃tH[}bg
 		WAVEFORMATEX* m_format = nullptr;
 		// WAVt@C̃f[^{́iSoundEngine::LoadWavFileŃq[vɊmۂꂽ́j
 		BYTE* m_audioData = nullptr;
 		// f[^̃oCgTCY
 		DWORD m_audioBytes = 0;
+		// false ̏ꍇ m_audioData ̓AZbgA[JCuw (Ȃ)
+		bool m_isAudioDataOwned = true;
+		// ǂݍ񂾃t@C̃pX (Op)
+		std::string m_filePath;
+		// P SE 炷{CXv[ (Xg[Đł͎gȂ)
+		VoicePool* m_pOneShotPool = nullptr;
+		// Xg[Đ̏ꍇ̂ (m_audioData ͎gȂ)
+		std::unique_ptr<SoundStream> m_pStream;
+
+		// Xg[ǂݍ񂾃obt@{CX֐ς
+		class StreamSink : public SoundStream::Sink
+		{
+		public:
+			AudioVoice* pVoice = nullptr;
+			bool Submit(const std::uint8_t* pData, std::uint32_t bytes, bool isEnd) override;
+		} m_streamSink;
 
 		// Đ̃{CXĎ邽߂̃R[obN
-		class VoiceCallback : public IXAudio2VoiceCallback
+		class VoiceCallback : public AudioVoice::Callback
 		{
 		public:
-			STDMETHOD_(void, OnVoiceProcessingPassStart)(THIS_ UINT32 BytesRequired) {}
-			STDMETHOD_(void, OnVoiceProcessingPassEnd)(THIS) {}
-			STDMETHOD_(void, OnStreamEnd)(THIS)
-			{
-				// Đɒʒm󂯂邪Ał͓ɉȂiAssetManager̐Ӗj
-			}
-			STDMETHOD_(void, OnBufferStart)(THIS_ void* pBufferContext) {}
-			STDMETHOD_(void, OnBufferEnd)(THIS_ void* pBufferContext) {}
-			STDMETHOD_(void, OnLoopEnd)(THIS_ void* pBufferContext) {}
-			STDMETHOD_(void, OnVoiceError)(THIS_ void* pBufferContext, HRESULT Error)
+			// Xg[Đ̏ꍇAĐIobt@Ԃ
+			SoundStream* pStream = nullptr;
+
+			void OnBufferEnd() override
 			{
-				std::cerr << "XAudio2 SoundEffect Voice Error: " << std::hex << Error << std::endl;
+				if (pStream) pStream->OnBufferEnd();
 			}
 		} m_voiceCallback;
 
+		// ǂݍ݌Xg[JAtH[}bg m_format ֎ʂ
+		bool OpenStream(std::unique_ptr<StreamReader> pReader, const std::string& filePath);
+
 	public:
 		/**
 		 * @brief RXgN^B
@@ -93,6 +110,50 @@ namespace Audio
 		 */
 		bool Load(const std::string& filePath);
 
+		/**
+		 * [bool - LoadData]
+		 * @brief	WAVt@Cǂݍ ({CX͍쐬Ȃ)B
+		 * @details	XAudio2 gȂ߁A񓯊ǂݍ݂ł̓[J[XbhĂяoB
+		 * @param	[in] filePath WAVt@C̃pX
+		 * @return	true: , false: s
+		 */
+		bool LoadData(const std::string& filePath);
+
+		/**
+		 * [bool - LoadData]
+		 * @brief	WAVt@C̓eǂݍ (g`f[^̓Rs[ɎQƂ)B
+		 * @param	[in] pData WAVt@C̓e (SoundEffect 蒷ێ邱)
+		 * @param	[in] size pData ̃oCg
+		 * @param	[in] filePath Op̃pX
+		 * @return	true: , false: s
+		 */
+		bool LoadData(const void* pData, size_t size, const std::string& filePath);
+
+		/**
+		 * [bool - LoadStream]
+		 * @brief	WAVt@CXg[ĐpɊJ (wb_[̂ݓǂ݁Ag`͍Đɓǂݍ)B
+		 * @param	[in] filePath WAVt@C̃pX
+		 * @return	true: , false: s
+		 */
+		bool LoadStream(const std::string& filePath);
+
+		/**
+		 * [bool - LoadStream]
+		 * @brief	WAVt@C̓eXg[ĐpɊJ (AZbgA[JCũf[^Ȃ)B
+		 * @param	[in] pData WAVt@C̓e (SoundEffect 蒷ێ邱)
+		 * @param	[in] size pData ̃oCg
+		 * @param	[in] filePath Op̃pX
+		 * @return	true: , false: s
+		 */
+		bool LoadStream(const void* pData, size_t size, const std::string& filePath);
+
+		/**
+		 * [bool - CreateVoice]
+		 * @brief	LoadData œǂݍ񂾃f[^\[X{CX쐬 (CXbh)B
+		 * @return	true: , false: s
+		 */
+		bool CreateVoice();
+
 		/**
 		 * [void - Play]
 		 * @brief	TEhĐB
@@ -101,6 +162,17 @@ namespace Audio
 		 */
 		void Play(UINT32 loopCount = 0, float volume = 1.0f);
 
+		/**
+		 * [bool - PlayOneShot]
+		 * @brief	{CXv[̋󂢂{CXŖ炷 (Đ̉~߂ɏd˂)B͊mۂȂB
+		 * @param	[in] volume {[
+		 * @param	[in] pitch Đx̔{ (AudioBackend::MIN_PITCH - MAX_PITCH)
+		 * @param	[in] priority 󂫂ɒDɂ (傫قǎc)
+		 * @return	false: Dx肸炳ȂEs
+		 * @note	Stop / IsPlaying ̑ΏۊO (~߂ꍇ SoundEngine::StopOneShots)BXg[Đł Play Ɠ
+		 */
+		bool PlayOneShot(float volume = 1.0f, float pitch = 1.0f, int priority = 0);
+
 		/**
 		 * [void - Stop]
 		 * @brief	TEh̍Đ~B
@@ -125,6 +197,12 @@ namespace Audio
 		 * @brief	{[ݒ肷B
 		 */
 		void SetVolume(float volume);
+
+		/**
+		 * [size_t - GetMemorySize]
+		 * @brief	ǂݍ񂾔g`f[^̃oCg (AssetManager ̗\ZvZp)BXg[Đł̓obt@̍v
+		 */
+		size_t GetMemorySize() const { return m_pStream ? m_pStream->GetMemorySize() : m_audioBytes; }
 	};
 }
 
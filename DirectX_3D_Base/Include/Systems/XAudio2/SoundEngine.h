@@ -27,9 +27,14 @@
 #include <windows.h>
 #include <xaudio2.h>
 #include <mmreg.h>
+#include "Systems/Audio/AudioBackend.h"
+#include "Systems/XAudio2/SoundStream.h"
+#include "Systems/XAudio2/VoicePool.h"
 #include <stdexcept>
 #include <string>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #pragma comment(lib, "XAudio2.lib")
 
@@ -44,6 +49,7 @@ namespace Audio
 		WAVEFORMATEX* format = nullptr;	// TEhf[^̃tH[}bg
 		BYTE* audioData = nullptr;		// TEhf[^{
 		DWORD audioBytes = 0;			// TEhf[^̃oCgTCY
+		bool isAudioDataOwned = true;	// false : audioData ̓AZbgA[JCuw (Ȃ)
 
 		/**
 		 * @brief \[XB
@@ -55,11 +61,11 @@ namespace Audio
 				delete[] reinterpret_cast<BYTE*>(format);
 				format = nullptr;
 			}
-			if (audioData)
+			if (audioData && isAudioDataOwned)
 			{
 				delete[] audioData;
-				audioData = nullptr;
 			}
+			audioData = nullptr;
 			audioBytes = 0;
 		}
 	};
@@ -72,12 +78,35 @@ namespace Audio
 	{
 	public:
 		static SoundEngine* s_instance;
+		// P SE pɃtH[}bgƂɗpӂ{CX̐
+		static const int ONE_SHOT_VOICE_NUM = 16;
 
 	private:
 		// XAudio2 GWC^[tF[X
 		IXAudio2* m_pXAudio2 = nullptr;
 		// }X^[{CXiTEho̓foCXj
 		IXAudio2MasteringVoice* m_pMasteringVoice = nullptr;
+		// {CX̍쐬 (XAudio2 ̃\[X{CX)
+		std::unique_ptr<AudioBackend> m_pBackend;
+		// BGM Ȃǂ̃Xg[Đ̓ǂݍ݃Xbh
+		SoundStreamer m_streamer;
+
+		// P SE p̃{CX (tH[}bg̃TEhŋL)
+		class OneShotVoices : public VoicePool::Backend
+		{
+		public:
+			OneShotVoices() : pool(this, ONE_SHOT_VOICE_NUM) {}
+
+			bool IsVoiceActive(int voice) const override;
+			void StopVoice(int voice) override;
+			// pSample : 炷TEh AudioBuffer
+			bool StartVoice(int voice, const void* pSample, float volume, float pitch) override;
+
+			std::vector<BYTE> format;					// {CX쐬tH[}bg (WAVEFORMATEX + ǉ)
+			std::vector<std::unique_ptr<AudioVoice>> voices;
+			VoicePool pool;
+		};
+		std::vector<std::unique_ptr<OneShotVoices>> m_oneShotVoices;
 		// R[obN̂߂̃NXigp`j
 		class VoiceCallback : public IXAudio2VoiceCallback
 		{
@@ -155,6 +184,34 @@ namespace Audio
 		 */
 		IXAudio2* GetXAudio2Engine() const { return m_pXAudio2; }
 
+		/**
+		 * [AudioBackend* - GetBackend]
+		 * @brief	{CX̍쐬擾B
+		 *
+		 * @return	ɎsĂꍇnullptrB
+		 */
+		AudioBackend* GetBackend() const { return m_pBackend.get(); }
+
+		/**
+		 * [SoundStreamer & - GetStreamer]
+		 * @brief	Xg[Đ̓ǂݍ݃Xbh擾B
+		 */
+		SoundStreamer& GetStreamer() { return m_streamer; }
+
+		/**
+		 * [VoicePool* - GetVoicePool]
+		 * @brief	tH[}bgvP SE p̃{CXv[擾 (΃{CX쐬)B
+		 * @details	TEh̓ǂݍ݊ (CXbh) ɌĂсAĐɂ̓{CXȂ悤ɂB
+		 * @return	{CX쐬łȂ nullptr
+		 */
+		VoicePool* GetVoicePool(const WAVEFORMATEX* pFormat);
+
+		/**
+		 * [void - StopOneShots]
+		 * @brief	P SE p̃{CXSĎ~߂ (V[؂ւȂ)B
+		 */
+		void StopOneShots();
+
 		/**
 		 * [bool - LoadWavFile]
 		 * @brief	WAVt@Cǂݍ݁ALoadWavData\̂Ɋi[B
@@ -165,6 +222,20 @@ namespace Audio
 		 */
 		bool LoadWavFile(const std::string& filePath, LoadWavData& wavData);
 
+		/**
+		 * [bool - LoadWavMemory]
+		 * @brief	WAVt@C̓e͂ALoadWavData\̂Ɋi[B
+		 * @details	g`f[^̓Rs[ pData ̒w߁ApData  wavData 蒷ێ邱ƁB
+		 *			tH[}bĝ݊mۂăRs[B
+		 *
+		 * @param	[in] pData WAVt@C̓e (AZbgA[JCũf[^Ȃ)
+		 * @param	[in] size pData ̃oCg
+		 * @param	[in] filePath Op̃pX
+		 * @param	[out] wavData ǂݍ񂾃f[^󂯎\
+		 * @return	true: , false: s
+		 */
+		bool LoadWavMemory(const void* pData, size_t size, const std::string& filePath, LoadWavData& wavData);
+
 		// TODO: Iȋ@\gƂāAO[oȃ{[\bhȂǂǉ\
 	};
 }
@@ -0,0 +1,236 @@
+﻿/*****************************************************************//**
+ * @file	SoundStream.h
+ * @brief	BGM などの長いサウンドを、再生しながら少しずつ読み込むストリーム
+ *
+ * @details	WAV の data チャンクを一定の大きさ (約 0.25 秒) ずつ読み、少数のバッファを順に使い回す。
+ *			読み込みは SoundStreamer のスレッドで行い、埋まったバッファを Sink (XAudio2 のソースボイスなど) へ渡す。
+ *			Sink が再生し終えたバッファは OnBufferEnd で返され、次の読み込みに使われる。
+ *			XAudio2 に依存しないため、何も再生しない Sink を渡せば Linux 上でも動作を確認できる。
+ *
+ *			波形はそのまま Sink へ渡すため、PCM 以外にも XAudio2 が展開できる形式 (MS-ADPCM など) をそのまま流せる
+ *			(バッファの大きさはブロック境界 (nBlockAlign) に揃える)。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：WAV のストリーム読み込みとバッファの使い回しを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	Sink はバッファを渡された順に返すこと (XAudio2 のソースボイスはキューの順に再生する)
+ *********************************************************************/
+
+#ifndef ___SOUND_STREAM_H___
+#define ___SOUND_STREAM_H___
+
+// ===== インクルード =====
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Audio
+{
+	/**
+	 * @class	StreamReader
+	 * @brief	ストリームの読み込み元 (任意の位置から読める)
+	 */
+	class StreamReader
+	{
+	public:
+		virtual ~StreamReader() = default;
+		// 読めたバイト数を返す (終端・失敗で bytes より少なくなる)
+		virtual size_t ReadAt(std::uint64_t offset, void* pOut, size_t bytes) = 0;
+		virtual std::uint64_t GetSize() const = 0;
+	};
+
+	/**
+	 * @class	FileStreamReader
+	 * @brief	ファイルから読む (開いたまま保持する)
+	 */
+	class FileStreamReader : public StreamReader
+	{
+	public:
+		~FileStreamReader() override;
+		bool Open(const std::string& filePath);
+		size_t ReadAt(std::uint64_t offset, void* pOut, size_t bytes) override;
+		std::uint64_t GetSize() const override { return m_size; }
+
+	private:
+		FILE* m_pFile = nullptr;
+		std::uint64_t m_size = 0;
+	};
+
+	/**
+	 * @class	MemoryStreamReader
+	 * @brief	メモリ上 (アセットアーカイブのマップした領域など) から読む。pData は読み終えるまで保持すること
+	 */
+	class MemoryStreamReader : public StreamReader
+	{
+	public:
+		MemoryStreamReader(const void* pData, size_t size) : m_pData(static_cast<const std::uint8_t*>(pData)), m_size(size) {}
+		size_t ReadAt(std::uint64_t offset, void* pOut, size_t bytes) override;
+		std::uint64_t GetSize() const override { return m_size; }
+
+	private:
+		const std::uint8_t* m_pData;
+		size_t m_size;
+	};
+
+	/**
+	 * @struct	WavInfo
+	 * @brief	WAV ファイルのヘッダーの解析結果
+	 */
+	struct WavInfo
+	{
+		std::vector<std::uint8_t> format;	// fmt チャンク (WAVEFORMATEX として使えるよう 18 バイト以上に 0 で埋める)
+		std::uint16_t formatTag = 0;
+		std::uint16_t blockAlign = 0;
+		std::uint32_t avgBytesPerSec = 0;
+		std::uint64_t dataOffset = 0;		// data チャンクの先頭
+		std::uint32_t dataBytes = 0;		// data チャンクのバイト数 (ブロック境界に切り詰める)
+	};
+
+	/**
+	 * [bool - ParseWav]
+	 * @brief	RIFF / WAVE のチャンクを辿り、fmt と data の位置を調べる (波形は読まない)
+	 * @return	false : WAV でない・ストリームできない形式
+	 */
+	bool ParseWav(StreamReader& reader, WavInfo* pOut);
+
+	/**
+	 * @class	SoundStream
+	 * @brief	1つの WAV を再生しながら読み込む
+	 * @details	スレッドの役割
+	 *			  Open / SetSink / Start / Stop / IsPlaying : メインスレッド
+	 *			  Service                                   : SoundStreamer のスレッド
+	 *			  OnBufferEnd                               : Sink のスレッド (XAudio2 の再生スレッド。ロックしない)
+	 */
+	class SoundStream
+	{
+	public:
+		static const int BUFFER_NUM = 4;				// 使い回すバッファの数
+		static const std::uint32_t BUFFER_MS = 250;		// バッファ1つ分の長さ
+		static const std::uint32_t LOOP_INFINITE = 255;	// XAUDIO2_LOOP_INFINITE と同じ値
+
+		/// @brief 読み込んだ波形の受け取り先
+		class Sink
+		{
+		public:
+			virtual ~Sink() = default;
+			// 再生キューへ積む (isEnd : この後に続くデータが無い)。積めなければ false
+			virtual bool Submit(const std::uint8_t* pData, std::uint32_t bytes, bool isEnd) = 0;
+		};
+
+	public:
+		SoundStream() = default;
+		SoundStream(const SoundStream&) = delete;
+		SoundStream& operator=(const SoundStream&) = delete;
+
+		/**
+		 * [bool - Open]
+		 * @brief	ヘッダーを解析してバッファを確保する (波形はまだ読まない)
+		 */
+		bool Open(std::unique_ptr<StreamReader> pReader, const std::string& filePath);
+
+		const WavInfo& GetInfo() const { return m_info; }
+		void SetSink(Sink* pSink) { m_pSink = pSink; }
+
+		/**
+		 * [void - Start]
+		 * @brief	先頭から再生を始める (読み込みは SoundStreamer が行う)
+		 * @param	[in] loopCount 先頭へ戻る回数 (LOOP_INFINITE : 止めるまで繰り返す)
+		 * @note	Sink のキューは空にしてから呼ぶこと (積まれていたバッファは OnBufferEnd で返れば再利用される)
+		 */
+		void Start(std::uint32_t loopCount);
+
+		/**
+		 * [void - Stop]
+		 * @brief	読み込みを止める (読み込み中なら終わるまで待つ)。この後 Sink のキューを空にする
+		 */
+		void Stop();
+
+		// 再生中か (最後のバッファが返るまで true)
+		bool IsPlaying() const;
+
+		/**
+		 * [bool - Service]
+		 * @brief	空いているバッファを全て埋めて Sink へ渡す (SoundStreamer のスレッド)
+		 * @return	1つでもバッファを渡したら true
+		 */
+		bool Service();
+
+		// Sink がバッファを1つ再生し終えた (渡された順に呼ぶこと)
+		void OnBufferEnd() { m_returnedNum.fetch_add(1, std::memory_order_release); }
+
+		// 常駐するメモリ量 (バッファの合計)
+		size_t GetMemorySize() const { return m_buffers.size() * m_bufferBytes; }
+
+	private:
+		// buffer を position から埋める (終端ではループ回数に応じて先頭へ戻る)
+		std::uint32_t Fill(std::uint8_t* pBuffer, bool* pIsEnd);
+
+	private:
+		std::unique_ptr<StreamReader> m_pReader;
+		WavInfo m_info;
+		std::string m_filePath;
+		Sink* m_pSink = nullptr;
+
+		std::vector<std::vector<std::uint8_t>> m_buffers;
+		std::uint32_t m_bufferBytes = 0;
+
+		mutable std::mutex m_mutex;			// 以下の読み込み状態 (Service と Start / Stop の排他)
+		bool m_isActive = false;
+		bool m_isEndSubmitted = false;		// 最後のバッファを渡した
+		std::uint32_t m_position = 0;		// data チャンク内の読み込み位置
+		std::uint32_t m_loopsLeft = 0;
+		std::uint64_t m_submittedNum = 0;	// Sink へ渡したバッファの数 (次に使うバッファは m_submittedNum % BUFFER_NUM)
+		std::atomic<std::uint64_t> m_returnedNum{ 0 };	// Sink から返ったバッファの数
+	};
+
+	/**
+	 * @class	SoundStreamer
+	 * @brief	登録された全ストリームの読み込みを1本のスレッドで行う
+	 * @details	POLL_MS ごとに空いたバッファを確認する (バッファ全体で約1秒分あるため、再生スレッドから起こさなくても途切れない)。
+	 *			再生開始時は Wake で起こして、最初のバッファをすぐに読み込む。
+	 */
+	class SoundStreamer
+	{
+	public:
+		static const int POLL_MS = 10;
+
+		~SoundStreamer() { Stop(); }
+
+		void Start();
+		void Stop();
+
+		void Add(SoundStream* pStream);
+		// 戻った時点でこのストリームの読み込みは行われていない
+		void Remove(SoundStream* pStream);
+
+		// 次の確認を待たずに読み込ませる (再生開始時。どのスレッドからでも呼べる)
+		void Wake();
+
+	private:
+		void ThreadMain();
+
+	private:
+		std::mutex m_mutex;					// m_streams と Service の実行
+		std::vector<SoundStream*> m_streams;
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wakeCv;
+		bool m_isWoken = false;
+		bool m_isStopping = false;
+		std::thread m_thread;
+	};
+}
+
+#endif // !___SOUND_STREAM_H___
@@ -0,0 +1,112 @@
+﻿/*****************************************************************//**
+ * @file	VoicePool.h
+ * @brief	同じフォーマットのサウンドを重ねて鳴らすための、固定数のボイスの割り当て
+ *
+ * @details	足音やカーソル音のように短い間隔で鳴らす SE は、SoundEffect が1つだけ持つボイスでは前の音が切れてしまう。
+ *			VoicePool はあらかじめ作っておいたボイスを使い回し、再生のたびに空いているものへ割り当てる。
+ *			空きが無ければ、優先度の低いもの・同じ優先度なら古いものから奪って鳴らす
+ *			(鳴らす音の優先度が、鳴っているどの音よりも低ければ鳴らさない)。
+ *
+ *			ボイスの操作は Backend を通して行うため XAudio2 に依存せず、割り当ての規則だけを確認できる。
+ *			Play はメモリを確保しない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ボイスの割り当てと、優先度・古さによる奪い取りを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	メインスレッドからのみ使う
+ *********************************************************************/
+
+#ifndef ___VOICE_POOL_H___
+#define ___VOICE_POOL_H___
+
+// ===== インクルード =====
+#include <cstdint>
+#include <vector>
+
+namespace Audio
+{
+	/**
+	 * @class	VoicePool
+	 * @brief	固定数のボイスを、鳴らすサンプルに割り当てる
+	 */
+	class VoicePool
+	{
+	public:
+		static const int INVALID_VOICE = -1;
+
+		/// @brief ボイスの実体 (XAudio2 のソースボイスなど) の操作
+		class Backend
+		{
+		public:
+			virtual ~Backend() = default;
+			// まだ鳴っているか (鳴り終えたボイスは次の再生に使われる)
+			virtual bool IsVoiceActive(int voice) const = 0;
+			// 止めてキューを空にする
+			virtual void StopVoice(int voice) = 0;
+			// pSample を先頭から鳴らす (pitch : 再生速度の倍率)。鳴らせなければ false
+			virtual bool StartVoice(int voice, const void* pSample, float volume, float pitch) = 0;
+		};
+
+		/// @brief 再生の集計
+		struct Stats
+		{
+			std::uint32_t played = 0;	// 鳴らした数
+			std::uint32_t stolen = 0;	// うち、鳴っているボイスを奪った数
+			std::uint32_t dropped = 0;	// 優先度が足りず鳴らさなかった数
+		};
+
+	public:
+		VoicePool(Backend* pBackend, int voiceNum);
+		VoicePool(const VoicePool&) = delete;
+		VoicePool& operator=(const VoicePool&) = delete;
+
+		/**
+		 * [int - Play]
+		 * @brief	空いているボイス (無ければ奪ったボイス) で pSample を鳴らす
+		 * @param	[in] pSample Backend に渡すサンプル (同じサンプルを重ねて鳴らしてよい)
+		 * @param	[in] priority 大きいほど奪われにくい
+		 * @return	鳴らしたボイスの番号 (鳴らさなかった場合は INVALID_VOICE)
+		 */
+		int Play(const void* pSample, float volume, float pitch, int priority);
+
+		/**
+		 * [void - StopSample]
+		 * @brief	pSample を鳴らしているボイスを全て止める (サンプルを解放する前に呼ぶ)
+		 */
+		void StopSample(const void* pSample);
+
+		// 全てのボイスを止める
+		void StopAll();
+
+		int GetVoiceNum() const { return static_cast<int>(m_slots.size()); }
+		// 鳴っているボイスの数
+		int GetActiveNum() const;
+		const Stats& GetStats() const { return m_stats; }
+
+	private:
+		struct Slot
+		{
+			const void* pSample = nullptr;	// 鳴らしているサンプル (nullptr : 空き)
+			int priority = 0;
+			std::uint64_t order = 0;		// 鳴らし始めた順 (小さいほど古い)
+		};
+
+		// 鳴り終えていれば空きにする
+		bool IsFree(int voice) const;
+
+	private:
+		Backend* m_pBackend;
+		mutable std::vector<Slot> m_slots;
+		std::uint64_t m_order = 0;
+		Stats m_stats;
+	};
+}
+
+#endif // !___VOICE_POOL_H___
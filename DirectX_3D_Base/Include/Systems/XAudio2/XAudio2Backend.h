@@ -0,0 +1,44 @@
+﻿/*****************************************************************//**
+ * @file	XAudio2Backend.h
+ * @brief	XAudio2 のソースボイスで鳴らす AudioBackend
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：AudioVoice を XAudio2 のソースボイスで実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+#ifndef ___XAUDIO2_BACKEND_H___
+#define ___XAUDIO2_BACKEND_H___
+
+// ===== インクルード =====
+#include "Systems/Audio/AudioBackend.h"
+#include <xaudio2.h>
+
+namespace Audio
+{
+	/**
+	 * @class	XAudio2Backend
+	 * @brief	XAudio2 のソースボイスを作り、マスターボイスへ出力する
+	 */
+	class XAudio2Backend : public AudioBackend
+	{
+	public:
+		XAudio2Backend(IXAudio2* pXAudio2, IXAudio2MasteringVoice* pMasteringVoice);
+
+		std::unique_ptr<AudioVoice> CreateVoice(const WaveFormat& format, AudioVoice::Callback* pCallback) override;
+
+	private:
+		IXAudio2* m_pXAudio2;
+		UINT32 m_outputChannels = 2;	// マスターボイスのチャンネル数 (パンの出力行列に使う)
+	};
+}
+
+#endif // !___XAUDIO2_BACKEND_H___
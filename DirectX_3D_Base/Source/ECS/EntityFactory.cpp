@@ -23,6 +23,7 @@
 #include "ECS/ECSInitializer.h"
 #include "ECS/ECS.h" // すべてのコンポーネントとCoordinatorにアクセスするため
 #include "Main.h" // METERなどの定数にアクセス
+#include "Systems/AssetManifest.h"
 
 
 using namespace ECS;
@@ -126,22 +127,12 @@ EntityID EntityFactory::CreatePlayer(Coordinator* coordinator, const XMFLOAT3& p
  */
 EntityID EntityFactory::CreateCollectable(Coordinator* coordinator, const DirectX::XMFLOAT3& position, int orderIndex, const std::string& itemID)
 {
-	std::string modelPath = "M_TREASURE1";
+	std::string modelPath = GetCollectableModelID(itemID);
 	DirectX::XMFLOAT4 color = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	float rot = 0.0f;
 
-	if (itemID == "Takara_Daiya") { modelPath = "M_TREASURE1"; }
-	else if (itemID == "Takara_Crystal") { modelPath = "M_TREASURE2"; }
-	else if (itemID == "Takara_Yubiwa") { modelPath = "M_TREASURE3"; }
-	else if (itemID == "Takara_Kaiga1") { modelPath = "M_TREASURE4"; rot = 1.57f; }
-	else if (itemID == "Takara_Kaiga2") { modelPath = "M_TREASURE5"; rot = 1.57f; }
-	else if (itemID == "Takara_Kaiga3") { modelPath = "M_TREASURE6"; rot = 1.57f; }
-	else if (itemID == "Takara_Doki") { modelPath = "M_TREASURE7"; }
-	else if (itemID == "Takara_Tubo_Blue") { modelPath = "M_TREASURE8"; }
-	else if (itemID == "Takara_Tubo_Gouyoku") { modelPath = "M_TREASURE9"; }
-	else if (itemID == "Takara_Dinosaur") { modelPath = "M_TREASURE10"; }
-	else if (itemID == "Takara_Ammonite") { modelPath = "M_TREASURE11"; }
-	else if (itemID == "Takara_Dinosaur_Foot") { modelPath = "M_TREASURE12"; }
+	// 絵画は壁に立てかけるため倒して置く
+	if (itemID == "Takara_Kaiga1" || itemID == "Takara_Kaiga2" || itemID == "Takara_Kaiga3") { rot = 1.57f; }
 
 	ECS::EntityID entity = coordinator->CreateEntity(
 		TagComponent(
@@ -473,6 +464,84 @@ void ECS::EntityFactory::GenerateStageFromConfig(ECS::Coordinator* coordinator,
 //	CreatePlayer(coordinator, XMFLOAT3(2.5f, 0.0f, 2.5f));
 }
 
+/**
+ * [void - CollectStageAssets]
+ * @brief	ステージ生成 (MapGenerationSystem::CreateMap) で使われるアセットを列挙する
+ *
+ * @param	[in] stageId マップ設定のステージID
+ * @param	[out] manifest 追加先
+ * @note	生成処理と同じ ID・スケールを指定すること (モデルは最初に要求した設定で読み込まれる)
+ */
+void ECS::EntityFactory::CollectStageAssets(const std::string& stageId, Asset::AssetManifest& manifest)
+{
+	MapStageConfig config = MapConfigLoader::Load(stageId);
+
+	// 常に配置されるもの (プレイヤー・通路・壁・扉・警備員の出現位置)
+	manifest.AddModel("M_PLAYER", 0.1f, Model::None, { "A_PLAYER_IDLE", "A_PLAYER_RUN", "A_PLAYER_CAUGHT" });
+	manifest.AddModel("M_CORRIDOR", 0.25f, Model::None);
+	manifest.AddModel("M_WALL", 0.25f, Model::None);
+	manifest.AddModel("M_DOOR", 0.25f, Model::None, { "A_DOOR_OPEN", "A_DOOR_CLOSE" });
+	manifest.AddModel("M_GUARD", 0.1f, Model::None, { "A_GUARD_RUN", "A_GUARD_WALK", "A_GUARD_ATTACK" });
+	manifest.AddEffect("EFK_ALERT");
+	manifest.AddEffect("EFK_DOOR");
+	manifest.AddSound("SE_DOOR");
+
+	// 回収アイテム
+	if (config.items.empty())
+	{
+		manifest.AddModel(GetCollectableModelID(""), 0.1f, Model::None);
+	}
+	for (const auto& itemID : config.items)
+	{
+		manifest.AddModel(GetCollectableModelID(itemID), 0.1f, Model::None);
+	}
+	manifest.AddEffect("EFK_TREASURE_GLOW");
+
+	// ギミック
+	for (const auto& gimmick : config.gimmicks)
+	{
+		if (gimmick.count <= 0) continue;
+
+		if (gimmick.type == "Taser") { manifest.AddModel("M_TASER", 0.25f, Model::None); }
+		else if (gimmick.type == "Teleporter") { manifest.AddEffect("EFK_TELEPORT"); }
+		else if (gimmick.type == "Signboard") { manifest.AddModel("M_KANBAN", 0.1f, Model::None); }
+	}
+
+	// 賑やかしオブジェクト (配置は乱数で決まるため、全種類を読み込む)
+	manifest.AddModel("M_PUROPERA", 0.1f, Model::None);
+	manifest.AddModel("M_CAMERA", 0.25f, Model::None);
+	for (const auto& modelID : GetWallPaintingModelIDs())
+	{
+		manifest.AddModel(modelID, 0.15f, Model::None);
+	}
+}
+
+std::string ECS::EntityFactory::GetCollectableModelID(const std::string& itemID)
+{
+	if (itemID == "Takara_Daiya") { return "M_TREASURE1"; }
+	else if (itemID == "Takara_Crystal") { return "M_TREASURE2"; }
+	else if (itemID == "Takara_Yubiwa") { return "M_TREASURE3"; }
+	else if (itemID == "Takara_Kaiga1") { return "M_TREASURE4"; }
+	else if (itemID == "Takara_Kaiga2") { return "M_TREASURE5"; }
+	else if (itemID == "Takara_Kaiga3") { return "M_TREASURE6"; }
+	else if (itemID == "Takara_Doki") { return "M_TREASURE7"; }
+	else if (itemID == "Takara_Tubo_Blue") { return "M_TREASURE8"; }
+	else if (itemID == "Takara_Tubo_Gouyoku") { return "M_TREASURE9"; }
+	else if (itemID == "Takara_Dinosaur") { return "M_TREASURE10"; }
+	else if (itemID == "Takara_Ammonite") { return "M_TREASURE11"; }
+	else if (itemID == "Takara_Dinosaur_Foot") { return "M_TREASURE12"; }
+	return "M_TREASURE1";
+}
+
+const std::vector<std::string>& ECS::EntityFactory::GetWallPaintingModelIDs()
+{
+	static const std::vector<std::string> paintModels = {
+		"M_KAIGA_BIRD", "M_KAIGA_CAT", "M_KAIGA_PANCAKES","M_KAIGA_PENGUIN",
+		"M_KAIGA_ROSE", "M_KAIGA_SKELETON", "M_KAIGA_MAGICALGIRL", "M_KAIGA_SIBAKO"
+	};
+	return paintModels;
+}
+
 EntityID ECS::EntityFactory::CreateBasicCamera(Coordinator* coordinator, const DirectX::XMFLOAT3& position)
 {
 	EntityID entity = coordinator->CreateEntity(
@@ -24,6 +24,30 @@
 
 // O[oR[fBl[^̎擾OƂ
 
+/**
+ * @brief	fXgN^BV[̏IɁAĂP SE ~߂B
+ */
+AudioSystem::~AudioSystem()
+{
+	if (Audio::SoundEngine::s_instance)
+	{
+		Audio::SoundEngine::s_instance->StopOneShots();
+	}
+}
+
+/**
+ * [bool - PlayOneShot]
+ * @brief	P SE {CXv[璼ږ炷B
+ */
+bool AudioSystem::PlayOneShot(const Asset::AssetHandle& handle, float volume, float pitch, int priority)
+{
+	// ǂݍ݂Ȃǂݍ݂n߂ (ǂݍݍς݂ȂLbV̊mF̂)
+	Asset::AssetInfo* info = Asset::AssetManager::GetInstance().RequestSound(handle);
+	if (!info || !info->pResource) return false;
+
+	return static_cast<Audio::SoundEffect*>(info->pResource)->PlayOneShot(volume, pitch, priority);
+}
+
 /**
  * [void - UpdatePersistentSound]
  * @brief SoundComponent (iTEh) ̍XVWbNB
@@ -33,8 +57,13 @@ void AudioSystem::UpdatePersistentSound(ECS::EntityID entity)
 	// iTEh (BGM/Ambient/~\SE) ̃WbN
 	auto& soundComp = m_coordinator->GetComponent<SoundComponent>(entity);
 
-	Asset::AssetInfo* info = Asset::AssetManager::GetInstance().LoadSound(soundComp.assetID);
-	if (!info)
+	Asset::AssetInfo* info = Asset::AssetManager::GetInstance().RequestSound(soundComp.assetRef, soundComp.assetID);
+	if (info && info->state == Asset::LoadState::Pending)
+	{
+		// ǂݍݒ͗vێ܂܎̃t[
+		return;
+	}
+	if (!info || !info->pResource)
 	{
 		soundComp.isPlaying = false;
 		return;
@@ -101,8 +130,13 @@ void AudioSystem::UpdateOneShotSound(ECS::EntityID entity)
 	auto& oneShotComp = m_coordinator->GetComponent<OneShotSoundComponent>(entity);
 
 	// 1. AssetManagerSoundEffect\[X擾
-	Asset::AssetInfo* info = Asset::AssetManager::GetInstance().LoadSound(oneShotComp.assetID);
-	if (!info)
+	Asset::AssetInfo* info = Asset::AssetManager::GetInstance().RequestSound(oneShotComp.assetRef, oneShotComp.assetID);
+	if (info && info->state == Asset::LoadState::Pending)
+	{
+		// ǂݍݒ͔jɎ̃t[ōĐ
+		return;
+	}
+	if (!info || !info->pResource)
 	{
 		// [hsÃGeBeBj
 		m_entitiesToDestroy.insert(entity);
@@ -114,8 +148,8 @@ void AudioSystem::UpdateOneShotSound(ECS::EntityID entity)
 	// 2. ܂ĂȂ΍Đv (Play and Auto-Destroy Pattern)
 	if (!oneShotComp.processed)
 	{
-		// [vȂ (0) ōĐ
-		soundEffect->Play(0, oneShotComp.volume);
+		// {CXv[Ŗ炷 ( SE ĂĂ؂炸ɏd˂)
+		soundEffect->PlayOneShot(oneShotComp.volume);
 		oneShotComp.processed = true;
 		// ĐL[ɓ́ÃGeBeB̃t[Ŕj邽߂Ƀ}[N
 		// ł͑ɔjƑ̃VXeɉeo\邽߁A
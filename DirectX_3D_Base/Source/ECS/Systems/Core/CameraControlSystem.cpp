@@ -114,10 +114,9 @@ static bool RaycastToWall(
         }
         t = t_next;
 
-        if (currentGrid.x >= 0 && currentGrid.x < mapComp.gridSizeX &&
-            currentGrid.y >= 0 && currentGrid.y < mapComp.gridSizeY)
+        if (mapComp.grid.InBounds(currentGrid.x, currentGrid.y))
         {
-            if (mapComp.grid[currentGrid.y][currentGrid.x].type == CellType::Wall) {
+            if (!mapComp.grid.IsWalkable(currentGrid.x, currentGrid.y)) {
                 float t_adjust = t - CAMERA_SAFETY_OFFSET;
                 float t_min = mapComp.tileSize * 0.5f;
                 t_adjust = std::max(t_adjust, t_min);
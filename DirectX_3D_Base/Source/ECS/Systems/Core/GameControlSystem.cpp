@@ -87,6 +87,16 @@ void GameControlSystem::PlayStopableSE(const std::string& assetID, float volume)
     m_coordinator->GetComponent<SoundComponent>(entity).RequestPlay(volume, 0);
 }
 
+void GameControlSystem::PlayOneShotSE(Asset::AssetHandle& handle, const char* assetID, float volume, float pitch, int priority)
+{
+    auto audioSys = ECS::ECSInitializer::GetSystem<AudioSystem>();
+    if (!audioSys) return;
+
+    // ID からの検索は初回のみ (以降はハンドルで引く)
+    if (!handle.IsValid()) handle = Asset::AssetManager::GetInstance().FindSoundHandle(assetID);
+    audioSys->PlayOneShot(handle, volume, pitch, priority);
+}
+
 // 定数定義などの下、またはUpdate関数の直前あたりに静的変数を定義
 static GameMode s_prevMode = GameMode::SCOUTING_MODE; // 前フレームのモード
 static float s_modeSwitchCooldown = 0.0f;             // 切り替え防止タイマー
@@ -218,7 +228,8 @@ void GameControlSystem::UpdateGuardFootsteps(float deltaTime)
                 // �����_���Đ� (��1�b��1��)
                 if (rand() % 60 == 0) {
                     // ���C��: ��~�\��SE�Ƃ��čĐ� (�V�[���J�ڂŏ�����悤��)
-                    PlayStopableSE("SE_RUN", volume);
+                    // 重なっても前の足音を切らないようボイスプールで鳴らし、少しずつ高さを変える
+                    PlayOneShotSE(m_runSoundHandle, "SE_RUN", volume, 0.9f + 0.01f * static_cast<float>(rand() % 21), AudioSystem::PRIORITY_AMBIENT);
                 }
             }
         }
@@ -457,7 +468,7 @@ void GameControlSystem::UpdateVisualEffects(float deltaTime, ECS::EntityID contr
         m_footstepTimer += deltaTime;
         if (m_footstepTimer > 0.4f) {
             // ���C��: ��~�\��SE�Ƃ��čĐ� (SE_RUN)
-            PlayStopableSE("SE_RUN", 0.3f);
+            PlayOneShotSE(m_runSoundHandle, "SE_RUN", 0.3f, 1.0f, AudioSystem::PRIORITY_DEFAULT);
             m_footstepTimer = 0.0f;
         }
     }
@@ -634,7 +645,7 @@ void GameControlSystem::CreateStylePauseUI() {
     float w2 = baseH * 4.5f; float y2 = baseY + gapY;
     m_pauseItems.btnRetry = CreateStyledButton(GetXForY(y2), y2, w2, baseH, "BTN_RETRY_POSE", [this]() {
         EntityFactory::CreateOneShotSoundEntity(m_coordinator, "SE_DECISION", 0.5f);
-        m_pendingTransition = []() { SceneManager::ChangeScene<GameScene>(); }; m_pauseState = PauseState::AnimateOut;
+        m_pendingTransition = []() { SceneManager::ChangeSceneWithLoading<GameScene>(); }; m_pauseState = PauseState::AnimateOut;
         });
 
     float w3 = baseH * 4.5f; float y3 = baseY + gapY * 2.0f;
@@ -816,7 +827,7 @@ void GameControlSystem::UpdatePauseSequence(float deltaTime, ECS::EntityID contr
                 selX = trans.position.x - 220.0f;
 
                 if (m_lastHoveredID != btnID) {
-                    EntityFactory::CreateOneShotSoundEntity(m_coordinator, "SE_CURSOR", 0.5f);
+                    PlayOneShotSE(m_cursorSoundHandle, "SE_CURSOR", 0.5f, 1.0f, AudioSystem::PRIORITY_UI);
                     m_lastHoveredID = btnID;
                 }
             }
@@ -20,9 +20,11 @@
 // ===== インクルード =====
 #include "ECS/EntityFactory.h" 
 #include "ECS/ECS.h"
+#include "ECS/Systems/Gameplay/MapVisibility.h"
 #include "Systems/Geometory.h"
 
 #include <algorithm>
+#include <chrono>
 #include <random>
 #include <cmath>
 #include <map>
@@ -55,15 +57,77 @@ namespace DirectX {
 // MazeGenerator 実装
 // ===================================================================
 
+namespace
+{
+    /**
+     * @class   CellUnionFind
+     * @brief   セルインデックスに対する素集合データ構造 (迷路の連結判定用)
+     */
+    class CellUnionFind
+    {
+    public:
+        explicit CellUnionFind(int count)
+            : m_parent(count), m_size(count, 1)
+        {
+            for (int i = 0; i < count; ++i) m_parent[i] = i;
+        }
+
+        int Find(int index)
+        {
+            // 経路半減で木を平らに保つ
+            while (m_parent[index] != index)
+            {
+                m_parent[index] = m_parent[m_parent[index]];
+                index = m_parent[index];
+            }
+            return index;
+        }
+
+        void Unite(int a, int b)
+        {
+            a = Find(a);
+            b = Find(b);
+            if (a == b) return;
+            if (m_size[a] < m_size[b]) std::swap(a, b);
+            m_parent[b] = a;
+            m_size[a] += m_size[b];
+        }
+
+        int GetSetSize(int index) { return m_size[Find(index)]; }
+
+    private:
+        std::vector<int> m_parent;
+        std::vector<int> m_size;
+    };
+}
+
 // 静的メンバ変数の初期化
-std::mt19937 MazeGenerator::s_generator(std::random_device{}());
+thread_local std::mt19937 MazeGenerator::s_generator(std::random_device{}());
+std::uint32_t MazeGenerator::s_seedOverride = 0;
+
+/**
+ * [std::uint32_t - ResolveSeed]
+ * @brief	使用するシードを決定する (上書き > ステージ設定 > random_device の順)
+ */
+std::uint32_t MazeGenerator::ResolveSeed(const MapStageConfig& config)
+{
+    if (s_seedOverride != 0) return s_seedOverride;
+    if (config.seed != 0) return config.seed;
+
+    // 0 は「未指定」を表すため、ランダムに選んだ場合も 0 以外にする
+    std::uint32_t seed = std::random_device{}();
+    return (seed != 0) ? seed : 1u;
+}
 
 /**
  * @brief 迷路生成ロジックの本体。MapComponentのgridを書き換える。
  * @param mapComp - 迷路データを書き込むMapComponentへの参照
+ * @param outStats - 実行統計の出力先 (不要なら nullptr)
  */
-void MazeGenerator::Generate(MapComponent& mapComp, ItemTrackerComponent& trackerComp, const MapStageConfig& config)
+void MazeGenerator::Generate(MapComponent& mapComp, ItemTrackerComponent& trackerComp, const MapStageConfig& config, MazeGenerationStats* outStats)
 {
+    MazeGenerationStats stats;
+
     // configから動的な定数を取得
     const int GRID_SIZE_X = config.gridSizeX;
     const int GRID_SIZE_Y = config.gridSizeY;
@@ -80,21 +144,28 @@ void MazeGenerator::Generate(MapComponent& mapComp, ItemTrackerComponent& tracke
 
     int directions[4][2] = { { 0, 1 }, { 0, -1 }, { 1, 0 }, { -1, 0 } };
 
+    // 通路セル数の上限見積もり: バックトラッカーが掘る奇数座標の格子セルとその間の通路、
+    // 全ての部屋、部屋ごとに1つの接続用の壁。これでも下限に届かない設定では再試行しても結果は変わらない
+    const int latticeCellCount = ((GRID_SIZE_X - 1) / 2) * ((GRID_SIZE_Y - 1) / 2);
+    const int roomSide = (config.maxRoomSize / 2) * 2 + 1;
+    const int maxReachablePathCount = latticeCellCount * 2 - 1 + config.maxRoomCount * (roomSide * roomSide + 1);
+
+    int maxAttempts = MAX_GENERATION_ATTEMPTS;
+    if (maxReachablePathCount < MIN_PATH_COUNT)
+    {
+        printf("[Warning] minPathPercentage %.2f needs %d path cells but a %dx%d maze yields at most %d. Skipping retries.\n",
+            MIN_PATH_PERCENTAGE, MIN_PATH_COUNT, GRID_SIZE_X, GRID_SIZE_Y, maxReachablePathCount);
+        maxAttempts = 1;
+        stats.retriesSkipped = MAX_GENERATION_ATTEMPTS - 1;
+    }
+
     // 成功するまでマップ生成プロセスを繰り返す
-    for (int attempt = 0; attempt < MAX_GENERATION_ATTEMPTS; ++attempt)
+    for (int attempt = 0; attempt < maxAttempts; ++attempt)
     {
-        // 可変サイズに対応するため、gridをリサイズ
-        mapComp.grid.assign(GRID_SIZE_Y, std::vector<Cell>(GRID_SIZE_X));
+        ++stats.attempts;
 
-        // 全てのセルを未訪問(Unvisited)にリセット
-        for (int y = 0; y < GRID_SIZE_Y; ++y)
-        {
-            for (int x = 0; x < GRID_SIZE_X; ++x)
-            {
-                mapComp.grid[y][x].visited = false;
-                mapComp.grid[y][x].type = CellType::Wall; // 初期状態はすべて壁
-            }
-        }
+        // 可変サイズに対応するため、gridを確保 (全セルを未訪問の壁で初期化)
+        mapComp.grid.Assign(GRID_SIZE_X, GRID_SIZE_Y);
 
         // --------------------------------------------------------------------------------
         // 【ステップ5-2: 部屋配置ロジックの追加】
@@ -140,8 +211,8 @@ void MazeGenerator::Generate(MapComponent& mapComp, ItemTrackerComponent& tracke
                     // 境界からはみ出さないか最終チェック
                     if (x >= 0 && x < GRID_SIZE_X && y >= 0 && y < GRID_SIZE_Y)
                     {
-                        mapComp.grid[y][x].type = CellType::Room;
-                        mapComp.grid[y][x].visited = true; // 迷路生成アルゴリズムの対象外
+                        mapComp.grid.At(x, y).type = CellType::Room;
+                        mapComp.grid.At(x, y).visited = true; // 迷路生成アルゴリズムの対象外
                     }
                 }
             }
@@ -161,8 +232,8 @@ void MazeGenerator::Generate(MapComponent& mapComp, ItemTrackerComponent& tracke
         startY = 1;
 
         // 開始セルをPathとしてマークし、visitedをリセット
-        mapComp.grid[startY][startX].type = CellType::Path;
-        mapComp.grid[startY][startX].visited = false;
+        mapComp.grid.At(startX, startY).type = CellType::Path;
+        mapComp.grid.At(startX, startY).visited = false;
 
         RecursiveBacktracker(mapComp, config, startX, startY);
 
@@ -173,142 +244,119 @@ void MazeGenerator::Generate(MapComponent& mapComp, ItemTrackerComponent& tracke
         for (int i = 0; i < GRID_SIZE_X; ++i)
         {
             // 1. 上下の境界 (y=0 と y=MAX_INDEX_Y)
-            mapComp.grid[0][i].type = CellType::Wall;
-            mapComp.grid[0][i].visited = true;
+            mapComp.grid.At(i, 0).type = CellType::Wall;
+            mapComp.grid.At(i, 0).visited = true;
 
-            mapComp.grid[MAX_INDEX_Y][i].type = CellType::Wall;
-            mapComp.grid[MAX_INDEX_Y][i].visited = true;
+            mapComp.grid.At(i, MAX_INDEX_Y).type = CellType::Wall;
+            mapComp.grid.At(i, MAX_INDEX_Y).visited = true;
         }
         for (int i = 0; i < GRID_SIZE_Y; ++i)
         {
             // 2. 左右の境界 (x=0 と x=MAX_INDEX_X)
-            mapComp.grid[i][0].type = CellType::Wall;
-            mapComp.grid[i][0].visited = true;
+            mapComp.grid.At(0, i).type = CellType::Wall;
+            mapComp.grid.At(0, i).visited = true;
 
-            mapComp.grid[i][MAX_INDEX_X].type = CellType::Wall;
-            mapComp.grid[i][MAX_INDEX_X].visited = true;
+            mapComp.grid.At(MAX_INDEX_X, i).type = CellType::Wall;
+            mapComp.grid.At(MAX_INDEX_X, i).visited = true;
         }
 
         // --------------------------------------------------------------------------------
-        // 【確実な接続保証ロジック（Flood Fillによる連結成分の結合）】
+        // 【確実な接続保証ロジック（Union-Findによる連結成分の結合）】
         // --------------------------------------------------------------------------------
-        bool mapWasConnected = false;
+        // 外周を除く非壁セルを隣接同士で結合しておき、壁を掘るたびに成分を併合する。
+        // 到達判定は Find の比較だけで済むため、Flood Fill を掘るたびにやり直す必要はない。
+        CellUnionFind cellSets(GRID_SIZE_X * GRID_SIZE_Y);
+        int openCellCount = 0;      // 連結判定の対象セル数 (壁以外)
+        int totalPathCells = 0;     // 品質チェック用の通路/部屋セル数 (壁・未訪問以外)
 
-        // 接続プロセスを最大でGRID_SIZE分繰り返す
-        for (int connection_iter = 0; connection_iter < GRID_SIZE_X + GRID_SIZE_Y; ++connection_iter)
+        for (int y = 1; y < MAX_INDEX_Y; ++y)
         {
-            bool wallDestroyed = false;
-
-            // a) Flood Fillのための visitedフラグをリセット
-            for (int y = 0; y < GRID_SIZE_Y; ++y)
+            for (int x = 1; x < MAX_INDEX_X; ++x)
             {
-                for (int x = 0; x < GRID_SIZE_X; ++x)
-                {
-                    if (mapComp.grid[y][x].type != CellType::Wall)
-                    {
-                        mapComp.grid[y][x].visited = false;
-                    }
-                }
-            }
+                const CellType type = mapComp.grid.At(x, y).type;
+                if (type == CellType::Wall) continue;
 
-            // スタート位置を一時的に設定（スタート/ゴール配置前の暫定処理）
-            XMINT2 tempStartPos = { startX, startY };
+                ++openCellCount;
+                if (type != CellType::Unvisited) ++totalPathCells;
 
-            // b) Flood Fill (BFS) を実行: スタートから到達可能なセルをマーク
-            std::vector<XMINT2> bfs_queue;
-            bfs_queue.push_back(tempStartPos);
-            mapComp.grid[tempStartPos.y][tempStartPos.x].visited = true;
-
-            size_t head = 0;
-            while (head < bfs_queue.size())
-            {
-                XMINT2 current = bfs_queue[head++];
+                const int index = mapComp.grid.GetIndex(x, y);
+                if (x - 1 > 0 && mapComp.grid.At(x - 1, y).type != CellType::Wall) cellSets.Unite(index, index - 1);
+                if (y - 1 > 0 && mapComp.grid.At(x, y - 1).type != CellType::Wall) cellSets.Unite(index, index - GRID_SIZE_X);
+            }
+        }
 
-                for (int i = 0; i < 4; ++i)
-                {
-                    int nx = current.x + directions[i][0];
-                    int ny = current.y + directions[i][1];
+        // スタート位置を一時的に設定（スタート/ゴール配置前の暫定処理）
+        const int startIndex = mapComp.grid.GetIndex(startX, startY);
 
-                    // 境界チェックにMAX_INDEX_X, MAX_INDEX_Yを使用
-                    if (nx > 0 && nx < MAX_INDEX_X && ny > 0 && ny < MAX_INDEX_Y &&
-                        mapComp.grid[ny][nx].type != CellType::Wall &&
-                        !mapComp.grid[ny][nx].visited)
-                    {
-                        mapComp.grid[ny][nx].visited = true;
-                        bfs_queue.push_back({ nx, ny });
-                    }
-                }
-            }
+        // 未到達エリアと到達エリアを繋ぐ壁を走査順に破壊する。
+        // 1パスで全ての成分が繋がらない場合 (後から到達エリアに接した壁がある場合) だけ再走査する
+        bool wallDestroyed = true;
+        while (wallDestroyed && cellSets.GetSetSize(startIndex) < openCellCount)
+        {
+            wallDestroyed = false;
 
-            // c) 接続の試行: 未到達エリアと到達エリアを繋ぐ壁を探して破壊
             // 境界チェックにMAX_INDEX_X, MAX_INDEX_Yを使用
             for (int y = 1; y < MAX_INDEX_Y; ++y)
             {
                 for (int x = 1; x < MAX_INDEX_X; ++x)
                 {
-                    if (mapComp.grid[y][x].type == CellType::Wall)
+                    if (mapComp.grid.At(x, y).type != CellType::Wall) continue;
+
+                    const int startRoot = cellSets.Find(startIndex);
+                    bool bordersReachable = false;
+                    bool bordersUnreachable = false;
+
+                    for (int i = 0; i < 4; ++i)
                     {
-                        bool bordersReachable = false;
-                        bool bordersUnreachable = false;
+                        int nx = x + directions[i][0];
+                        int ny = y + directions[i][1];
 
-                        for (int i = 0; i < 4; ++i)
+                        if (nx > 0 && nx < MAX_INDEX_X && ny > 0 && ny < MAX_INDEX_Y &&
+                            mapComp.grid.At(nx, ny).type != CellType::Wall)
                         {
-                            int nx = x + directions[i][0];
-                            int ny = y + directions[i][1];
-
-                            // 境界チェックにMAX_INDEX_X, MAX_INDEX_Yを使用
-                            if (nx > 0 && nx < MAX_INDEX_X && ny > 0 && ny < MAX_INDEX_Y &&
-                                mapComp.grid[ny][nx].type != CellType::Wall)
-                            {
-                                if (mapComp.grid[ny][nx].visited) bordersReachable = true;
-                                else bordersUnreachable = true;
-                            }
+                            if (cellSets.Find(mapComp.grid.GetIndex(nx, ny)) == startRoot) bordersReachable = true;
+                            else bordersUnreachable = true;
                         }
+                    }
+
+                    if (!bordersReachable || !bordersUnreachable) continue;
+
+                    // 壁を掘り、隣接する全ての成分と併合する
+                    mapComp.grid.At(x, y).type = CellType::Path;
+                    ++openCellCount;
+                    ++totalPathCells;
+                    ++stats.wallsCarved;
+                    wallDestroyed = true;
 
-                        if (bordersReachable && bordersUnreachable)
+                    const int index = mapComp.grid.GetIndex(x, y);
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        int nx = x + directions[i][0];
+                        int ny = y + directions[i][1];
+
+                        if (nx > 0 && nx < MAX_INDEX_X && ny > 0 && ny < MAX_INDEX_Y &&
+                            mapComp.grid.At(nx, ny).type != CellType::Wall)
                         {
-                            mapComp.grid[y][x].type = CellType::Path;
-                            wallDestroyed = true;
-                            // 接続が発生したため、内側のループを抜けて Flood Fill の再実行へ
-                            goto restart_connection_loop;
+                            cellSets.Unite(index, mapComp.grid.GetIndex(nx, ny));
                         }
                     }
                 }
             }
-
-        restart_connection_loop:;
-
-            if (!wallDestroyed)
-            {
-                mapWasConnected = true;
-                break; // 完全に接続された
-            }
         }
 
+        const bool mapWasConnected = (cellSets.GetSetSize(startIndex) == openCellCount);
+
         // --------------------------------------------------------------------------------
         // 【BUG-01修正強化: 品質チェックと再試行】
         // --------------------------------------------------------------------------------
 
-        // 1. 通路/部屋セルの総数をカウント
-        int totalPathCells = 0;
-        for (int y = 0; y < GRID_SIZE_Y; ++y)
-        {
-            for (int x = 0; x < GRID_SIZE_X; ++x)
-            {
-                if (mapComp.grid[y][x].type != CellType::Wall && mapComp.grid[y][x].type != CellType::Unvisited)
-                {
-                    totalPathCells++;
-                }
-            }
-        }
-
-        // 2. 迷路の密度が低すぎる（ほぼ壁）の場合、再試行
+        // 1. 迷路の密度が低すぎる（ほぼ壁）の場合、再試行
         if (totalPathCells < MIN_PATH_COUNT)
         {
             continue; // for ループの先頭に戻り、新しいマップ生成を試みる
         }
 
-        // 3. 接続性の最終チェック (Flood Fillが成功しているか)
+        // 2. 接続性の最終チェック (全ての非壁セルがスタートと同じ成分か)
         if (!mapWasConnected)
         {
             // 非常に稀なケースだが、接続が保証されない場合は再試行
@@ -323,6 +371,10 @@ void MazeGenerator::Generate(MapComponent& mapComp, ItemTrackerComponent& tracke
 
 end_generate_loop:;
 
+    printf("[Info] MazeGenerator: %d attempt(s), %d wall(s) carved for connectivity, %d retries skipped\n",
+        stats.attempts, stats.wallsCarved, stats.retriesSkipped);
+    if (outStats) *outStats = stats;
+
     // --------------------------------------------------------------------------------
     // 【ステップ2-1: 行き止まり（袋小路）除去ロジックの導入】
     // --------------------------------------------------------------------------------
@@ -347,7 +399,7 @@ end_generate_loop:;
             for (int x = 1; x < MAX_INDEX_X; ++x)
             {
                 // Roomも開通していると見なすため、Pathのみを対象とする
-                if (mapComp.grid[y][x].type != CellType::Path) continue;
+                if (mapComp.grid.At(x, y).type != CellType::Path) continue;
 
                 int openDirections = 0;
                 // 1マス先の隣接セルをチェック (前回修正されたロジック)
@@ -358,7 +410,7 @@ end_generate_loop:;
 
                     if (nx > 0 && nx < MAX_INDEX_X && ny > 0 && ny < MAX_INDEX_Y)
                     {
-                        CellType type = mapComp.grid[ny][nx].type;
+                        CellType type = mapComp.grid.At(nx, ny).type;
                         if (type == CellType::Path || type == CellType::Room || type == CellType::Start || type == CellType::Goal)
                         {
                             openDirections++;
@@ -379,7 +431,7 @@ end_generate_loop:;
         // 2. 検出された全てのデッドエンドを順番に処理する
         for (const auto& targetDeadEnd : deadEndCandidates)
         {
-            if (mapComp.grid[targetDeadEnd.y][targetDeadEnd.x].type != CellType::Path) continue;
+            if (mapComp.grid.At(targetDeadEnd.x, targetDeadEnd.y).type != CellType::Path) continue;
 
             // ----------------------------------------------------------------------------------
             // 3. 行き止まりセルから、最も近い Path/Room への接続経路を BFS で検索
@@ -398,7 +450,7 @@ end_generate_loop:;
                 if (nx > 0 && nx < MAX_INDEX_X && ny > 0 && ny < MAX_INDEX_Y)
                 {
                     XMINT2 neighbor = { nx, ny };
-                    CellType neighborType = mapComp.grid[ny][nx].type;
+                    CellType neighborType = mapComp.grid.At(nx, ny).type;
 
                     // もし隣接セルがPath/Roomの場合、それがデッドエンドの真の根元である
                     if (neighborType == CellType::Path || neighborType == CellType::Room || neighborType == CellType::Start || neighborType == CellType::Goal)
@@ -429,7 +481,7 @@ end_generate_loop:;
                 // 接続ターゲットの発見チェック (自身は除く)
                 if (current.x != targetDeadEnd.x || current.y != targetDeadEnd.y)
                 {
-                    CellType type = mapComp.grid[current.y][current.x].type;
+                    CellType type = mapComp.grid.At(current.x, current.y).type;
                     if (type == CellType::Path || type == CellType::Room)
                     {
                         foundTarget = current;
@@ -448,7 +500,7 @@ end_generate_loop:;
                         XMINT2 neighbor = { nx, ny };
                         if (visitedSet.find(neighbor) == visitedSet.end())
                         {
-                            CellType type = mapComp.grid[ny][nx].type;
+                            CellType type = mapComp.grid.At(nx, ny).type;
 
                             if (type != CellType::Unvisited)
                             {
@@ -478,7 +530,7 @@ end_generate_loop:;
                     XMINT2 parent = parentMap[current];
 
                     // currentが壁セルで、かつ親がデッドエンドではない場合（デッドエンド側から見て最初の壁を探す）
-                    if (mapComp.grid[current.y][current.x].type == CellType::Wall)
+                    if (mapComp.grid.At(current.x, current.y).type == CellType::Wall)
                     {
                         wallToDestroy = current; // ターゲットに最も近い壁を一旦保持
                     }
@@ -487,7 +539,7 @@ end_generate_loop:;
                     if (parent.x == targetDeadEnd.x && parent.y == targetDeadEnd.y)
                     {
                         // デッドエンドに隣接する最後のセルが壁であればそれを破壊
-                        if (mapComp.grid[current.y][current.x].type == CellType::Wall)
+                        if (mapComp.grid.At(current.x, current.y).type == CellType::Wall)
                         {
                             wallToDestroy = current;
                         }
@@ -500,7 +552,7 @@ end_generate_loop:;
                 // 5. 壁の破壊
                 if (wallToDestroy.x != -1)
                 {
-                    mapComp.grid[wallToDestroy.y][wallToDestroy.x].type = CellType::Path;
+                    mapComp.grid.At(wallToDestroy.x, wallToDestroy.y).type = CellType::Path;
                     deadEndsWereProcessed = true;
                     totalDeadEndsResolved++;
                     printf("Resolved dead end at (%d, %d) by destroying wall at (%d, %d). Total resolved: %d\n",
@@ -524,7 +576,7 @@ end_generate_loop:;
         for (int x = 1; x < MAX_INDEX_X; ++x)
         {
             // WallでもUnvisitedでもない (Path/Room) セルを候補とする
-            if (mapComp.grid[y][x].type != CellType::Wall && mapComp.grid[y][x].type != CellType::Unvisited) {
+            if (mapComp.grid.At(x, y).type != CellType::Wall && mapComp.grid.At(x, y).type != CellType::Unvisited) {
 
                 // 全ての有効なセルを候補に追加
                 spawnablePositions.push_back({ x, y });
@@ -574,8 +626,8 @@ end_generate_loop:;
     }
 
     // 3. セルタイプを更新
-    mapComp.grid[mapComp.startPos.y][mapComp.startPos.x].type = CellType::Start;
-    mapComp.grid[mapComp.goalPos.y][mapComp.goalPos.x].type = CellType::Goal;
+    mapComp.grid.At(mapComp.startPos.x, mapComp.startPos.y).type = CellType::Start;
+    mapComp.grid.At(mapComp.goalPos.x, mapComp.goalPos.y).type = CellType::Goal;
 
     // --------------------------------------------------------------------------------
     // 【ステップ2-3: アイテムと警備員の配置ロジック】
@@ -588,7 +640,7 @@ end_generate_loop:;
         for (int x = 0; x < GRID_SIZE_X; ++x)
         {
             // 通路であり、かつスタート・ゴールではない位置を候補とする
-            if (mapComp.grid[y][x].type == CellType::Path)
+            if (mapComp.grid.At(x, y).type == CellType::Path)
             {
                 availablePathPositions.push_back({ x, y });
             }
@@ -610,7 +662,7 @@ end_generate_loop:;
         XMINT2 pos = availablePathPositions.back();
         availablePathPositions.pop_back(); // 使用した座標はリストから削除
 
-        mapComp.grid[pos.y][pos.x].type = CellType::Item;
+        mapComp.grid.At(pos.x, pos.y).type = CellType::Item;
         mapComp.itemPositions.push_back(pos); // ItemComponentで管理するために位置情報を保存
     }
 
@@ -623,7 +675,7 @@ end_generate_loop:;
         XMINT2 pos = availablePathPositions.back();
         availablePathPositions.pop_back();
 
-        mapComp.grid[pos.y][pos.x].type = CellType::Guard;
+        mapComp.grid.At(pos.x, pos.y).type = CellType::Guard;
         guardsPlaced++;
     }
 
@@ -641,7 +693,7 @@ end_generate_loop:;
                 XMINT2 pos = availablePathPositions.back();
                 availablePathPositions.pop_back();
 
-                mapComp.grid[pos.y][pos.x].type = CellType::Taser;
+                mapComp.grid.At(pos.x, pos.y).type = CellType::Taser;
                 placedCount++;
             }
             // --- [Case: Teleporter] ---
@@ -661,8 +713,8 @@ end_generate_loop:;
                 availablePathPositions.pop_back();
 
                 // グリッドにテレポート属性を設定
-                mapComp.grid[posA.y][posA.x].type = CellType::Teleporter;
-                mapComp.grid[posB.y][posB.x].type = CellType::Teleporter;
+                mapComp.grid.At(posA.x, posA.y).type = CellType::Teleporter;
+                mapComp.grid.At(posB.x, posB.y).type = CellType::Teleporter;
 
                 mapComp.teleportPairs.push_back({ posA, posB });
                 placedCount++;
@@ -676,7 +728,7 @@ end_generate_loop:;
                 availablePathPositions.pop_back();
 
                 // グリッド情報を書き換え
-                mapComp.grid[pos.y][pos.x].type = CellType::StopTrap;
+                mapComp.grid.At(pos.x, pos.y).type = CellType::StopTrap;
                 placedCount++;
             }
             // --- [Case: その他 (将来的な拡張)] ---
@@ -688,6 +740,9 @@ end_generate_loop:;
             }
         }
     }
+
+    // 経路探索・レイキャスト用の通行可能マスクを確定させる
+    mapComp.grid.RebuildWalkableMask();
 }
 
 /**
@@ -702,10 +757,10 @@ void MazeGenerator::RecursiveBacktracker(MapComponent& mapComp, const MapStageCo
     const int GRID_SIZE_Y = config.gridSizeY;
 
     // 現在のセルを訪問済みとしてマーク
-    mapComp.grid[y][x].visited = true;
-    if (mapComp.grid[y][x].type != CellType::Room)
+    mapComp.grid.At(x, y).visited = true;
+    if (mapComp.grid.At(x, y).type != CellType::Room)
     {
-        mapComp.grid[y][x].type = CellType::Path; // 通路を掘る
+        mapComp.grid.At(x, y).type = CellType::Path; // 通路を掘る
     }
 
     // 進行方向の候補 (dx, dy) を定義 (北, 東, 南, 西)
@@ -736,10 +791,10 @@ void MazeGenerator::RecursiveBacktracker(MapComponent& mapComp, const MapStageCo
         // 境界チェック (nx, ny がグリッド内か)
         if (nx >= 0 && nx < GRID_SIZE_X && ny >= 0 && ny < GRID_SIZE_Y)
         {
-            if (!mapComp.grid[ny][nx].visited)
+            if (!mapComp.grid.At(nx, ny).visited)
             {
                 // 間の壁セルを通路にする
-                mapComp.grid[wallY][wallX].type = CellType::Path; // 間のセルを通路として掘る
+                mapComp.grid.At(wallX, wallY).type = CellType::Path; // 間のセルを通路として掘る
 
                 // 次のセルへ進む
                 RecursiveBacktracker(mapComp, config, nx, ny); // <--- configを渡す
@@ -749,54 +804,143 @@ void MazeGenerator::RecursiveBacktracker(MapComponent& mapComp, const MapStageCo
 }
 
 // ===================================================================
-// MapGenerationSystem 実装
+// MapPrefetcher 実装
 // ===================================================================
 
+std::string MapPrefetcher::s_pendingStageID;
+std::future<StagedMap> MapPrefetcher::s_pending;
+
 /**
- * [void - CreateMap]
- * @brief	マップ生成システムを初期化し、迷路を生成する。
- * 
- * @param	[in] stageID 読み込むステージ設定のID
+ * [void - Request]
+ * @brief	指定ステージの生成をワーカースレッドで開始する (同じステージが生成中なら何もしない)
+ *
+ * @param	[in] stageID 生成するステージのID
  */
-void MapGenerationSystem::CreateMap(const std::string& stageID)
+void MapPrefetcher::Request(const std::string& stageID)
 {
-    // 1. 設定の読み込み
-    MapStageConfig config = MapConfigLoader::Load(stageID);
+    if (s_pending.valid() && s_pendingStageID == stageID) return;
 
-    // MapComponentを持つエンティティは一つだけとする
-    EntityID mapEntity = FindFirstEntityWithComponent<MapComponent>(m_coordinator);
+    // 別ステージの生成中であれば、その完了を待ってから置き換える (1ステージ数ms程度)
+    s_pendingStageID = stageID;
+    s_pending = std::async(std::launch::async, [stageID]() { return MapPrefetcher::Build(stageID); });
+}
 
-    // 見つからなかった場合は、専用のエンティティを生成してアタッチ
-    if (mapEntity == INVALID_ENTITY_ID) return;
+/**
+ * [StagedMap - Take]
+ * @brief	指定ステージの生成結果を受け取る。先行生成が無ければこの場で生成する
+ *
+ * @param	[in] stageID 受け取るステージのID
+ * @return	生成済みのマップ
+ */
+StagedMap MapPrefetcher::Take(const std::string& stageID)
+{
+    if (s_pending.valid())
+    {
+        const bool isMatch = (s_pendingStageID == stageID);
+        StagedMap staged = s_pending.get();
+        s_pendingStageID.clear();
 
-    auto& mapComp = m_coordinator->GetComponent<MapComponent>(mapEntity);
-    auto& trackerComp = m_coordinator->GetComponent<ItemTrackerComponent>(mapEntity);
-    auto& stateComp = m_coordinator->GetComponent<GameStateComponent>(mapEntity);
+        if (isMatch)
+        {
+            printf("[Info] Using prefetched map for %s\n", stageID.c_str());
+            return staged;
+        }
+    }
 
-    stateComp.timeLimitStar = config.timeLimitStar;
-    trackerComp.targetItemIDs.clear();
-    mapComp.teleportPairs.clear();
-    mapComp.itemPositions.clear();
+    return Build(stageID);
+}
+
+/**
+ * [StagedMap - Build]
+ * @brief	設定の読込から迷路生成までを行う (どのスレッドからでも呼べる)
+ *
+ * @param	[in] stageID 生成するステージのID
+ * @return	生成済みのマップ
+ */
+StagedMap MapPrefetcher::Build(const std::string& stageID)
+{
+    StagedMap staged;
+    staged.stageID = stageID;
+
+    // 1. 設定の読み込み
+    staged.config = MapConfigLoader::Load(stageID);
+    const MapStageConfig& config = staged.config;
 
     // 2. 迷路データの生成
     // MapComponent内に設定情報がコピーされる
+    MapComponent& mapComp = staged.map;
     mapComp.gridSizeX = config.gridSizeX;
     mapComp.gridSizeY = config.gridSizeY;
     mapComp.tileSize = config.tileSize;
     mapComp.wallHeight = config.wallHeight;
     mapComp.startPos = { 1, 1 };
     mapComp.goalPos = { config.gridSizeX - 2, config.gridSizeY - 2 };
+
+    ItemTrackerComponent& trackerComp = staged.tracker;
     trackerComp.useOrderedCollection = config.useOrderedCollection;
     trackerComp.currentTargetOrder = 1;
     trackerComp.collectedItems = 0;
     trackerComp.totalItems = 0;
 
+    // 生成と配置の乱数を同じシードから引くことで、同じシードなら同じステージを再現できる
+    mapComp.seed = MazeGenerator::ResolveSeed(config);
+    MazeGenerator::Seed(mapComp.seed);
+
+    const auto generateBegin = std::chrono::steady_clock::now();
     MazeGenerator::Generate(mapComp, trackerComp, config);
+    const auto generateEnd = std::chrono::steady_clock::now();
+    staged.generateMs = std::chrono::duration<float, std::milli>(generateEnd - generateBegin).count();
+
+    // Entity配置はメインスレッドの生成機で行うため、ここまでの乱数状態を引き渡す
+    staged.generator = MazeGenerator::s_generator;
+
+    printf("[Info] Maze generated: %dx%d grid, seed %u, %.2f ms\n", config.gridSizeX, config.gridSizeY, mapComp.seed, staged.generateMs);
+    return staged;
+}
+
+// ===================================================================
+// MapGenerationSystem 実装
+// ===================================================================
+
+/**
+ * [void - CreateMap]
+ * @brief	マップ生成システムを初期化し、迷路を生成する。
+ * 
+ * @param	[in] stageID 読み込むステージ設定のID
+ */
+void MapGenerationSystem::CreateMap(const std::string& stageID)
+{
+    // MapComponentを持つエンティティは一つだけとする
+    EntityID mapEntity = FindFirstEntityWithComponent<MapComponent>(m_coordinator);
+
+    // 見つからなかった場合は、専用のエンティティを生成してアタッチ
+    if (mapEntity == INVALID_ENTITY_ID) return;
+
+    // 1. 迷路データの取得 (ステージ選択中に先行生成していればその結果を受け取る)
+    StagedMap staged = MapPrefetcher::Take(stageID);
+    const MapStageConfig& config = staged.config;
+
+    auto& mapComp = m_coordinator->GetComponent<MapComponent>(mapEntity);
+    auto& trackerComp = m_coordinator->GetComponent<ItemTrackerComponent>(mapEntity);
+    auto& stateComp = m_coordinator->GetComponent<GameStateComponent>(mapEntity);
+
+    // 2. 生成済みのバッファをコンポーネントへ入れ替える
+    stateComp.timeLimitStar = config.timeLimitStar;
+    mapComp = std::move(staged.map);
+    trackerComp = std::move(staged.tracker);
+    MazeGenerator::s_generator = staged.generator;
+
+    // 警備員の視界判定用に、セル間可視テーブルの構築をワーカースレッドで開始
+    // (Entity配置と並行して進み、完了までは GuardAISystem がレイキャストで代替する)
+    mapComp.visibility = MapVisibility::BuildAsync(mapComp);
 
     m_itemSpawnIndex = 0;
 
     // 3. 3D空間へのEntity配置
+    const auto spawnBegin = std::chrono::steady_clock::now();
     SpawnMapEntities(mapComp, config);
+    const auto spawnEnd = std::chrono::steady_clock::now();
+    printf("[Info] Map entities spawned: %.2f ms\n", std::chrono::duration<float, std::milli>(spawnEnd - spawnBegin).count());
 }
 
 /**
@@ -864,7 +1008,7 @@ void MapGenerationSystem::DrawDebugLines()
         for (int x = 0; x < GRID_SIZE_X; ++x)
         {
             // 現在のセルタイプ
-            CellType currentType = mapComp.grid[y][x].type;
+            CellType currentType = mapComp.grid.At(x, y).type;
 
             // 壁または未訪問のセルは描画対象外
             if (currentType == CellType::Wall || currentType == CellType::Unvisited)
@@ -875,7 +1019,7 @@ void MapGenerationSystem::DrawDebugLines()
             // 1. 北側の境界線 (y-1)
             if (y > 0)
             {
-                CellType neighborType = mapComp.grid[y - 1][x].type;
+                CellType neighborType = mapComp.grid.At(x, y - 1).type;
                 if (neighborType == CellType::Wall)
                 {
                     XMFLOAT3 start = GetWorldPosition(x, y, tempConfig); // <--- tempConfigを渡す
@@ -891,7 +1035,7 @@ void MapGenerationSystem::DrawDebugLines()
             // 2. 東側の境界線 (x+1)
             if (x < GRID_SIZE_X - 1)
             {
-                CellType neighborType = mapComp.grid[y][x + 1].type;
+                CellType neighborType = mapComp.grid.At(x + 1, y).type;
                 if (neighborType == CellType::Wall)
                 {
                     XMFLOAT3 start = GetWorldPosition(x, y, tempConfig); // <--- tempConfigを渡す
@@ -908,7 +1052,7 @@ void MapGenerationSystem::DrawDebugLines()
             // 3. 南側の境界線 (y+1)
             if (y < GRID_SIZE_Y - 1)
             {
-                CellType neighborType = mapComp.grid[y + 1][x].type;
+                CellType neighborType = mapComp.grid.At(x, y + 1).type;
                 if (neighborType == CellType::Wall)
                 {
                     XMFLOAT3 start = GetWorldPosition(x, y, tempConfig); // <--- tempConfigを渡す
@@ -925,7 +1069,7 @@ void MapGenerationSystem::DrawDebugLines()
             // 4. 西側の境界線 (x-1)
             if (x > 0)
             {
-                CellType neighborType = mapComp.grid[y][x - 1].type;
+                CellType neighborType = mapComp.grid.At(x - 1, y).type;
                 if (neighborType == CellType::Wall)
                 {
                     XMFLOAT3 start = GetWorldPosition(x, y, tempConfig); // <--- tempConfigを渡す
@@ -994,7 +1138,7 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
                 // ここではデバッグのため「壁ならOK」としつつ、外周優先にするロジックも考えられるが、
                 // まずは isOuter && Wall で見つかるはず。見つからないなら nx, ny の計算か Wall 判定が怪しい。
 
-                if (isOuter && mapComp.grid[ny][nx].type == CellType::Wall)
+                if (isOuter && mapComp.grid.At(nx, ny).type == CellType::Wall)
                 {
                     // 座標計算
                     XMFLOAT3 basePos = GetWorldPosition(nx, ny, config);
@@ -1051,8 +1195,8 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
     {
         for (int x = 0; x < GRID_SIZE_X; ++x)
         {
-            if (mapComp.grid[y][x].type == CellType::Wall ||
-                mapComp.grid[y][x].type == CellType::Unvisited ||
+            if (mapComp.grid.At(x, y).type == CellType::Wall ||
+                mapComp.grid.At(x, y).type == CellType::Unvisited ||
                 processed[y][x])
             {
                 continue;
@@ -1093,7 +1237,7 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
     {
         for (int x = 0; x < GRID_SIZE_X; ++x)
         {
-            if (mapComp.grid[y][x].type != CellType::Wall || processed[y][x]) continue;
+            if (mapComp.grid.At(x, y).type != CellType::Wall || processed[y][x]) continue;
 
             // 座標計算
             XMFLOAT3 basePos = GetWorldPosition(x, y, config);
@@ -1123,7 +1267,7 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
     {
         for (int x = 0; x < GRID_SIZE_X; ++x) // GRID_SIZE_X を使用
         {
-            Cell& cell = mapComp.grid[y][x];
+            Cell& cell = mapComp.grid.At(x, y);
 
             switch (cell.type)
             {
@@ -1231,19 +1375,16 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
     // --------------------------------------------------------------------
 
     // 絵画のバリエーション
-    std::vector<std::string> paintModels = {
-        "M_KAIGA_BIRD", "M_KAIGA_CAT", "M_KAIGA_PANCAKES","M_KAIGA_PENGUIN",
-        "M_KAIGA_ROSE", "M_KAIGA_SKELETON", "M_KAIGA_MAGICALGIRL", "M_KAIGA_SIBAKO"
-    };
+    const std::vector<std::string>& paintModels = EntityFactory::GetWallPaintingModelIDs();
 
     // A. 天井プロペラ (通路の天井に配置)
     for (int y = 1; y < GRID_SIZE_Y - 1; ++y) {
         for (int x = 1; x < GRID_SIZE_X - 1; ++x) {
-            CellType type = mapComp.grid[y][x].type;
+            CellType type = mapComp.grid.At(x, y).type;
             // 通路または部屋の場合
             if (type == CellType::Path || type == CellType::Room) {
                 // 5%の確率で配置
-                if (rand() % 100 < 5) {
+                if (MazeGenerator::RandomInt(0, 99) < 5) {
                     XMFLOAT3 pos = GetWorldPosition(x, y, config);
                     pos.x += TILE_SIZE / 2.0f;
                     pos.z += TILE_SIZE / 2.0f;
@@ -1284,14 +1425,14 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
         for (int y = 1; y < GRID_SIZE_Y - 1; ++y) {
             for (int x = 1; x < GRID_SIZE_X - 1; ++x) {
                 // 通路セルのみ対象
-                if (mapComp.grid[y][x].type == CellType::Path) {
+                if (mapComp.grid.At(x, y).type == CellType::Path) {
 
                     // 隣接する壁を探す
                     std::vector<int> validWallDirs;
                     for (int i = 0; i < 4; ++i) {
                         int nx = x + dx[i];
                         int ny = y + dy[i];
-                        if (mapComp.grid[ny][nx].type == CellType::Wall) {
+                        if (mapComp.grid.At(nx, ny).type == CellType::Wall) {
                             validWallDirs.push_back(i);
                         }
                     }
@@ -1299,7 +1440,7 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
                     // 壁に隣接している場合、候補に追加
                     if (!validWallDirs.empty()) {
                         // 1つのセルに複数の壁がある場合、ランダムに1つ選んで配置候補とする（1セル1看板制限）
-                        int dirIdx = validWallDirs[rand() % validWallDirs.size()];
+                        int dirIdx = validWallDirs[MazeGenerator::RandomInt(0, (int)validWallDirs.size() - 1)];
 
                         // 座標計算
                         DirectX::XMFLOAT3 pos = GetWorldPosition(x, y, config);
@@ -1320,9 +1461,7 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
         }
 
         // 候補をシャッフルして、指定数だけ生成
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(candidates.begin(), candidates.end(), g);
+        std::shuffle(candidates.begin(), candidates.end(), MazeGenerator::s_generator);
 
         for (int i = 0; i < signboardCount && i < candidates.size(); ++i) {
             auto& c = candidates[i];
@@ -1339,16 +1478,16 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
 
     for (int y = 1; y < GRID_SIZE_Y - 1; ++y) {
         for (int x = 1; x < GRID_SIZE_X - 1; ++x) {
-            if (mapComp.grid[y][x].type == CellType::Wall) {
+            if (mapComp.grid.At(x, y).type == CellType::Wall) {
 
                 for (int i = 0; i < 4; ++i) {
                     int nx = x + dx[i];
                     int ny = y + dy[i];
 
-                    CellType nType = mapComp.grid[ny][nx].type;
+                    CellType nType = mapComp.grid.At(nx, ny).type;
                     if (nType == CellType::Path || nType == CellType::Room || nType == CellType::Start) {
 
-                        if (rand() % 100 < 20) {
+                        if (MazeGenerator::RandomInt(0, 99) < 20) {
                             XMFLOAT3 pos = GetWorldPosition(x, y, config);
                             pos.x += TILE_SIZE / 2.0f;
                             pos.z += TILE_SIZE / 2.0f;
@@ -1357,7 +1496,7 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
                             pos.x += dx[i] * offset;
                             pos.z += dy[i] * offset;
 
-                            if (rand() % 4 == 0) {
+                            if (MazeGenerator::RandomInt(0, 3) == 0) {
                                 // 監視カメラ
                                 pos.y = WALL_HEIGHT * 0.55f;
 
@@ -1370,7 +1509,7 @@ void MapGenerationSystem::SpawnMapEntities(MapComponent& mapComp, const MapStage
                                 // 絵画
                                 pos.y = WALL_HEIGHT * 0.25f;
                                 float rotY = DirectX::XMConvertToRadians(rots[i]);
-                                std::string model = paintModels[rand() % paintModels.size()];
+                                std::string model = paintModels[MazeGenerator::RandomInt(0, (int)paintModels.size() - 1)];
                                 EntityFactory::CreateWallPainting(m_coordinator, pos, rotY, model);
                             }
                             break;
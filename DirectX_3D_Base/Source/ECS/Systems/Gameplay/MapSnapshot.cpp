@@ -0,0 +1,303 @@
+﻿/*****************************************************************//**
+ * @file	MapSnapshot.cpp
+ * @brief	MapSnapshotの実装
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：MapSnapshot.cppを作成。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "ECS/Systems/Gameplay/MapSnapshot.h"
+#include "ECS/Components/Gameplay/MapComponent.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+	const char kMagic[4] = { 'M', 'A', 'P', 'S' };
+	const std::uint32_t kVersion = 1;
+
+	// 極端な値を含む壊れたファイルで巨大な確保をしないための上限
+	const int kMaxGridSize = 1024;
+	const std::uint32_t kMaxListCount = 1u << 16;
+
+	/**
+	 * @class	ByteWriter
+	 * @brief	固定幅の値をリトルエンディアンでバッファに追記する
+	 */
+	class ByteWriter
+	{
+	public:
+		void U8(std::uint8_t value) { m_bytes.push_back(value); }
+		void U32(std::uint32_t value)
+		{
+			for (int i = 0; i < 4; ++i) m_bytes.push_back((std::uint8_t)(value >> (i * 8)));
+		}
+		void I32(std::int32_t value) { U32((std::uint32_t)value); }
+		void F32(float value)
+		{
+			std::uint32_t bits = 0;
+			std::memcpy(&bits, &value, sizeof(bits));
+			U32(bits);
+		}
+		void Int2(const DirectX::XMINT2& value) { I32(value.x); I32(value.y); }
+
+		const std::vector<std::uint8_t>& GetBytes() const { return m_bytes; }
+
+	private:
+		std::vector<std::uint8_t> m_bytes;
+	};
+
+	/**
+	 * @class	ByteReader
+	 * @brief	ByteWriterで書いたバッファを先頭から読み出す (範囲外は失敗扱い)
+	 */
+	class ByteReader
+	{
+	public:
+		ByteReader(const std::uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+		bool U8(std::uint8_t& out)
+		{
+			if (m_pos + 1 > m_size) return false;
+			out = m_data[m_pos++];
+			return true;
+		}
+		bool U32(std::uint32_t& out)
+		{
+			if (m_pos + 4 > m_size) return false;
+			out = 0;
+			for (int i = 0; i < 4; ++i) out |= (std::uint32_t)m_data[m_pos++] << (i * 8);
+			return true;
+		}
+		bool I32(std::int32_t& out)
+		{
+			std::uint32_t bits = 0;
+			if (!U32(bits)) return false;
+			out = (std::int32_t)bits;
+			return true;
+		}
+		bool F32(float& out)
+		{
+			std::uint32_t bits = 0;
+			if (!U32(bits)) return false;
+			std::memcpy(&out, &bits, sizeof(out));
+			return true;
+		}
+		bool Int2(DirectX::XMINT2& out) { return I32(out.x) && I32(out.y); }
+
+		size_t GetPosition() const { return m_pos; }
+
+	private:
+		const std::uint8_t* m_data;
+		size_t m_size;
+		size_t m_pos = 0;
+	};
+
+	std::uint64_t Fnv1a(const std::uint8_t* data, size_t size)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= data[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	// ハッシュを除いた保存内容を組み立てる
+	void Serialize(const MapComponent& mapComp, ByteWriter& writer)
+	{
+		for (char c : kMagic) writer.U8((std::uint8_t)c);
+		writer.U32(kVersion);
+		writer.U32(mapComp.seed);
+		writer.I32(mapComp.gridSizeX);
+		writer.I32(mapComp.gridSizeY);
+		writer.F32(mapComp.tileSize);
+		writer.F32(mapComp.wallHeight);
+
+		writer.Int2(mapComp.startPos);
+		writer.Int2(mapComp.goalPos);
+
+		writer.U32((std::uint32_t)mapComp.itemPositions.size());
+		for (const auto& pos : mapComp.itemPositions) writer.Int2(pos);
+
+		writer.U32((std::uint32_t)mapComp.teleportPairs.size());
+		for (const auto& pair : mapComp.teleportPairs)
+		{
+			writer.Int2(pair.posA);
+			writer.Int2(pair.posB);
+		}
+
+		for (int y = 0; y < mapComp.gridSizeY; ++y)
+		{
+			for (int x = 0; x < mapComp.gridSizeX; ++x)
+			{
+				writer.U8((std::uint8_t)mapComp.grid.GetType(x, y));
+			}
+		}
+	}
+}
+
+bool MapSnapshot::Save(const MapComponent& mapComp, const std::string& filePath)
+{
+	if (mapComp.grid.GetSizeX() != mapComp.gridSizeX || mapComp.grid.GetSizeY() != mapComp.gridSizeY)
+	{
+		printf("[Error] MapSnapshot: grid size does not match MapComponent (%s)\n", filePath.c_str());
+		return false;
+	}
+
+	ByteWriter writer;
+	Serialize(mapComp, writer);
+	const std::vector<std::uint8_t>& bytes = writer.GetBytes();
+	const std::uint64_t hash = Fnv1a(bytes.data(), bytes.size());
+
+	std::ofstream ofs(filePath, std::ios::binary | std::ios::trunc);
+	if (!ofs.is_open())
+	{
+		printf("[Error] MapSnapshot: failed to open %s for writing\n", filePath.c_str());
+		return false;
+	}
+
+	ofs.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+	for (int i = 0; i < 8; ++i) ofs.put((char)(std::uint8_t)(hash >> (i * 8)));
+
+	if (!ofs)
+	{
+		printf("[Error] MapSnapshot: failed to write %s\n", filePath.c_str());
+		return false;
+	}
+
+	printf("[Info] MapSnapshot saved: %s (seed %u, %zu bytes)\n", filePath.c_str(), mapComp.seed, bytes.size() + 8);
+	return true;
+}
+
+bool MapSnapshot::Load(MapComponent& mapComp, const std::string& filePath)
+{
+	std::ifstream ifs(filePath, std::ios::binary);
+	if (!ifs.is_open())
+	{
+		printf("[Error] MapSnapshot: failed to open %s\n", filePath.c_str());
+		return false;
+	}
+
+	const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+	if (bytes.size() < 8)
+	{
+		printf("[Error] MapSnapshot: %s is truncated\n", filePath.c_str());
+		return false;
+	}
+
+	// 末尾のハッシュで破損を検出する
+	const size_t payloadSize = bytes.size() - 8;
+	std::uint64_t storedHash = 0;
+	for (int i = 0; i < 8; ++i) storedHash |= (std::uint64_t)bytes[payloadSize + i] << (i * 8);
+	if (storedHash != Fnv1a(bytes.data(), payloadSize))
+	{
+		printf("[Error] MapSnapshot: checksum mismatch in %s\n", filePath.c_str());
+		return false;
+	}
+
+	ByteReader reader(bytes.data(), payloadSize);
+
+	std::uint8_t magic[4] = {};
+	std::uint32_t version = 0;
+	for (auto& c : magic) if (!reader.U8(c)) return false;
+	if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || !reader.U32(version) || version != kVersion)
+	{
+		printf("[Error] MapSnapshot: unsupported format in %s\n", filePath.c_str());
+		return false;
+	}
+
+	// 読込が全て成功するまでは一時オブジェクトに展開する
+	MapComponent loaded;
+	std::uint32_t itemCount = 0;
+	std::uint32_t pairCount = 0;
+
+	bool ok = reader.U32(loaded.seed)
+		&& reader.I32(loaded.gridSizeX)
+		&& reader.I32(loaded.gridSizeY)
+		&& reader.F32(loaded.tileSize)
+		&& reader.F32(loaded.wallHeight)
+		&& reader.Int2(loaded.startPos)
+		&& reader.Int2(loaded.goalPos)
+		&& reader.U32(itemCount)
+		&& itemCount <= kMaxListCount;
+
+	for (std::uint32_t i = 0; ok && i < itemCount; ++i)
+	{
+		DirectX::XMINT2 pos = { 0, 0 };
+		ok = reader.Int2(pos);
+		loaded.itemPositions.push_back(pos);
+	}
+
+	ok = ok && reader.U32(pairCount) && pairCount <= kMaxListCount;
+	for (std::uint32_t i = 0; ok && i < pairCount; ++i)
+	{
+		MapComponent::TeleportPair pair;
+		ok = reader.Int2(pair.posA) && reader.Int2(pair.posB);
+		loaded.teleportPairs.push_back(pair);
+	}
+
+	ok = ok && loaded.gridSizeX > 0 && loaded.gridSizeX <= kMaxGridSize
+		&& loaded.gridSizeY > 0 && loaded.gridSizeY <= kMaxGridSize;
+
+	if (ok)
+	{
+		loaded.grid.Assign(loaded.gridSizeX, loaded.gridSizeY);
+		for (int y = 0; ok && y < loaded.gridSizeY; ++y)
+		{
+			for (int x = 0; ok && x < loaded.gridSizeX; ++x)
+			{
+				std::uint8_t type = 0;
+				ok = reader.U8(type) && type <= (std::uint8_t)CellType::StopTrap;
+				if (ok) loaded.grid.At(x, y).type = (CellType)type;
+			}
+		}
+	}
+
+	if (!ok || reader.GetPosition() != payloadSize)
+	{
+		printf("[Error] MapSnapshot: malformed data in %s\n", filePath.c_str());
+		return false;
+	}
+
+	loaded.grid.RebuildWalkableMask();
+
+	mapComp.seed = loaded.seed;
+	mapComp.gridSizeX = loaded.gridSizeX;
+	mapComp.gridSizeY = loaded.gridSizeY;
+	mapComp.tileSize = loaded.tileSize;
+	mapComp.wallHeight = loaded.wallHeight;
+	mapComp.grid = std::move(loaded.grid);
+	mapComp.startPos = loaded.startPos;
+	mapComp.goalPos = loaded.goalPos;
+	mapComp.itemPositions = std::move(loaded.itemPositions);
+	mapComp.teleportPairs = std::move(loaded.teleportPairs);
+	mapComp.visibility.reset();
+
+	printf("[Info] MapSnapshot loaded: %s (seed %u, %dx%d)\n", filePath.c_str(), mapComp.seed, mapComp.gridSizeX, mapComp.gridSizeY);
+	return true;
+}
+
+std::uint64_t MapSnapshot::ComputeHash(const MapComponent& mapComp)
+{
+	ByteWriter writer;
+	Serialize(mapComp, writer);
+	return Fnv1a(writer.GetBytes().data(), writer.GetBytes().size());
+}
@@ -0,0 +1,157 @@
+﻿/*****************************************************************//**
+ * @file	MapVisibility.cpp
+ * @brief	セル間可視テーブルの構築処理の実装
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：MapVisibility.cppを作成。スーパーカバー線分走査による全セル対の可視判定を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- xx：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "ECS/Systems/Gameplay/MapVisibility.h"
+#include "ECS/Components/Gameplay/MapComponent.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * [std::shared_ptr<MapVisibility> - BuildAsync]
+ * @brief	壁配置を複製し、可視テーブルの構築をワーカースレッドに投げる
+ */
+std::shared_ptr<MapVisibility> MapVisibility::BuildAsync(const MapComponent& mapComp)
+{
+    std::shared_ptr<MapVisibility> table(new MapVisibility());
+    table->m_sizeX = mapComp.gridSizeX;
+    table->m_sizeY = mapComp.gridSizeY;
+
+    const int cellCount = table->m_sizeX * table->m_sizeY;
+    table->m_wordsPerRow = (cellCount + 63) / 64;
+
+    // ワーカーがMapComponentに触れないよう、壁フラグだけを複製しておく
+    table->m_isWall.resize((size_t)cellCount);
+    for (int y = 0; y < table->m_sizeY; ++y)
+    {
+        for (int x = 0; x < table->m_sizeX; ++x)
+        {
+            table->m_isWall[(size_t)y * table->m_sizeX + x] = mapComp.grid.IsWalkable(x, y) ? 0 : 1;
+        }
+    }
+    table->m_bits.assign((size_t)cellCount * table->m_wordsPerRow, 0ull);
+
+    MapVisibility* raw = table.get();
+    table->m_buildTask = std::async(std::launch::async, [raw]() { raw->Build(); });
+
+    return table;
+}
+
+MapVisibility::~MapVisibility()
+{
+    // 構築途中で破棄された場合もワーカーの終了を待つ
+    if (m_buildTask.valid())
+    {
+        m_buildTask.wait();
+    }
+}
+
+/**
+ * [void - Build]
+ * @brief	全セル対について見通しを計算する。可視関係は対称なので上三角のみ走査する
+ */
+void MapVisibility::Build()
+{
+    const auto begin = std::chrono::steady_clock::now();
+
+    const int cellCount = m_sizeX * m_sizeY;
+    auto SetBit = [this](int from, int to)
+        {
+            m_bits[(size_t)from * m_wordsPerRow + (to >> 6)] |= (1ull << (to & 63));
+        };
+
+    int walkableCount = 0;
+    for (int a = 0; a < cellCount; ++a)
+    {
+        if (m_isWall[a]) continue;
+        walkableCount++;
+
+        const int ax = a % m_sizeX;
+        const int ay = a / m_sizeX;
+        SetBit(a, a);
+
+        for (int b = a + 1; b < cellCount; ++b)
+        {
+            if (m_isWall[b]) continue;
+
+            if (TraceLine(ax, ay, b % m_sizeX, b / m_sizeX))
+            {
+                SetBit(a, b);
+                SetBit(b, a);
+            }
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    m_buildTimeMs = std::chrono::duration<float, std::milli>(end - begin).count();
+
+    printf("[Info] MapVisibility built: %dx%d grid, %d walkable cells, %zu bytes, %.2f ms\n",
+        m_sizeX, m_sizeY, walkableCount, GetMemoryBytes(), m_buildTimeMs);
+
+    m_isReady.store(true, std::memory_order_release);
+}
+
+/**
+ * [bool - TraceLine]
+ * @brief	セル中心 (ax, ay) から (bx, by) への線分が通過する全セルを走査する
+ *
+ * @note	線分が格子の角をちょうど通過する場合は、角を挟む両セルのどちらかが壁なら遮蔽とみなす
+ */
+bool MapVisibility::TraceLine(int ax, int ay, int bx, int by) const
+{
+    int dx = std::abs(bx - ax);
+    int dy = std::abs(by - ay);
+    const int stepX = (bx > ax) ? 1 : -1;
+    const int stepY = (by > ay) ? 1 : -1;
+
+    int x = ax;
+    int y = ay;
+    int error = dx - dy;
+    dx *= 2;
+    dy *= 2;
+
+    for (int n = 1 + std::abs(bx - ax) + std::abs(by - ay); n > 0; --n)
+    {
+        if (IsWall(x, y)) return false;
+
+        if (error > 0)
+        {
+            x += stepX;
+            error -= dy;
+        }
+        else if (error < 0)
+        {
+            y += stepY;
+            error += dx;
+        }
+        else
+        {
+            // 角を通過する
+            if (n > 1 && (IsWall(x + stepX, y) || IsWall(x, y + stepY))) return false;
+            x += stepX;
+            y += stepY;
+            error += dx - dy;
+            --n;
+        }
+    }
+
+    return true;
+}
@@ -21,6 +21,7 @@
 #include "ECS/ECS.h"
 #include "ECS/ECSInitializer.h"
 #include "ECS/EntityFactory.h"
+#include "ECS/Systems/Gameplay/MapVisibility.h"
 #include "Systems/Geometory.h"
 
 #include <DirectXMath.h>
@@ -28,7 +29,6 @@
 #include <cmath>
 #include <vector>
 #include <queue>
-#include <map>
 #include <limits>
 
 using namespace DirectX;
@@ -46,19 +46,6 @@ inline bool operator==(const XMINT2& lhs, const XMINT2& rhs)
     return lhs.x == rhs.x && lhs.y == rhs.y;
 }
 
-/**
- * @brief XMINT2L[ƂĎgp邽߂̔rZq (std::mapp)
- * @note std::map<XMINT2, AStarNode> gp邽߂ɕKv
- */
-struct XMINT2Comparer
-{
-    bool operator()(const XMINT2& lhs, const XMINT2& rhs) const
-    {
-        if (lhs.y != rhs.y) return lhs.y < rhs.y;
-        return lhs.x < rhs.x;
-    }
-};
-
 // --------------------------------------------------------------------------------
 // A* T: S[܂ł̑SoHԂ
 // --------------------------------------------------------------------------------
@@ -74,8 +61,11 @@ std::vector<XMINT2> GuardAISystem::FindPath(XMINT2 startGrid, XMINT2 targetGrid,
     }
 
     // A*̃ZbgAbv
+    // m[h̓ZCfbNXň镽RȔzɒuAt[Ԃōėp
+    const MapGrid& grid = mapComp.grid;
     std::priority_queue<AStarNode, std::vector<AStarNode>, std::greater<AStarNode>> openSet;
-    std::map<XMINT2, AStarNode, XMINT2Comparer> allNodes;
+    std::vector<AStarNode>& allNodes = m_pathNodes;
+    allNodes.assign((size_t)grid.GetCellCount(), AStarNode());
 
     AStarNode startNode;
     startNode.gridPos = startGrid;
@@ -85,14 +75,14 @@ std::vector<XMINT2> GuardAISystem::FindPath(XMINT2 startGrid, XMINT2 targetGrid,
     startNode.parentPos = startGrid; // e͎
 
     openSet.push(startNode);
-    allNodes[startGrid] = startNode;
+    allNodes[grid.GetIndex(startGrid.x, startGrid.y)] = startNode;
 
     while (!openSet.empty())
     {
         AStarNode current = openSet.top();
         openSet.pop();
 
-        if (current.fCost > allNodes.at(current.gridPos).fCost) continue;
+        if (current.fCost > allNodes[grid.GetIndex(current.gridPos.x, current.gridPos.y)].fCost) continue;
 
         // S[B
         if (current.gridPos == targetGrid)
@@ -103,7 +93,7 @@ std::vector<XMINT2> GuardAISystem::FindPath(XMINT2 startGrid, XMINT2 targetGrid,
             while (!(curr == startGrid))
             {
                 path.push_back(curr);
-                curr = allNodes.at(curr).parentPos;
+                curr = allNodes[grid.GetIndex(curr.x, curr.y)].parentPos;
             }
             // path.push_back(startGrid); // X^[gn_͊܂߂ȂėǂiݒnȂ̂Łj
             std::reverse(path.begin(), path.end()); // S[X^[gȂ̂Ŕ]
@@ -120,12 +110,13 @@ std::vector<XMINT2> GuardAISystem::FindPath(XMINT2 startGrid, XMINT2 targetGrid,
             if (neighborPos.x <= 0 || neighborPos.x >= mapComp.gridSizeX - 1 ||
                 neighborPos.y <= 0 || neighborPos.y >= mapComp.gridSizeY - 1) continue;
 
-            CellType type = mapComp.grid[neighborPos.y][neighborPos.x].type;
-            if (type == CellType::Wall || type == CellType::Unvisited) continue;
+            if (!grid.IsWalkable(neighborPos.x, neighborPos.y)) continue;
 
             float newGCost = current.gCost + 1.0f;
+            AStarNode& neighborSlot = allNodes[grid.GetIndex(neighborPos.x, neighborPos.y)];
 
-            if (allNodes.find(neighborPos) == allNodes.end() || newGCost < allNodes.at(neighborPos).gCost)
+            // Km[h gCost ͍őlȂ̂ŁArŏKł
+            if (newGCost < neighborSlot.gCost)
             {
                 AStarNode neighborNode;
                 neighborNode.gridPos = neighborPos;
@@ -134,7 +125,7 @@ std::vector<XMINT2> GuardAISystem::FindPath(XMINT2 startGrid, XMINT2 targetGrid,
                 neighborNode.fCost = neighborNode.gCost + neighborNode.hCost;
                 neighborNode.parentPos = current.gridPos;
 
-                allNodes[neighborPos] = neighborNode;
+                neighborSlot = neighborNode;
                 openSet.push(neighborNode);
             }
         }
@@ -254,10 +245,9 @@ bool GuardAISystem::RaycastHitWall(
         XMINT2 gridPos = GetGridPosition(currentPos, mapComp);
 
         // Obh͈͓`FbN
-        if (gridPos.x >= 0 && gridPos.x < mapComp.gridSizeX &&
-            gridPos.y >= 0 && gridPos.y < mapComp.gridSizeY)
+        if (mapComp.grid.InBounds(gridPos.x, gridPos.y))
         {
-            if (mapComp.grid[gridPos.y][gridPos.x].type == CellType::Wall)
+            if (!mapComp.grid.IsWalkable(gridPos.x, gridPos.y))
             {
                 return true; // ǂɃqbg
             }
@@ -268,64 +258,71 @@ bool GuardAISystem::RaycastHitWall(
 }
 
 // --------------------------------------------------------------------------------
-// ^[QbgE (ApxAՕ)
+// Sx̎Eꊇ] (ApxAՕ)
 // --------------------------------------------------------------------------------
-bool GuardAISystem::IsTargetInSight(
-    const TransformComponent& guardTransform,
-    const GuardComponent& guardInfo,
-    const TransformComponent& targetTransform,
-    const MapComponent& mapComp
-)
+void GuardAISystem::EvaluateSightBatch(const TransformComponent& targetTransform, const MapComponent& mapComp)
 {
-    // 1. 
-    XMVECTOR guardPos = XMLoadFloat3(&guardTransform.position);
-    XMVECTOR targetPos = XMLoadFloat3(&targetTransform.position);
-    XMVECTOR toTarget = targetPos - guardPos;
-
-    // 
-    toTarget = XMVectorSetY(toTarget, 0.0f);
+    SightBatch& batch = m_sightBatch;
+    batch.Clear();
 
-    XMVECTOR distSqVec = XMVector3LengthSq(toTarget);
-    float distSq;
-    XMStoreFloat(&distSq, distSqVec);
-
-    if (distSq > guardInfo.viewRange * guardInfo.viewRange)
+    // 1. SoAobt@֋l߂
+    for (auto const& entity : m_entities)
     {
-        return false; // ͈͊O
+        const GuardComponent& guardComp = m_coordinator->GetComponent<GuardComponent>(entity);
+        const TransformComponent& guardTransform = m_coordinator->GetComponent<TransformComponent>(entity);
+
+        const float yawRad = guardTransform.rotation.y;
+        const float cosHalf = std::cos(XMConvertToRadians(guardComp.viewAngle * 0.5f));
+        const XMINT2 grid = GetGridPosition(guardTransform.position, mapComp);
+
+        batch.posX.push_back(guardTransform.position.x);
+        batch.posZ.push_back(guardTransform.position.z);
+        batch.forwardX.push_back(std::sin(yawRad));
+        batch.forwardZ.push_back(std::cos(yawRad));
+        batch.rangeSq.push_back(guardComp.viewRange * guardComp.viewRange);
+        batch.cosHalfAngle.push_back(cosHalf);
+        batch.cellIndex.push_back(mapComp.visibility ? mapComp.visibility->GetCellIndex(grid.x, grid.y) : -1);
     }
 
-    // 2. px
-    XMVECTOR toTargetDir = XMVector3Normalize(toTarget);
-    float yawRad = guardTransform.rotation.y;
-
-    float dirX = std::sin(yawRad);
-    float dirZ = std::cos(yawRad);
-    XMVECTOR forwardDir = XMVectorSet(dirX, 0.0f, dirZ, 0.0f);
+    const size_t count = batch.posX.size();
+    batch.inSight.resize(count);
 
-    XMVECTOR dotVec = XMVector3Dot(forwardDir, toTargetDir);
-    float dot;
-    XMStoreFloat(&dot, dotVec);
-
-    float angleThreshold = std::cos(XMConvertToRadians(guardInfo.viewAngle * 0.5f));
-
-    if (dot < angleThreshold)
+    // 2. Epx (Ȃ̃[vɂăRpC̃xNgɔC)
+    //    dot >= cosHalf * |toTarget| r邱ƂŐK̏ZȂ
+    const float targetX = targetTransform.position.x;
+    const float targetZ = targetTransform.position.z;
+    for (size_t i = 0; i < count; ++i)
     {
-        return false; // pO
+        const float dx = targetX - batch.posX[i];
+        const float dz = targetZ - batch.posZ[i];
+        const float distSq = dx * dx + dz * dz;
+        const float dot = batch.forwardX[i] * dx + batch.forwardZ[i] * dz;
+        const float minDot = batch.cosHalfAngle[i] * std::sqrt(distSq);
+
+        batch.inSight[i] = (distSq <= batch.rangeSq[i]) & (dot >= minDot);
     }
 
-    // 3. Օ (Raycast)
-    // g̈ʒu()^[Qbg̈ʒu()փC΂
-    XMFLOAT3 rayStart = guardTransform.position;
-    rayStart.y += 0.5f; // ڂ̍
-    XMFLOAT3 rayEnd = targetTransform.position;
-    rayEnd.y += 0.5f;
+    // 3. Օ: e[u\zς݂ȂrbgQƁAȂ烌CLXgő
+    const MapVisibility* visibility = (mapComp.visibility && mapComp.visibility->IsReady()) ? mapComp.visibility.get() : nullptr;
+    const XMINT2 targetGrid = GetGridPosition(targetTransform.position, mapComp);
+    const int targetCell = visibility ? visibility->GetCellIndex(targetGrid.x, targetGrid.y) : -1;
 
-    if (RaycastHitWall(rayStart, rayEnd, mapComp))
+    for (size_t i = 0; i < count; ++i)
     {
-        return false; // ǂɎՂꂽ
-    }
+        if (!batch.inSight[i]) continue;
 
-    return true; // SĂ̏NA
+        if (visibility)
+        {
+            batch.inSight[i] = visibility->IsVisible(batch.cellIndex[i], targetCell) ? 1 : 0;
+        }
+        else
+        {
+            // g̈ʒu()^[Qbg̈ʒu()փC΂
+            XMFLOAT3 rayStart = { batch.posX[i], 0.5f, batch.posZ[i] };
+            XMFLOAT3 rayEnd = { targetX, 0.5f, targetZ };
+            batch.inSight[i] = RaycastHitWall(rayStart, rayEnd, mapComp) ? 0 : 1;
+        }
+    }
 }
 
 // --------------------------------------------------------------------------------
@@ -409,9 +406,15 @@ void GuardAISystem::Update(float deltaTime)
     const int GRID_SIZE_X = mapComp.gridSizeX;
     const int GRID_SIZE_Y = mapComp.gridSizeY;
 
+    // E͑Sx܂Ƃ߂Đɕ]Ă
+    EvaluateSightBatch(pTrans, mapComp);
+    size_t guardIndex = 0;
+
     // xGeBeBŜ𔽕
     for (auto const& entity : m_entities)
     {
+        const bool isTargetInSight = m_sightBatch.inSight[guardIndex++] != 0;
+
         GuardComponent& guardComp = m_coordinator->GetComponent<GuardComponent>(entity);
         TransformComponent& guardTransform = m_coordinator->GetComponent<TransformComponent>(entity);
         RigidBodyComponent& guardRigidBody = m_coordinator->GetComponent<RigidBodyComponent>(entity);
@@ -503,7 +506,7 @@ void GuardAISystem::Update(float deltaTime)
 
             // F̐ݒ
             DirectX::XMFLOAT4 color = { 1.0f, 1.0f, 0.0f, 1.0f }; // 
-            if (IsTargetInSight(guardTransform, guardComp, pTrans, mapComp))
+            if (isTargetInSight)
             {
                 color = { 1.0f, 0.0f, 0.0f, 1.0f }; // F
             }
@@ -553,7 +556,7 @@ void GuardAISystem::Update(float deltaTime)
             // -------------------------------------------------------------
             // EƃQ[I[o[
             // -------------------------------------------------------------
-            if (IsTargetInSight(guardTransform, guardComp, pTrans, mapComp))
+            if (isTargetInSight)
             {
                 // --- vC[̏ ---
 
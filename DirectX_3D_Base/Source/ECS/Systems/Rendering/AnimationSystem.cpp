@@ -6,6 +6,7 @@
 #include "ECS/Systems/Rendering/AnimationSystem.h"
 #include "ECS/ECS.h"
 #include <DirectXMath.h>
+#include <algorithm>
 
 using namespace ECS;
 
@@ -28,7 +29,13 @@ void AnimationSystem::Update(float deltaTime)
         auto& modelComp = m_coordinator->GetComponent<ModelComponent>(entity);
         auto& animComp = m_coordinator->GetComponent<AnimationComponent>(entity);
 
-        if (!modelComp.pModel) continue;
+        // Skip until the asynchronous load has finished
+        if (!modelComp.Resolve()) continue;
+
+        // Playback state lives per entity; the Model itself is shared through AssetManager
+        if (!modelComp.pInstance)
+            modelComp.pInstance = std::make_unique<ModelInstance>(modelComp.pModel);
+        ModelInstance& instance = *modelComp.pInstance;
 
         // 1) Preload animations
         if (!animComp.preloadList.empty())
@@ -46,9 +53,9 @@ void AnimationSystem::Update(float deltaTime)
             const auto& req = animComp.currentRequest;
 
             if (req.isBlend)
-                modelComp.pModel->PlayBlend(req.animeID, req.blendTime, req.loop, req.speed);
+                instance.PlayBlend(req.animeID, req.blendTime, req.loop, req.speed);
             else
-                modelComp.pModel->Play(req.animeID, req.loop, req.speed);
+                instance.Play(req.animeID, req.loop, req.speed);
 
             // ★★★ 修正箇所：ここに追加 ★★★
             // 再生開始時に、古い履歴データ（前のEntityの残りカス）を消す
@@ -61,8 +68,21 @@ void AnimationSystem::Update(float deltaTime)
             animComp.hasRequest = false;
         }
 
-        // 3) Advance animation time
-        modelComp.pModel->Step(deltaTime);
+        m_stepBatch.push_back(&instance);
+    }
+
+    // 3) Advance animation time
+    //    Instances sharing a Model are grouped so their bone hierarchies are evaluated 4 at a time
+    std::sort(m_stepBatch.begin(), m_stepBatch.end(),
+        [](const ModelInstance* a, const ModelInstance* b) { return a->GetModel() < b->GetModel(); });
+    ModelInstance::StepBatch(m_stepBatch.data(), m_stepBatch.size(), deltaTime);
+    m_stepBatch.clear();
+
+    for (auto const& entity : m_entities)
+    {
+        auto& modelComp = m_coordinator->GetComponent<ModelComponent>(entity);
+        if (!modelComp.pInstance) continue;
+        ModelInstance& instance = *modelComp.pInstance;
 
         // 4) Apply node-animation transform
         auto& transform = m_coordinator->GetComponent<TransformComponent>(entity);
@@ -71,7 +91,7 @@ void AnimationSystem::Update(float deltaTime)
         DirectX::XMFLOAT3 animRot{};
         DirectX::XMFLOAT3 animScale{};
 
-        if (modelComp.pModel->GetAnimatedTransform(animPos, animRot, animScale))
+        if (instance.GetAnimatedTransform(animPos, animRot, animScale))
         {
             // --- 位置用のイテレータ取得 ---
             auto itPrevPos = m_prevNodeAnimPos.find(entity);
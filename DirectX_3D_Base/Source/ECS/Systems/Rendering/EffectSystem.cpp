@@ -205,11 +205,14 @@ void EffectSystem::Update(float deltaTime)
 		}
 
 		// 再生
-		if (effectComp.requestPlay)
+		// (読み込み中は再生要求を残したまま次のフレームへ回す)
+		Asset::AssetInfo* pEffectInfo = effectComp.requestPlay
+			? Asset::AssetManager::GetInstance().RequestEffect(effectComp.assetRef, effectComp.assetID) : nullptr;
+		if (effectComp.requestPlay && !(pEffectInfo && pEffectInfo->state == Asset::LoadState::Pending))
 		{
 			effectComp.requestPlay = false;
 
-			Effekseer::EffectRef effectRef = Asset::AssetManager::GetInstance().LoadEffect(effectComp.assetID);
+			Effekseer::EffectRef effectRef = Asset::AssetManager::GetInstance().GetEffect(pEffectInfo);
 
 			if (effectRef != nullptr)
 			{
@@ -26,6 +26,8 @@
 #include "Systems/Model.h"
 #include "Systems/DirectX/Texture.h"
 #include "Systems/DirectX/ShaderList.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 using namespace DirectX;
@@ -139,7 +141,7 @@ void RenderSystem::DrawEntityInternal(ECS::EntityID entity, const DirectX::XMFLO
 	case MESH_MODEL:
 	{
 		ModelComponent& model = m_coordinator->GetComponent<ModelComponent>(entity);
-		if (model.pModel)
+		if (model.Resolve())
 		{
 			// VF[_[ݒ
 			if (m_coordinator->HasComponent<AnimationComponent>(entity))
@@ -167,6 +169,20 @@ void RenderSystem::DrawEntityInternal(ECS::EntityID entity, const DirectX::XMFLO
 				break;
 			}
 
+			// ʏ̑傫ڍדxI
+			// (E̒Sr[ԂֈڂAaʂ̍̔ɑ΂䗦ɂ)
+			if (model.pModel->GetLodNum() > 1)
+			{
+				const XMFLOAT3& center = model.pModel->GetBoundsCenter();
+				XMMATRIX view = XMMatrixTranspose(XMLoadFloat4x4(&viewMat));
+				XMVECTOR viewPos = XMVector3TransformCoord(XMLoadFloat3(&center), world * view);
+				float maxScale = std::max(std::fabs(transform.scale.x), std::max(std::fabs(transform.scale.y), std::fabs(transform.scale.z)));
+				float radius = model.pModel->GetBoundsRadius() * maxScale;
+				// se (_44 == 1) ͋ŏk܂Ȃ
+				float depth = (projMat._44 == 1.0f) ? 1.0f : std::max(XMVectorGetZ(viewPos), 0.01f);
+				model.lod = model.pModel->SelectLod(radius * projMat._22 / depth, model.lod);
+			}
+
 			// bVƂ̃[vőIʂs
 			for (uint32_t i = 0; i < model.pModel->GetMeshNum(); ++i)
 			{
@@ -195,7 +211,11 @@ void RenderSystem::DrawEntityInternal(ECS::EntityID entity, const DirectX::XMFLO
 				// vZAt@lKpĕ`
 				material.diffuse.w = finalAlpha;
 				ShaderList::SetMaterial(material);
-				model.pModel->Draw(i);
+				// Đ̃CX^X΂̎pŁA΃oCh|[Yŕ`
+				if (model.pInstance)
+					model.pInstance->Draw(i, model.lod);
+				else
+					model.pModel->Draw(i, nullptr, model.lod);
 			}
 
 			// C: `̓ftHgiʃJOjɖ߂
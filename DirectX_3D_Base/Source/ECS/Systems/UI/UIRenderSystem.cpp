@@ -79,10 +79,16 @@ void UIRenderSystem::Render(bool drawBackground)
 
 		// R|[lg̎擾
 		const auto& transform = m_coordinator->GetComponent<TransformComponent>(entity);
-		const auto& uiComp = m_coordinator->GetComponent<UIImageComponent>(entity);
+		auto& uiComp = m_coordinator->GetComponent<UIImageComponent>(entity);
 
-		// AssetManagereNX`\[X擾
-		Asset::AssetInfo* info = Asset::AssetManager::GetInstance().LoadTexture(uiComp.assetID);
+		// AssetManagereNX`\[X擾 (ǂݍݒ̂̂͊܂ŕ`悵Ȃ)
+		// 2ڈȍ~͉ς݂̃nhň߁Ǎ͍sȂ
+		// AgXɂ܂Ƃ߂Ă΃y[W̃eNX`ԂAatlasRegion Ƀy[W͈̔͂
+		Asset::AssetInfo* info = Asset::AssetManager::GetInstance().RequestSpriteTexture(uiComp.assetRef, uiComp.atlasRegion, uiComp.assetID);
+		if (info && info->state == Asset::LoadState::Pending)
+		{
+			continue;
+		}
 		if (!info || !info->pResource)
 		{
 			std::cerr << "Warning: Failed to load UI texture for entity " << entity << " (ID: " << uiComp.assetID << ")" << std::endl;
@@ -113,8 +119,17 @@ void UIRenderSystem::Render(bool drawBackground)
 		// ϊ̍WZbg
 		Sprite::SetOffset({ ndcPosX, ndcPosY });
 		Sprite::SetSize({ ndcScaleX, ndcScaleY });
-		Sprite::SetUVPos(uiComp.uvPos);
-		Sprite::SetUVScale(uiComp.uvScale);
+		if (const Asset::AtlasRegion* region = uiComp.atlasRegion)
+		{
+			// ̃eNX` UV y[W͈̔͂֎ʂ (] ( uvScale) ̂܂܈)
+			Sprite::SetUVPos({ region->uvPos.x + uiComp.uvPos.x * region->uvScale.x, region->uvPos.y + uiComp.uvPos.y * region->uvScale.y });
+			Sprite::SetUVScale({ uiComp.uvScale.x * region->uvScale.x, uiComp.uvScale.y * region->uvScale.y });
+		}
+		else
+		{
+			Sprite::SetUVPos(uiComp.uvPos);
+			Sprite::SetUVScale(uiComp.uvScale);
+		}
 		Sprite::SetColor(uiComp.color);
 		Sprite::SetAngle(transform.rotation.z);
 
@@ -32,11 +32,14 @@
 #include "Systems/AssetManager.h"
 #include "Systems/XAudio2/SoundEngine.h"
 #include "ECS/Systems/Rendering/EffectSystem.h"
+#include "ECS/Systems/Gameplay/MapGenerationSystem.h"
 
 // Scene
 #include "Scene/SceneManager.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <iostream>
 #include <crtdbg.h>
 #include <DirectXMath.h>
@@ -87,6 +90,18 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	}
 #endif
 
+	// N "-seed <l>" Ń}bṽV[hŒ肷 (s̍ČEvp)
+	if (lpCmdLine)
+	{
+		const char* seedArg = strstr(lpCmdLine, "-seed ");
+		if (seedArg)
+		{
+			const unsigned long seed = strtoul(seedArg + 6, nullptr, 10);
+			MazeGenerator::SetSeedOverride((std::uint32_t)seed);
+			printf("[Info] Map seed override: %lu\n", seed);
+		}
+	}
+
 	// ******************************* //
 	//                     //
 	// ******************************* //
@@ -221,6 +236,15 @@ int Init(HINSTANCE hInstance, int nCmdShow)
 		MessageBox(hWnd, "AZbgXg̃[hɎs܂Bt@CpXmFĂB", "G[", MB_OK);
 		return -1;
 	}
+	// UI ̃eNX`܂Ƃ߂AgX (Tools/AtlasPacker ōBΌʂ̃eNX`ŕ`悷)
+	assetManager.LoadAtlasList("Assets/CSV/AtlasList.csv");
+	// ނƂ̃\Z (ƎQƂĂȂ̂)
+	assetManager.SetBudget(Asset::AssetType::Texture, 256 * 1024 * 1024);
+	assetManager.SetBudget(Asset::AssetType::Model, 128 * 1024 * 1024);
+	assetManager.SetBudget(Asset::AssetType::Sound, 96 * 1024 * 1024);
+	assetManager.SetBudget(Asset::AssetType::Effect, 32 * 1024 * 1024);
+	// AssetPacker ōA[JCu΂ǂ (Όʂ̃t@Cǂ)
+	assetManager.MountArchive("Assets.pak");
 
 	/* @\ */
 	Geometory::Init();	// Geometory
@@ -263,6 +287,9 @@ void Update(float deltaTime)
 {
 	UpdateInput();
 
+	// 񓯊ǂݍ݂IAZbg̊ (GPU \[XE{CX̍쐬)
+	Asset::AssetManager::GetInstance().Update();
+
 	// V[}l[W[
 	SceneManager::Update(deltaTime);
 }
@@ -22,6 +22,7 @@
 #include "ECS/ECS.h"
 #include "ECS/ECSInitializer.h"
 #include "ECS/EntityFactory.h"
+#include "Systems/AssetManifest.h"
 #include "Systems/Input.h"
 #include <DirectXMath.h>
 #include <iostream>
@@ -377,6 +378,25 @@ namespace
 ECS::Coordinator* GameScene::s_coordinator = nullptr;
 std::string GameScene::s_StageNo = "";
 
+/**
+ * [void - CollectAssets]
+ * @brief	ステージ生成と Init で使うアセットを列挙する (LoadingScene での先読み用)
+ */
+void GameScene::CollectAssets(Asset::AssetManifest& manifest) const
+{
+    ECS::EntityFactory::CollectStageAssets(s_StageNo, manifest);
+
+    // GameControlSystem が鳴らす BGM・効果音 (未登録の BGM_TEST 等は除く)
+    for (const char* soundID : { "BGM_TOPVIEW", "BGM_GAME_1", "BGM_GAME_2", "SE_ALERT", "SE_ARREST", "SE_RUN", "SE_STEAL" })
+    {
+        manifest.AddSound(soundID);
+    }
+    manifest.AddTexture("BG_TOPVIEW");
+    manifest.AddTexture("UI_SCAN_LINE");
+    manifest.AddTexture("BG_GAME_OVER");
+    manifest.AddTexture("UI_SONAR");
+}
+
 void GameScene::Init()
 {
     // ECS
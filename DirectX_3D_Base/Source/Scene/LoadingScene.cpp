@@ -1,6 +1,6 @@
 /*****************************************************************//**
  * @file    LoadingScene.cpp
- * @brief   [hʁiLOADING\ + EUVAjj
+ * @brief   [hʁiLOADING\ + EUVAj + io[j
  *********************************************************************/
 
 #include "Scene/LoadingScene.h"
@@ -9,10 +9,12 @@
 
 #include "ECS/ECSInitializer.h"
 #include "ECS/Systems/UI/UIRenderSystem.h"
+#include "Systems/AssetManager.h"
 
 #include "Main.h" // SCREEN_WIDTH / SCREEN_HEIGHT
 
 #include <cmath> // ǉ: sin, abs
+#include <cstdio>
 
 namespace
 {
@@ -24,6 +26,8 @@ namespace
     }
 }
 
+std::function<Scene* ()> LoadingScene::s_nextSceneFactory = nullptr;
+
 LoadingScene::EntityHandle LoadingScene::SpawnUI(
     const char* assetId,
     float x, float y,
@@ -68,6 +72,20 @@ void LoadingScene::SetLoadAnimFrame(int frameIndex)
     // ui.uvPos.y = static_cast<float>(kRows - 1 - row) * ui.uvScale.y;
 }
 
+void LoadingScene::SetProgressBar(float ratio)
+{
+    if (!m_hasProgressBar) { return; }
+
+    if (ratio < 0.0f) ratio = 0.0f;
+    if (ratio > 1.0f) ratio = 1.0f;
+
+    // UI͒S̂߁A[Œ肵ĐL΂
+    auto& transform = m_coordinator->GetComponent<TransformComponent>(m_progressBarEntity);
+    const float width = m_progressBarWidth * ratio;
+    transform.scale.x = width;
+    transform.position.x = m_progressBarLeft + (width * 0.5f);
+}
+
 void LoadingScene::Init()
 {
     m_coordinator = std::make_shared<ECS::Coordinator>();
@@ -170,6 +188,49 @@ void LoadingScene::Init()
         // t[Kpiŏ1R}j
         SetLoadAnimFrame(m_loadAnimFrame);
     }
+
+    // ------------------------------------------------------------
+    // io[iLOADING ̏j
+    // ------------------------------------------------------------
+    {
+        constexpr float kBarHeight = 8.0f;
+        constexpr float kBarGap = 16.0f;
+        const float y = baseCenterY - (kLetterSize * 0.5f) - kBarGap;
+
+        m_progressBarLeft = startX;
+        m_progressBarWidth = lettersWidth;
+
+        // niÂO[j
+        (void)SpawnUI("FADE_WHITE", m_progressBarLeft + (m_progressBarWidth * 0.5f), y,
+            m_progressBarWidth, kBarHeight, kBaseDepth - 0.02f, 0.25f, 0.25f, 0.25f, 1.0f);
+
+        m_progressBarEntity = SpawnUI("FADE_WHITE", m_progressBarLeft, y,
+            0.0f, kBarHeight, kBaseDepth - 0.01f);
+        m_hasProgressBar = true;
+        SetProgressBar(0.0f);
+    }
+
+    // ------------------------------------------------------------
+    // ̃V[̃AZbgǂ
+    // ------------------------------------------------------------
+    if (s_nextSceneFactory)
+    {
+        m_nextScene = std::unique_ptr<Scene>(s_nextSceneFactory());
+        s_nextSceneFactory = nullptr;
+
+        Asset::AssetManifest manifest;
+        m_nextScene->CollectAssets(manifest);
+        m_progress = Asset::AssetManager::GetInstance().RequestManifest(manifest);
+
+        // Sēǂݍݍς݂Ȃ (gC) ҂ɐ؂ւ
+        m_needsWait = !m_progress->IsDone();
+        printf("[Info] LoadingScene: Preloading %zu assets (%zu already resident)\n",
+            m_progress->totalNum, m_progress->doneNum);
+    }
+    else
+    {
+        m_needsWait = true;
+    }
 }
 
 void LoadingScene::Uninit()
@@ -182,9 +243,14 @@ void LoadingScene::Uninit()
     m_textBaseY.clear();
 
     m_hasLoadAnim = false;
+    m_hasProgressBar = false;
     m_loadAnimTimer = 0.0f;
     m_loadAnimFrame = 0;
     m_elapsed = 0.0f;
+
+    // ؂ւOɔjꂽꍇAǂݍ݂̓LbVɎc莟Ɏg
+    m_nextScene.reset();
+    m_progress.reset();
 }
 
 void LoadingScene::Update(float deltaTime)
@@ -228,7 +294,27 @@ void LoadingScene::Update(float deltaTime)
         }
     }
 
-    if (m_elapsed >= m_minDisplaySec)
+    // io[XViʒm AssetManager::Update œ͂j
+    const bool isLoaded = !m_progress || m_progress->IsDone();
+    if (m_progress)
+    {
+        SetProgressBar(m_progress->GetRatio());
+    }
+    else
+    {
+        SetProgressBar(m_elapsed / m_minDisplaySec);
+    }
+
+    if (!isLoaded) { return; }
+    if (m_needsWait && m_elapsed < m_minDisplaySec) { return; }
+
+    if (m_nextScene)
+    {
+        printf("[Info] LoadingScene: Preloaded %zu assets in %.1f ms (%zu failed)\n",
+            m_progress->totalNum, m_progress->elapsedMs, m_progress->failedNum);
+        SceneManager::ChangeScene(std::move(m_nextScene));
+    }
+    else
     {
         SceneManager::ChangeScene<TitleScene>();
     }
@@ -858,7 +858,8 @@ void ResultScene::CreateButtons()
         []()
         {
             GameScene::SetStageNo(ResultScene::s_resultData.stageID);
-            SceneManager::ChangeScene<GameScene>();
+            MapPrefetcher::Request(ResultScene::s_resultData.stageID);
+            SceneManager::ChangeSceneWithLoading<GameScene>();
         }
     );
 
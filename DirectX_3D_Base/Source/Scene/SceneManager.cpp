@@ -19,12 +19,16 @@
 
 // ===== CN[h =====
 #include "Scene/SceneManager.h"
+#include "Systems/AssetManager.h"
 #include <iostream>
+#include <chrono>
 
 // ===== ÓIo[ϐ̒` =====
 std::unique_ptr<Scene> SceneManager::s_currentScene = nullptr;
 std::function<Scene* ()> SceneManager::s_nextSceneFactory = nullptr;
 std::unordered_map<std::type_index, std::function<Scene* ()>> SceneManager::s_sceneFactories;
+std::unique_ptr<Scene> SceneManager::s_preparedScene = nullptr;
+bool SceneManager::s_isFirstFrame = false;
 
 
 /**
@@ -32,8 +36,8 @@ std::unordered_map<std::type_index, std::function<Scene* ()>> SceneManager::s_sc
  */
 void SceneManager::ProcessSceneChange()
 {
-	// ̃V[̃t@Ng֐ݒ肳ĂȂΉȂ
-	if (!s_nextSceneFactory)
+	// ̃V[it@Ng֐ς݂̃V[jݒ肳ĂȂΉȂ
+	if (!s_nextSceneFactory && !s_preparedScene)
 	{
 		return;
 	}
@@ -49,13 +53,29 @@ void SceneManager::ProcessSceneChange()
 
 	// 2. VV[̐Ə
 	// t@Ng֐VScene*擾Aunique_ptrŏLǗ
-	Scene* newScene = s_nextSceneFactory();
-	s_currentScene = std::unique_ptr<Scene>(newScene);
+	// LoadingScene Őς݂̃V[΂g
+	if (s_preparedScene)
+	{
+		s_currentScene = std::move(s_preparedScene);
+	}
+	else
+	{
+		Scene* newScene = s_nextSceneFactory();
+		s_currentScene = std::unique_ptr<Scene>(newScene);
+	}
+
+	const auto startTime = std::chrono::steady_clock::now();
 	s_currentScene->Init();
+	const float initMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+	// VV[QƂŁAgȂȂAZbg
+	Asset::AssetManager::GetInstance().OnSceneChanged();
 
 	// 3. ؂ւvNA
 	s_nextSceneFactory = nullptr;
+	s_isFirstFrame = true;
 	std::cout << "SceneManager: New scene initialized and started." << std::endl;
+	printf("[Info] SceneManager: Scene Init %.2f ms\n", initMs);
 }
 
 void SceneManager::Init()
@@ -73,6 +93,7 @@ void SceneManager::Uninit()
 		s_currentScene.reset();
 		std::cout << "SceneManager: All scenes uninitialized and destroyed." << std::endl;
 	}
+	s_preparedScene.reset();
 
 	// t@Ng̃NA
 	s_sceneFactories.clear();
@@ -86,10 +107,25 @@ void SceneManager::Update(float deltaTime)
 	// ݂̃V[̍XV
 	if (s_currentScene)
 	{
+		const auto startTime = std::chrono::steady_clock::now();
 		s_currentScene->Update(deltaTime);
+
+		// ؂ւ1t[ ( Update œǂݍ݂ƂLт)
+		if (s_isFirstFrame)
+		{
+			s_isFirstFrame = false;
+			const float updateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+			printf("[Info] SceneManager: First Update %.2f ms\n", updateMs);
+		}
 	}
 }
 
+void SceneManager::ChangeScene(std::unique_ptr<Scene> scene)
+{
+	s_preparedScene = std::move(scene);
+	s_nextSceneFactory = nullptr;
+}
+
 void SceneManager::Draw()
 {
 	// ݂̃V[̕`揈
@@ -404,6 +404,9 @@ void StageSelectScene::Init()
 					m_selectedStageID = id;
 					UpdateBestTimeDigitsByStageId(m_selectedStageID);
 
+					// 詳細演出の間に迷路データをワーカースレッドで先行生成しておく
+					MapPrefetcher::Request(m_selectedStageID);
+
 					UpdateStarIconsByStageId(std::string());
 					m_starRevealPending = true;
 					m_starRevealStageId = m_selectedStageID;
@@ -745,7 +748,7 @@ void StageSelectScene::Init()
 
 				ScreenTransition::RequestFadeOutEx(
 					m_coordinator.get(), m_blackTransitionEntity, 0.15f, 0.35f, 0.45f,
-					[this]() { GameScene::SetStageNo(m_selectedStageID); SceneManager::ChangeScene<GameScene>(); },
+					[this]() { GameScene::SetStageNo(m_selectedStageID); SceneManager::ChangeSceneWithLoading<GameScene>(); },
 					false, nullptr, 0.0f, 0.35f, false, false
 				);
 			}
@@ -1024,7 +1027,7 @@ void StageSelectScene::Update(float deltaTime)
 				m_coordinator.get(), m_blackTransitionEntity, 0.15f, 0.35f, 0.45f,
 				[this]() {
 					GameScene::SetStageNo(m_selectedStageID);
-					SceneManager::ChangeScene<GameScene>();
+					SceneManager::ChangeSceneWithLoading<GameScene>();
 				},
 				false, nullptr, 0.0f, 0.35f, false, false
 			);
@@ -0,0 +1,132 @@
+﻿/*****************************************************************//**
+ * @file	AssetArchive.cpp
+ * @brief	アセットアーカイブ (.pak) のマウントと索引の検索
+ *
+ * @details	
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：マウント・索引の検索を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/AssetArchive.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Asset
+{
+	using namespace Pack;
+
+	bool AssetArchive::Mount(const char* file)
+	{
+		Unmount();
+		if (!m_file.Open(file)) return false;
+
+		// ヘッダーの確認
+		const std::uint8_t* pData = m_file.GetData();
+		const std::uint64_t fileSize = m_file.GetSize();
+		if (fileSize < sizeof(ArchiveHeader))
+		{
+			printf("[Warning] AssetArchive: '%s' is truncated\n", file);
+			m_file.Close();
+			return false;
+		}
+		const ArchiveHeader& header = *reinterpret_cast<const ArchiveHeader*>(pData);
+		if (header.magic != MAGIC || header.version != VERSION)
+		{
+			printf("[Warning] AssetArchive: '%s' is not a supported archive (version %u)\n", file, header.version);
+			m_file.Close();
+			return false;
+		}
+
+		// 索引・文字列がファイルに収まっているか
+		const std::uint64_t indexEnd = header.indexOffset + static_cast<std::uint64_t>(header.entryNum) * sizeof(EntryRecord);
+		const std::uint64_t stringsEnd = header.stringsOffset + header.stringsSize;
+		if (indexEnd > fileSize || stringsEnd > fileSize || header.indexOffset % alignof(EntryRecord) != 0 ||
+			(header.stringsSize > 0 && pData[stringsEnd - 1] != '\0'))
+		{
+			printf("[Warning] AssetArchive: '%s' has a broken index\n", file);
+			m_file.Close();
+			return false;
+		}
+
+		// 各データの範囲と並び順 (二分探索の前提) は一度だけ確認し、検索時には確認しない
+		const EntryRecord* pEntries = reinterpret_cast<const EntryRecord*>(pData + header.indexOffset);
+		for (std::uint32_t i = 0; i < header.entryNum; ++i)
+		{
+			const EntryRecord& entry = pEntries[i];
+			const bool isInside = entry.offset <= fileSize && entry.size <= fileSize - entry.offset;
+			const bool isSorted = (i == 0) || pEntries[i - 1] < entry;
+			const bool isPathValid = entry.path == NO_PATH || entry.path < header.stringsSize;
+			if (!isInside || !isSorted || !isPathValid)
+			{
+				printf("[Warning] AssetArchive: '%s' has a broken entry (%u)\n", file, i);
+				m_file.Close();
+				return false;
+			}
+		}
+
+		m_pEntries = pEntries;
+		m_entryNum = header.entryNum;
+		m_pStrings = reinterpret_cast<const char*>(pData + header.stringsOffset);
+		m_stringsSize = header.stringsSize;
+		printf("[Info] AssetArchive: mounted '%s' (%u entries, %.1fMB)\n",
+			file, m_entryNum, fileSize / (1024.0 * 1024.0));
+		return true;
+	}
+
+	void AssetArchive::Unmount()
+	{
+		m_pEntries = nullptr;
+		m_entryNum = 0;
+		m_pStrings = nullptr;
+		m_stringsSize = 0;
+		m_file.Close();
+	}
+
+	FileView AssetArchive::Find(std::uint8_t type, AssetHash key) const
+	{
+		const EntryRecord* pEntry = FindEntry(type, key);
+		return pEntry ? GetView(*pEntry) : FileView();
+	}
+
+	FileView AssetArchive::FindFile(const std::string& path) const
+	{
+		if (!IsMounted()) return FileView();
+
+		// 別のパスとハッシュが衝突していないよう、格納したパスとも比較する
+		const std::string normalized = NormalizePath(path);
+		const EntryRecord* pEntry = FindEntry(ENTRY_FILE, HashAssetID(normalized));
+		if (!pEntry || pEntry->path == NO_PATH || normalized != m_pStrings + pEntry->path) return FileView();
+		return GetView(*pEntry);
+	}
+
+	const EntryRecord* AssetArchive::FindEntry(std::uint8_t type, AssetHash key) const
+	{
+		if (!IsMounted()) return nullptr;
+
+		EntryRecord target = {};
+		target.key = key;
+		target.type = type;
+		const EntryRecord* pEnd = m_pEntries + m_entryNum;
+		const EntryRecord* pFound = std::lower_bound(m_pEntries, pEnd, target);
+		return (pFound != pEnd && pFound->key == key && pFound->type == type) ? pFound : nullptr;
+	}
+
+	FileView AssetArchive::GetView(const EntryRecord& entry) const
+	{
+		// 圧縮されたデータはコピーせずに渡せないため、元ファイルから読み込ませる
+		if (entry.compression != COMPRESSION_NONE) return FileView();
+		return FileView(m_file.GetData() + entry.offset, static_cast<std::size_t>(entry.size));
+	}
+}
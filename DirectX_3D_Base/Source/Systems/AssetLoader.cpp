@@ -0,0 +1,203 @@
+﻿/*****************************************************************//**
+ * @file	AssetLoader.cpp
+ * @brief	アセットの非同期読み込み (ワーカースレッドのジョブキュー) の実装
+ *
+ * @details	ジョブは m_jobs で Finish が済むまで保持し、状態 (未着手・実行中・完了) に応じて
+ *			m_queue / m_done のどちらかにも並べる。Finish は必ずメインスレッドで実行する。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ジョブキュー・メインスレッドでの完了処理・待機を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/AssetLoader.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Asset
+{
+	AssetLoader::~AssetLoader()
+	{
+		Stop();
+	}
+
+	void AssetLoader::Start(unsigned int threadNum, ThreadHook onThreadStart, ThreadHook onThreadEnd)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_threads.empty()) return;
+
+		m_isStopping = false;
+		for (unsigned int i = 0; i < threadNum; ++i)
+		{
+			m_threads.emplace_back(&AssetLoader::WorkerMain, this, onThreadStart, onThreadEnd);
+		}
+	}
+
+	void AssetLoader::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_queueCv.notify_all();
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+		m_threads.clear();
+
+		// 残ったジョブの後始末 (終了処理中はデバイスが解放済みの場合があるため、全て失敗扱いにする)
+		std::vector<JobPtr> rest;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (auto& pJob : m_done) rest.push_back(pJob);
+			for (auto& pJob : m_queue) rest.push_back(pJob);
+			m_done.clear();
+			m_queue.clear();
+		}
+		for (auto& pJob : rest)
+		{
+			pJob->result = false;
+			Complete(pJob);
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = false;
+	}
+
+	AssetLoader::JobID AssetLoader::Submit(Work work, Finish finish)
+	{
+		JobPtr pJob = std::make_shared<Job>();
+		pJob->work = std::move(work);
+		pJob->finish = std::move(finish);
+		pJob->state = JobState::Queued;
+		pJob->result = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			pJob->id = m_nextID++;
+			m_jobs[pJob->id] = pJob;
+			m_queue.push_back(pJob);
+		}
+		m_queueCv.notify_one();
+		return pJob->id;
+	}
+
+	size_t AssetLoader::Update(float budgetMs)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		size_t finishedNum = 0;
+		while (true)
+		{
+			JobPtr pJob;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (!m_done.empty())
+				{
+					pJob = m_done.front();
+					m_done.pop_front();
+				}
+				else if (m_threads.empty() && !m_queue.empty())
+				{
+					// ワーカーが無ければこのスレッドで実行する
+					pJob = m_queue.front();
+					m_queue.pop_front();
+					pJob->state = JobState::Running;
+				}
+			}
+			if (!pJob) break;
+
+			if (pJob->state == JobState::Running)
+			{
+				pJob->result = pJob->work ? pJob->work() : true;
+				pJob->state = JobState::Done;
+			}
+			Complete(pJob);
+			++finishedNum;
+
+			const float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+			if (budgetMs > 0.0f && elapsedMs >= budgetMs) break;
+		}
+		return finishedNum;
+	}
+
+	void AssetLoader::Wait(JobID id)
+	{
+		JobPtr pJob;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			auto it = m_jobs.find(id);
+			if (it == m_jobs.end()) return;	// 完了済み
+			pJob = it->second;
+
+			if (pJob->state == JobState::Queued)
+			{
+				// 未着手ならキューから外してこのスレッドで実行する
+				m_queue.erase(std::find(m_queue.begin(), m_queue.end(), pJob));
+				pJob->state = JobState::Running;
+				lock.unlock();
+				pJob->result = pJob->work ? pJob->work() : true;
+				pJob->state = JobState::Done;
+			}
+			else
+			{
+				m_doneCv.wait(lock, [&pJob]() { return pJob->state == JobState::Done; });
+				m_done.erase(std::find(m_done.begin(), m_done.end(), pJob));
+			}
+		}
+		Complete(pJob);
+	}
+
+	size_t AssetLoader::GetPendingNum() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_jobs.size();
+	}
+
+	void AssetLoader::WorkerMain(ThreadHook onThreadStart, ThreadHook onThreadEnd)
+	{
+		if (onThreadStart) onThreadStart();
+
+		while (true)
+		{
+			JobPtr pJob;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_queueCv.wait(lock, [this]() { return m_isStopping || !m_queue.empty(); });
+				if (m_isStopping) break;
+				pJob = m_queue.front();
+				m_queue.pop_front();
+				pJob->state = JobState::Running;
+			}
+
+			const bool result = pJob->work ? pJob->work() : true;
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				pJob->result = result;
+				pJob->state = JobState::Done;
+				m_done.push_back(pJob);
+			}
+			m_doneCv.notify_all();
+		}
+
+		if (onThreadEnd) onThreadEnd();
+	}
+
+	void AssetLoader::Complete(const JobPtr& pJob)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs.erase(pJob->id);
+		}
+		if (pJob->finish) pJob->finish(pJob->result);
+	}
+}
@@ -20,12 +20,71 @@
 // ===== インクルード =====
 #include "Systems/AssetManager.h"
 #include "Systems/DirectX/ShaderList.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 
 // シングルトンインスタンスの初期化
 Asset::AssetManager* Asset::AssetManager::s_instance = nullptr;
 
 namespace Asset
 {
+	// ----------------------------------------
+	// アセット表
+	// ----------------------------------------
+	AssetTable::AddResult AssetTable::Add(const AssetInfo& info, const AssetInfo** ppExisting)
+	{
+		auto it = m_indexMap.find(info.hash);
+		if (it != m_indexMap.end())
+		{
+			const AssetInfo* pExisting = m_infos[it->second].get();
+			if (ppExisting) *ppExisting = pExisting;
+			return (pExisting->assetID == info.assetID) ? AddResult::Duplicate : AddResult::Collision;
+		}
+
+		const std::uint32_t index = static_cast<std::uint32_t>(m_infos.size());
+		m_indexMap.emplace(info.hash, index);
+		m_infos.push_back(std::make_unique<AssetInfo>(info));
+
+		// 表の中の位置と常駐情報の持ち主は登録時に決まる
+		AssetInfo* pInfo = m_infos.back().get();
+		pInfo->handle = AssetHandle{ index, m_generation };
+		pInfo->residency = ResidencyEntry();
+		pInfo->residency.pOwner = pInfo;
+		pInfo->residency.slot = static_cast<int>(pInfo->type);
+		return AddResult::Added;
+	}
+
+	void AssetTable::Clear()
+	{
+		m_infos.clear();
+		m_indexMap.clear();
+		m_generation++; // 発行済みのハンドルを無効にする
+	}
+
+	AssetInfo* AssetTable::Find(const std::string& assetID)
+	{
+		return Get(FindHandle(assetID));
+	}
+
+	const AssetInfo* AssetTable::Find(const std::string& assetID) const
+	{
+		return const_cast<AssetTable*>(this)->Find(assetID);
+	}
+
+	AssetHandle AssetTable::FindHandle(const std::string& assetID) const
+	{
+		AssetHandle handle;
+		auto it = m_indexMap.find(HashAssetID(assetID));
+		// 未登録のIDが登録済みのIDと衝突している場合に備えて文字列も比較する
+		if (it != m_indexMap.end() && m_infos[it->second]->assetID == assetID)
+		{
+			handle.index = it->second;
+			handle.generation = m_generation;
+		}
+		return handle;
+	}
+
 	// ----------------------------------------
 	// ヘルパー関数
 	// ----------------------------------------
@@ -34,14 +93,14 @@ namespace Asset
 	 * @brief	汎用的なCSV読み込みとAssetInfoへの変換、マップへの格納を行うヘルパー関数。
 	 * 
 	 * @param	[in] csvPath 読み込むCSVファイルのパス
-	 * @param	[in] targetMap 格納対象のマップ（m_modelMapなど）
+	 * @param	[in] targetTable 格納対象の表（m_modelTableなど）
 	 * @param	[in] type アセットの種類（AssetType::Modelなど）
 	 * @return	true.成功 false.失敗
 	 * @note	（省略可）
 	 */
 	bool AssetManager::LoadAssetListInternal(
 		const std::string& csvPath,
-		std::map<std::string, AssetInfo>& targetMap,
+		AssetTable& targetTable,
 		AssetType type
 	)
 	{
@@ -69,18 +128,27 @@ namespace Asset
 				info.assetID = row[0];
 				info.filePath = row[2]; // 3列目 (インデックス2) がファイルパス
 				info.type = type;       // 呼び出し側で指定されたタイプを設定
+				info.hash = HashAssetID(info.assetID);
 
-				// IDが既に登録されていないか確認（重複防止）
-				if (targetMap.count(info.assetID))
+				// IDが既に登録されていないか、別のIDとハッシュが衝突していないか確認
+				const AssetInfo* pExisting = nullptr;
+				switch (targetTable.Add(info, &pExisting))
 				{
+				case AssetTable::AddResult::Duplicate:
 					std::cerr << "Warning: Duplicate Asset ID found: " << info.assetID
 						<< " in " << csvPath << ". Skipping." << std::endl;
-					continue;
-				}
+					break;
+
+				case AssetTable::AddResult::Collision:
+					std::cerr << "Error: Asset ID hash collision: '" << info.assetID << "' and '" << pExisting->assetID
+						<< "' in " << csvPath << ". Rename one of them. Skipping." << std::endl;
+					break;
 
-				targetMap[info.assetID] = info;
+				default:
+					break;
+				}
 			}
-			std::cout << "Successfully loaded " << targetMap.size() << " assets of type "
+			std::cout << "Successfully loaded " << targetTable.size() << " assets of type "
 				<< csvPath << " into manager." << std::endl;
 			return true;
 		}
@@ -101,27 +169,144 @@ namespace Asset
 	// ----------------------------------------
 	bool AssetManager::LoadModelList(const std::string& csvPath)
 	{
-		return LoadAssetListInternal(csvPath, m_modelMap, AssetType::Model);
+		return LoadAssetListInternal(csvPath, m_modelTable, AssetType::Model);
 	}
 
 	bool AssetManager::LoadTextureList(const std::string& csvPath)
 	{
-		return LoadAssetListInternal(csvPath, m_textureMap, AssetType::Texture);
+		return LoadAssetListInternal(csvPath, m_textureTable, AssetType::Texture);
 	}
 
 	bool AssetManager::LoadSoundList(const std::string& csvPath)
 	{
-		return LoadAssetListInternal(csvPath, m_soundMap, AssetType::Sound);
+		return LoadAssetListInternal(csvPath, m_soundTable, AssetType::Sound);
 	}
 
 	bool AssetManager::LoadAnimationList(const std::string& csvPath)
 	{
-		return LoadAssetListInternal(csvPath, m_animationMap, AssetType::Animation);
+		return LoadAssetListInternal(csvPath, m_animationTable, AssetType::Animation);
 	}
 
 	bool AssetManager::LoadEffectList(const std::string& csvPath)
 	{
-		return LoadAssetListInternal(csvPath, m_effectMap, AssetType::Effect);
+		return LoadAssetListInternal(csvPath, m_effectTable, AssetType::Effect);
+	}
+
+	/**
+	 * [bool - LoadAtlasList]
+	 * @brief	アトラスの一覧 (AssetID, PageID, PageFile, X, Y, Width, Height, PageWidth, PageHeight) を読み込む
+	 *
+	 * @param	[in] csvPath 読み込むCSVファイルのパス
+	 * @return	true.成功 false.一覧が無い・読み込めない
+	 * @note	範囲は画素単位で書かれているため、ここでページの大きさで割って UV にする
+	 */
+	bool AssetManager::LoadAtlasList(const std::string& csvPath)
+	{
+		Utility::CSVLoader::Data csvData;
+		try
+		{
+			csvData = Utility::CSVLoader::Load(csvPath);
+		}
+		catch (const std::runtime_error&)
+		{
+			printf("[Info] AssetManager: no atlas list at '%s', UI textures are drawn separately\n", csvPath.c_str());
+			return false;
+		}
+
+		size_t regionNum = 0;
+		for (size_t i = 1; i < csvData.size(); ++i)	// 1行目はヘッダー
+		{
+			const auto& row = csvData[i];
+			if (row.size() < 9 || row[0].empty())
+			{
+				continue;
+			}
+			float rect[6];	// X, Y, Width, Height, PageWidth, PageHeight
+			char* pEnd = nullptr;
+			bool isValid = true;
+			for (int n = 0; n < 6; ++n)
+			{
+				rect[n] = std::strtof(row[3 + n].c_str(), &pEnd);
+				isValid = isValid && pEnd != row[3 + n].c_str();
+			}
+			if (!isValid || rect[4] <= 0.0f || rect[5] <= 0.0f)
+			{
+				printf("[Warning] AssetManager: invalid atlas entry '%s', skipping\n", row[0].c_str());
+				continue;
+			}
+
+			// ページはテクスチャとして登録する (複数の行が同じページを指す)
+			if (!m_textureTable.Find(row[1]))
+			{
+				AssetInfo info;
+				info.assetID = row[1];
+				info.filePath = row[2];
+				info.type = AssetType::Texture;
+				info.hash = HashAssetID(info.assetID);
+				if (m_textureTable.Add(info) != AssetTable::AddResult::Added)
+				{
+					printf("[Error] AssetManager: atlas page ID '%s' collides with another texture, skipping\n", row[1].c_str());
+					continue;
+				}
+			}
+
+			AtlasRegion region;
+			region.assetID = row[0];
+			region.pageID = row[1];
+			region.uvPos = { rect[0] / rect[4], rect[1] / rect[5] };
+			region.uvScale = { rect[2] / rect[4], rect[3] / rect[5] };
+			if (!m_atlasMap.emplace(HashAssetID(region.assetID), region).second)
+			{
+				printf("[Warning] AssetManager: duplicate atlas entry '%s', skipping\n", region.assetID.c_str());
+				continue;
+			}
+			regionNum++;
+		}
+		printf("[Info] AssetManager: %zu textures resolved through the atlas\n", regionNum);
+		return true;
+	}
+
+	// ----------------------------------------
+	// アセットアーカイブ
+	// ----------------------------------------
+	bool AssetManager::MountArchive(const std::string& archivePath)
+	{
+		// 索引の種類は AssetType と同じ値で引く
+		static_assert(Pack::ENTRY_MODEL == static_cast<int>(AssetType::Model) &&
+			Pack::ENTRY_TEXTURE == static_cast<int>(AssetType::Texture) &&
+			Pack::ENTRY_SOUND == static_cast<int>(AssetType::Sound) &&
+			Pack::ENTRY_ANIMATION == static_cast<int>(AssetType::Animation) &&
+			Pack::ENTRY_EFFECT == static_cast<int>(AssetType::Effect), "Pack::EntryType must match AssetType");
+
+		const auto startTime = std::chrono::steady_clock::now();
+		if (!m_archive.Mount(archivePath.c_str()))
+		{
+			printf("[Info] AssetManager: no archive at '%s', loading loose files\n", archivePath.c_str());
+			return false;
+		}
+		printf("[Info] AssetManager: archive mounted in %.2f ms\n",
+			std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+		return true;
+	}
+
+	// ----------------------------------------
+	// アトラス
+	// ----------------------------------------
+	const AtlasRegion* AssetManager::FindAtlasRegion(const std::string& assetID) const
+	{
+		auto it = m_atlasMap.find(HashAssetID(assetID));
+		// 未登録のIDが登録済みのIDと衝突している場合に備えて文字列も比較する
+		return (it != m_atlasMap.end() && it->second.assetID == assetID) ? &it->second : nullptr;
+	}
+
+	AssetInfo* AssetManager::RequestSpriteTexture(AssetRef& ref, const AtlasRegion*& pRegion, const std::string& assetID, ReadyCallback callback)
+	{
+		// 解決済みなら範囲も前回のものを使う (assetID を変えたときは呼び出し側が ref を Reset する)
+		if (!m_textureTable.Get(ref.GetHandle()))
+		{
+			pRegion = FindAtlasRegion(assetID);
+		}
+		return RequestTexture(ref, pRegion ? pRegion->pageID : assetID, callback);
 	}
 
 	// ----------------------------------------
@@ -129,10 +314,9 @@ namespace Asset
 	// ----------------------------------------
 	std::string AssetManager::GetModelPath(const std::string& assetID) const
 	{
-		auto it = m_modelMap.find(assetID);
-		if (it != m_modelMap.end())
+		if (const AssetInfo* pInfo = m_modelTable.Find(assetID))
 		{
-			return it->second.filePath;
+			return pInfo->filePath;
 		}
 		std::cerr << "Error: Model Asset ID '" << assetID << "' not found." << std::endl;
 		return "";
@@ -140,10 +324,9 @@ namespace Asset
 
 	std::string AssetManager::GetTexturePath(const std::string& assetID) const
 	{
-		auto it = m_textureMap.find(assetID);
-		if (it != m_textureMap.end())
+		if (const AssetInfo* pInfo = m_textureTable.Find(assetID))
 		{
-			return it->second.filePath;
+			return pInfo->filePath;
 		}
 		std::cerr << "Error: Model Asset ID '" << assetID << "' not found." << std::endl;
 		return "";
@@ -151,10 +334,9 @@ namespace Asset
 
 	std::string AssetManager::GetSoundPath(const std::string& assetID) const
 	{
-		auto it = m_soundMap.find(assetID);
-		if (it != m_soundMap.end())
+		if (const AssetInfo* pInfo = m_soundTable.Find(assetID))
 		{
-			return it->second.filePath;
+			return pInfo->filePath;
 		}
 		std::cerr << "Error: Model Asset ID '" << assetID << "' not found." << std::endl;
 		return "";
@@ -162,10 +344,9 @@ namespace Asset
 
 	std::string AssetManager::GetAnimationPath(const std::string& assetID) const
 	{
-		auto it = m_animationMap.find(assetID);
-		if (it != m_animationMap.end())
+		if (const AssetInfo* pInfo = m_animationTable.Find(assetID))
 		{
-			return it->second.filePath;
+			return pInfo->filePath;
 		}
 		std::cerr << "Error: Animation Asset ID '" << assetID << "' not found." << std::endl;
 		return "";
@@ -173,10 +354,9 @@ namespace Asset
 
 	std::string AssetManager::GetEffectPath(const std::string& assetID) const
 	{
-		auto it = m_effectMap.find(assetID);
-		if (it != m_effectMap.end())
+		if (const AssetInfo* pInfo = m_effectTable.Find(assetID))
 		{
-			return it->second.filePath;
+			return pInfo->filePath;
 		}
 		std::cerr << "Error: Effect Asset ID '" << assetID << "' not found." << std::endl;
 		return "";
@@ -187,159 +367,480 @@ namespace Asset
 	// ----------------------------------------
 	AssetInfo* AssetManager::LoadModel(const std::string& assetID, float scale, Model::Flip flip)
 	{
-		auto it = m_modelMap.find(assetID);
-		if (it == m_modelMap.end())
-		{
-			std::cerr << "Error: Model Asset ID '" << assetID << "' not registered in CSV." << std::endl;
-			return nullptr;
-		}
+		AssetInfo* pInfo = RequestModel(assetID, scale, flip);
+		Wait(pInfo);
+		return (pInfo && pInfo->state == LoadState::Ready) ? pInfo : nullptr;
+	}
 
-		AssetInfo& info = it->second;
+	AssetInfo* AssetManager::LoadTexture(const std::string& assetID)
+	{
+		AssetInfo* pInfo = RequestTexture(assetID);
+		Wait(pInfo);
+		return (pInfo && pInfo->state == LoadState::Ready) ? pInfo : nullptr;
+	}
 
-		// 【キャッシュチェック】: 既にロード済みならそれを返す
-		if (info.pResource != nullptr)
-		{
-			// std::cout << "Model '" << assetID << "' already loaded. Returning cached resource." << std::endl;
-			return &info;
-		}
+	AssetInfo* AssetManager::LoadSound(const std::string& assetID)
+	{
+		AssetInfo* pInfo = RequestSound(assetID);
+		Wait(pInfo);
+		return (pInfo && pInfo->state == LoadState::Ready) ? pInfo : nullptr;
+	}
 
-		// 【新規ロード】: ファイルパスを取得し、ロードする
-		const std::string& filePath = info.filePath;
+	Effekseer::EffectRef AssetManager::LoadEffect(const std::string& assetID)
+	{
+		AssetInfo* pInfo = RequestEffect(assetID);
+		Wait(pInfo);
+		return GetEffect(assetID);
+	}
 
-		Model* newModel = new Model();
+	// ----------------------------------------
+	// 生成
+	// ----------------------------------------
+	AssetManager::AssetManager()
+	{
+		// 参照されなくなったアセットの解放は AssetResidency が決め、実際の破棄はここで行う
+		m_residency.SetEvictFunc([this](ResidencyEntry& entry)
+			{
+				Evict(*static_cast<AssetInfo*>(entry.pOwner));
+			});
+	}
 
-		if (newModel->Load(filePath.c_str(), scale, flip))
-		{
-			info.pResource = newModel; // 成功したらポインタをキャッシュ
-			std::cout << "Model '" << assetID << "' loaded successfully from " << filePath << std::endl;
-			return &info;
-		}
-		else
-		{
-			std::cerr << "Error: Failed to load model file: " << filePath << std::endl;
-			delete newModel; // ロード失敗時はインスタンスを解放
-			return nullptr;
-		}
+	// ----------------------------------------
+	// 非同期ロードインタフェース
+	// ----------------------------------------
+	AssetInfo* AssetManager::RequestModel(const std::string& assetID, float scale, Model::Flip flip, ReadyCallback callback)
+	{
+		return RequestModelInfo(FindAsset(m_modelTable, assetID, "Model"), scale, flip, callback);
 	}
 
-	AssetInfo* AssetManager::LoadTexture(const std::string& assetID)
+	AssetInfo* AssetManager::RequestModelInfo(AssetInfo* pInfo, float scale, Model::Flip flip, ReadyCallback callback)
 	{
-		auto it = m_textureMap.find(assetID);
-		if (it == m_textureMap.end())
-		{
-			std::cerr << "Error: Texture Asset ID '" << assetID << "' not registered in CSV." << std::endl;
-			return nullptr;
-		}
+		if (!pInfo || !BeginRequest(*pInfo, callback)) return pInfo;
+
+		// コンストラクタでデフォルトシェーダーを作成するため、生成はメインスレッドで行う
+		Model* newModel = new Model();
+		const std::string filePath = pInfo->filePath;
+		pInfo->jobID = m_loader.Submit(
+			[newModel, filePath, scale, flip]()
+			{
+				return newModel->LoadData(filePath.c_str(), scale, flip);
+			},
+			[this, pInfo, newModel](bool isSucceeded)
+			{
+				if (isSucceeded) isSucceeded = newModel->CreateDeviceResources();
+				if (isSucceeded)
+				{
+					pInfo->pResource = newModel;
+				}
+				else
+				{
+					delete newModel; // ロード失敗時はインスタンスを解放
+				}
+				FinishRequest(*pInfo, isSucceeded, isSucceeded ? newModel->GetMemorySize() : 0);
+			});
+		return pInfo;
+	}
 
-		AssetInfo& info = it->second;
+	AssetInfo* AssetManager::RequestTexture(const std::string& assetID, ReadyCallback callback)
+	{
+		return RequestTextureInfo(FindAsset(m_textureTable, assetID, "Texture"), callback);
+	}
 
-		// 【キャッシュチェック】: 既にロード済みならそれを返す
-		if (info.pResource != nullptr)
-		{
-			return &info;
-		}
+	AssetInfo* AssetManager::RequestTexture(AssetRef& ref, const std::string& assetID, ReadyCallback callback)
+	{
+		return RequestTextureInfo(ResolveRef(m_textureTable, ref, assetID, "Texture"), callback);
+	}
 
-		// 【新規ロード】: ファイルパスを取得し、Textureをロードする
-		const std::string& filePath = info.filePath;
+	AssetInfo* AssetManager::RequestTextureInfo(AssetInfo* pInfo, ReadyCallback callback)
+	{
+		if (!pInfo || !BeginRequest(*pInfo, callback)) return pInfo;
 
 		// Texture はヒープに確保し、pResource に格納する
 		// Textureクラスが、リソース解放をデストラクタで担うことを前提とします。
 		Texture* newTexture = new Texture();
+		const std::string filePath = pInfo->filePath;
+		const FileView packed = m_archive.Find(static_cast<std::uint8_t>(pInfo->type), pInfo->hash);
+		pInfo->jobID = m_loader.Submit(
+			[newTexture, filePath, packed]()
+			{
+				// アーカイブにあればマップした領域から直接展開する
+				if (packed) return SUCCEEDED(newTexture->Decode(packed.pData, packed.size, filePath.c_str()));
+				return SUCCEEDED(newTexture->Decode(filePath.c_str()));
+			},
+			[this, pInfo, newTexture](bool isSucceeded)
+			{
+				if (isSucceeded) isSucceeded = SUCCEEDED(newTexture->Upload());
+				if (isSucceeded)
+				{
+					pInfo->pResource = newTexture;
+				}
+				else
+				{
+					delete newTexture; // ロード失敗時はインスタンスを解放
+				}
+				FinishRequest(*pInfo, isSucceeded, isSucceeded ? newTexture->GetMemorySize() : 0);
+			});
+		return pInfo;
+	}
+
+	AssetInfo* AssetManager::RequestSound(const std::string& assetID, ReadyCallback callback)
+	{
+		return RequestSoundInfo(FindAsset(m_soundTable, assetID, "Sound"), callback);
+	}
+
+	AssetInfo* AssetManager::RequestSound(AssetRef& ref, const std::string& assetID, ReadyCallback callback)
+	{
+		return RequestSoundInfo(ResolveRef(m_soundTable, ref, assetID, "Sound"), callback);
+	}
+
+	AssetInfo* AssetManager::RequestSound(const AssetHandle& handle, ReadyCallback callback)
+	{
+		return RequestSoundInfo(m_soundTable.Get(handle), callback);
+	}
+
+	// BGM は長く全体を読み込むと大きいため、再生しながら読み込む
+	static bool IsStreamSound(const std::string& assetID)
+	{
+		return assetID.compare(0, 4, "BGM_") == 0;
+	}
+
+	AssetInfo* AssetManager::RequestSoundInfo(AssetInfo* pInfo, ReadyCallback callback)
+	{
+		if (!pInfo || !BeginRequest(*pInfo, callback)) return pInfo;
+
+		// SoundEffect はヒープに確保し、pResource に格納する
+		Audio::SoundEffect* newSound = new Audio::SoundEffect();
+		const std::string filePath = pInfo->filePath;
+		const FileView packed = m_archive.Find(static_cast<std::uint8_t>(pInfo->type), pInfo->hash);
+		const bool isStream = IsStreamSound(pInfo->assetID);
+		pInfo->jobID = m_loader.Submit(
+			[newSound, filePath, packed, isStream]()
+			{
+				// ストリーム再生はヘッダーのみ読み、波形は再生中に少しずつ読み込む
+				if (isStream)
+				{
+					if (packed) return newSound->LoadStream(packed.pData, packed.size, filePath);
+					return newSound->LoadStream(filePath);
+				}
+				// アーカイブにあれば波形データはマップした領域をそのまま再生する
+				if (packed) return newSound->LoadData(packed.pData, packed.size, filePath);
+				return newSound->LoadData(filePath);
+			},
+			[this, pInfo, newSound](bool isSucceeded)
+			{
+				if (isSucceeded) isSucceeded = newSound->CreateVoice();
+				if (isSucceeded)
+				{
+					pInfo->pResource = newSound;
+				}
+				else
+				{
+					delete newSound; // ロード失敗時はインスタンスを解放
+				}
+				FinishRequest(*pInfo, isSucceeded, isSucceeded ? newSound->GetMemorySize() : 0);
+			});
+		return pInfo;
+	}
 
-		// Texture::Load() のシグネチャを仮定 (Texture.hの構造に依存)
-		HRESULT hr = newTexture->Create(filePath.c_str());
-		if (!hr)
+	AssetInfo* AssetManager::RequestEffect(const std::string& assetID, ReadyCallback callback)
+	{
+		if (m_effekseerManager == nullptr)
 		{
-			info.pResource = newTexture; // 成功したらポインタをキャッシュ (void*)
-			std::cout << "Texture '" << assetID << "' loaded successfully from " << filePath << std::endl;
-			return &info;
+			return nullptr;
 		}
-		else
+		return RequestEffectInfo(FindAsset(m_effectTable, assetID, "Effect"), callback);
+	}
+
+	AssetInfo* AssetManager::RequestEffect(AssetRef& ref, const std::string& assetID, ReadyCallback callback)
+	{
+		if (m_effekseerManager == nullptr)
 		{
-			std::cerr << "Error: Failed to load texture file: " << filePath << std::endl;
-			delete newTexture; // ロード失敗時はインスタンスを解放
 			return nullptr;
 		}
+		return RequestEffectInfo(ResolveRef(m_effectTable, ref, assetID, "Effect"), callback);
 	}
 
-	AssetInfo* AssetManager::LoadSound(const std::string& assetID)
+	AssetInfo* AssetManager::RequestEffectInfo(AssetInfo* pInfo, ReadyCallback callback)
+	{
+		if (!pInfo || !BeginRequest(*pInfo, callback)) return pInfo;
+
+		// ファイルの読み込みだけをワーカーで行い、Effect の作成 (テクスチャ等の読み込みを含む) はメインスレッドで行う
+		// アーカイブにあればファイルを読まずにマップした領域を渡す
+		std::shared_ptr<std::vector<char>> pData = std::make_shared<std::vector<char>>();
+		const std::string filePath = pInfo->filePath;
+		const FileView packed = m_archive.Find(static_cast<std::uint8_t>(pInfo->type), pInfo->hash);
+		pInfo->jobID = m_loader.Submit(
+			[pData, filePath, packed]()
+			{
+				if (packed) return true;
+				std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+				if (!file) return false;
+				pData->resize(static_cast<size_t>(file.tellg()));
+				file.seekg(0, std::ios::beg);
+				return !pData->empty() && static_cast<bool>(file.read(pData->data(), pData->size()));
+			},
+			[this, pInfo, pData, filePath, packed](bool isSucceeded)
+			{
+				const void* pBytes = packed ? static_cast<const void*>(packed.pData) : pData->data();
+				const size_t size = packed ? packed.size : pData->size();
+				if (isSucceeded)
+				{
+					// マテリアル・テクスチャはエフェクトファイルと同じディレクトリから探す
+					std::string directory = filePath.substr(0, filePath.find_last_of("/\\") + 1);
+					std::u16string u16Directory(directory.begin(), directory.end());
+					Effekseer::EffectRef effect = Effekseer::Effect::Create(
+						m_effekseerManager, pBytes, static_cast<int32_t>(size), 1.0f, u16Directory.c_str());
+					isSucceeded = (effect != nullptr);
+					if (isSucceeded)
+					{
+						// マップに保存 (参照カウント+1)
+						m_effectRefMap[pInfo->hash] = effect;
+
+						// AssetInfoのpResourceは使わない (nullptrのままにするか、目印を入れる)
+						pInfo->pResource = (void*)1;
+					}
+				}
+				// エフェクト本体のメモリ量は取得できないため、ファイルサイズで代用する
+				FinishRequest(*pInfo, isSucceeded, isSucceeded ? size : 0);
+			});
+		return pInfo;
+	}
+
+	Effekseer::EffectRef AssetManager::GetEffect(const std::string& assetID) const
 	{
-		auto it = m_soundMap.find(assetID);
-		if (it == m_soundMap.end())
+		return GetEffect(m_effectTable.Find(assetID));
+	}
+
+	Effekseer::EffectRef AssetManager::GetEffect(const AssetInfo* pInfo) const
+	{
+		if (!pInfo) return nullptr;
+
+		auto it = m_effectRefMap.find(pInfo->hash);
+		if (it != m_effectRefMap.end())
 		{
-			std::cerr << "Error: Sound Asset ID '" << assetID << "' not registered in CSV." << std::endl;
-			return nullptr;
+			return it->second;
 		}
+		return nullptr;
+	}
+
+	std::shared_ptr<ManifestProgress> AssetManager::RequestManifest(const AssetManifest& manifest)
+	{
+		auto pProgress = std::make_shared<ManifestProgress>();
+		pProgress->totalNum = manifest.GetTotalNum();
 
-		AssetInfo& info = it->second;
+		const auto startTime = std::chrono::steady_clock::now();
+		auto onDone = [pProgress, startTime](bool isSucceeded)
+		{
+			pProgress->doneNum++;
+			if (!isSucceeded) pProgress->failedNum++;
+			if (pProgress->IsDone())
+			{
+				pProgress->elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+			}
+		};
+		auto callback = [onDone](AssetInfo& info) { onDone(info.state == LoadState::Ready); };
 
-		// 【キャッシュチェック】：既にロード済みならそれを返す
-		if (info.pResource != nullptr)
+		// 進捗が参照を持つため、読み込み終わってから次のシーンが使うまでの間に解放されることはない
+		for (const auto& entry : manifest.models)
+		{
+			const std::vector<std::string> animations = entry.animations;
+			AssetInfo* pInfo = RequestModel(entry.assetID, entry.scale, entry.flip,
+				[onDone, animations](AssetInfo& info)
+				{
+					Model* pModel = static_cast<Model*>(info.pResource);
+					if (info.state == LoadState::Ready && pModel)
+					{
+						// 重複は Model 側で除かれるため、既に関連付け済みでも問題ない
+						for (const auto& animeID : animations)
+						{
+							pModel->AddAnimation(animeID);
+						}
+					}
+					onDone(info.state == LoadState::Ready);
+				});
+			if (!pInfo) onDone(false);
+			else pProgress->refs.push_back(MakeRef(pInfo));
+		}
+		for (const auto& assetID : manifest.textures)
+		{
+			AssetInfo* pInfo = RequestTexture(assetID, callback);
+			if (!pInfo) onDone(false);
+			else pProgress->refs.push_back(MakeRef(pInfo));
+		}
+		for (const auto& assetID : manifest.sounds)
+		{
+			AssetInfo* pInfo = RequestSound(assetID, callback);
+			if (!pInfo) onDone(false);
+			else pProgress->refs.push_back(MakeRef(pInfo));
+		}
+		for (const auto& assetID : manifest.effects)
 		{
-			return &info;
+			AssetInfo* pInfo = RequestEffect(assetID, callback);
+			if (!pInfo) onDone(false);
+			else pProgress->refs.push_back(MakeRef(pInfo));
 		}
+		return pProgress;
+	}
 
-		// 【新規ロード】: ファイルパスを取得し、SoundEffectをロードする
-		const std::string& filePath = info.filePath;
+	void AssetManager::Update(float budgetMs)
+	{
+		m_residency.BeginFrame();
+		m_loader.Update(budgetMs);
+	}
 
-		// SoundEffect はヒープに確保し、pResource に格納する
-		Audio::SoundEffect* newSound = new Audio::SoundEffect();
+	// ----------------------------------------
+	// 参照数・常駐メモリ管理
+	// ----------------------------------------
+	AssetRef AssetManager::MakeRef(AssetInfo* pInfo)
+	{
+		if (!pInfo) return AssetRef();
+		return AssetRef(&m_residency, &pInfo->residency, pInfo->handle);
+	}
 
- 		if (newSound->Load(filePath)) // SoundEffect::Load()を呼び出す
+	void AssetManager::OnSceneChanged()
+	{
+		const size_t evictNum = m_residency.OnSceneChanged();
+
+		static const char* const typeNames[] = { "Model", "Texture", "Sound", "Animation", "Effect" };
+		const AssetType types[] = { AssetType::Model, AssetType::Texture, AssetType::Sound, AssetType::Animation, AssetType::Effect };
+		printf("[Info] AssetManager: scene changed, %zu assets evicted\n", evictNum);
+		for (int i = 0; i < static_cast<int>(sizeof(types) / sizeof(types[0])); i++)
 		{
-			info.pResource = newSound; // 成功したらポインタをキャッシュ (void*)
-			std::cout << "Sound '" << assetID << "' loaded successfully from " << filePath << std::endl;
-			return &info;
+			const ResidencyStats& stats = GetStats(types[i]);
+			if (stats.residentNum == 0 && stats.evictNum == 0) continue;
+			printf("[Info]   %-9s %4zu resident %7.1fMB / %s, hits %llu misses %llu, evicted %llu (%.1fMB)\n",
+				typeNames[i], stats.residentNum, stats.residentBytes / (1024.0 * 1024.0),
+				stats.budgetBytes ? (std::to_string(stats.budgetBytes / (1024 * 1024)) + "MB").c_str() : "unlimited",
+				static_cast<unsigned long long>(stats.hitNum), static_cast<unsigned long long>(stats.missNum),
+				static_cast<unsigned long long>(stats.evictNum), stats.evictedBytes / (1024.0 * 1024.0));
 		}
-		else
+	}
+
+	/**
+	 * [void - Evict]
+	 * @brief	参照されなくなったアセットのリソースを破棄し、未読み込みの状態に戻す
+	 * @note	再び要求されれば通常通り読み込み直す
+	 */
+	void AssetManager::Evict(AssetInfo& info)
+	{
+		switch (info.type)
 		{
-			std::cerr << "Error: Failed to load sound file: " << filePath << std::endl;
-			delete newSound; // ロード失敗時はインスタンスを解放
-			return nullptr;
+		case AssetType::Model:		delete static_cast<Model*>(info.pResource);				break;
+		case AssetType::Texture:	delete static_cast<Texture*>(info.pResource);			break;
+		case AssetType::Sound:		delete static_cast<Audio::SoundEffect*>(info.pResource);	break;
+		case AssetType::Effect:		m_effectRefMap.erase(info.hash);						break;
+		default:																				break;
 		}
+		info.pResource = nullptr;
+		info.state = LoadState::Unloaded;
+		printf("[Info] AssetManager: evicted '%s'\n", info.assetID.c_str());
 	}
 
-	Effekseer::EffectRef AssetManager::LoadEffect(const std::string& assetID)
+	void AssetManager::Wait(AssetInfo* pInfo)
 	{
-		// 1. 既にロード済みならマップから返す
-		auto it = m_effectRefMap.find(assetID);
-		if (it != m_effectRefMap.end())
+		if (pInfo && pInfo->state == LoadState::Pending)
 		{
-			return it->second;
+			m_loader.Wait(pInfo->jobID);
 		}
+	}
+
+	// ----------------------------------------
+	// 非同期読み込みの共通処理
+	// ----------------------------------------
+	/**
+	 * [void - StartLoader]
+	 * @brief	初回の読み込み要求でワーカースレッドを起動する。
+	 * @note	WIC (テクスチャの展開) が COM を使うため、各スレッドで COM を初期化する
+	 */
+	void AssetManager::StartLoader()
+	{
+		if (m_loader.GetThreadNum() > 0) return;
+
+		// メインスレッドの分を除き、1～4スレッド
+		const unsigned int coreNum = std::thread::hardware_concurrency();
+		const unsigned int threadNum = std::max(1u, std::min(4u, coreNum > 1 ? coreNum - 1 : 1u));
+		m_loader.Start(threadNum,
+			[]() { CoInitializeEx(nullptr, COINIT_MULTITHREADED); },
+			[]() { CoUninitialize(); });
+		printf("[Info] AssetManager: %u loader threads started\n", threadNum);
+	}
 
-		// 2. CSV情報からパスを取得
-		auto infoIt = m_effectMap.find(assetID); // ファイルパス用マップ
-		if (infoIt == m_effectMap.end())
+	AssetInfo* AssetManager::FindAsset(AssetTable& targetTable, const std::string& assetID, const char* typeName)
+	{
+		AssetInfo* pInfo = targetTable.Find(assetID);
+		if (!pInfo)
 		{
-			std::cerr << "Error: Effect Asset ID '" << assetID << "' not registered." << std::endl;
-			return nullptr;
+			std::cerr << "Error: " << typeName << " Asset ID '" << assetID << "' not registered in CSV." << std::endl;
 		}
+		return pInfo;
+	}
 
-		if (m_effekseerManager == nullptr)
+	AssetInfo* AssetManager::ResolveRef(AssetTable& targetTable, AssetRef& ref, const std::string& assetID, const char* typeName)
+	{
+		// 解決済みならハッシュ計算も文字列比較もせずに返す
+		if (AssetInfo* pInfo = targetTable.Get(ref.GetHandle()))
 		{
-			return nullptr;
+			return pInfo;
 		}
 
-		const std::string& filePath = infoIt->second.filePath;
-		std::wstring wFilePath(filePath.begin(), filePath.end());
+		AssetInfo* pInfo = targetTable.Find(assetID);
+		if (!pInfo)
+		{
+			std::cerr << "Error: " << typeName << " Asset ID '" << assetID << "' not registered in CSV." << std::endl;
+		}
+		ref = MakeRef(pInfo);
+		return pInfo;
+	}
 
-		// 3. ロード (スマートポインタが返る)
-		Effekseer::EffectRef effect = Effekseer::Effect::Create(m_effekseerManager, (const char16_t*)wFilePath.c_str());
+	bool AssetManager::BeginRequest(AssetInfo& info, ReadyCallback callback)
+	{
+		// 読み込み済み (または読み込み中) の要求はヒットとして数える
+		m_residency.Touch(info.residency, info.state != LoadState::Unloaded);
 
-		if (effect != nullptr)
+		switch (info.state)
 		{
-			// 4. マップに保存 (参照カウント+1)
-			m_effectRefMap[assetID] = effect;
+		case LoadState::Unloaded:
+			// 新規ロード
+			if (callback) info.callbacks.push_back(callback);
+			info.state = LoadState::Pending;
+			StartLoader();
+			return true;
+
+		case LoadState::Pending:
+			// 読み込み中なら完了時にまとめて通知する
+			if (callback) info.callbacks.push_back(callback);
+			return false;
+
+		default:
+			// 【キャッシュチェック】: 既に結果が出ていればその場で通知する
+			if (callback) callback(info);
+			return false;
+		}
+	}
 
-			// AssetInfoのpResourceは使わない (nullptrのままにするか、目印を入れる)
-			infoIt->second.pResource = (void*)1;
+	void AssetManager::FinishRequest(AssetInfo& info, bool isSucceeded, size_t bytes)
+	{
+		info.state = isSucceeded ? LoadState::Ready : LoadState::Failed;
+		info.jobID = AssetLoader::JOB_NONE;
+		if (isSucceeded)
+		{
+			std::cout << "Asset '" << info.assetID << "' loaded successfully from " << info.filePath << std::endl;
+		}
+		else
+		{
+			std::cerr << "Error: Failed to load asset file: " << info.filePath << std::endl;
+		}
 
-			std::cout << "Effect '" << assetID << "' loaded." << std::endl;
-			return effect;
+		// コールバックの中で別のアセットを要求できるよう、一覧を取り出してから呼ぶ
+		std::vector<ReadyCallback> callbacks;
+		callbacks.swap(info.callbacks);
+		for (auto& callback : callbacks)
+		{
+			callback(info);
 		}
 
-		return nullptr;
+		// 予算を超えた分の解放は、待っていたコールバックが参照を取った後に行う
+		if (isSucceeded) m_residency.OnResident(info.residency, bytes);
 	}
 
 	// ----------------------------------------
@@ -349,14 +850,17 @@ namespace Asset
 	{
 		std::cout << "AssetManager: Starting resource unloading..." << std::endl;
 
+		// 読み込み中のアセットを片付けてからワーカースレッドを止める
+		m_loader.Stop();
+
 		// ----------------------------------------------------
 		// ヘルパーテンプレートを使用して解放処理を共通化
 		// ----------------------------------------------------
-		auto unloadMap = [this](auto& assetMap, const std::string& typeName) {
+		auto unloadTable = [this](AssetTable& assetTable, const std::string& typeName) {
 			size_t releasedCount = 0;
-			for (auto& pair : assetMap)
+			for (auto& pInfo : assetTable)
 			{
-				AssetInfo& info = pair.second;
+				AssetInfo& info = *pInfo;
 				if (info.pResource != nullptr)
 				{
 					// モデルは new Model() で確保されているため delete
@@ -378,22 +882,30 @@ namespace Asset
 
 					info.pResource = nullptr;
 				}
+				info.state = LoadState::Unloaded;
+				m_residency.Forget(info.residency);
 			}
 			std::cout << "AssetManager: Unloaded " << releasedCount << " " << typeName << " resources." << std::endl;
-			assetMap.clear(); // マップから全てのエントリを削除
+			assetTable.Clear(); // 表から全てのエントリを削除 (発行済みのハンドルも無効になる)
 			};
 
 		m_effectRefMap.clear();
+		m_atlasMap.clear(); // ページはテクスチャの表と一緒に消える
 
 		// pResourceフラグのリセット
-		for (auto& pair : m_effectMap) pair.second.pResource = nullptr;
+		for (auto& pInfo : m_effectTable)
+		{
+			pInfo->pResource = nullptr;
+			pInfo->state = LoadState::Unloaded;
+			m_residency.Forget(pInfo->residency);
+		}
 
 		std::cout << "AssetManager: Effects unloaded." << std::endl;
 
 		// 実際には型安全を確保する必要がありますが、Modelについては new/delete が確実なため実装します。
-		unloadMap(m_modelMap, "Model");
-		unloadMap(m_textureMap, "Texture");
-		unloadMap(m_soundMap, "Sound");
+		unloadTable(m_modelTable, "Model");
+		unloadTable(m_textureTable, "Texture");
+		unloadTable(m_soundTable, "Sound");
 
 		std::cout << "AssetManager: Resource unloading completed." << std::endl;
 	}
@@ -406,9 +918,13 @@ namespace Asset
 		m_effectRefMap.clear();
 
 		// AssetInfo側のダミーフラグもリセット（念のため）
-		for (auto& pair : m_effectMap)
+		for (auto& pInfo : m_effectTable)
 		{
-			pair.second.pResource = nullptr;
+			// 読み込み中のものは完了時に登録されるため残す
+			if (pInfo->state == LoadState::Pending) continue;
+			pInfo->pResource = nullptr;
+			pInfo->state = LoadState::Unloaded;
+			m_residency.Forget(pInfo->residency);
 		}
 
 		std::cout << "AssetManager: Unloaded " << count << " Effect resources." << std::endl;
@@ -0,0 +1,220 @@
+﻿/*****************************************************************//**
+ * @file	AssetResidency.cpp
+ * @brief	アセットの参照数・常駐メモリ量の管理と LRU による解放の実装
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：参照数・予算・LRU 解放・統計を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/AssetResidency.h"
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace Asset
+{
+	// ----------------------------------------
+	// AssetRef
+	// ----------------------------------------
+	AssetRef::AssetRef(AssetResidency* pResidency, ResidencyEntry* pEntry, const AssetHandle& handle)
+		: m_pResidency(pResidency), m_pEntry(pEntry), m_handle(handle)
+	{
+		if (m_pResidency && m_pEntry) m_pResidency->AddRef(*m_pEntry);
+	}
+
+	AssetRef::AssetRef(const AssetRef& other)
+		: AssetRef(other.m_pResidency, other.m_pEntry, other.m_handle)
+	{
+	}
+
+	AssetRef::AssetRef(AssetRef&& other) noexcept
+		: m_pResidency(other.m_pResidency), m_pEntry(other.m_pEntry), m_handle(other.m_handle)
+	{
+		other.m_pResidency = nullptr;
+		other.m_pEntry = nullptr;
+		other.m_handle.Reset();
+	}
+
+	AssetRef& AssetRef::operator=(const AssetRef& other)
+	{
+		if (this != &other)
+		{
+			// 同じアセットを指している場合に参照数が一度 0 にならないよう、先に増やす
+			AssetRef copy(other);
+			*this = std::move(copy);
+		}
+		return *this;
+	}
+
+	AssetRef& AssetRef::operator=(AssetRef&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset();
+			m_pResidency = other.m_pResidency;
+			m_pEntry = other.m_pEntry;
+			m_handle = other.m_handle;
+			other.m_pResidency = nullptr;
+			other.m_pEntry = nullptr;
+			other.m_handle.Reset();
+		}
+		return *this;
+	}
+
+	void AssetRef::Reset()
+	{
+		if (m_pResidency && m_pEntry) m_pResidency->Release(*m_pEntry);
+		m_pResidency = nullptr;
+		m_pEntry = nullptr;
+		m_handle.Reset();
+	}
+
+	// ----------------------------------------
+	// AssetResidency
+	// ----------------------------------------
+	void AssetResidency::SetBudget(int slot, std::size_t bytes)
+	{
+		m_slots[slot].stats.budgetBytes = bytes;
+		EnforceBudget(slot);
+	}
+
+	void AssetResidency::Touch(ResidencyEntry& entry, bool isHit)
+	{
+		entry.lastUseFrame = m_frame;
+		ResidencyStats& stats = m_slots[entry.slot].stats;
+		if (isHit) stats.hitNum++;
+		else stats.missNum++;
+
+		// 参照されていなくても、使われたものは LRU の先頭へ
+		if (entry.isInLRU)
+		{
+			RemoveLRU(entry);
+			PushLRU(entry);
+		}
+	}
+
+	void AssetResidency::OnResident(ResidencyEntry& entry, std::size_t bytes)
+	{
+		if (entry.isResident) Forget(entry);
+
+		entry.bytes = bytes;
+		entry.isResident = true;
+		entry.lastUseFrame = m_frame;
+		ResidencyStats& stats = m_slots[entry.slot].stats;
+		stats.residentBytes += bytes;
+		stats.residentNum++;
+		if (entry.refCount == 0) PushLRU(entry);
+
+		EnforceBudget(entry.slot);
+	}
+
+	void AssetResidency::Forget(ResidencyEntry& entry)
+	{
+		if (!entry.isResident) return;
+
+		ResidencyStats& stats = m_slots[entry.slot].stats;
+		stats.residentBytes -= entry.bytes;
+		stats.residentNum--;
+		RemoveLRU(entry);
+		entry.bytes = 0;
+		entry.isResident = false;
+	}
+
+	void AssetResidency::AddRef(ResidencyEntry& entry)
+	{
+		if (entry.refCount == 0) RemoveLRU(entry);
+		entry.refCount++;
+	}
+
+	void AssetResidency::Release(ResidencyEntry& entry)
+	{
+		if (entry.refCount == 0) return;
+
+		entry.refCount--;
+		if (entry.refCount == 0 && entry.isResident)
+		{
+			// 解放はここでは行わず、予算超過・シーン切り替えまで残しておく
+			PushLRU(entry);
+		}
+	}
+
+	std::size_t AssetResidency::OnSceneChanged()
+	{
+		// 前回の切り替え以降に使われていないものを集めてから解放する (解放中に LRU が変わるため)
+		std::vector<ResidencyEntry*> victims;
+		for (Slot& slot : m_slots)
+		{
+			for (ResidencyEntry* pEntry : slot.lru)
+			{
+				if (pEntry->lastUseFrame < m_sceneMarkFrame) victims.push_back(pEntry);
+			}
+		}
+		for (ResidencyEntry* pEntry : victims)
+		{
+			Evict(*pEntry);
+		}
+
+		m_sceneMarkFrame = m_frame;
+		return victims.size();
+	}
+
+	void AssetResidency::Evict(ResidencyEntry& entry)
+	{
+		ResidencyStats& stats = m_slots[entry.slot].stats;
+		stats.evictNum++;
+		stats.evictedBytes += entry.bytes;
+		Forget(entry);
+		if (m_evictFunc) m_evictFunc(entry);
+	}
+
+	void AssetResidency::EnforceBudget(int slot)
+	{
+		Slot& target = m_slots[slot];
+		const std::size_t budget = target.stats.budgetBytes;
+		if (budget == 0) return;
+
+		// このフレームで使われたものは解放しない (読み込んだ直後に消さないため)
+		while (target.stats.residentBytes > budget && !target.lru.empty())
+		{
+			ResidencyEntry* pVictim = target.lru.back();
+			if (pVictim->lastUseFrame >= m_frame) break;
+			Evict(*pVictim);
+		}
+
+		// 参照中・使用中のものだけで超えている場合は解放できないため、超えた時に一度だけ知らせる
+		const bool isOverBudget = target.stats.residentBytes > budget;
+		if (isOverBudget && !target.isOverBudget)
+		{
+			printf("[Warning] AssetResidency: slot %d over budget (%.1f / %.1f MB, %zu unreferenced)\n",
+				slot, target.stats.residentBytes / (1024.0 * 1024.0), budget / (1024.0 * 1024.0), target.lru.size());
+		}
+		target.isOverBudget = isOverBudget;
+	}
+
+	void AssetResidency::PushLRU(ResidencyEntry& entry)
+	{
+		if (entry.isInLRU || !entry.isResident) return;
+
+		std::list<ResidencyEntry*>& lru = m_slots[entry.slot].lru;
+		entry.lruIt = lru.insert(lru.begin(), &entry);
+		entry.isInLRU = true;
+	}
+
+	void AssetResidency::RemoveLRU(ResidencyEntry& entry)
+	{
+		if (!entry.isInLRU) return;
+
+		m_slots[entry.slot].lru.erase(entry.lruIt);
+		entry.isInLRU = false;
+	}
+}
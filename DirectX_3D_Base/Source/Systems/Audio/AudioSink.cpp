@@ -0,0 +1,96 @@
+﻿/*****************************************************************//**
+ * @file	AudioSink.cpp
+ * @brief	ミキサーの出力先の実装
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：WAV ファイルへの書き出しを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/Audio/AudioSink.h"
+#include "Systems/Audio/AudioBackend.h"
+
+namespace
+{
+	void WriteU16(FILE* pFile, std::uint16_t value)
+	{
+		const std::uint8_t bytes[2] = { static_cast<std::uint8_t>(value), static_cast<std::uint8_t>(value >> 8) };
+		fwrite(bytes, 1, sizeof(bytes), pFile);
+	}
+
+	void WriteU32(FILE* pFile, std::uint32_t value)
+	{
+		const std::uint8_t bytes[4] = {
+			static_cast<std::uint8_t>(value), static_cast<std::uint8_t>(value >> 8),
+			static_cast<std::uint8_t>(value >> 16), static_cast<std::uint8_t>(value >> 24) };
+		fwrite(bytes, 1, sizeof(bytes), pFile);
+	}
+
+	// RIFF ヘッダー (44 バイト)。大きさは Close で書き直す
+	void WriteHeader(FILE* pFile, std::uint32_t sampleRate, std::uint16_t channels, std::uint32_t dataBytes)
+	{
+		const std::uint16_t blockAlign = static_cast<std::uint16_t>(channels * sizeof(float));
+		fwrite("RIFF", 1, 4, pFile);
+		WriteU32(pFile, 36 + dataBytes);
+		fwrite("WAVEfmt ", 1, 8, pFile);
+		WriteU32(pFile, 16);
+		WriteU16(pFile, Audio::WAVE_TAG_IEEE_FLOAT);
+		WriteU16(pFile, channels);
+		WriteU32(pFile, sampleRate);
+		WriteU32(pFile, sampleRate * blockAlign);
+		WriteU16(pFile, blockAlign);
+		WriteU16(pFile, 32);
+		fwrite("data", 1, 4, pFile);
+		WriteU32(pFile, dataBytes);
+	}
+}
+
+namespace Audio
+{
+	bool WavFileAudioSink::Open(const std::string& filePath, std::uint32_t sampleRate, std::uint16_t channels)
+	{
+		Close();
+		m_pFile = fopen(filePath.c_str(), "wb");
+		if (!m_pFile)
+		{
+			printf("[Error] WavFileAudioSink: cannot open '%s'\n", filePath.c_str());
+			return false;
+		}
+		m_channels = channels;
+		m_dataBytes = 0;
+		WriteHeader(m_pFile, sampleRate, channels, 0);
+		return true;
+	}
+
+	void WavFileAudioSink::Close()
+	{
+		if (!m_pFile) return;
+
+		// RIFF と data の大きさを確定する
+		fseek(m_pFile, 4, SEEK_SET);
+		WriteU32(m_pFile, 36 + m_dataBytes);
+		fseek(m_pFile, 40, SEEK_SET);
+		WriteU32(m_pFile, m_dataBytes);
+		fclose(m_pFile);
+		m_pFile = nullptr;
+	}
+
+	bool WavFileAudioSink::Write(const float* pFrames, std::uint32_t frames)
+	{
+		if (!m_pFile) return false;
+		// float はリトルエンディアンの環境 (x86 / x64) を前提にそのまま書く
+		const size_t count = static_cast<size_t>(frames) * m_channels;
+		if (fwrite(pFrames, sizeof(float), count, m_pFile) != count) return false;
+		m_dataBytes += static_cast<std::uint32_t>(count * sizeof(float));
+		return true;
+	}
+}
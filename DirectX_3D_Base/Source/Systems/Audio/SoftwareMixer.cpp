@@ -0,0 +1,490 @@
+﻿/*****************************************************************//**
+ * @file	SoftwareMixer.cpp
+ * @brief	ソフトウェアミキサーの実装
+ *
+ * @details	ボイスごとに BLOCK_FRAMES ずつ、出力のレートへ変換した波形を作業用の配列へ書き
+ *			(音量は掛けず、整数のサンプルは正規化もしない)、
+ *			正規化・音量・パンをまとめた左右の倍率を掛けながら出力へ足し込む。
+ *			変換は1サンプルずつの処理になるが、足し込みはボイス数 × フレーム数の回数だけ行うため SIMD にする。
+ *
+ *			読み込み位置は 32.32 の固定小数点で持ち、ピッチ 1・同じレートの場合は補間をせずに写す。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：リサンプル・音量・パン・SIMD による足し込みを行うミキサーを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/Audio/SoftwareMixer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define MIXER_X86_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC は /arch の指定が無くても AVX の組み込み関数を使える
+#define MIXER_TARGET_AVX
+#else
+#define MIXER_TARGET_AVX __attribute__((target("avx")))
+#endif
+#endif
+
+namespace
+{
+	using Audio::SoftwareMixer;
+
+	const std::uint64_t POSITION_ONE = 1ull << 32;		// 読み込み位置の 1 フレーム
+	const float POSITION_TO_FRACTION = 1.0f / 4294967296.0f;
+
+	// サンプルの種類 (作業用の配列には正規化せずに書き、Mix で倍率に含める)
+	enum class SampleType
+	{
+		UInt8,
+		Int16,
+		Float32,
+	};
+
+	inline float ReadSample(const std::uint8_t* p) { return static_cast<float>(static_cast<int>(*p) - 128); }
+	inline float ReadSample(const std::int16_t* p) { return static_cast<float>(*p); }
+	inline float ReadSample(const float* p) { return *p; }
+
+	// ----------------------------------------
+	// 足し込み : pOut[i] += pIn[i] * (i が偶数なら left、奇数なら right)
+	// ----------------------------------------
+	void AccumulateScalar(float* pOut, const float* pIn, std::uint32_t frames, float left, float right)
+	{
+		for (std::uint32_t i = 0; i < frames; ++i)
+		{
+			pOut[i * 2 + 0] += pIn[i * 2 + 0] * left;
+			pOut[i * 2 + 1] += pIn[i * 2 + 1] * right;
+		}
+	}
+
+#ifdef MIXER_X86_SIMD
+	void AccumulateSSE(float* pOut, const float* pIn, std::uint32_t frames, float left, float right)
+	{
+		const __m128 gains = _mm_setr_ps(left, right, left, right);
+		const std::uint32_t count = frames * 2;
+		std::uint32_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m128 a = _mm_add_ps(_mm_loadu_ps(pOut + i), _mm_mul_ps(_mm_loadu_ps(pIn + i), gains));
+			const __m128 b = _mm_add_ps(_mm_loadu_ps(pOut + i + 4), _mm_mul_ps(_mm_loadu_ps(pIn + i + 4), gains));
+			_mm_storeu_ps(pOut + i, a);
+			_mm_storeu_ps(pOut + i + 4, b);
+		}
+		AccumulateScalar(pOut + i, pIn + i, (count - i) / 2, left, right);
+	}
+
+	MIXER_TARGET_AVX void AccumulateAVX(float* pOut, const float* pIn, std::uint32_t frames, float left, float right)
+	{
+		const __m256 gains = _mm256_setr_ps(left, right, left, right, left, right, left, right);
+		const std::uint32_t count = frames * 2;
+		std::uint32_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m256 a = _mm256_add_ps(_mm256_loadu_ps(pOut + i), _mm256_mul_ps(_mm256_loadu_ps(pIn + i), gains));
+			const __m256 b = _mm256_add_ps(_mm256_loadu_ps(pOut + i + 8), _mm256_mul_ps(_mm256_loadu_ps(pIn + i + 8), gains));
+			_mm256_storeu_ps(pOut + i, a);
+			_mm256_storeu_ps(pOut + i + 8, b);
+		}
+		AccumulateScalar(pOut + i, pIn + i, (count - i) / 2, left, right);
+	}
+#endif
+}
+
+namespace Audio
+{
+	// ----------------------------------------
+	// ボイス
+	// ----------------------------------------
+	class SoftwareMixer::Voice : public AudioVoice
+	{
+	public:
+		Voice(SoftwareMixer* pMixer, const WaveFormat& format, SampleType type, Callback* pCallback)
+			: m_pMixer(pMixer)
+			, m_pCallback(pCallback)
+			, m_type(type)
+			, m_channels(format.channels)
+			, m_frameBytes(format.blockAlign)
+			, m_sourceRate(format.sampleRate)
+		{
+			UpdateStep();
+		}
+
+		~Voice() override
+		{
+			std::lock_guard<std::mutex> lock(m_pMixer->m_mutex);
+			auto& voices = m_pMixer->m_voices;
+			voices.erase(std::remove(voices.begin(), voices.end(), this), voices.end());
+		}
+
+		bool Submit(const AudioBuffer& buffer) override
+		{
+			std::lock_guard<std::mutex> lock(m_pMixer->m_mutex);
+			if (m_queueNum == MAX_QUEUED_BUFFERS || !buffer.pData || buffer.bytes < m_frameBytes) return false;
+			if (m_queueNum == 0)
+			{
+				m_position = 0;
+				m_loopsLeft = buffer.loopCount;
+			}
+			m_queue[(m_queueHead + m_queueNum) % MAX_QUEUED_BUFFERS] = buffer;
+			m_queueNum++;
+			return true;
+		}
+
+		bool Start() override
+		{
+			std::lock_guard<std::mutex> lock(m_pMixer->m_mutex);
+			m_isStarted = true;
+			return true;
+		}
+
+		void Stop() override
+		{
+			std::lock_guard<std::mutex> lock(m_pMixer->m_mutex);
+			m_isStarted = false;
+			while (m_queueNum > 0) PopFront();
+			m_position = 0;
+		}
+
+		bool IsActive() const override
+		{
+			std::lock_guard<std::mutex> lock(m_pMixer->m_mutex);
+			return m_queueNum > 0;
+		}
+
+		void SetVolume(float volume) override
+		{
+			std::lock_guard<std::mutex> lock(m_pMixer->m_mutex);
+			m_volume = volume;
+		}
+
+		void SetPan(float pan) override
+		{
+			std::lock_guard<std::mutex> lock(m_pMixer->m_mutex);
+			m_pan = pan;
+		}
+
+		void SetPitch(float pitch) override
+		{
+			std::lock_guard<std::mutex> lock(m_pMixer->m_mutex);
+			m_pitch = ClampPitch(pitch);
+			UpdateStep();
+		}
+
+		// ----- 以下はミキサーのロック中に呼ぶ -----
+		bool IsPlaying() const { return m_isStarted && m_queueNum > 0; }
+
+		// 作業用の値に掛ける左右の倍率 (正規化・音量・パン)
+		void GetGains(float* pLeft, float* pRight) const
+		{
+			const float scale = (m_type == SampleType::Int16) ? 1.0f / 32768.0f : (m_type == SampleType::UInt8) ? 1.0f / 128.0f : 1.0f;
+			CalcPanGains(m_pan, pLeft, pRight);
+			*pLeft *= m_volume * scale;
+			*pRight *= m_volume * scale;
+		}
+
+		/**
+		 * [std::uint32_t - Render]
+		 * @brief	最大 frames フレームを出力のレートへ変換して pOut (ステレオ) へ書く
+		 * @return	書いたフレーム数 (キューが尽きると frames より少なくなる)
+		 */
+		std::uint32_t Render(float* pOut, std::uint32_t frames)
+		{
+			switch (m_type)
+			{
+			case SampleType::UInt8:	return (m_channels == 1) ? RenderAs<std::uint8_t, 1>(pOut, frames) : RenderAs<std::uint8_t, 2>(pOut, frames);
+			case SampleType::Int16:	return (m_channels == 1) ? RenderAs<std::int16_t, 1>(pOut, frames) : RenderAs<std::int16_t, 2>(pOut, frames);
+			default:				return (m_channels == 1) ? RenderAs<float, 1>(pOut, frames) : RenderAs<float, 2>(pOut, frames);
+			}
+		}
+
+	private:
+		void UpdateStep()
+		{
+			const double step = static_cast<double>(m_pitch) * m_sourceRate / m_pMixer->m_sampleRate;
+			m_step = static_cast<std::uint64_t>(std::llround(step * static_cast<double>(POSITION_ONE)));
+		}
+
+		// 先頭のバッファを捨てて通知する
+		void PopFront()
+		{
+			m_queueHead = (m_queueHead + 1) % MAX_QUEUED_BUFFERS;
+			m_queueNum--;
+			m_loopsLeft = (m_queueNum > 0) ? m_queue[m_queueHead].loopCount : 0;
+			if (m_pCallback) m_pCallback->OnBufferEnd();
+		}
+
+		// 先頭のバッファを読み終えた。繰り返すか次のバッファへ進み、読むものが無ければ false
+		bool Advance()
+		{
+			if (m_loopsLeft > 0)
+			{
+				if (m_loopsLeft != AUDIO_LOOP_INFINITE) m_loopsLeft--;
+				return true;
+			}
+			PopFront();
+			if (m_queueNum == 0) m_position = 0;
+			return m_queueNum > 0;
+		}
+
+		template<typename T, int CH>
+		std::uint32_t RenderAs(float* pOut, std::uint32_t frames)
+		{
+			std::uint32_t written = 0;
+			while (written < frames && m_queueNum > 0)
+			{
+				const AudioBuffer& buffer = m_queue[m_queueHead];
+				const T* pSamples = reinterpret_cast<const T*>(buffer.pData);
+				const std::uint32_t bufferFrames = buffer.bytes / m_frameBytes;
+
+				if (m_step == POSITION_ONE)
+				{
+					// 同じレート : 補間せずに写す
+					std::uint32_t index = static_cast<std::uint32_t>(m_position >> 32);
+					const std::uint32_t count = (std::min)(frames - written, bufferFrames > index ? bufferFrames - index : 0u);
+					for (std::uint32_t i = 0; i < count; ++i, ++index, ++written)
+					{
+						const float l = ReadSample(pSamples + index * CH);
+						pOut[written * 2 + 0] = l;
+						pOut[written * 2 + 1] = (CH == 2) ? ReadSample(pSamples + index * CH + 1) : l;
+					}
+					m_position = static_cast<std::uint64_t>(index) << 32;
+				}
+				else
+				{
+					// 線形補間 (最後のフレームの次は、繰り返しの先頭か次のバッファの先頭を使う)
+					const T* pNext = GetNextFrame(pSamples + (bufferFrames > 0 ? bufferFrames - 1 : 0) * CH);
+					while (written < frames)
+					{
+						const std::uint32_t index = static_cast<std::uint32_t>(m_position >> 32);
+						if (index >= bufferFrames) break;
+						const float t = static_cast<float>(static_cast<std::uint32_t>(m_position)) * POSITION_TO_FRACTION;
+						const T* p0 = pSamples + index * CH;
+						const T* p1 = (index + 1 < bufferFrames) ? p0 + CH : pNext;
+						const float l0 = ReadSample(p0);
+						const float l = l0 + (ReadSample(p1) - l0) * t;
+						float r = l;
+						if (CH == 2)
+						{
+							const float r0 = ReadSample(p0 + 1);
+							r = r0 + (ReadSample(p1 + 1) - r0) * t;
+						}
+						pOut[written * 2 + 0] = l;
+						pOut[written * 2 + 1] = r;
+						m_position += m_step;
+						written++;
+					}
+				}
+
+				// 読み終えたら繰り返すか次のバッファへ (ピッチが高いと複数バッファを飛ばすことがある)
+				while (m_queueNum > 0 && (m_position >> 32) >= m_queue[m_queueHead].bytes / m_frameBytes)
+				{
+					m_position -= static_cast<std::uint64_t>(m_queue[m_queueHead].bytes / m_frameBytes) << 32;
+					if (!Advance()) break;
+				}
+			}
+			return written;
+		}
+
+		// 先頭のバッファの最後のフレームの次に鳴るフレーム (無ければ pLast をそのまま伸ばす)
+		template<typename T>
+		const T* GetNextFrame(const T* pLast) const
+		{
+			if (m_loopsLeft > 0) return reinterpret_cast<const T*>(m_queue[m_queueHead].pData);
+			if (m_queueNum > 1)
+			{
+				const AudioBuffer& next = m_queue[(m_queueHead + 1) % MAX_QUEUED_BUFFERS];
+				if (next.bytes >= m_frameBytes) return reinterpret_cast<const T*>(next.pData);
+			}
+			return pLast;
+		}
+
+	private:
+		SoftwareMixer* m_pMixer;
+		Callback* m_pCallback;
+		const SampleType m_type;
+		const int m_channels;
+		const std::uint32_t m_frameBytes;
+		const std::uint32_t m_sourceRate;
+
+		AudioBuffer m_queue[MAX_QUEUED_BUFFERS];
+		int m_queueHead = 0;
+		int m_queueNum = 0;
+		std::uint32_t m_loopsLeft = 0;		// 先頭のバッファの残りの繰り返し回数
+		std::uint64_t m_position = 0;		// 先頭のバッファ内の読み込み位置 (32.32)
+		std::uint64_t m_step = POSITION_ONE;	// 出力 1 フレームあたりに進む量
+
+		bool m_isStarted = false;
+		float m_volume = 1.0f;
+		float m_pan = 0.0f;
+		float m_pitch = 1.0f;
+	};
+
+	// ----------------------------------------
+	// ミキサー
+	// ----------------------------------------
+	SoftwareMixer::SoftwareMixer(std::uint32_t sampleRate)
+		: m_sampleRate(sampleRate)
+		, m_simdLevel(GetSupportedSimdLevel())
+		, m_scratch(BLOCK_FRAMES * CHANNEL_NUM)
+	{
+	}
+
+	SoftwareMixer::~SoftwareMixer()
+	{
+		StopOutput();
+		if (!m_voices.empty())
+		{
+			printf("[Warning] SoftwareMixer: %d voice(s) outlive the mixer\n", static_cast<int>(m_voices.size()));
+		}
+	}
+
+	std::unique_ptr<AudioVoice> SoftwareMixer::CreateVoice(const WaveFormat& format, AudioVoice::Callback* pCallback)
+	{
+		// WAVE_FORMAT_EXTENSIBLE は SubFormat (GUID) の先頭2バイトが実際のフォーマットタグ
+		std::uint16_t formatTag = format.formatTag;
+		if (formatTag == WAVE_TAG_EXTENSIBLE && format.extraSize >= 22)
+		{
+			const std::uint8_t* pSubFormat = reinterpret_cast<const std::uint8_t*>(&format + 1) + 6;
+			formatTag = static_cast<std::uint16_t>(pSubFormat[0] | (pSubFormat[1] << 8));
+		}
+
+		SampleType type;
+		if (formatTag == WAVE_TAG_PCM && format.bitsPerSample == 8) type = SampleType::UInt8;
+		else if (formatTag == WAVE_TAG_PCM && format.bitsPerSample == 16) type = SampleType::Int16;
+		else if (formatTag == WAVE_TAG_IEEE_FLOAT && format.bitsPerSample == 32) type = SampleType::Float32;
+		else
+		{
+			printf("[Warning] SoftwareMixer: unsupported format (tag 0x%04X, %u bit)\n", formatTag, format.bitsPerSample);
+			return nullptr;
+		}
+		if ((format.channels != 1 && format.channels != 2) || format.sampleRate == 0 ||
+			format.blockAlign != format.channels * format.bitsPerSample / 8)
+		{
+			printf("[Warning] SoftwareMixer: unsupported layout (%u ch, %u Hz)\n", format.channels, format.sampleRate);
+			return nullptr;
+		}
+
+		std::unique_ptr<Voice> pVoice(new Voice(this, format, type, pCallback));
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_voices.push_back(pVoice.get());
+		return pVoice;
+	}
+
+	void SoftwareMixer::Mix(float* pOut, std::uint32_t frames)
+	{
+		void (*accumulate)(float*, const float*, std::uint32_t, float, float) = AccumulateScalar;
+#ifdef MIXER_X86_SIMD
+		if (m_simdLevel == SimdLevel::AVX) accumulate = AccumulateAVX;
+		else if (m_simdLevel == SimdLevel::SSE) accumulate = AccumulateSSE;
+#endif
+
+		memset(pOut, 0, sizeof(float) * frames * CHANNEL_NUM);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (Voice* pVoice : m_voices)
+		{
+			if (!pVoice->IsPlaying()) continue;
+
+			float left, right;
+			pVoice->GetGains(&left, &right);
+			for (std::uint32_t offset = 0; offset < frames; offset += BLOCK_FRAMES)
+			{
+				const std::uint32_t count = (std::min)(frames - offset, static_cast<std::uint32_t>(BLOCK_FRAMES));
+				const std::uint32_t rendered = pVoice->Render(m_scratch.data(), count);
+				accumulate(pOut + offset * CHANNEL_NUM, m_scratch.data(), rendered, left, right);
+				if (rendered < count) break;
+			}
+		}
+	}
+
+	bool SoftwareMixer::StartOutput(AudioSink* pSink, bool isRealTime)
+	{
+		if (!pSink || m_outputThread.joinable()) return false;
+		m_isOutputStopping = false;
+		m_outputThread = std::thread(&SoftwareMixer::OutputThreadMain, this, pSink, isRealTime);
+		return true;
+	}
+
+	void SoftwareMixer::StopOutput()
+	{
+		if (!m_outputThread.joinable()) return;
+		m_isOutputStopping = true;
+		m_outputThread.join();
+	}
+
+	int SoftwareMixer::GetActiveVoiceNum()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		int num = 0;
+		for (Voice* pVoice : m_voices)
+		{
+			if (pVoice->IsPlaying()) num++;
+		}
+		return num;
+	}
+
+	void SoftwareMixer::SetSimdLevel(SimdLevel level)
+	{
+		m_simdLevel = (std::min)(level, GetSupportedSimdLevel());
+	}
+
+	SoftwareMixer::SimdLevel SoftwareMixer::GetSupportedSimdLevel()
+	{
+#ifdef MIXER_X86_SIMD
+#if defined(_MSC_VER)
+		// AVX は CPU の対応 (CPUID) に加えて、OS が YMM レジスタを保存するか (XGETBV) も確認する
+		int info[4];
+		__cpuid(info, 1);
+		const bool isOsxsave = (info[2] & (1 << 27)) != 0;
+		const bool isAvx = (info[2] & (1 << 28)) != 0;
+		if (isOsxsave && isAvx && (_xgetbv(0) & 0x6) == 0x6) return SimdLevel::AVX;
+		return SimdLevel::SSE;	// x86 / x64 の MSVC は SSE2 を前提とする
+#else
+		if (__builtin_cpu_supports("avx")) return SimdLevel::AVX;
+		if (__builtin_cpu_supports("sse")) return SimdLevel::SSE;
+		return SimdLevel::Scalar;
+#endif
+#else
+		return SimdLevel::Scalar;
+#endif
+	}
+
+	void SoftwareMixer::OutputThreadMain(AudioSink* pSink, bool isRealTime)
+	{
+		std::vector<float> block(BLOCK_FRAMES * CHANNEL_NUM);
+		const auto startTime = std::chrono::steady_clock::now();
+		std::uint64_t writtenFrames = 0;
+		while (!m_isOutputStopping)
+		{
+			Mix(block.data(), BLOCK_FRAMES);
+			if (!pSink->Write(block.data(), BLOCK_FRAMES))
+			{
+				printf("[Error] SoftwareMixer: failed to write to the sink\n");
+				break;
+			}
+			writtenFrames += BLOCK_FRAMES;
+
+			// 実時間に合わせる場合は、書いた分の再生時間が経つまで待つ
+			if (isRealTime)
+			{
+				const std::chrono::duration<double> elapsed(static_cast<double>(writtenFrames) / m_sampleRate);
+				std::this_thread::sleep_until(startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(elapsed));
+			}
+		}
+	}
+}
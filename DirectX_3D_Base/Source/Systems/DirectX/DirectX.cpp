@@ -4,6 +4,7 @@
 //--- O[oϐ
 ID3D11Device*				g_pDevice;
 ID3D11DeviceContext*		g_pContext;
+ID3D11DeviceContext1*		g_pContext1;	// D3D11.1 (萔obt@̕XVp)
 IDXGISwapChain*				g_pSwapChain;
 RenderTarget*				g_pRTV;
 DepthStencil*				g_pDSV;
@@ -21,6 +22,10 @@ ID3D11DeviceContext* GetContext()
 {
 	return g_pContext;
 }
+ID3D11DeviceContext1* GetContext1()
+{
+	return g_pContext1;
+}
 IDXGISwapChain* GetSwapChain()
 {
 	return g_pSwapChain;
@@ -103,6 +108,14 @@ HRESULT InitDirectX(HWND hWnd, UINT width, UINT height, bool fullscreen)
 		return hr;
 	}
 
+	//--- 萔obt@̕XV (D3D11.1) ɑΉĂ邩mF
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	if (SUCCEEDED(g_pDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+		options.ConstantBufferPartialUpdate)
+	{
+		g_pContext->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&g_pContext1));
+	}
+
 	//--- _[^[Qbgݒ
 	g_pRTV = new RenderTarget();
 	if (FAILED(hr = g_pRTV->CreateFromScreen()))
@@ -191,6 +204,7 @@ HRESULT InitDirectX(HWND hWnd, UINT width, UINT height, bool fullscreen)
 	samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
 	samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
 	samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+	samplerDesc.MaxLOD = D3D11_FLOAT32_MAX;	// 0 ̂܂܂ƃ~bv}bvgȂ
 	for (int i = 0; i < SAMPLER_MAX; ++i)
 	{
 		samplerDesc.Filter = filter[i];
@@ -217,6 +231,7 @@ void UninitDirectX()
 		SAFE_RELEASE(g_pRasterizerState[i]);
 	if(g_pContext)
 		g_pContext->ClearState();
+	SAFE_RELEASE(g_pContext1);
 	SAFE_RELEASE(g_pContext);
 	if(g_pSwapChain)
 		g_pSwapChain->SetFullscreenState(false, NULL);
@@ -1,7 +1,7 @@
 #include "Systems/DirectX/MeshBuffer.h"
 
 MeshBuffer::MeshBuffer()
-	: m_pVtxBuffer(NULL), m_pIdxBuffer(NULL), m_desc{}
+	: m_pVtxBuffer(NULL), m_pStreamBuffers{}, m_pIdxBuffer(NULL), m_desc{}
 {
 }
 MeshBuffer::~MeshBuffer()
@@ -9,6 +9,8 @@ MeshBuffer::~MeshBuffer()
 	SAFE_DELETE_ARRAY(m_desc.pIdx);
 	SAFE_DELETE_ARRAY(m_desc.pVtx);
 	SAFE_RELEASE(m_pIdxBuffer);
+	for (UINT i = 0; i < MAX_STREAM - 1; ++i)
+		SAFE_RELEASE(m_pStreamBuffers[i]);
 	SAFE_RELEASE(m_pVtxBuffer);
 }
 
@@ -17,9 +19,18 @@ HRESULT MeshBuffer::Create(const Description& desc)
 	HRESULT hr = E_FAIL;
 
 	// _obt@쐬
-	hr = CreateVertexBuffer(desc.pVtx, desc.vtxSize, desc.vtxCount, desc.isWrite);
+	hr = CreateVertexBuffer(desc.pVtx, desc.vtxSize, desc.vtxCount, desc.isWrite, &m_pVtxBuffer);
 	if (FAILED(hr)) { return hr; }
 
+	// ǉ̒_Xg[쐬 (݂͈ʒuXg[̂ݑΉ)
+	for (UINT i = 0; i < MAX_STREAM - 1; ++i)
+	{
+		if (!desc.streams[i].pData) continue;
+		const UINT count = desc.streams[i].isShared ? 1 : desc.vtxCount;
+		hr = CreateVertexBuffer(desc.streams[i].pData, desc.streams[i].size, count, false, &m_pStreamBuffers[i]);
+		if (FAILED(hr)) { return hr; }
+	}
+
 	// CfbNXobt@쐬
 	if (desc.pIdx) {
 		hr = CreateIndexBuffer(desc.pIdx, desc.idxSize, desc.idxCount);
@@ -28,6 +39,8 @@ HRESULT MeshBuffer::Create(const Description& desc)
 
 	// obt@̃Rs[
 	m_desc = desc;
+	for (UINT i = 0; i < MAX_STREAM - 1; ++i)
+		m_desc.streams[i].pData = nullptr;
 
 	// _ACfbNX̏Rs[
 	rsize_t vtxMemSize = desc.vtxSize * desc.vtxCount;
@@ -45,14 +58,21 @@ HRESULT MeshBuffer::Create(const Description& desc)
 }
 
 
-void MeshBuffer::Draw(int count)
+void MeshBuffer::Draw(int count, UINT startIndex)
 {
 	ID3D11DeviceContext* pContext = GetContext();
-	UINT stride = m_desc.vtxSize;
-	UINT offset = 0;
+	ID3D11Buffer* pBuffers[MAX_STREAM] = { m_pVtxBuffer };
+	UINT strides[MAX_STREAM] = { m_desc.vtxSize };
+	UINT offsets[MAX_STREAM] = {};
+	for (UINT i = 0; i < MAX_STREAM - 1; ++i)
+	{
+		pBuffers[i + 1] = m_pStreamBuffers[i];
+		strides[i + 1] = m_desc.streams[i].isShared ? 0 : m_desc.streams[i].size;
+	}
 
 	pContext->IASetPrimitiveTopology(m_desc.topology);
-	pContext->IASetVertexBuffers(0, 1, &m_pVtxBuffer, &stride, &offset);
+	// gpȂXbg nullptr ŏ㏑AÕbṼXg[cȂ悤ɂ
+	pContext->IASetVertexBuffers(0, MAX_STREAM, pBuffers, strides, offsets);
 
 	// `
 	if (m_desc.idxCount > 0)
@@ -64,7 +84,7 @@ void MeshBuffer::Draw(int count)
 		case 2: format = DXGI_FORMAT_R16_UINT; break;
 		}
 		pContext->IASetIndexBuffer(m_pIdxBuffer, format, 0);
-		pContext->DrawIndexed(count ? count : m_desc.idxCount, 0, 0);
+		pContext->DrawIndexed(count ? count : m_desc.idxCount, startIndex, 0);
 	}
 	else
 	{
@@ -99,7 +119,7 @@ MeshBuffer::Description MeshBuffer::GetDesc()
 	return m_desc;
 }
 
-HRESULT MeshBuffer::CreateVertexBuffer(const void* pVtx, UINT size, UINT count, bool isWrite)
+HRESULT MeshBuffer::CreateVertexBuffer(const void* pVtx, UINT size, UINT count, bool isWrite, ID3D11Buffer** ppBuffer)
 {
 	//--- 쐬obt@̏
 	D3D11_BUFFER_DESC bufDesc = {};
@@ -119,7 +139,7 @@ HRESULT MeshBuffer::CreateVertexBuffer(const void* pVtx, UINT size, UINT count,
 	//--- _obt@̍쐬
 	HRESULT hr;
 	ID3D11Device* pDevice = GetDevice();
-	hr = pDevice->CreateBuffer(&bufDesc, &subResource, &m_pVtxBuffer);
+	hr = pDevice->CreateBuffer(&bufDesc, &subResource, ppBuffer);
 
 	return hr;
 }
@@ -1,6 +1,7 @@
 #include "Systems/DirectX/Shader.h"
 #include <d3dcompiler.h>
 #include <stdio.h>
+#include <string.h>
 
 #pragma comment(lib, "d3dcompiler.lib")
 
@@ -74,6 +75,33 @@ void Shader::WriteBuffer(UINT slot, void* pData)
 	if(slot < m_pBuffers.size())
 		GetContext()->UpdateSubresource(m_pBuffers[slot], 0, nullptr, pData, 0, 0);
 }
+void Shader::WriteBuffer(UINT slot, const void* pData, UINT size)
+{
+	if (slot >= m_pBuffers.size() || size == 0) { return; }
+
+	D3D11_BUFFER_DESC desc;
+	m_pBuffers[slot]->GetDesc(&desc);
+	if (size >= desc.ByteWidth)
+	{
+		GetContext()->UpdateSubresource(m_pBuffers[slot], 0, nullptr, pData, 0, 0);
+		return;
+	}
+
+	// D3D11.1 Ȃgp͈͂] (c̗͕̈sɂȂ)
+	ID3D11DeviceContext1* pContext1 = GetContext1();
+	if (pContext1)
+	{
+		D3D11_BOX box = { 0, 0, 0, size, 1, 1 };
+		pContext1->UpdateSubresource1(m_pBuffers[slot], 0, &box, pData, 0, 0, D3D11_COPY_DISCARD);
+		return;
+	}
+
+	// XVɖΉ̊ł̓obt@Ŝ
+	static std::vector<BYTE> scratch;
+	scratch.resize(desc.ByteWidth);
+	memcpy(scratch.data(), pData, size);
+	GetContext()->UpdateSubresource(m_pBuffers[slot], 0, nullptr, scratch.data(), 0, 0);
+}
 void Shader::SetTexture(UINT slot, Texture* tex)
 {
 	if (!tex || slot >= m_pTextures.size()) { return; }
@@ -149,6 +177,11 @@ void VertexShader::Bind(void)
 		pContext->VSSetShaderResources(i, 1, &m_pTextures[i]);
 }
 
+void VertexShader::SetInputLayout(const D3D11_INPUT_ELEMENT_DESC* pDesc, UINT num)
+{
+	m_inputDesc.assign(pDesc, pDesc + num);
+}
+
 HRESULT VertexShader::MakeShader(void* pData, UINT size)
 {
 	HRESULT hr;
@@ -158,6 +191,15 @@ HRESULT VertexShader::MakeShader(void* pData, UINT size)
 	hr = pDevice->CreateVertexShader(pData, size, NULL, &m_pVS);
 	if(FAILED(hr)) { return hr; }
 
+	// ̓CAEgĂ΂̂܂܎gp (pbN`EXg[̒_Ȃ)
+	if (!m_inputDesc.empty())
+	{
+		return pDevice->CreateInputLayout(
+			m_inputDesc.data(), static_cast<UINT>(m_inputDesc.size()),
+			pData, size, &m_pInputLayout
+		);
+	}
+
 	/*
 	VF[_쐬ɃVF[_tNVʂăCvbgCAEg擾
 	Z}eBNX̔zuȂǂ环ʎq쐬
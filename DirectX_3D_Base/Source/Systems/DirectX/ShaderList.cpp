@@ -3,6 +3,9 @@
 
 VertexShader* ShaderList::m_pVS[VS_KIND_MAX];
 PixelShader* ShaderList::m_pPS[PS_KIND_MAX];
+const DirectX::XMFLOAT4X4* ShaderList::m_pLastBones = nullptr;
+UINT ShaderList::m_lastBoneCount = 0;
+std::uint64_t ShaderList::m_lastBoneRevision = 0;
 
 
 ShaderList::ShaderList()
@@ -83,6 +86,23 @@ void ShaderList::SetWVP(DirectX::XMFLOAT4X4* wvp)
 void ShaderList::SetBones(DirectX::XMFLOAT4X4* bones200)
 {
 	m_pVS[VS_ANIME]->WriteBuffer(1, bones200);
+	m_pLastBones = nullptr;
+	m_lastBoneCount = 0;
+	m_lastBoneRevision = 0;
+}
+void ShaderList::SetBones(const DirectX::XMFLOAT4X4* pBones, UINT count, std::uint64_t revision)
+{
+	const UINT maxBone = 200;	// MakeAnimeVS  bone[200] ɍ킹
+	if (count > maxBone) { count = maxBone; }
+	if (count == 0) { return; }
+	if (revision != 0 && revision == m_lastBoneRevision && pBones == m_pLastBones && count <= m_lastBoneCount)
+	{
+		return;
+	}
+	m_pVS[VS_ANIME]->WriteBuffer(1, pBones, sizeof(DirectX::XMFLOAT4X4) * count);
+	m_pLastBones = pBones;
+	m_lastBoneCount = count;
+	m_lastBoneRevision = revision;
 }
 void ShaderList::SetMaterial(const Model::Material& material)
 {
@@ -174,10 +194,16 @@ void ShaderList::MakeWorldVS()
 	const char* code = R"EOT(
 struct VS_IN {
 	float3 pos : POSITION;
-	float3 normal : NORMAL0;
+	float2 normal : NORMAL0;
 	float2 uv : TEXCOORD0;
 	float4 color : COLOR0;
 };
+float3 DecodeNormal(float2 e) {
+	float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+	float t = saturate(-n.z);
+	n.xy += n.xy >= 0.0f ? -t : t;
+	return normalize(n);
+}
 struct VS_OUT {
 	float4 pos : SV_POSITION;
 	float3 normal : NORMAL0;
@@ -197,12 +223,13 @@ VS_OUT main(VS_IN vin) {
 	vout.wPos = vout.pos;
 	vout.pos = mul(vout.pos, view);
 	vout.pos = mul(vout.pos, proj);
-	vout.normal = mul(vin.normal, (float3x3)world);
+	vout.normal = mul(DecodeNormal(vin.normal), (float3x3)world);
 	vout.uv = vin.uv;
 	vout.color = vin.color;
 	return vout;
 })EOT";
 	m_pVS[VS_WORLD] = new VertexShader();
+	Model::SetInputLayout(m_pVS[VS_WORLD]);
 	m_pVS[VS_WORLD]->Compile(code);
 }
 void ShaderList::MakeAnimeVS()
@@ -210,12 +237,18 @@ void ShaderList::MakeAnimeVS()
 	const char* code = R"EOT(
 struct VS_IN {
 	float3 pos : POSITION;
-	float3 normal : NORMAL0;
+	float2 normal : NORMAL0;
 	float2 uv : TEXCOORD0;
 	float4 color : COLOR0;
 	float4 weight : WEIGHT0;
 	uint4 index : INDEX0;
 };
+float3 DecodeNormal(float2 e) {
+	float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+	float t = saturate(-n.z);
+	n.xy += n.xy >= 0.0f ? -t : t;
+	return normalize(n);
+}
 struct VS_OUT {
 	float4 pos : SV_POSITION;
 	float3 normal : NORMAL0;
@@ -244,7 +277,7 @@ VS_OUT main(VS_IN vin) {
 	vout.wPos = vout.pos;
 	vout.pos = mul(vout.pos, view);
 	vout.pos = mul(vout.pos, proj);
-	vout.normal = vin.normal;
+	vout.normal = DecodeNormal(vin.normal);
 	vout.normal = mul(vout.normal, (float3x3)anime);
 	vout.normal = mul(vout.normal, (float3x3)world);
 	vout.uv = vin.uv;
@@ -252,6 +285,7 @@ VS_OUT main(VS_IN vin) {
 	return vout;
 })EOT";
 	m_pVS[VS_ANIME] = new VertexShader();
+	Model::SetInputLayout(m_pVS[VS_ANIME]);
 	m_pVS[VS_ANIME]->Compile(code);
 }
 void ShaderList::MakeUnlitPS()
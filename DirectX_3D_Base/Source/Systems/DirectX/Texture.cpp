@@ -1,5 +1,18 @@
 #include "Systems/DirectX/Texture.h"
 #include "DirectXTex/TextureLoad.h"
+#include "Systems/MappedFile.h"
+#include "Systems/TextureCookedFormat.h"
+
+// ϊς݃eNX` (.dds) 摜ϊKv̂Ȃ̂ (摜΂̂܂܎g)
+static bool IsCookedUpToDate(const FileView& cooked, const char* sourceFile)
+{
+	TextureCooked::Header header;
+	TextureCooked::CookTag tag;
+	if (!TextureCooked::ReadHeader(cooked.pData, cooked.size, &header, &tag)) return false;
+	ModelCooked::SourceStamp source;
+	if (!ModelCooked::GetSourceStamp(sourceFile, &source)) return true;
+	return tag.source.size == source.size && tag.source.time == source.time;
+}
 
 /// <summary>
 /// eNX`
@@ -8,6 +21,7 @@ Texture::Texture()
 	: m_width(0), m_height(0)
 	, m_pTex(nullptr)
 	, m_pSRV(nullptr)
+	, m_memorySize(0)
 {
 }
 Texture::~Texture()
@@ -16,32 +30,76 @@ Texture::~Texture()
 	SAFE_RELEASE(m_pTex);
 }
 HRESULT Texture::Create(const char* fileName)
+{
+	HRESULT hr = Decode(fileName);
+	if (FAILED(hr)) {
+		return hr;
+	}
+	return Upload();
+}
+HRESULT Texture::Decode(const char* fileName)
 {
 	HRESULT hr = S_OK;
 
+	// ϊς (.ddsB~bv}bvEubNkς) ΂ǂ
+	const std::string cookedPath = TextureCooked::GetCookedPath(fileName);
+	MappedFile cooked(cookedPath.c_str());
+	if (cooked.GetData() && IsCookedUpToDate(cooked.GetView(), fileName) &&
+		SUCCEEDED(Decode(cooked.GetData(), cooked.GetSize(), cookedPath.c_str())))
+	{
+		return S_OK;
+	}
+
 	// ϊ
 	wchar_t wPath[MAX_PATH];
-	size_t wLen = 0;
 	MultiByteToWideChar(0, 0, fileName, -1, wPath, MAX_PATH);
 
 	// t@Cʓǂݍ
-	DirectX::TexMetadata mdata;
-	DirectX::ScratchImage image;
+	std::unique_ptr<DirectX::ScratchImage> pImage(new DirectX::ScratchImage());
 	if (strstr(fileName, ".tga"))
-		hr = DirectX::LoadFromTGAFile(wPath, &mdata, image);
+		hr = DirectX::LoadFromTGAFile(wPath, nullptr, *pImage);
+	else
+		hr = DirectX::LoadFromWICFile(wPath, DirectX::WIC_FLAGS::WIC_FLAGS_IGNORE_SRGB, nullptr, *pImage);
+	if (FAILED(hr)) {
+		return E_FAIL;
+	}
+	m_pImage = std::move(pImage);
+	return S_OK;
+}
+HRESULT Texture::Decode(const void* pData, size_t size, const char* fileName)
+{
+	HRESULT hr = S_OK;
+
+	// t@Cʓǂݍ (AZbgA[JCũf[^Rs[ɓWJ)
+	std::unique_ptr<DirectX::ScratchImage> pImage(new DirectX::ScratchImage());
+	if (size >= sizeof(TextureCooked::DDS_MAGIC) && memcmp(pData, &TextureCooked::DDS_MAGIC, sizeof(TextureCooked::DDS_MAGIC)) == 0)
+		hr = DirectX::LoadFromDDSMemory(pData, size, DirectX::DDS_FLAGS_NONE, nullptr, *pImage);
+	else if (strstr(fileName, ".tga"))
+		hr = DirectX::LoadFromTGAMemory(pData, size, nullptr, *pImage);
 	else
-		hr = DirectX::LoadFromWICFile(wPath, DirectX::WIC_FLAGS::WIC_FLAGS_IGNORE_SRGB, &mdata, image);
+		hr = DirectX::LoadFromWICMemory(pData, size, DirectX::WIC_FLAGS::WIC_FLAGS_IGNORE_SRGB, nullptr, *pImage);
 	if (FAILED(hr)) {
 		return E_FAIL;
 	}
+	m_pImage = std::move(pImage);
+	return S_OK;
+}
+HRESULT Texture::Upload()
+{
+	if (!m_pImage) {
+		return E_FAIL;
+	}
 
 	// VF[_\[X
-	hr = CreateShaderResourceView(GetDevice(), image.GetImages(), image.GetImageCount(), mdata, &m_pSRV);
+	const DirectX::TexMetadata& mdata = m_pImage->GetMetadata();
+	HRESULT hr = CreateShaderResourceView(GetDevice(), m_pImage->GetImages(), m_pImage->GetImageCount(), mdata, &m_pSRV);
 	if (SUCCEEDED(hr))
 	{
 		m_width = (UINT)mdata.width;
 		m_height = (UINT)mdata.height;
+		m_memorySize = m_pImage->GetPixelsSize();
 	}
+	m_pImage.reset();
 	return hr;
 }
 HRESULT Texture::Create(DXGI_FORMAT format, UINT width, UINT height, const void* pData)
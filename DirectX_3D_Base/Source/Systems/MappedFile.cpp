@@ -0,0 +1,81 @@
+﻿/*****************************************************************//**
+ * @file	MappedFile.cpp
+ * @brief	ファイル全体の読み取り専用メモリマップ
+ *
+ * @details	
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ModelCooked.cpp から移動。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "Systems/MappedFile.h"
+
+bool MappedFile::Open(const char* file)
+{
+	Close();
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(hFile, &size) && size.QuadPart > 0)
+	{
+		m_hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_hMapping)
+		{
+			m_pData = static_cast<const std::uint8_t*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+			if (m_pData) m_size = static_cast<size_t>(size.QuadPart);
+		}
+	}
+	CloseHandle(hFile);
+#else
+	int fd = open(file, O_RDONLY);
+	if (fd < 0) return false;
+	struct stat st;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+	{
+		void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED)
+		{
+			m_pData = static_cast<const std::uint8_t*>(p);
+			m_size = static_cast<size_t>(st.st_size);
+		}
+	}
+	close(fd);
+#endif
+	return m_pData != nullptr;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (m_pData) UnmapViewOfFile(m_pData);
+	if (m_hMapping) CloseHandle(static_cast<HANDLE>(m_hMapping));
+	m_hMapping = nullptr;
+#else
+	if (m_pData) munmap(const_cast<std::uint8_t*>(m_pData), m_size);
+#endif
+	m_pData = nullptr;
+	m_size = 0;
+}
@@ -0,0 +1,372 @@
+﻿/*****************************************************************//**
+ * @file	MeshOptimizer.cpp
+ * @brief	メッシュのインデックス・頂点の並び替えの実装
+ *
+ * @details	頂点キャッシュの並び替えは Tom Forsyth "Linear-Speed Vertex Cache Optimisation"、
+ *			オーバードローの並び替えは Sander らの "Fast Triangle Reordering for Vertex Locality
+ *			and Reduced Overdraw" のまとまり単位の並び替えに従う。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：頂点の結合・三角形/頂点の並び替え・キャッシュ統計を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+	const std::uint32_t NO_TRIANGLE = 0xFFFFFFFFu;
+	const int			SCORE_CACHE_SIZE = 32;	// Forsyth 法で想定するキャッシュの大きさ
+	const std::uint32_t SCORE_MAX_VALENCE = 32;	// 残り三角形数による加点を計算する上限
+
+	/// @brief 頂点の評価値の表 (キャッシュ上の位置・残り三角形数から引く)
+	struct ScoreTable
+	{
+		float cache[SCORE_CACHE_SIZE];
+		float valence[SCORE_MAX_VALENCE + 1];
+
+		ScoreTable()
+		{
+			// 直前の三角形の頂点は同じ値にして、同じ向きへ帯状に進み続けないようにする
+			for (int i = 0; i < SCORE_CACHE_SIZE; ++i)
+			{
+				cache[i] = i < 3 ? 0.75f :
+					std::pow(1.0f - static_cast<float>(i - 3) / (SCORE_CACHE_SIZE - 3), 1.5f);
+			}
+			// 残りの少ない頂点を優先して使い切り、孤立した三角形が最後に残らないようにする
+			valence[0] = 0.0f;
+			for (std::uint32_t i = 1; i <= SCORE_MAX_VALENCE; ++i)
+			{
+				valence[i] = 2.0f / std::sqrt(static_cast<float>(i));
+			}
+		}
+
+		float Get(int cachePos, std::uint32_t remaining) const
+		{
+			if (remaining == 0) return 0.0f;
+			const float score = cachePos >= 0 ? cache[cachePos] : 0.0f;
+			return score + valence[std::min(remaining, SCORE_MAX_VALENCE)];
+		}
+	};
+
+	/// @brief 頂点のバイト列のハッシュ (FNV-1a)
+	std::uint32_t HashBytes(const unsigned char* pData, size_t size)
+	{
+		std::uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= pData[i];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	const float* GetPosition(const float* pPositions, size_t stride, std::uint32_t index)
+	{
+		return reinterpret_cast<const float*>(reinterpret_cast<const unsigned char*>(pPositions) + stride * index);
+	}
+}
+
+namespace MeshOptimizer
+{
+	size_t GenerateVertexRemap(std::uint32_t* pRemap, const std::uint32_t* pIndices, size_t indexCount,
+		const void* pVertices, size_t vertexCount, size_t stride)
+	{
+		const unsigned char* pBytes = static_cast<const unsigned char*>(pVertices);
+		std::fill(pRemap, pRemap + vertexCount, REMAP_UNUSED);
+
+		// 開番地法のハッシュ表 (代表の頂点番号を格納する)
+		size_t capacity = 1;
+		while (capacity < vertexCount * 2) capacity <<= 1;
+		const size_t mask = capacity - 1;
+		std::vector<std::uint32_t> table(capacity, REMAP_UNUSED);
+
+		// インデックス順に調べるため、新しい頂点番号は初めて参照される順になる
+		size_t uniqueCount = 0;
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			const std::uint32_t index = pIndices[i];
+			if (pRemap[index] != REMAP_UNUSED) continue;
+
+			const unsigned char* pVertex = pBytes + stride * index;
+			size_t slot = HashBytes(pVertex, stride) & mask;
+			while (table[slot] != REMAP_UNUSED && memcmp(pBytes + stride * table[slot], pVertex, stride) != 0)
+			{
+				slot = (slot + 1) & mask;
+			}
+			if (table[slot] == REMAP_UNUSED)
+			{
+				table[slot] = index;
+				pRemap[index] = static_cast<std::uint32_t>(uniqueCount++);
+			}
+			else
+			{
+				pRemap[index] = pRemap[table[slot]];
+			}
+		}
+		return uniqueCount;
+	}
+
+	void OptimizeVertexCache(std::uint32_t* pIndices, size_t indexCount, size_t vertexCount)
+	{
+		static const ScoreTable score;
+		const size_t triCount = indexCount / 3;
+		if (triCount < 2) return;
+
+		// 頂点毎の三角形の一覧 (先頭 remaining[v] 個がまだ出力していない三角形)
+		std::vector<std::uint32_t> offsets(vertexCount + 1, 0);
+		for (size_t i = 0; i < triCount * 3; ++i) ++offsets[pIndices[i] + 1];
+		for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+		std::vector<std::uint32_t> remaining(vertexCount);
+		for (size_t v = 0; v < vertexCount; ++v) remaining[v] = offsets[v + 1] - offsets[v];
+		std::vector<std::uint32_t> adjacency(triCount * 3);
+		{
+			std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < triCount * 3; ++i) adjacency[fill[pIndices[i]]++] = static_cast<std::uint32_t>(i / 3);
+		}
+
+		// 評価値の初期化
+		std::vector<int> cachePos(vertexCount, -1);
+		std::vector<float> vertexScore(vertexCount);
+		for (size_t v = 0; v < vertexCount; ++v) vertexScore[v] = score.Get(-1, remaining[v]);
+		std::vector<float> triScore(triCount);
+		std::uint32_t best = NO_TRIANGLE;
+		for (size_t t = 0; t < triCount; ++t)
+		{
+			triScore[t] = vertexScore[pIndices[t * 3]] + vertexScore[pIndices[t * 3 + 1]] + vertexScore[pIndices[t * 3 + 2]];
+			if (best == NO_TRIANGLE || triScore[t] > triScore[best]) best = static_cast<std::uint32_t>(t);
+		}
+
+		std::vector<std::uint32_t> result(triCount * 3);
+		std::vector<bool> isEmitted(triCount, false);
+		std::uint32_t cache[SCORE_CACHE_SIZE + 3];
+		std::uint32_t newCache[SCORE_CACHE_SIZE + 3];
+		int cacheCount = 0;
+		size_t cursor = 0;
+
+		for (size_t out = 0; out < triCount; ++out)
+		{
+			// キャッシュ上に候補が無ければ、まだ出力していない三角形を元の順に探す
+			if (best == NO_TRIANGLE)
+			{
+				while (isEmitted[cursor]) ++cursor;
+				best = static_cast<std::uint32_t>(cursor);
+			}
+
+			// 出力して、各頂点の一覧から取り除く
+			const std::uint32_t* pTri = pIndices + best * 3;
+			isEmitted[best] = true;
+			int newCount = 0;
+			for (int k = 0; k < 3; ++k)
+			{
+				const std::uint32_t v = pTri[k];
+				result[out * 3 + k] = v;
+				std::uint32_t* pAdj = adjacency.data() + offsets[v];
+				std::uint32_t* pFound = std::find(pAdj, pAdj + remaining[v], best);
+				std::swap(*pFound, pAdj[remaining[v] - 1]);
+				--remaining[v];
+
+				if (std::find(newCache, newCache + newCount, v) == newCache + newCount) newCache[newCount++] = v;
+			}
+
+			// 出力した三角形の頂点をキャッシュの先頭へ
+			for (int i = 0; i < cacheCount; ++i)
+			{
+				if (cache[i] != pTri[0] && cache[i] != pTri[1] && cache[i] != pTri[2]) newCache[newCount++] = cache[i];
+			}
+
+			// 位置が変わった頂点の評価値を更新し、その頂点を使う三角形から次を選ぶ
+			best = NO_TRIANGLE;
+			float bestScore = -1.0f;
+			for (int i = 0; i < newCount; ++i)
+			{
+				const std::uint32_t v = newCache[i];
+				cachePos[v] = i < SCORE_CACHE_SIZE ? i : -1;
+				const float newScore = score.Get(cachePos[v], remaining[v]);
+				const float delta = newScore - vertexScore[v];
+				vertexScore[v] = newScore;
+
+				const std::uint32_t* pAdj = adjacency.data() + offsets[v];
+				for (std::uint32_t a = 0; a < remaining[v]; ++a)
+				{
+					triScore[pAdj[a]] += delta;
+				}
+			}
+			for (int i = 0; i < std::min(newCount, SCORE_CACHE_SIZE); ++i)
+			{
+				const std::uint32_t v = newCache[i];
+				const std::uint32_t* pAdj = adjacency.data() + offsets[v];
+				for (std::uint32_t a = 0; a < remaining[v]; ++a)
+				{
+					if (triScore[pAdj[a]] > bestScore)
+					{
+						bestScore = triScore[pAdj[a]];
+						best = pAdj[a];
+					}
+				}
+			}
+
+			cacheCount = std::min(newCount, SCORE_CACHE_SIZE);
+			std::copy(newCache, newCache + cacheCount, cache);
+		}
+
+		std::copy(result.begin(), result.end(), pIndices);
+	}
+
+	void OptimizeOverdraw(std::uint32_t* pIndices, size_t indexCount, const float* pPositions,
+		size_t vertexCount, size_t positionStride, float threshold)
+	{
+		const size_t triCount = indexCount / 3;
+		if (triCount < 2) return;
+
+		// キャッシュが一巡した (3頂点とも実行される) 三角形でまとまりに区切る
+		std::vector<std::uint32_t> clusters;
+		{
+			std::vector<std::uint32_t> stamp(vertexCount, 0);
+			std::uint32_t timestamp = STATS_CACHE_SIZE + 1;
+			for (size_t t = 0; t < triCount; ++t)
+			{
+				int misses = 0;
+				for (int k = 0; k < 3; ++k)
+				{
+					const std::uint32_t v = pIndices[t * 3 + k];
+					if (timestamp - stamp[v] > STATS_CACHE_SIZE)
+					{
+						stamp[v] = timestamp++;
+						++misses;
+					}
+				}
+				if (t == 0 || misses == 3) clusters.push_back(static_cast<std::uint32_t>(t));
+			}
+		}
+		if (clusters.size() < 2) return;
+		clusters.push_back(static_cast<std::uint32_t>(triCount));
+
+		// まとまり毎の中心と向き (面積で重み付け)
+		const size_t clusterCount = clusters.size() - 1;
+		std::vector<float> centers(clusterCount * 3, 0.0f);
+		std::vector<float> normals(clusterCount * 3, 0.0f);
+		float meshCenter[3] = {};
+		float meshArea = 0.0f;
+		for (size_t c = 0; c < clusterCount; ++c)
+		{
+			float area = 0.0f;
+			for (std::uint32_t t = clusters[c]; t < clusters[c + 1]; ++t)
+			{
+				const float* p0 = GetPosition(pPositions, positionStride, pIndices[t * 3]);
+				const float* p1 = GetPosition(pPositions, positionStride, pIndices[t * 3 + 1]);
+				const float* p2 = GetPosition(pPositions, positionStride, pIndices[t * 3 + 2]);
+				const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+				const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+				const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+				const float triArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				for (int i = 0; i < 3; ++i)
+				{
+					centers[c * 3 + i] += (p0[i] + p1[i] + p2[i]) * (triArea / 3.0f);
+					normals[c * 3 + i] += n[i];
+				}
+				area += triArea;
+			}
+			for (int i = 0; i < 3; ++i) meshCenter[i] += centers[c * 3 + i];
+			meshArea += area;
+			if (area > 0.0f)
+			{
+				for (int i = 0; i < 3; ++i) centers[c * 3 + i] /= area;
+			}
+		}
+		if (meshArea <= 0.0f) return;
+		for (int i = 0; i < 3; ++i) meshCenter[i] /= meshArea;
+
+		// 中心から外側を向いているまとまりほど手前に来やすいため先に描く
+		std::vector<float> keys(clusterCount);
+		for (size_t c = 0; c < clusterCount; ++c)
+		{
+			const float* n = &normals[c * 3];
+			const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			float key = 0.0f;
+			if (length > 0.0f)
+			{
+				for (int i = 0; i < 3; ++i) key += (centers[c * 3 + i] - meshCenter[i]) * n[i];
+				key /= length;
+			}
+			keys[c] = key;
+		}
+		std::vector<std::uint32_t> order(clusterCount);
+		for (size_t c = 0; c < clusterCount; ++c) order[c] = static_cast<std::uint32_t>(c);
+		std::stable_sort(order.begin(), order.end(), [&keys](std::uint32_t a, std::uint32_t b) { return keys[a] > keys[b]; });
+
+		std::vector<std::uint32_t> result;
+		result.reserve(triCount * 3);
+		for (std::uint32_t c : order)
+		{
+			result.insert(result.end(), pIndices + clusters[c] * 3, pIndices + clusters[c + 1] * 3);
+		}
+
+		// キャッシュ効率が許容範囲を超えて悪化する場合は並び替えない
+		const VertexCacheStats before = AnalyzeVertexCache(pIndices, triCount * 3, vertexCount);
+		const VertexCacheStats after = AnalyzeVertexCache(result.data(), result.size(), vertexCount);
+		if (after.transformed > before.transformed * threshold) return;
+		std::copy(result.begin(), result.end(), pIndices);
+	}
+
+	size_t GenerateFetchRemap(std::uint32_t* pRemap, const std::uint32_t* pIndices, size_t indexCount, size_t vertexCount)
+	{
+		std::fill(pRemap, pRemap + vertexCount, REMAP_UNUSED);
+		size_t count = 0;
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			if (pRemap[pIndices[i]] == REMAP_UNUSED) pRemap[pIndices[i]] = static_cast<std::uint32_t>(count++);
+		}
+		return count;
+	}
+
+	void RemapIndices(std::uint32_t* pIndices, size_t indexCount, const std::uint32_t* pRemap)
+	{
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			pIndices[i] = pRemap[pIndices[i]];
+		}
+	}
+
+	VertexCacheStats AnalyzeVertexCache(const std::uint32_t* pIndices, size_t indexCount, size_t vertexCount,
+		unsigned int cacheSize)
+	{
+		VertexCacheStats stats = {};
+		if (indexCount < 3) return stats;
+
+		// 最後に実行した時刻との差がキャッシュの大きさを超えていればミス (FIFO)
+		std::vector<std::uint32_t> stamp(vertexCount, 0);
+		std::vector<bool> isUsed(vertexCount, false);
+		std::uint32_t timestamp = cacheSize + 1;
+		size_t usedCount = 0;
+		for (size_t i = 0; i < indexCount; ++i)
+		{
+			const std::uint32_t v = pIndices[i];
+			if (timestamp - stamp[v] > cacheSize)
+			{
+				stamp[v] = timestamp++;
+				++stats.transformed;
+			}
+			if (!isUsed[v])
+			{
+				isUsed[v] = true;
+				++usedCount;
+			}
+		}
+		stats.acmr = static_cast<float>(stats.transformed) / (indexCount / 3);
+		stats.atvr = static_cast<float>(stats.transformed) / usedCount;
+		return stats;
+	}
+}
@@ -0,0 +1,378 @@
+﻿/*****************************************************************//**
+ * @file	MeshSimplifier.cpp
+ * @brief	二次誤差 (QEM) による辺の縮約の実装
+ *
+ * @details	Garland / Heckbert "Surface Simplification Using Quadric Error Metrics" に従い、
+ *			各頂点に周囲の面の平面からの距離の二乗和 (面積で重み付け) を持たせる。
+ *			1回の走査で誤差の小さい順に縮約し、縮約した頂点の周囲はその走査では触らない
+ *			(面の裏返りの判定が古い形状に基づかないようにするため)。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：辺の縮約による簡略化を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/MeshSimplifier.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	const float BORDER_WEIGHT = 10.0f;	// 穴の縁を保つための平面の重み
+	const float SKIN_WEIGHT = 0.1f;		// スキンウェイトの差 (0 ～ 2) を誤差 (比率) へ換算する係数
+	const int	MAX_PASS = 100;
+
+	/// @brief 頂点の種類 (縮約で動かせる方向が異なる)
+	enum VertexKind : std::uint8_t
+	{
+		KIND_MANIFOLD,	// 内部の頂点 : 隣接するどの頂点へも寄せられる
+		KIND_BORDER,	// 穴の縁 : 縁に沿って縁の頂点へのみ寄せられる
+		KIND_LOCKED,	// 継ぎ目・非多様体 : 動かさない
+	};
+
+	/// @brief 平面からの距離の二乗和 (x^T A x + 2 b^T x + c を重み w で割って使う)
+	struct Quadric
+	{
+		double a00, a11, a22, a01, a02, a12;
+		double b0, b1, b2;
+		double c;
+		double w;
+
+		void AddPlane(const float n[3], float d, float weight)
+		{
+			a00 += weight * n[0] * n[0]; a11 += weight * n[1] * n[1]; a22 += weight * n[2] * n[2];
+			a01 += weight * n[0] * n[1]; a02 += weight * n[0] * n[2]; a12 += weight * n[1] * n[2];
+			b0 += weight * n[0] * d; b1 += weight * n[1] * d; b2 += weight * n[2] * d;
+			c += weight * d * d;
+			w += weight;
+		}
+		void Add(const Quadric& q)
+		{
+			a00 += q.a00; a11 += q.a11; a22 += q.a22; a01 += q.a01; a02 += q.a02; a12 += q.a12;
+			b0 += q.b0; b1 += q.b1; b2 += q.b2;
+			c += q.c;
+			w += q.w;
+		}
+		/// @brief 位置 p の誤差 (距離の二乗の加重平均)
+		float Error(const float p[3]) const
+		{
+			if (w <= 0.0) return 0.0f;
+			const double x = p[0], y = p[1], z = p[2];
+			const double e = a00 * x * x + a11 * y * y + a22 * z * z +
+				2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+				2.0 * (b0 * x + b1 * y + b2 * z) + c;
+			return static_cast<float>(std::max(e, 0.0) / w);
+		}
+	};
+
+	struct Collapse
+	{
+		std::uint32_t	from;
+		std::uint32_t	to;
+		float			error;	// 距離の二乗 (比率)
+	};
+
+	std::uint64_t EdgeKey(std::uint32_t a, std::uint32_t b)
+	{
+		return (static_cast<std::uint64_t>(a) << 32) | b;
+	}
+
+	void Cross(const float a[3], const float b[3], float out[3])
+	{
+		out[0] = a[1] * b[2] - a[2] * b[1];
+		out[1] = a[2] * b[0] - a[0] * b[2];
+		out[2] = a[0] * b[1] - a[1] * b[0];
+	}
+
+	float Dot(const float a[3], const float b[3])
+	{
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+	}
+
+	/// @brief 2頂点のスキンウェイトの差 (ボーン毎の差の絶対値の和、0 ～ 2)
+	float SkinDistance(const MeshSimplifier::VertexData& data, std::uint32_t a, std::uint32_t b)
+	{
+		const float* wa = reinterpret_cast<const float*>(reinterpret_cast<const char*>(data.pWeights) + data.stride * a);
+		const float* wb = reinterpret_cast<const float*>(reinterpret_cast<const char*>(data.pWeights) + data.stride * b);
+		const unsigned int* ia = reinterpret_cast<const unsigned int*>(reinterpret_cast<const char*>(data.pBoneIndices) + data.stride * a);
+		const unsigned int* ib = reinterpret_cast<const unsigned int*>(reinterpret_cast<const char*>(data.pBoneIndices) + data.stride * b);
+		float distance = 0.0f;
+		for (int i = 0; i < 4; ++i)
+		{
+			float other = 0.0f;
+			for (int j = 0; j < 4; ++j)
+			{
+				if (ib[j] == ia[i]) other += wb[j];
+			}
+			distance += std::fabs(wa[i] - other);
+		}
+		for (int j = 0; j < 4; ++j)
+		{
+			if (std::find(ia, ia + 4, ib[j]) == ia + 4) distance += wb[j];
+		}
+		return distance;
+	}
+}
+
+namespace MeshSimplifier
+{
+	Result Simplify(std::uint32_t* pDestination, const std::uint32_t* pIndices, size_t indexCount,
+		const VertexData& vertices, size_t targetIndexCount, float targetError)
+	{
+		Result result = { indexCount - indexCount % 3, 0.0f, 0.0f };
+		std::copy(pIndices, pIndices + result.indexCount, pDestination);
+		const size_t vertexCount = vertices.vertexCount;
+		if (result.indexCount <= targetIndexCount || vertexCount == 0) return result;
+
+		// 座標をメッシュの大きさで割り、誤差を比率で扱う
+		std::vector<float> positions(vertexCount * 3);
+		float minPos[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+		float maxPos[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			const float* p = reinterpret_cast<const float*>(reinterpret_cast<const char*>(vertices.pPositions) + vertices.stride * v);
+			for (int i = 0; i < 3; ++i)
+			{
+				positions[v * 3 + i] = p[i];
+				minPos[i] = std::min(minPos[i], p[i]);
+				maxPos[i] = std::max(maxPos[i], p[i]);
+			}
+		}
+		result.extent = std::max(maxPos[0] - minPos[0], std::max(maxPos[1] - minPos[1], maxPos[2] - minPos[2]));
+		if (result.extent <= 0.0f) return result;
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			for (int i = 0; i < 3; ++i) positions[v * 3 + i] = (positions[v * 3 + i] - minPos[i]) / result.extent;
+		}
+		auto position = [&positions](std::uint32_t v) { return &positions[v * 3]; };
+
+		// 同じ位置の頂点をまとめる (継ぎ目の判定と、縁の判定を位置で行うため)
+		std::vector<std::uint32_t> positionID(vertexCount);
+		std::vector<std::uint32_t> siblingCount(vertexCount, 0);
+		{
+			struct Hash
+			{
+				size_t operator()(const std::uint64_t& key) const { return static_cast<size_t>(key ^ (key >> 29)); }
+			};
+			std::unordered_map<std::uint64_t, std::vector<std::uint32_t>, Hash> buckets;
+			for (size_t v = 0; v < vertexCount; ++v)
+			{
+				std::uint32_t bits[3];
+				memcpy(bits, position(static_cast<std::uint32_t>(v)), sizeof(bits));
+				const std::uint64_t key = (static_cast<std::uint64_t>(bits[0]) * 73856093u) ^ (static_cast<std::uint64_t>(bits[1]) * 19349663u) ^ (static_cast<std::uint64_t>(bits[2]) * 83492791u);
+				std::vector<std::uint32_t>& bucket = buckets[key];
+				positionID[v] = static_cast<std::uint32_t>(v);
+				for (std::uint32_t other : bucket)
+				{
+					if (memcmp(position(other), position(static_cast<std::uint32_t>(v)), sizeof(float) * 3) == 0)
+					{
+						positionID[v] = positionID[other];
+						break;
+					}
+				}
+				bucket.push_back(static_cast<std::uint32_t>(v));
+				++siblingCount[positionID[v]];
+			}
+		}
+
+		// 位置で見た有向辺 (逆向きの辺が無ければ穴の縁)
+		std::unordered_set<std::uint64_t> edges;
+		for (size_t i = 0; i < result.indexCount; i += 3)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				edges.insert(EdgeKey(positionID[pDestination[i + k]], positionID[pDestination[i + (k + 1) % 3]]));
+			}
+		}
+		auto isBorderEdge = [&](std::uint32_t a, std::uint32_t b)
+			{
+				return edges.count(EdgeKey(positionID[b], positionID[a])) == 0;
+			};
+
+		// 頂点の種類と、面・縁の平面の二次誤差
+		std::vector<std::uint32_t> borderCount(vertexCount, 0);
+		std::vector<Quadric> quadrics(vertexCount, Quadric());
+		for (size_t i = 0; i < result.indexCount; i += 3)
+		{
+			const std::uint32_t tri[3] = { pDestination[i], pDestination[i + 1], pDestination[i + 2] };
+			float e1[3], e2[3], n[3];
+			for (int k = 0; k < 3; ++k)
+			{
+				e1[k] = position(tri[1])[k] - position(tri[0])[k];
+				e2[k] = position(tri[2])[k] - position(tri[0])[k];
+			}
+			Cross(e1, e2, n);
+			const float length = std::sqrt(Dot(n, n));
+			if (length <= 0.0f) continue;
+			for (int k = 0; k < 3; ++k) n[k] /= length;
+			const float d = -Dot(n, position(tri[0]));
+			for (int k = 0; k < 3; ++k) quadrics[tri[k]].AddPlane(n, d, length * 0.5f);
+
+			// 縁の辺には、辺を含み面に垂直な平面を加えて縁の形を保つ
+			for (int k = 0; k < 3; ++k)
+			{
+				const std::uint32_t a = tri[k];
+				const std::uint32_t b = tri[(k + 1) % 3];
+				if (!isBorderEdge(a, b)) continue;
+				++borderCount[positionID[a]];
+				++borderCount[positionID[b]];
+				float edge[3], plane[3];
+				for (int j = 0; j < 3; ++j) edge[j] = position(b)[j] - position(a)[j];
+				Cross(edge, n, plane);
+				const float planeLength = std::sqrt(Dot(plane, plane));
+				if (planeLength <= 0.0f) continue;
+				for (int j = 0; j < 3; ++j) plane[j] /= planeLength;
+				const float planeD = -Dot(plane, position(a));
+				const float weight = Dot(edge, edge) * BORDER_WEIGHT;
+				quadrics[a].AddPlane(plane, planeD, weight);
+				quadrics[b].AddPlane(plane, planeD, weight);
+			}
+		}
+		std::vector<VertexKind> kinds(vertexCount, KIND_MANIFOLD);
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			const std::uint32_t id = positionID[v];
+			if (siblingCount[id] > 1) kinds[v] = KIND_LOCKED;
+			else if (borderCount[id] == 2) kinds[v] = KIND_BORDER;
+			else if (borderCount[id] != 0) kinds[v] = KIND_LOCKED;
+		}
+
+		// 縮約の誤差 (スキンウェイトの差は比率の誤差として上乗せする)
+		auto collapseError = [&](std::uint32_t from, std::uint32_t to)
+			{
+				float error = quadrics[from].Error(position(to));
+				if (vertices.pWeights)
+				{
+					const float skin = SkinDistance(vertices, from, to) * SKIN_WEIGHT;
+					error += skin * skin;
+				}
+				return error;
+			};
+		auto canCollapse = [&](std::uint32_t from, std::uint32_t to)
+			{
+				if (kinds[from] == KIND_MANIFOLD) return true;
+				if (kinds[from] == KIND_BORDER)
+				{
+					return kinds[to] != KIND_MANIFOLD && (isBorderEdge(from, to) || isBorderEdge(to, from));
+				}
+				return false;
+			};
+
+		const float errorLimit = targetError * targetError;
+		std::vector<std::uint32_t> remap(vertexCount);
+		std::vector<bool> isLocked(vertexCount);
+		std::vector<std::uint32_t> adjacencyOffsets(vertexCount + 1);
+		std::vector<std::uint32_t> adjacency;
+		std::vector<Collapse> collapses;
+		for (int pass = 0; pass < MAX_PASS && result.indexCount > targetIndexCount; ++pass)
+		{
+			const size_t indexNum = result.indexCount;
+
+			// 頂点毎の三角形の一覧
+			std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+			for (size_t i = 0; i < indexNum; ++i) ++adjacencyOffsets[pDestination[i] + 1];
+			for (size_t v = 0; v < vertexCount; ++v) adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+			adjacency.resize(indexNum);
+			{
+				std::vector<std::uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (size_t i = 0; i < indexNum; ++i) adjacency[fill[pDestination[i]]++] = static_cast<std::uint32_t>(i / 3);
+			}
+
+			// 辺毎に、寄せられる向きのうち誤差の小さい方を候補にする
+			collapses.clear();
+			for (size_t i = 0; i < indexNum; i += 3)
+			{
+				for (int k = 0; k < 3; ++k)
+				{
+					const std::uint32_t a = pDestination[i + k];
+					const std::uint32_t b = pDestination[i + (k + 1) % 3];
+					const bool canAB = canCollapse(a, b);
+					const bool canBA = canCollapse(b, a);
+					if (!canAB && !canBA) continue;
+					const float errorAB = canAB ? collapseError(a, b) : FLT_MAX;
+					const float errorBA = canBA ? collapseError(b, a) : FLT_MAX;
+					const Collapse collapse = errorAB <= errorBA ? Collapse{ a, b, errorAB } : Collapse{ b, a, errorBA };
+					if (collapse.error <= errorLimit) collapses.push_back(collapse);
+				}
+			}
+			if (collapses.empty()) break;
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+			// 誤差の小さい順に縮約 (縮約した頂点の周囲の頂点はこの走査では動かさない)
+			for (size_t v = 0; v < vertexCount; ++v) remap[v] = static_cast<std::uint32_t>(v);
+			std::fill(isLocked.begin(), isLocked.end(), false);
+			const size_t triangleGoal = (indexNum - targetIndexCount) / 3;
+			size_t triangleRemoved = 0;
+			size_t collapseNum = 0;
+			for (const Collapse& collapse : collapses)
+			{
+				if (isLocked[collapse.from] || isLocked[collapse.to]) continue;
+
+				// 面が裏返る縮約は行わない
+				bool isFlip = false;
+				const std::uint32_t* pAdj = adjacency.data() + adjacencyOffsets[collapse.from];
+				const std::uint32_t adjNum = adjacencyOffsets[collapse.from + 1] - adjacencyOffsets[collapse.from];
+				for (std::uint32_t t = 0; t < adjNum && !isFlip; ++t)
+				{
+					const std::uint32_t* tri = pDestination + pAdj[t] * 3;
+					if (tri[0] == collapse.to || tri[1] == collapse.to || tri[2] == collapse.to) continue;
+					const int k = tri[0] == collapse.from ? 0 : (tri[1] == collapse.from ? 1 : 2);
+					const float* pb = position(tri[(k + 1) % 3]);
+					const float* pc = position(tri[(k + 2) % 3]);
+					float before[3], after[3], e1[3], e2[3];
+					for (int j = 0; j < 3; ++j) { e1[j] = pb[j] - position(collapse.from)[j]; e2[j] = pc[j] - position(collapse.from)[j]; }
+					Cross(e1, e2, before);
+					for (int j = 0; j < 3; ++j) { e1[j] = pb[j] - position(collapse.to)[j]; e2[j] = pc[j] - position(collapse.to)[j]; }
+					Cross(e1, e2, after);
+					isFlip = Dot(before, after) <= 0.0f;
+				}
+				if (isFlip) continue;
+
+				remap[collapse.from] = collapse.to;
+				quadrics[collapse.to].Add(quadrics[collapse.from]);
+				for (std::uint32_t t = 0; t < adjNum; ++t)
+				{
+					const std::uint32_t* tri = pDestination + pAdj[t] * 3;
+					isLocked[tri[0]] = isLocked[tri[1]] = isLocked[tri[2]] = true;
+				}
+				isLocked[collapse.to] = true;
+				result.error = std::max(result.error, collapse.error);
+				++collapseNum;
+				triangleRemoved += kinds[collapse.from] == KIND_BORDER ? 1 : 2;
+				if (triangleRemoved >= triangleGoal) break;
+			}
+			if (collapseNum == 0) break;
+
+			// インデックスを書き換え、潰れた三角形を除く
+			size_t write = 0;
+			for (size_t i = 0; i < indexNum; i += 3)
+			{
+				const std::uint32_t a = remap[pDestination[i]];
+				const std::uint32_t b = remap[pDestination[i + 1]];
+				const std::uint32_t c = remap[pDestination[i + 2]];
+				if (a == b || b == c || c == a) continue;
+				pDestination[write++] = a;
+				pDestination[write++] = b;
+				pDestination[write++] = c;
+			}
+			result.indexCount = write;
+		}
+
+		result.error = std::sqrt(result.error);
+		return result;
+	}
+}
@@ -2,58 +2,62 @@
 #include "Systems/DirectX/ShaderList.h"
 #include "../../DirectXTex/DirectXTex.h"
 #include "Systems/AssetManager.h"
+#include "Systems/VertexPacking.h"
+#include "Systems/TextureCookedFormat.h"
 #include <algorithm>
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
 
 #ifdef _DEBUG
 #include "Systems/Geometory.h"
 #endif
 
-#if _MSC_VER >= 1930
-#ifdef _DEBUG
-#pragma comment(lib, "assimp-vc143-mtd.lib")
-#else
-#pragma comment(lib, "assimp-vc143-mt.lib")
-#endif
-#elif _MSC_VER >= 1920
-#ifdef _DEBUG
-#pragma comment(lib, "assimp-vc142-mtd.lib")
-#else
-#pragma comment(lib, "assimp-vc142-mt.lib")
-#endif
-#elif _MSC_VER >= 1910
-#ifdef _DEBUG
-#pragma comment(lib, "assimp-vc141-mtd.lib")
-#else
-#pragma comment(lib, "assimp-vc141-mt.lib")
-#endif
-#endif
-
 // staticoϐ`
 VertexShader* Model::m_pDefVS = nullptr;
 PixelShader* Model::m_pDefPS = nullptr;
 unsigned int	Model::m_shaderRef = 0;
+std::uint64_t	Model::m_paletteRevision = 0;
+std::unordered_map<std::string, std::weak_ptr<const Model::Animation>>	Model::m_clipCache;
 #ifdef _DEBUG
-std::string		Model::m_errorStr = "";
+thread_local std::string	Model::m_errorStr = "";
 #endif
 
-/*
-* @brief assimp̍sXMMATRIX^ɕϊ
-* @param[in] M assimp̍s
-* @return ϊ̍s
-*/
-DirectX::XMMATRIX GetMatrixFromAssimpMatrix(aiMatrix4x4 M)
+// アセットアーカイブからファイルを探す (マウントしていない・収録されていなければ空)
+static FileView FindPackedFile(const std::string& path)
 {
-	return DirectX::XMMatrixSet(
-		M.a1, M.b1, M.c1, M.d1,
-		M.a2, M.b2, M.c2, M.d2,
-		M.a3, M.b3, M.c3, M.d3,
-		M.a4, M.b4, M.c4, M.d4
-	);
+	return Asset::AssetManager::GetInstance().FindArchiveFile(path);
 }
 
+// アーカイブにあればマップした領域から、無ければファイルから画像を展開する (変換済みの .dds を優先する)
+static HRESULT DecodeTexture(Texture* pTexture, const std::string& path)
+{
+	const std::string cookedPath = TextureCooked::GetCookedPath(path);
+	const FileView packedCooked = FindPackedFile(cookedPath);
+	if (packedCooked && SUCCEEDED(pTexture->Decode(packedCooked.pData, packedCooked.size, cookedPath.c_str()))) return S_OK;
+	const FileView packed = FindPackedFile(path);
+	if (packed) return pTexture->Decode(packed.pData, packed.size, path.c_str());
+	return pTexture->Decode(path.c_str());
+}
+
+// LOD を切り替える画面上の大きさ (境界球の半径 / 画面の高さの半分)。LOD n+1 は g_lodScreenSize[n] 未満で使う
+const float g_lodScreenSize[] = { 0.4f, 0.2f, 0.1f };
+const float g_lodHysteresis = 0.15f;	// 切り替えの境界に持たせる幅 (比率)
+
+// パック済み頂点の入力レイアウト (ストリーム0: 位置、1: VertexPacking::Attribute、2: VertexPacking::Skin)
+const D3D11_INPUT_ELEMENT_DESC g_modelInputLayout[] =
+{
+	{ "POSITION",	0, DXGI_FORMAT_R32G32B32_FLOAT,	0, 0,										D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "NORMAL",		0, DXGI_FORMAT_R16G16_SNORM,	1, offsetof(VertexPacking::Attribute, normal),	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "TEXCOORD",	0, DXGI_FORMAT_R16G16_FLOAT,	1, offsetof(VertexPacking::Attribute, uv),		D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "COLOR",		0, DXGI_FORMAT_R8G8B8A8_UNORM,	1, offsetof(VertexPacking::Attribute, color),	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "WEIGHT",		0, DXGI_FORMAT_R8G8B8A8_UNORM,	2, offsetof(VertexPacking::Skin, weight),		D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	{ "INDEX",		0, DXGI_FORMAT_R8G8B8A8_UINT,	2, offsetof(VertexPacking::Skin, index),		D3D11_INPUT_PER_VERTEX_DATA, 0 },
+};
+
 /*
 * @brief ftHg̃VF[_[쐬
 * @param[out] vs _VF[_[i[
@@ -64,9 +68,15 @@ void MakeModelDefaultShader(VertexShader** vs, PixelShader** ps)
 	const char* ModelVS = R"EOT(
 struct VS_IN {
 	float3 pos : POSITION0;
-	float3 normal : NORMAL0;
+	float2 normal : NORMAL0;
 	float2 uv : TEXCOORD0;
 };
+float3 DecodeNormal(float2 e) {
+	float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+	float t = saturate(-n.z);
+	n.xy += n.xy >= 0.0f ? -t : t;
+	return normalize(n);
+}
 struct VS_OUT {
 	float4 pos : SV_POSITION;
 	float3 normal : NORMAL0;
@@ -77,7 +87,7 @@ VS_OUT main(VS_IN vin) {
 	vout.pos = float4(vin.pos, 1.0f);
 	vout.pos.z += 0.5f;
 	vout.pos.y -= 0.8f;
-	vout.normal = vin.normal;
+	vout.normal = DecodeNormal(vin.normal);
 	vout.uv = vin.uv;
 	return vout;
 })EOT";
@@ -94,6 +104,7 @@ float4 main(PS_IN pin) : SV_TARGET
 	return tex.Sample(samp, pin.uv);
 })EOT";
 	*vs = new VertexShader();
+	Model::SetInputLayout(*vs);
 	(*vs)->Compile(ModelVS);
 	*ps = new PixelShader();
 	(*ps)->Compile(ModelPS);
@@ -107,12 +118,12 @@ float4 main(PS_IN pin) : SV_TARGET
 Model::Model()
 	: m_loadScale(1.0f)
 	, m_loadFlip(None)
-	, m_playNo(ANIME_NONE)
-	, m_blendNo(ANIME_NONE)
-	, m_parametric{ ANIME_NONE, ANIME_NONE }
-	, m_blendTime(0.0f)
-	, m_blendTotalTime(0.0f)
-	, m_parametricBlend(0.0f)
+	, m_isCooked(false)
+	, m_loadDataMs(0.0f)
+	, m_bufferBytes(0)
+	, m_bindPaletteRevision(0)
+	, m_boundsCenter(0.0f, 0.0f, 0.0f)
+	, m_boundsRadius(0.0f)
 {
 	// ftHgVF[_[̓Kp
 	if (m_shaderRef == 0)
@@ -156,6 +167,14 @@ void Model::Reset()
 		if (matIt->pTexture) delete matIt->pTexture;
 		++matIt;
 	}
+
+	m_meshes.clear();
+	m_materials.clear();
+	m_texturePaths.clear();
+	m_palettes.clear();
+	m_paletteBones.clear();
+	m_bindPalette.clear();
+	m_bindPaletteRevision = 0;
 }
 
 /*
@@ -182,33 +201,47 @@ void Model::SetPixelShader(PixelShader* ps)
 * @return ǂݍ݌
 */
 bool Model::Load(const char* file, float scale, Flip flip)
+{
+	if (!LoadData(file, scale, flip)) return false;
+	return CreateDeviceResources();
+}
+
+/*
+* @brief モデルデータの読み込み (デバイスを使わない部分)
+* @details 変換済みバイナリ / assimp での読み込み、スケール・反転の適用、境界球の計算、
+*          テクスチャの展開までを行う。ワーカースレッドから呼び出してよい。
+* @param[in] file 読み込むファイルへのパス
+* @param[in] scale モデルのサイズ変更
+* @param[in] flip 反転設定
+* @return 読み込み結果
+*/
+bool Model::LoadData(const char* file, float scale, Flip flip)
 {
 #ifdef _DEBUG
 	m_errorStr = "";
 #endif
 	Reset();
+	const auto startTime = std::chrono::steady_clock::now();
 
-	// assimp̐ݒ
-	Assimp::Importer importer;
-	int flag = 0;
-	flag |= aiProcess_Triangulate;
-	flag |= aiProcess_FlipUVs;
-	//flag |= aiProcess_MakeLeftHanded;
-
-	// assimpœǂݍ
-	const aiScene* pScene = importer.ReadFile(file, flag);
-	if (!pScene) {
-#ifdef _DEBUG
-		m_errorStr = importer.GetErrorString();
-#endif
-		return false;
+	// 変換済みバイナリ (.mdl) が元ファイルより新しければそちらを使い、無ければassimpで読み込む
+	// アーカイブに収録されていれば、そちらはパック時に変換済みなので鮮度の確認は省く
+	const std::string cookedPath = ModelCooked::GetCookedPath(file, false);
+	const FileView packedCooked = FindPackedFile(cookedPath);
+	m_isCooked = packedCooked ? LoadCooked(packedCooked, cookedPath.c_str(), nullptr) : LoadCooked(cookedPath.c_str(), file);
+	if (!m_isCooked)
+	{
+		Reset();
+		if (!Import(file, FindPackedFile(file))) return false;
 	}
 
-	// ǂݍݎ̐ݒۑ
+	// 読み込み時の設定保存
+	m_loadFile = file;
 	m_loadScale = scale;
 	m_loadFlip = flip;
+	ApplyLoadTransform();
+	ComputeBounds();
 
-	// fBNg̓ǂݎ
+	// ディレクトリの読み取り
 	std::string directory = file;
 	auto strIt = directory.begin();
 	while (strIt != directory.end()) {
@@ -218,22 +251,245 @@ bool Model::Load(const char* file, float scale, Flip flip)
 	}
 	directory = directory.substr(0, directory.find_last_of('\\') + 1);
 
-	// m[h̍쐬
-	MakeBoneNodes(pScene);
-	// bV쐬
-	MakeMesh(pScene, scale, flip);
-	// }eA̍쐬
-	MakeMaterial(pScene, directory);
+	// テクスチャの展開
+	DecodeTextures(directory);
+
+	m_loadDataMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	return true;
+}
+
+/*
+* @brief GPU リソースの作成 (LoadData の後にメインスレッドで呼び出す)
+* @return 作成結果
+*/
+bool Model::CreateDeviceResources()
+{
+	const auto startTime = std::chrono::steady_clock::now();
+
+	// メッシュバッファ・テクスチャの作成
+	const size_t bufferBytes = CreateResources();
+	m_bufferBytes = bufferBytes;
+	size_t sourceBytes = 0;
+	for (auto meshIt = m_meshes.begin(); meshIt != m_meshes.end(); ++meshIt)
+	{
+		sourceBytes += meshIt->vertices.size() * sizeof(Vertex) + meshIt->indices.size() * sizeof(std::uint32_t);
+	}
+
+	// バインドポーズのパレットは姿勢が変わらないため、読み込み時に一度だけ計算する
+	m_bindPalette.resize(m_paletteBones.size());
+	BuildPalette(nullptr, m_bindPalette.data());
+	m_bindPaletteRevision = IssuePaletteRevision();
+
+	const float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	printf("[Info] Model '%s': %s, %u meshes, %u nodes, buffers %.1fKB -> %.1fKB, data %.2fms + device %.2fms\n",
+		m_loadFile.c_str(), m_isCooked ? "cooked" : "FBX", GetMeshNum(), GetNodeNum(),
+		sourceBytes / 1024.0f, bufferBytes / 1024.0f, m_loadDataMs, elapsedMs);
 
 	return true;
 }
 
 /*
-* @brief `
-* @param[in] meshNo `悷郁bVA-1͑S\
-* @param[in] func bV`R[obN
+* @brief モデル用の頂点シェーダーにパック済み頂点の入力レイアウトを設定する
+* @param[in] vs 設定する頂点シェーダー (Compile / Load の前に呼び出す)
+*/
+void Model::SetInputLayout(VertexShader* vs)
+{
+	vs->SetInputLayout(g_modelInputLayout, static_cast<UINT>(sizeof(g_modelInputLayout) / sizeof(g_modelInputLayout[0])));
+}
+
+/*
+* @brief テクスチャの展開
+* @details 画像ファイルを読み込んでメモリ上に展開する (デバイスは使わない)。
+*          見つからなければモデルと同じディレクトリも探索する。
+* @param[in] directory モデルファイルのあるディレクトリ
 */
-void Model::Draw(int meshNo)
+void Model::DecodeTextures(const std::string& directory)
+{
+	for (unsigned int i = 0; i < m_materials.size(); ++i)
+	{
+		m_materials[i].pTexture = nullptr;
+		if (i >= m_texturePaths.size() || m_texturePaths[i].empty()) {
+			continue;
+		}
+		const std::string& path = m_texturePaths[i];
+
+		// テクスチャ領域確保
+		HRESULT hr;
+		m_materials[i].pTexture = new Texture;
+
+		// そのまま読み込み
+		hr = DecodeTexture(m_materials[i].pTexture, path);
+		if (SUCCEEDED(hr)) { continue; }
+
+		// ディレクトリと連結して探索
+		hr = DecodeTexture(m_materials[i].pTexture, directory + path);
+		if (SUCCEEDED(hr)) { continue; }
+
+		// モデルと同じ階層を探索
+		// パスからファイル名のみ取得
+		std::string fullPath = path;
+		std::string::iterator strIt = fullPath.begin();
+		while (strIt != fullPath.end()) {
+			if (*strIt == '/')
+				*strIt = '\\';
+			++strIt;
+		}
+		size_t find = fullPath.find_last_of("\\");
+		std::string fileName = fullPath;
+		if (find != std::string::npos)
+			fileName = fileName.substr(find + 1);
+		// テクスチャの読込
+		hr = DecodeTexture(m_materials[i].pTexture, directory + fileName);
+		if (SUCCEEDED(hr)) { continue; }
+
+		// テクスチャが見つからなかった
+		delete m_materials[i].pTexture;
+		m_materials[i].pTexture = nullptr;
+#ifdef _DEBUG
+		m_errorStr += path;
+#endif
+	}
+}
+
+/*
+* @brief メッシュバッファ・テクスチャの作成
+* @details 頂点は位置 (float3) と、法線・UV・色、スキニング情報 (ボーンを持つメッシュのみ) の
+*          ストリームに分けて詰め込む。ノードに直接付いたメッシュのように全頂点のスキニング情報が
+*          同じ場合は1要素だけを共有する。インデックスは各 LOD の分も連続で持ち、
+*          頂点数が 65536 以下なら 16bit にする。
+*          CPU 側の m_meshes は読み込んだままの精度で残す。
+*          テクスチャは DecodeTextures で展開済みのものを転送する。
+* @return 作成した頂点・インデックスバッファの合計バイト数
+*/
+size_t Model::CreateResources()
+{
+	// メッシュバッファ
+	size_t bufferBytes = 0;
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<VertexPacking::Attribute> attributes;
+	std::vector<VertexPacking::Skin> skins;
+	std::vector<std::uint32_t> longIndices;
+	std::vector<std::uint16_t> shortIndices;
+	for (auto meshIt = m_meshes.begin(); meshIt != m_meshes.end(); ++meshIt)
+	{
+		const size_t vertexNum = meshIt->vertices.size();
+		const bool isSkinned = !meshIt->bones.empty();
+		positions.resize(vertexNum);
+		attributes.resize(vertexNum);
+		skins.resize(isSkinned ? vertexNum : 0);
+		for (size_t v = 0; v < vertexNum; ++v)
+		{
+			const Vertex& vertex = meshIt->vertices[v];
+			VertexPacking::Attribute& attribute = attributes[v];
+			positions[v] = vertex.pos;
+			VertexPacking::PackOctNormal(vertex.normal.x, vertex.normal.y, vertex.normal.z, attribute.normal);
+			attribute.uv[0] = VertexPacking::FloatToHalf(vertex.uv.x);
+			attribute.uv[1] = VertexPacking::FloatToHalf(vertex.uv.y);
+			attribute.color[0] = VertexPacking::PackUnorm8(vertex.color.x);
+			attribute.color[1] = VertexPacking::PackUnorm8(vertex.color.y);
+			attribute.color[2] = VertexPacking::PackUnorm8(vertex.color.z);
+			attribute.color[3] = VertexPacking::PackUnorm8(vertex.color.w);
+			if (isSkinned)
+			{
+				VertexPacking::PackWeights(vertex.weight, skins[v].weight);
+				VertexPacking::PackIndices(vertex.index, skins[v].index);
+			}
+		}
+
+		MeshBuffer::Description desc = {};
+		desc.pVtx = positions.data();
+		desc.vtxSize = sizeof(DirectX::XMFLOAT3);
+		desc.vtxCount = static_cast<UINT>(vertexNum);
+		desc.streams[0].pData = attributes.data();
+		desc.streams[0].size = sizeof(VertexPacking::Attribute);
+		if (isSkinned)
+		{
+			const bool isShared = std::all_of(skins.begin(), skins.end(), [&skins](const VertexPacking::Skin& skin)
+				{
+					return memcmp(&skin, &skins[0], sizeof(skin)) == 0;
+				});
+			desc.streams[1].pData = skins.data();
+			desc.streams[1].size = sizeof(VertexPacking::Skin);
+			desc.streams[1].isShared = isShared;
+		}
+
+		// インデックス (LOD0 の後ろに各 LOD を続けて1つのバッファにする)
+		longIndices.assign(meshIt->indices.begin(), meshIt->indices.end());
+		for (auto lodIt = meshIt->lods.begin(); lodIt != meshIt->lods.end(); ++lodIt)
+		{
+			lodIt->indexStart = static_cast<unsigned int>(longIndices.size());
+			longIndices.insert(longIndices.end(), lodIt->indices.begin(), lodIt->indices.end());
+		}
+		if (vertexNum <= 0x10000)
+		{
+			shortIndices.resize(longIndices.size());
+			for (size_t i = 0; i < shortIndices.size(); ++i)
+			{
+				shortIndices[i] = static_cast<std::uint16_t>(longIndices[i]);
+			}
+			desc.pIdx = shortIndices.data();
+			desc.idxSize = sizeof(std::uint16_t);
+		}
+		else
+		{
+			desc.pIdx = longIndices.data();
+			desc.idxSize = sizeof(std::uint32_t);
+		}
+		desc.idxCount = static_cast<UINT>(longIndices.size());
+		desc.topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+		desc.isWrite = false;
+
+		meshIt->pMesh = new MeshBuffer();
+		meshIt->pMesh->Create(desc);
+		bufferBytes += vertexNum * (desc.vtxSize + desc.streams[0].size);
+		bufferBytes += desc.streams[1].isShared ? desc.streams[1].size : vertexNum * desc.streams[1].size;
+		bufferBytes += desc.idxCount * desc.idxSize;
+	}
+
+	// テクスチャ
+	for (auto matIt = m_materials.begin(); matIt != m_materials.end(); ++matIt)
+	{
+		if (!matIt->pTexture) continue;
+		if (FAILED(matIt->pTexture->Upload()))
+		{
+			delete matIt->pTexture;
+			matIt->pTexture = nullptr;
+		}
+	}
+
+	return bufferBytes;
+}
+
+/*
+* @brief 描画
+* @param[in] meshNo 描画するメッシュ番号、-1なら全て表示
+* @param[in] pNodeMatrices ノード毎の姿勢行列 (nullptrならバインドポーズで描画)
+* @param[in] lod 描画する詳細度
+*/
+void Model::Draw(int meshNo, const DirectX::XMMATRIX* pNodeMatrices, int lod)
+{
+	if (!pNodeMatrices)
+	{
+		Draw(meshNo, m_bindPalette.data(), m_bindPaletteRevision, lod);
+		return;
+	}
+
+	// 姿勢を直接渡された場合はその場でパレットを計算する
+	// (毎フレーム描画するものは ModelInstance の保持するパレットを使うこと)
+	thread_local std::vector<DirectX::XMFLOAT4X4> palette;
+	palette.resize(m_paletteBones.size());
+	BuildPalette(pNodeMatrices, palette.data());
+	Draw(meshNo, palette.data(), IssuePaletteRevision(), lod);
+}
+
+/*
+* @brief 計算済みのパレットで描画
+* @param[in] meshNo 描画するメッシュ番号、-1なら全て表示
+* @param[in] pPalette BuildPalette で計算したスキニング行列
+* @param[in] revision パレットの識別番号 (内容を書き換えたら IssuePaletteRevision で付け直す)
+* @param[in] lod 描画する詳細度 (メッシュに無い場合は最も粗い LOD)
+*/
+void Model::Draw(int meshNo, const DirectX::XMFLOAT4X4* pPalette, std::uint64_t revision, int lod)
 {
 	// VF[_[ݒ
 	m_pVS->Bind();
@@ -258,42 +514,118 @@ void Model::Draw(int meshNo)
 			m_pPS->SetTexture(0, m_materials[m_meshes[i].materialID].pTexture);
 		}
 
-		// --- XLjOs̍쐬Ɠ] ---
-
-		// 1. zmۂAׂĒPʍsŏ (dv)
-		//    ȂƁAgpȂvfɃS~AGPUŕsN܂
-		DirectX::XMFLOAT4X4 boneMatrices[MAX_BONE];
+		// --- スキニング行列の転送 (同じパレットを使うメッシュ間では転送を省略) ---
+		const Palette& palette = m_palettes[m_meshes[i].paletteNo];
+		ShaderList::SetBones(pPalette + palette.offset, palette.count, revision);
 
-		const UINT boneCount = static_cast<UINT>(std::min(m_meshes[i].bones.size(), static_cast<size_t>(MAX_BONE)));
-		for (UINT b = 0; b < boneCount; ++b)
+		// `
+		const Mesh& mesh = m_meshes[i];
+		if (mesh.pMesh)
 		{
-			const Bone& bone = m_meshes[i].bones[b];
-
-			DirectX::XMMATRIX m = DirectX::XMMatrixIdentity();
-			if (bone.index != INDEX_NONE)
+			const int meshLod = std::min(lod, static_cast<int>(mesh.lods.size()));
+			if (meshLod > 0)
 			{
-				// ŏIXLjOs
-				m = bone.invOffset * m_nodes[bone.index].mat;
+				const MeshLod& meshLodData = mesh.lods[meshLod - 1];
+				mesh.pMesh->Draw(static_cast<int>(meshLodData.indices.size()), meshLodData.indexStart);
+			}
+			else
+			{
+				mesh.pMesh->Draw(static_cast<int>(mesh.indices.size()));
 			}
-
-			DirectX::XMStoreFloat4x4(&boneMatrices[b], DirectX::XMMatrixTranspose(m));
 		}
+	}
+}
+
+/*
+* @brief LOD の段数
+* @return LOD0 を含む段数 (いずれかのメッシュが持つ最大の段数)
+*/
+int Model::GetLodNum() const
+{
+	size_t lodNum = 0;
+	for (auto meshIt = m_meshes.begin(); meshIt != m_meshes.end(); ++meshIt)
+	{
+		lodNum = std::max(lodNum, meshIt->lods.size());
+	}
+	return static_cast<int>(lodNum) + 1;
+}
+
+/*
+* @brief 画面上の大きさから LOD を選ぶ
+* @details 前回の LOD から1段ずつ移り、粗くする時は境界より小さく、細かくする時は境界より大きくなるまで待つ。
+* @param[in] screenSize 境界球の半径を画面の高さの半分で割った値
+* @param[in] currentLod 前回選んだ LOD
+* @return 描画する LOD
+*/
+int Model::SelectLod(float screenSize, int currentLod) const
+{
+	const int lodNum = std::min(GetLodNum(), static_cast<int>(sizeof(g_lodScreenSize) / sizeof(g_lodScreenSize[0])) + 1);
+	int lod = std::max(0, std::min(currentLod, lodNum - 1));
+	while (lod + 1 < lodNum && screenSize < g_lodScreenSize[lod] * (1.0f - g_lodHysteresis))
+	{
+		++lod;
+	}
+	while (lod > 0 && screenSize > g_lodScreenSize[lod - 1] * (1.0f + g_lodHysteresis))
+	{
+		--lod;
+	}
+	return lod;
+}
 
-		for (UINT b = boneCount; b < MAX_BONE; ++b)
+/*
+* @brief バインドポーズの全頂点を囲む境界球を求める
+*/
+void Model::ComputeBounds()
+{
+	DirectX::XMVECTOR minPos = DirectX::XMVectorReplicate(FLT_MAX);
+	DirectX::XMVECTOR maxPos = DirectX::XMVectorReplicate(-FLT_MAX);
+	for (auto meshIt = m_meshes.begin(); meshIt != m_meshes.end(); ++meshIt)
+	{
+		for (auto vtxIt = meshIt->vertices.begin(); vtxIt != meshIt->vertices.end(); ++vtxIt)
 		{
-			DirectX::XMStoreFloat4x4(&boneMatrices[b], DirectX::XMMatrixIdentity());
+			const DirectX::XMVECTOR pos = DirectX::XMLoadFloat3(&vtxIt->pos);
+			minPos = DirectX::XMVectorMin(minPos, pos);
+			maxPos = DirectX::XMVectorMax(maxPos, pos);
 		}
+	}
+	if (DirectX::XMVector3Greater(minPos, maxPos))
+	{
+		m_boundsCenter = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		m_boundsRadius = 0.0f;
+		return;
+	}
 
-		// 3. 萔obt@֏
-		//    ShaderListoRāA݃oChĂVF[_[(VS_ANIME)̒萔obt@XV
-		ShaderList::SetBones(boneMatrices);
-		// ----------------------------------------
+	const DirectX::XMVECTOR center = DirectX::XMVectorScale(DirectX::XMVectorAdd(minPos, maxPos), 0.5f);
+	float radiusSq = 0.0f;
+	for (auto meshIt = m_meshes.begin(); meshIt != m_meshes.end(); ++meshIt)
+	{
+		for (auto vtxIt = meshIt->vertices.begin(); vtxIt != meshIt->vertices.end(); ++vtxIt)
+		{
+			const DirectX::XMVECTOR offset = DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&vtxIt->pos), center);
+			radiusSq = std::max(radiusSq, DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(offset)));
+		}
+	}
+	DirectX::XMStoreFloat3(&m_boundsCenter, center);
+	m_boundsRadius = std::sqrt(radiusSq);
+}
 
-		// `
-		if (m_meshes[i].pMesh)
+/*
+* @brief ノード行列からスキニング行列を計算する
+* @param[in] pNodeMatrices ノード毎の姿勢行列 (nullptrならバインドポーズ)
+* @param[out] pOut 計算結果 (GetPaletteSize() 個、シェーダー用に転置済み)
+*/
+void Model::BuildPalette(const DirectX::XMMATRIX* pNodeMatrices, DirectX::XMFLOAT4X4* pOut) const
+{
+	const size_t boneNum = m_paletteBones.size();
+	for (size_t i = 0; i < boneNum; ++i)
+	{
+		const Bone& bone = m_paletteBones[i];
+		DirectX::XMMATRIX m = DirectX::XMMatrixIdentity();
+		if (bone.index != INDEX_NONE)
 		{
-			m_meshes[i].pMesh->Draw();
+			m = bone.invOffset * (pNodeMatrices ? pNodeMatrices[bone.index] : m_nodes[bone.index].mat);
 		}
+		DirectX::XMStoreFloat4x4(&pOut[i], DirectX::XMMatrixTranspose(m));
 	}
 }
 
@@ -341,6 +673,19 @@ uint32_t Model::GetMaterialNum()
 	return static_cast<uint32_t>(m_materials.size());
 }
 
+/*
+* @brief GPU 上のメモリ量 (頂点・インデックスバッファとマテリアルのテクスチャ)
+*/
+size_t Model::GetMemorySize() const
+{
+	size_t bytes = m_bufferBytes;
+	for (const Material& material : m_materials)
+	{
+		if (material.pTexture) bytes += material.pTexture->GetMemorySize();
+	}
+	return bytes;
+}
+
 /*
 * @brief Aj[V̕ϊs擾
 * @param[in] index {[ԍ
@@ -362,9 +707,9 @@ DirectX::XMMATRIX Model::GetBone(NodeIndex index)
 */
 const Model::Animation* Model::GetAnimation(AnimeNo no)
 {
-	if (AnimeNoCheck(no))
+	if (0 <= no && no < static_cast<AnimeNo>(m_animes.size()))
 	{
-		return &m_animes[no];
+		return m_animes[no].pClip.get();
 	}
 	return nullptr;
 }
@@ -391,6 +736,17 @@ Model::AnimeNo Model::AddAnimation(const std::string& assetID)
 	return AddAnimation(filePath.c_str(), assetID);
 }
 
+/*
+* @brief IDからアニメーション番号を検索
+* @param[in] assetID AddAnimationで登録したID
+* @return アニメーション番号 (未登録なら ANIME_NONE)
+*/
+Model::AnimeNo Model::FindAnimation(const std::string& assetID) const
+{
+	auto it = m_animeIdMap.find(assetID);
+	return (it != m_animeIdMap.end()) ? it->second : ANIME_NONE;
+}
+
 /*
 * @brief Aj[Vǂݍ
 * @param[in] file ǂݍރAj[Vt@Cւ̃pX
@@ -401,479 +757,58 @@ Model::AnimeNo Model::AddAnimation(const char* file, const std::string& aliasID)
 #ifdef _DEBUG
 	m_errorStr = "";
 #endif
-
-	// assimp̐ݒ
-	Assimp::Importer importer;
-	int flag = 0;
-	flag |= aiProcess_Triangulate;
-	flag |= aiProcess_FlipUVs;
-	if (m_loadFlip == Flip::XFlip)  flag |= aiProcess_MakeLeftHanded;
-
-	// assimpœǂݍ
-	const aiScene* pScene = importer.ReadFile(file, flag);
-	if (!pScene)
-	{
-#ifdef _DEBUG
-		m_errorStr += importer.GetErrorString();
-#endif
-		return ANIME_NONE;
-	}
-
-	// Aj[V`FbN
-	if (!pScene->HasAnimations())
-	{
-#ifdef _DEBUG
-		m_errorStr += "no animation.";
-#endif
-		return ANIME_NONE;
-	}
-
-	// Aj[Vf[^m
-	aiAnimation* assimpAnime = pScene->mAnimations[0];
-	m_animes.push_back(Animation());
-	Animation& anime = m_animes.back();
-
-	// Aj[Vݒ
-	float animeFrame = static_cast<float>(assimpAnime->mTicksPerSecond);
-	anime.totalTime = static_cast<float>(assimpAnime->mDuration) / animeFrame;
-	anime.channels.resize(assimpAnime->mNumChannels);
-	Channels::iterator channelIt = anime.channels.begin();
-	while (channelIt != anime.channels.end())
-	{
-		// Ή`l({[)T
-		uint32_t channelIdx = static_cast<uint32_t>(channelIt - anime.channels.begin());
-		aiNodeAnim* assimpChannel = assimpAnime->mChannels[channelIdx];
-		Model::Nodes::iterator nodeIt = std::find_if(m_nodes.begin(), m_nodes.end(),
-			[assimpChannel](Node& node) {
-				return node.name == assimpChannel->mNodeName.data;
-			});
-		if (nodeIt == m_nodes.end())
+	const auto startTime = std::chrono::steady_clock::now();
+
+	// 他のモデルが読み込み済みのクリップがあれば、ファイルを読まずにノードへの対応だけを作る
+	// (XFlip は assimp で左手系へ変換したキーになるため別のクリップとして扱う)
+	const std::string cacheKey = (aliasID.empty() ? std::string(file) : aliasID) + (m_loadFlip == XFlip ? "|XFlip" : "");
+	AnimeNo newIndex = ANIME_NONE;
+	const char* source = "shared";
+	auto cacheIt = m_clipCache.find(cacheKey);
+	if (cacheIt != m_clipCache.end())
+	{
+		AnimationPtr pClip = cacheIt->second.lock();
+		if (pClip)
 		{
-			channelIt->index = INDEX_NONE;
-			++channelIt;
-			continue;
-		}
-
-		// eL[̒lݒ
-		channelIt->index = static_cast<NodeIndex>(nodeIt - m_nodes.begin());
-		Timeline& timeline = channelIt->timeline;
-
-		// xXMVECTOR^Ŋi[
-		using XMVectorKey = std::pair<float, DirectX::XMVECTOR>;
-		using XMVectorKeys = std::map<float, DirectX::XMVECTOR>;
-		XMVectorKeys keys[3];
-		// ʒu
-		for (UINT i = 0; i < assimpChannel->mNumPositionKeys; ++i)
-		{
-			aiVectorKey& key = assimpChannel->mPositionKeys[i];
-			keys[0].insert(XMVectorKey(static_cast<float>(key.mTime) / animeFrame,
-				DirectX::XMVectorSet(key.mValue.x, key.mValue.y, key.mValue.z, 0.0f)
-			));
-		}
-		// ]
-		for (UINT i = 0; i < assimpChannel->mNumRotationKeys; ++i)
-		{
-			aiQuatKey& key = assimpChannel->mRotationKeys[i];
-			keys[1].insert(XMVectorKey(static_cast<float>(key.mTime) / animeFrame,
-				DirectX::XMVectorSet(key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w)));
-		}
-		// gk
-		for (UINT i = 0; i < assimpChannel->mNumScalingKeys; ++i)
-		{
-			aiVectorKey& key = assimpChannel->mScalingKeys[i];
-			keys[2].insert(XMVectorKey(static_cast<float>(key.mTime) / animeFrame,
-				DirectX::XMVectorSet(key.mValue.x, key.mValue.y, key.mValue.z, 0.0f)));
-		}
-
-		// e^CC̐擪̎QƂݒ
-		XMVectorKeys::iterator it[] = { keys[0].begin(), keys[1].begin(), keys[2].begin() };
-		for (int i = 0; i < 3; ++i)
-		{
-			// L[Ȃꍇ́AQƏI
-			if (keys[i].size() == 1)
-				++it[i];
-		}
-
-		// evfƂ̃^CCł͂ȂAׂĂ̕ϊ܂߂^CC̍쐬
-		while (it[0] != keys[0].end() || it[1] != keys[1].end() || it[2] != keys[2].end())
-		{
-			// ŏԂ̎ZoWbN
-			// ̎QƈʒuňԏԂ擾
-			float time = anime.totalTime; // [vɏKv͏\傫Ȓl
-			bool isEnd = true; // Ip
-
-			for (int i = 0; i < 3; ++i)
-			{
-				// ύXFCe[^I[łȂꍇ̂ݎԂr
-				if (it[i] != keys[i].end())
-				{
-					time = std::min(it[i]->first, time);
-					isEnd = false;
-				}
-			}
-
-			// ׂẴCe[^I[ȂI
-			if (isEnd) break;
-
-			// ԂɊÂĕԒlvZ
-			DirectX::XMVECTOR result[3];
-			for (int i = 0; i < 3; ++i)
-			{
-				// 擪̃L[菬Ԃł΁A擪̒lݒ
-				if (time < keys[i].begin()->first)
-				{
-					result[i] = keys[i].begin()->second;
-				}
-				// ŏIL[傫Ԃł΁AŏI̒lݒ
-				else if (keys[i].rbegin()->first <= time)
-				{
-					result[i] = keys[i].rbegin()->second;
-					it[i] = keys[i].end();
-				}
-				// L[mɋ܂ꂽԂł΁AԒlvZ
-				else
-				{
-					// QƂĂ鎞ԂƓł΁A̎QƂփL[i߂
-					if (it[i]->first <= time)
-					{
-						++it[i];
-					}
-
-					// ԒľvZ
-					XMVectorKeys::iterator prev = it[i];
-					--prev;
-					float rate = (time - prev->first) / (it[i]->first - prev->first);
-					result[i] = DirectX::XMVectorLerp(prev->second, it[i]->second, rate);
-				}
-			}
-
-			// w莞ԂɊÂL[ǉ
-			Transform transform;
-			DirectX::XMStoreFloat3(&transform.translate, result[0]);
-			DirectX::XMStoreFloat4(&transform.quaternion, result[1]);
-			DirectX::XMStoreFloat3(&transform.scale, result[2]);
-			timeline.insert(Key(time, transform));
+			newIndex = BindAnimation(pClip);
 		}
-
-		++channelIt;
 	}
 
-	// Ajԍ
-	AnimeNo newIndex = static_cast<AnimeNo>(m_animes.size() - 1);
-
-	// IDw肳Ă΃}bvɓo^
-	if (!aliasID.empty())
-	{
-		m_animeIdMap[aliasID] = newIndex;
-	}
-
-	return newIndex;
-}
-
-/*
-* @brief Aj[V̍XV
-* @param[in] tick Aj[Voߎ
-*/
-void Model::Step(float tick)
-{
-	// Aj[V̍ĐmF
-	if (m_playNo == ANIME_NONE) { return; }
-
-	//--- Aj[Vs̍XV
-	// pgbN
-	if (m_playNo == PARAMETRIC_ANIME || m_blendNo == PARAMETRIC_ANIME)
+	// 変換済みバイナリ (.anm) は左手系への変換をしていないため、XFlip のモデルは常にassimpで読み込む
+	if (newIndex == ANIME_NONE && m_loadFlip != XFlip)
 	{
-		CalcAnime(PARAMETRIC0, m_parametric[0]);
-		CalcAnime(PARAMETRIC1, m_parametric[1]);
+		const std::string cookedPath = ModelCooked::GetCookedPath(file, true);
+		const FileView packedCooked = FindPackedFile(cookedPath);
+		newIndex = packedCooked ? LoadCookedAnimation(packedCooked, cookedPath.c_str(), nullptr) : LoadCookedAnimation(cookedPath.c_str(), file);
+		source = "cooked";
 	}
-	// CAj
-	if (m_playNo != ANIME_NONE && m_playNo != PARAMETRIC_ANIME)
+	if (newIndex == ANIME_NONE)
 	{
-		CalcAnime(MAIN, m_playNo);
-	}
-	// uhAj
-	if (m_blendNo != ANIME_NONE && m_blendNo != PARAMETRIC_ANIME)
-	{
-		CalcAnime(BLEND, m_blendNo);
+		newIndex = ImportAnimation(file, FindPackedFile(file));
+		source = "FBX";
+		if (newIndex == ANIME_NONE) return ANIME_NONE;
 	}
+	m_clipCache[cacheKey] = m_animes[newIndex].pClip;
 
-	std::function<void(NodeIndex, DirectX::XMMATRIX)> funcCalcBones =
-		[&](NodeIndex index, DirectX::XMMATRIX parent)
-		{
-			Transform transform;
-			// pgbN
-			if (m_playNo == PARAMETRIC_ANIME || m_blendNo == PARAMETRIC_ANIME)
-			{
-				LerpTransform(&transform, m_nodeTransform[PARAMETRIC0][index], m_nodeTransform[PARAMETRIC1][index], m_parametricBlend);
-				if (m_playNo == PARAMETRIC_ANIME) m_nodeTransform[MAIN][index] = transform;
-				if (m_blendNo == PARAMETRIC_ANIME) m_nodeTransform[BLEND][index] = transform;
-			}
-			// uhAj
-			if (m_blendNo != ANIME_NONE)
-			{
-				LerpTransform(&transform, m_nodeTransform[MAIN][index], m_nodeTransform[BLEND][index], m_blendTime / m_blendTotalTime);
-			}
-			else
-			{
-				transform = m_nodeTransform[MAIN][index];
-			}
-
-			// Ym[h̎psvZ
-			Node& node = m_nodes[index];
-			DirectX::XMMATRIX T = DirectX::XMMatrixTranslationFromVector(DirectX::XMLoadFloat3(&transform.translate));
-			DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&transform.quaternion));
-			DirectX::XMMATRIX S = DirectX::XMMatrixScalingFromVector(DirectX::XMLoadFloat3(&transform.scale));
-			node.mat = (S * R * T) * parent;
-
-			// qvf̎pXV
-			for (auto child : node.children)
-			{
-				funcCalcBones(child, node.mat);
-			}
-		};
-
-	funcCalcBones(0, DirectX::XMMatrixScaling(m_loadScale, m_loadScale, m_loadScale));
-
-
-	//--- Aj[V̎ԍXV
-	// CAj
-	if (m_playNo != ANIME_NONE && m_playNo != PARAMETRIC_ANIME) {
-		UpdateAnime(m_playNo, tick);
-	}
-	// uhAj
-	if (m_blendNo != ANIME_NONE)
-	{
-		if (m_blendNo != PARAMETRIC_ANIME) {
-			UpdateAnime(m_blendNo, tick);
-		}
-		m_blendTime += tick;
-		if (m_blendTime >= m_blendTotalTime) // oOC: <= ł͂Ȃ >=
-		{
-			// uhAj̎I
-			m_blendTime = 0.0f;
-			m_blendTotalTime = 0.0f;
-			m_playNo = m_blendNo;
-			m_blendNo = ANIME_NONE;
-		}
-	}
-	// pgbN
-	if (m_playNo == PARAMETRIC_ANIME || m_blendNo == PARAMETRIC_ANIME)
-	{
-		UpdateAnime(m_parametric[0], tick);
-		UpdateAnime(m_parametric[1], tick);
-	}
-}
-
-/*
-* @brief Aj[VĐ
-* @param[in] no ĐAj[Vԍ
-* @param[in] loop [vĐtO
-* @param[in] speed Đx
-*/
-void Model::Play(AnimeNo no, bool loop, float speed)
-{
-	// 再生チェック
-	if (!AnimeNoCheck(no)) { return; }
-
-	// IMPORTANT: allow restarting even if the same animation is requested
-	// This avoids "resume from last time" when Play is called again for UI effects.
-	// Also clear blend state so previous transitions do not leak.
-	m_blendTime = 0.0f;
-	m_blendTotalTime = 0.0f;
-	m_blendNo = ANIME_NONE;
-
-	// 合成アニメーションかチェック
-	if (no != PARAMETRIC_ANIME)
-	{
-		// 通常の初期化（nowTimeを0に戻す）
-		InitAnime(no);
-		m_animes[no].isLoop = loop;
-		m_animes[no].speed = speed;
-	}
-	else
-	{
-		// 合成アニメーションの元になっているアニメーションを初期化
-		InitAnime(m_parametric[0]);
-		InitAnime(m_parametric[1]);
-		m_animes[m_parametric[0]].isLoop = loop;
-		m_animes[m_parametric[1]].isLoop = loop;
-		SetParametricBlend(0.0f);
-	}
-
-	// 再生アニメーションの設定（同一noでも上のInitで必ずリスタートする）
-	m_playNo = no;
-}
-
-
-void Model::Play(const std::string& assetID, bool loop, float speed)
-{
-	auto it = m_animeIdMap.find(assetID);
-	if (it != m_animeIdMap.end())
-	{
-		// CfbNXgĊPlayĂ
-		Play(it->second, loop, speed);
-	}
-	else
-	{
-		std::cerr << "Warning: Animation ID '" << assetID << "' not found in model." << std::endl;
-	}
-}
-
-/*
-* @brief uhĐ
-* @param[in] no Aj[Vԍ
-* @param[in] blendTime uhɊ|鎞
-* @param[in] loop [vtO
-* @param[in] speed Đx
-*/
-void Model::PlayBlend(AnimeNo no, float blendTime, bool loop, float speed)
-{
-	// Đ`FbN
-	if (!AnimeNoCheck(no)) { return; }
-
-	// Aj[V`FbN
-	if (no != PARAMETRIC_ANIME)
-	{
-		InitAnime(no);
-		m_animes[no].isLoop = loop;
-		m_animes[no].speed = speed;
-	}
-	else
-	{
-		// Aj[V̌ɂȂĂAj[V
-		InitAnime(m_parametric[0]);
-		InitAnime(m_parametric[1]);
-		m_animes[m_parametric[0]].isLoop = loop;
-		m_animes[m_parametric[1]].isLoop = loop;
-		SetParametricBlend(0.0f);
-	}
-
-	// uh̐ݒ
-	m_blendTime = 0.0f;
-	m_blendTotalTime = blendTime;
-	m_blendNo = no;
-}
-
-void Model::PlayBlend(const std::string& animeID, float blendTime, bool loop, float speed)
-{
-	// IDCfbNX
-	auto it = m_animeIdMap.find(animeID);
-	if (it != m_animeIdMap.end())
-	{
-		// CfbNX(AnimeNo)gāAPlayBlendĂ
-		PlayBlend(it->second, blendTime, loop, speed);
-	}
-	else
-	{
-		// IDȂꍇ̓G[OoĉȂ
-		std::cerr << "Warning: PlayBlend failed. Animation ID '" << animeID << "' not found." << std::endl;
-	}
-}
-
-/*
-* @brief Aj[V̐ݒ
-* @param[in] no1 Aj1
-* @param[in] no2 Aj2
-*/
-void Model::SetParametric(AnimeNo no1, AnimeNo no2)
-{
-	// Aj[V`FbN
-	if (!AnimeNoCheck(no1)) { return; }
-	if (!AnimeNoCheck(no2)) { return; }
-
-	// ݒ
-	m_parametric[0] = no1;
-	m_parametric[1] = no2;
-	SetParametricBlend(0.0f);
-}
-
-/*
-* @brief Aj[V̍ݒ
-* @param[in] blendRate
-*/
-void Model::SetParametricBlend(float blendRate)
-{
-	// Ajݒ肳Ă邩mF
-	if (m_parametric[0] == ANIME_NONE || m_parametric[1] == ANIME_NONE) return;
-
-	// ݒ
-	m_parametricBlend = blendRate;
-
-	// ɊÂăAj[V̍Đxݒ
-	Animation& anime1 = m_animes[m_parametric[0]];
-	Animation& anime2 = m_animes[m_parametric[1]];
-	float blendTotalTime = anime1.totalTime * (1.0f - m_parametricBlend) + anime2.totalTime * m_parametricBlend;
-	anime1.speed = anime1.totalTime / blendTotalTime;
-	anime2.speed = anime2.totalTime / blendTotalTime;
-}
-
-/*
-* @brief Aj[V̍ĐԂύX
-* @param[in] no ύXAj
-* @param[in] time VĐ
-*/
-void Model::SetAnimationTime(AnimeNo no, float time)
-{
-	// Aj[V`FbN
-	if (!AnimeNoCheck(no)) { return; }
-
-	// ĐԕύX
-	Animation& anime = m_animes[no];
-	anime.nowTime = time;
-	while (anime.nowTime >= anime.totalTime)
-	{
-		anime.nowTime -= anime.totalTime;
-	}
-}
-
-/*
-* @brief ĐtO̎擾
-* @param[in] no ׂAjԍ
-* @return ݍĐȂtrue
-*/
-bool Model::IsPlay(AnimeNo no)
-{
-	// Aj[V`FbN
-	if (!AnimeNoCheck(no)) { return false; }
-
-	// pgbÑ͍Ajɔf
-	if (no == PARAMETRIC_ANIME) { no = m_parametric[0]; }
-
-	// ĐԂ̔
-	if (m_animes[no].totalTime < m_animes[no].nowTime) { return false; }
-
-	// ꂼ̍Đԍɐݒ肳Ă邩mF
-	if (m_playNo == no) { return true; }
-	if (m_blendNo == no) { return true; }
-	if (m_playNo == PARAMETRIC_ANIME || m_blendNo == PARAMETRIC_ANIME)
+	// IDが指定されていればマップに登録
+	if (!aliasID.empty())
 	{
-		if (m_parametric[0] == no) { return true; }
-		if (m_parametric[1] == no) { return true; }
+		m_animeIdMap[aliasID] = newIndex;
 	}
 
-	// ĐłȂ
-	return false;
-}
-
-/*
-* @brief Đ̔ԍ̎擾
-* @return Ajԍ
-*/
-Model::AnimeNo Model::GetPlayNo()
-{
-	return m_playNo;
-}
+	const AnimeBinding& binding = m_animes[newIndex];
+	const Animation& anime = *binding.pClip;
+	const size_t boundNum = binding.channelNodes.size() - std::count(binding.channelNodes.begin(), binding.channelNodes.end(), INDEX_NONE);
+	const float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	printf("[Info] Animation '%s': %u/%u channels bound, %.1fKB -> %.1fKB, max error T %.5f / R %.4fdeg / S %.5f (%s, %.2fms)\n",
+		aliasID.empty() ? file : aliasID.c_str(), static_cast<unsigned>(boundNum), static_cast<unsigned>(anime.channels.size()),
+		anime.rawBytes / 1024.0f, anime.packedBytes / 1024.0f,
+		anime.maxError[0], DirectX::XMConvertToDegrees(anime.maxError[1]), anime.maxError[2],
+		source, elapsedMs);
 
-/*
-* @brief Đ̃uhAj̎擾
-* @return Ajԍ
-*/
-Model::AnimeNo Model::GetBlendNo()
-{
-	return m_blendNo;
+	return newIndex;
 }
 
-
 #ifdef _DEBUG
 
 /*
@@ -890,420 +825,15 @@ std::string Model::GetError()
 */
 void Model::DrawBone()
 {
-	// ċA
-	std::function<void(int, DirectX::XMFLOAT3)> FuncDrawBone =
-		[&FuncDrawBone, this](int idx, DirectX::XMFLOAT3 parent)
-		{
-			// em[h猻݈ʒu܂ŕ`
-			DirectX::XMFLOAT3 pos;
-			DirectX::XMStoreFloat3(&pos, DirectX::XMVector3TransformCoord(DirectX::XMVectorZero(), m_nodes[idx].mat));
-			Geometory::AddLine(parent, pos, DirectX::XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f));
-
-			// qm[h̕`
-			auto it = m_nodes[idx].children.begin();
-			while (it != m_nodes[idx].children.end())
-			{
-				FuncDrawBone(*it, pos);
-				++it;
-			}
-		};
-
-	// `s
-	FuncDrawBone(0, DirectX::XMFLOAT3());
-	Geometory::DrawLines();
-}
-
-#endif
-
-
-void Model::MakeBoneNodes(const void* ptr)
-{
-	// ċAAssimp̃m[hǂݎ
-	std::function<NodeIndex(aiNode*, NodeIndex, DirectX::XMMATRIX mat)> FuncAssimpNodeConvert =
-		[&FuncAssimpNodeConvert, this](aiNode* assimpNode, NodeIndex parent, DirectX::XMMATRIX mat)
-		{
-			DirectX::XMMATRIX transform = GetMatrixFromAssimpMatrix(assimpNode->mTransformation);
-			std::string name = assimpNode->mName.data;
-			if (name.find("$AssimpFbx") != std::string::npos)
-			{
-				mat = transform * mat;
-				return FuncAssimpNodeConvert(assimpNode->mChildren[0], parent, mat);
-			}
-			else
-			{
-				// Assimp̃m[hfNX֊i[
-				Node node;
-				node.name = assimpNode->mName.data;
-				node.parent = parent;
-				node.children.resize(assimpNode->mNumChildren);
-				node.mat = mat;
-
-				// m[hXgɒǉ
-				m_nodes.push_back(node);
-				NodeIndex nodeIndex = static_cast<NodeIndex>(m_nodes.size() - 1);
-
-				// qvflɕϊ
-				for (UINT i = 0; i < assimpNode->mNumChildren; ++i)
-				{
-					m_nodes[nodeIndex].children[i] = FuncAssimpNodeConvert(
-						assimpNode->mChildren[i], nodeIndex, DirectX::XMMatrixIdentity());
-				}
-				return nodeIndex;
-			}
-		};
-
-	// m[h쐬
-	m_nodes.clear();
-	FuncAssimpNodeConvert(reinterpret_cast<const aiScene*>(ptr)->mRootNode, INDEX_NONE, DirectX::XMMatrixIdentity());
-
-	// Aj[VvZ̈ɁAm[h̏f[^쐬
-	Transform init = {
-		DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f),
-		DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f),
-		DirectX::XMFLOAT3(1.0f, 1.0f, 1.0f)
-	};
-	for (int i = 0; i < MAX_TRANSFORM; ++i)
+	// 親→子の順に並んでいるため、先頭から走査すれば親の位置は計算済み
+	std::vector<DirectX::XMFLOAT3> positions(m_nodes.size());
+	for (size_t i = 0; i < m_nodes.size(); ++i)
 	{
-		m_nodeTransform[i].resize(m_nodes.size(), init);
+		DirectX::XMStoreFloat3(&positions[i], DirectX::XMVector3TransformCoord(DirectX::XMVectorZero(), m_nodes[i].mat));
+		DirectX::XMFLOAT3 parent = m_nodeParents[i] == INDEX_NONE ? DirectX::XMFLOAT3() : positions[m_nodeParents[i]];
+		Geometory::AddLine(parent, positions[i], DirectX::XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f));
 	}
+	Geometory::DrawLines();
 }
 
-void Model::MakeWeight(const void* ptr, int meshIdx)
-{
-	const aiScene* pScene = reinterpret_cast<const aiScene*>(ptr);
-
-	// bVɑΉ{[邩
-	aiMesh* assimpMesh = pScene->mMeshes[meshIdx];
-	Mesh& mesh = m_meshes[meshIdx];
-	if (assimpMesh->HasBones())
-	{
-		// bV̒_̈쐬
-		struct WeightPair
-		{
-			unsigned int idx;
-			float weight;
-		};
-		std::vector<std::vector<WeightPair>> weights;
-		weights.resize(mesh.vertices.size());
-
-
-		// bVɊ蓖ĂĂ{[̈m
-		mesh.bones.resize(assimpMesh->mNumBones);
-		for (auto boneIt = mesh.bones.begin(); boneIt != mesh.bones.end(); ++boneIt)
-		{
-			UINT boneIdx = static_cast<UINT>(boneIt - mesh.bones.begin());
-			aiBone* assimpBone = assimpMesh->mBones[boneIdx];
-			// \zς݂̃{[m[hYm[h擾
-			std::string boneName = assimpBone->mName.data;
-			auto nodeIt = std::find_if(m_nodes.begin(), m_nodes.end(),
-				[boneName](const Node& val) {
-					return val.name == boneName;
-				});
-			// bVɊ蓖ĂĂ{[Am[hɑ݂Ȃ
-			if (nodeIt == m_nodes.end())
-			{
-				boneIt->index = INDEX_NONE;
-				continue;
-			}
-
-			// bṼ{[ƃm[h̕RÂ
-			boneIt->index = static_cast<NodeIndex>(nodeIt - m_nodes.begin());
-			boneIt->invOffset = GetMatrixFromAssimpMatrix(assimpBone->mOffsetMatrix);
-			boneIt->invOffset.r[3].m128_f32[0] *= m_loadScale;
-			boneIt->invOffset.r[3].m128_f32[1] *= m_loadScale;
-			boneIt->invOffset.r[3].m128_f32[2] *= m_loadScale;
-			boneIt->invOffset =
-				DirectX::XMMatrixScaling(m_loadFlip == ZFlipUseAnime ? -1.0f : 1.0f, 1.0f, 1.0f) *
-				boneIt->invOffset *
-				DirectX::XMMatrixScaling(1.f / m_loadScale, 1.f / m_loadScale, 1.f / m_loadScale);
-
-			// EFCg̐ݒ
-			UINT weightNum = assimpBone->mNumWeights;
-			for (UINT i = 0; i < weightNum; ++i)
-			{
-				aiVertexWeight weight = assimpBone->mWeights[i];
-				weights[weight.mVertexId].push_back({ boneIdx, weight.mWeight });
-			}
-		}
-
-		// 擾Ă_EFCgݒ
-		for (int i = 0; i < weights.size(); ++i)
-		{
-			if (weights[i].size() >= 4)
-			{
-				std::sort(weights[i].begin(), weights[i].end(), [](WeightPair& a, WeightPair& b) {
-					return a.weight > b.weight;
-					});
-				// EFCg4ɍ킹ĐK
-				float total = 0.0f;
-				for (int j = 0; j < 4; ++j)
-					total += weights[i][j].weight;
-				for (int j = 0; j < 4; ++j)
-					weights[i][j].weight /= total;
-			}
-			for (int j = 0; j < weights[i].size() && j < 4; ++j)
-			{
-				mesh.vertices[i].index[j] = weights[i][j].idx;
-				mesh.vertices[i].weight[j] = weights[i][j].weight;
-			}
-		}
-	}
-	else
-	{
-		// bV̐em[hgXtH[ƂČvZ
-		std::string nodeName = assimpMesh->mName.data;
-		auto nodeIt = std::find_if(m_nodes.begin(), m_nodes.end(),
-			[nodeName](const Node& val) {
-				return val.name == nodeName;
-			});
-		if (nodeIt == m_nodes.end())
-		{
-			return;	// {[f[^Ȃ
-		}
-
-		// bVłȂem[hċAT
-		std::function<int(int)> FuncFindNode =
-			[&FuncFindNode, this, pScene](NodeIndex parent)
-			{
-				std::string name = m_nodes[parent].name;
-				for (UINT i = 0; i < pScene->mNumMeshes; ++i)
-				{
-					if (name == pScene->mMeshes[i]->mName.data)
-					{
-						return FuncFindNode(m_nodes[parent].parent);
-					}
-				}
-				return parent;
-			};
-
-		Bone bone;
-		bone.index = FuncFindNode(nodeIt->parent);
-		bone.invOffset = DirectX::XMMatrixInverse(nullptr, m_nodes[bone.index].mat);
-		for (auto vtxIt = mesh.vertices.begin(); vtxIt != mesh.vertices.end(); ++vtxIt)
-		{
-			vtxIt->weight[0] = 1.0f;
-		}
-
-		mesh.bones.resize(1);
-		mesh.bones[0] = bone;
-	}
-}
-
-
-
-bool Model::AnimeNoCheck(AnimeNo no)
-{
-	// pgbNAj[VmF
-	if (no == PARAMETRIC_ANIME)
-	{
-		// pgbÑAj[Vݒ肳Ă邩
-		return
-			m_parametric[0] != ANIME_NONE &&
-			m_parametric[1] != ANIME_NONE;
-	}
-	else
-	{
-		// ȂAj[Vԍǂ
-		return 0 <= no && no < m_animes.size();
-	}
-}
-void Model::InitAnime(AnimeNo no)
-{
-	// Aj̐ݒȂApgbNŐݒ肳ĂȂ珉Ȃ
-	if (no == ANIME_NONE || no == PARAMETRIC_ANIME) { return; }
-
-	Animation& anime = m_animes[no];
-	anime.nowTime = 0.0f;
-	anime.speed = 1.0f;
-	anime.isLoop = false;
-}
-void Model::CalcAnime(AnimeTransform kind, AnimeNo no)
-{
-	Animation& anime = m_animes[no];
-	Channels::iterator channelIt = anime.channels.begin();
-	while (channelIt != anime.channels.end())
-	{
-		// v{[Ȃ΃XLbv
-		Timeline& timeline = channelIt->timeline;
-		if (channelIt->index == INDEX_NONE || timeline.empty())
-		{
-			++channelIt;
-			continue;
-		}
-
-		//--- Ym[h̎pAj[VōXV
-		Transform& transform = m_nodeTransform[kind][channelIt->index];
-		if (timeline.size() <= 1)
-		{
-			// L[Ȃ̂Œl̂܂܎gp
-			transform = channelIt->timeline.begin()->second;
-		}
-		else
-		{
-			Timeline::iterator startIt = timeline.begin();
-			if (anime.nowTime <= startIt->first)
-			{
-				// 擪L[O̎ԂȂA擪̒lgp
-				transform = startIt->second;
-			}
-			else if (timeline.rbegin()->first <= anime.nowTime)
-			{
-				// ŏIL[̎ԂȂAŌ̒lgp
-				transform = timeline.rbegin()->second;
-			}
-			else
-			{
-				// w肳ꂽԂ2̃L[AԂꂽlvZ
-				Timeline::iterator nextIt = timeline.upper_bound(anime.nowTime);
-				startIt = nextIt;
-				--startIt;
-				float rate = (anime.nowTime - startIt->first) / (nextIt->first - startIt->first);
-				LerpTransform(&transform, startIt->second, nextIt->second, rate);
-			}
-		}
-
-		++channelIt;
-	}
-}
-void Model::UpdateAnime(AnimeNo no, float tick)
-{
-	if (no == PARAMETRIC_ANIME) { return; }
-
-	Animation& anime = m_animes[no];
-	anime.nowTime += anime.speed * tick;
-	if (anime.isLoop)
-	{
-		while (anime.nowTime >= anime.totalTime)
-		{
-			anime.nowTime -= anime.totalTime;
-		}
-	}
-}
-void Model::CalcBones(NodeIndex index, const DirectX::XMMATRIX parent)
-{
-	//--- Aj[VƂ̃p[^
-	Transform transform;
-	// pgbN
-	if (m_playNo == PARAMETRIC_ANIME || m_blendNo == PARAMETRIC_ANIME)
-	{
-		LerpTransform(&transform, m_nodeTransform[PARAMETRIC0][index], m_nodeTransform[PARAMETRIC1][index], m_parametricBlend);
-		if (m_playNo == PARAMETRIC_ANIME)
-		{
-			m_nodeTransform[MAIN][index] = transform;
-		}
-		if (m_blendNo == PARAMETRIC_ANIME)
-		{
-			m_nodeTransform[BLEND][index] = transform;
-		}
-	}
-	// uhAj
-	if (m_blendNo != ANIME_NONE)
-	{
-		LerpTransform(&transform, m_nodeTransform[MAIN][index], m_nodeTransform[BLEND][index], m_blendTime / m_blendTotalTime);
-	}
-	else
-	{
-		// CAĵ
-		transform = m_nodeTransform[MAIN][index];
-	}
-
-	// Ym[h̎psvZ
-	Node& node = m_nodes[index];
-	DirectX::XMMATRIX T = DirectX::XMMatrixTranslationFromVector(DirectX::XMLoadFloat3(&transform.translate));
-	DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&transform.quaternion));
-	DirectX::XMMATRIX S = DirectX::XMMatrixScalingFromVector(DirectX::XMLoadFloat3(&transform.scale));
-	node.mat = (S * R * T) * parent;
-
-	// qvf̎pXV
-	Children::iterator it = node.children.begin();
-	while (it != node.children.end())
-	{
-		CalcBones(*it, node.mat);
-		++it;
-	}
-}
-
-void Model::LerpTransform(Transform* pOut, const Transform& a, const Transform& b, float rate)
-{
-	DirectX::XMVECTOR vec[][2] = {
-		{ DirectX::XMLoadFloat3(&a.translate),	DirectX::XMLoadFloat3(&b.translate) },
-		{ DirectX::XMLoadFloat4(&a.quaternion),	DirectX::XMLoadFloat4(&b.quaternion) },
-		{ DirectX::XMLoadFloat3(&a.scale),		DirectX::XMLoadFloat3(&b.scale) },
-	};
-	for (int i = 0; i < 3; ++i)
-	{
-		vec[i][0] = DirectX::XMVectorLerp(vec[i][0], vec[i][1], rate);
-	}
-	DirectX::XMStoreFloat3(&pOut->translate, vec[0][0]);
-	DirectX::XMStoreFloat4(&pOut->quaternion, vec[1][0]);
-	DirectX::XMStoreFloat3(&pOut->scale, vec[2][0]);
-}
-
-bool Model::GetAnimatedTransform(DirectX::XMFLOAT3& outPos, DirectX::XMFLOAT3& outRot, DirectX::XMFLOAT3& outScale)
-{
-	// 1. XLjOfi{[j`FbN
-	// {[ꍇ̓VF[_[(VS_ANIME)œ߁AłfalseԂďȂ
-	for (const auto& mesh : m_meshes)
-	{
-		if (!mesh.bones.empty()) return false;
-	}
-
-	// 2. Aj[VĐĂ邩`FbN
-	if (m_playNo == ANIME_NONE && m_blendNo == ANIME_NONE)
-	{
-		return false;
-	}
-
-	// 3. [gm[h(Index 0)̍s擾
-	// Step()֐ m_nodes[0].mat XVĂOł
-	if (m_nodes.empty()) return false;
-
-	DirectX::XMMATRIX rootMat = m_nodes[0].mat;
-
-	// 4. s𕪉 (Scale, Rotation, Translation)
-	DirectX::XMVECTOR s, r, t;
-	if (!DirectX::XMMatrixDecompose(&s, &r, &t, rootMat))
-	{
-		return false;
-	}
-
-	// 5. l̊i[
-	DirectX::XMStoreFloat3(&outScale, s);
-	DirectX::XMStoreFloat3(&outPos, t);
-
-	// 6. NH[^jI -> IC[p(x) ϊ
-	// TransformComponent́ux@vŊpxĂ̂ŕϊKvł
-	DirectX::XMFLOAT4 q;
-	DirectX::XMStoreFloat4(&q, r);
-
-	// ʓIȕϊ (Singularity΍􍞂)
-	float sqw = q.w * q.w;
-	float sqx = q.x * q.x;
-	float sqy = q.y * q.y;
-	float sqz = q.z * q.z;
-	float unit = sqx + sqy + sqz + sqw;
-	float test = q.x * q.w - q.y * q.z;
-
-	if (test > 0.4995f * unit) { // k (ٓ_)
-		outRot.y = 2.0f * atan2f(q.y, q.x);
-		outRot.x = DirectX::XM_PIDIV2;
-		outRot.z = 0;
-	}
-	else if (test < -0.4995f * unit) { //  (ٓ_)
-		outRot.y = -2.0f * atan2f(q.y, q.x);
-		outRot.x = -DirectX::XM_PIDIV2;
-		outRot.z = 0;
-	}
-	else {
-		outRot.y = atan2f(2.0f * q.w * q.y + 2.0f * q.z * q.x, 1 - 2.0f * (sqx + sqy));
-		outRot.x = asinf(2.0f * (q.w * q.x - q.y * q.z));
-		outRot.z = atan2f(2.0f * q.w * q.z + 2.0f * q.x * q.y, 1 - 2.0f * (sqz + sqx));
-	}
-
-	// WA -> x֕ϊ
-	outRot.x = DirectX::XMConvertToDegrees(outRot.x);
-	outRot.y = DirectX::XMConvertToDegrees(outRot.y);
-	outRot.z = DirectX::XMConvertToDegrees(outRot.z);
-
-	return true;
-}
+#endif
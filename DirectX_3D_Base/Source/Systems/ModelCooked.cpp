@@ -0,0 +1,600 @@
+﻿/*****************************************************************//**
+ * @file	ModelCooked.cpp
+ * @brief	変換済みモデル・アニメーション (.mdl / .anm) の読み書き
+ *
+ * @details	ファイル全体をメモリへマップし、各セクションの配列からモデルの共有データを
+ *			まとめてコピーする。assimp によるシーンの構築・ノード名の検索・キーの圧縮を
+ *			実行時に行わないため、FBX からの読み込みより大幅に速い。
+ *			書き出しは Tools/ModelCooker から行う。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：変換済みバイナリの読み込み・書き出しを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include <sys/stat.h>
+#include "Systems/Model.h"
+#include "Systems/MappedFile.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace ModelCooked;
+
+namespace
+{
+	static_assert(sizeof(VertexRecord) == sizeof(Model::Vertex), "VertexRecord must match Model::Vertex");
+
+	/// @brief セクションの先頭を返す (ファイル範囲外・境界が揃っていなければnullptr)
+	template<class T>
+	const T* GetSection(const FileView& data, const Section& section)
+	{
+		const std::uint64_t end = static_cast<std::uint64_t>(section.offset) + static_cast<std::uint64_t>(section.count) * sizeof(T);
+		if (end > data.size || reinterpret_cast<std::uintptr_t>(data.pData + section.offset) % alignof(T) != 0) return nullptr;
+		return reinterpret_cast<const T*>(data.pData + section.offset);
+	}
+
+	/**
+	 * @class	BlobWriter
+	 * @brief	ヘッダーに続けてセクションを4バイト境界で並べたファイルを組み立てる
+	 */
+	class BlobWriter
+	{
+	public:
+		explicit BlobWriter(size_t headerSize) : m_data(headerSize, 0) {}
+
+		template<class T>
+		Section Append(const T* pItems, size_t count)
+		{
+			m_data.resize((m_data.size() + 3) & ~static_cast<size_t>(3), 0);
+			Section section = { static_cast<std::uint32_t>(m_data.size()), static_cast<std::uint32_t>(count) };
+			const std::uint8_t* p = reinterpret_cast<const std::uint8_t*>(pItems);
+			m_data.insert(m_data.end(), p, p + count * sizeof(T));
+			return section;
+		}
+		template<class T>
+		Section Append(const std::vector<T>& items) { return Append(items.data(), items.size()); }
+
+		/// @brief 文字列を登録し、STRINGS 上の位置を返す
+		std::uint32_t AddString(const std::string& str)
+		{
+			const std::uint32_t offset = static_cast<std::uint32_t>(m_strings.size());
+			m_strings.insert(m_strings.end(), str.begin(), str.end());
+			m_strings.push_back('\0');
+			return offset;
+		}
+		const std::vector<char>& GetStrings() const { return m_strings; }
+
+		/// @brief ヘッダーを先頭に書き込んでファイルへ出力する
+		bool Save(const char* file, const void* pHeader, size_t headerSize)
+		{
+			memcpy(m_data.data(), pHeader, headerSize);
+			FILE* fp = fopen(file, "wb");
+			if (!fp) return false;
+			const bool isWritten = fwrite(m_data.data(), 1, m_data.size(), fp) == m_data.size();
+			return (fclose(fp) == 0) && isWritten;
+		}
+
+	private:
+		std::vector<std::uint8_t> m_data;
+		std::vector<char> m_strings;
+	};
+
+	void StoreMatrix(const DirectX::XMMATRIX& m, float* pOut)
+	{
+		DirectX::XMFLOAT4X4 f;
+		DirectX::XMStoreFloat4x4(&f, m);
+		memcpy(pOut, &f, sizeof(float) * 16);
+	}
+
+	DirectX::XMMATRIX LoadMatrix(const float* p)
+	{
+		DirectX::XMFLOAT4X4 f;
+		memcpy(&f, p, sizeof(float) * 16);
+		return DirectX::XMLoadFloat4x4(&f);
+	}
+
+	/// @brief 変換後に元ファイルが更新されていないか (元ファイルが無ければ変換済みバイナリをそのまま使う)
+	bool IsUpToDate(const SourceStamp& cooked, const char* sourceFile)
+	{
+		SourceStamp source;
+		if (!sourceFile || !GetSourceStamp(sourceFile, &source)) return true;
+		return cooked.size == source.size && cooked.time == source.time;
+	}
+
+	/// @brief 文字列セクションが終端付きで格納されているか
+	bool IsValidStrings(const char* pStrings, std::uint32_t count)
+	{
+		return count == 0 || (pStrings && pStrings[count - 1] == '\0');
+	}
+}
+
+/*
+* @brief ファイルのサイズと更新日時を取得する
+*/
+bool ModelCooked::GetSourceStamp(const char* file, SourceStamp* pOut)
+{
+#ifdef _WIN32
+	struct _stat64 st;
+	if (_stat64(file, &st) != 0) return false;
+#else
+	struct stat st;
+	if (stat(file, &st) != 0) return false;
+#endif
+	pOut->size = static_cast<std::uint64_t>(st.st_size);
+	pOut->time = static_cast<std::int64_t>(st.st_mtime);
+	return true;
+}
+
+/*
+* @brief 変換元のパスから変換後のパスを求める
+*/
+std::string ModelCooked::GetCookedPath(const std::string& file, bool isAnimation)
+{
+	const size_t slash = file.find_last_of("/\\");
+	size_t dot = file.find_last_of('.');
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) dot = file.size();
+	return file.substr(0, dot) + (isAnimation ? ".anm" : ".mdl");
+}
+
+/*
+* @brief 変換済みモデルを読み込む
+* @param[in] file 変換済みバイナリ (.mdl) へのパス
+* @param[in] sourceFile 変換元ファイルへのパス (変換後に更新されていれば読み込まない)
+* @return 読み込み結果 (失敗時は呼び出し側で Reset してから FBX を読み込むこと)
+*/
+bool Model::LoadCooked(const char* file, const char* sourceFile)
+{
+	MappedFile map(file);
+	return LoadCooked(map.GetView(), file, sourceFile);
+}
+
+/*
+* @brief メモリ上の変換済みモデルを読み込む (アセットアーカイブ内のものはコピーせずにそのまま渡す)
+* @param[in] data 変換済みバイナリの内容
+* @param[in] file ログ用のパス
+* @param[in] sourceFile 変換元ファイルへのパス (nullptr なら更新の確認をしない)
+*/
+bool Model::LoadCooked(const FileView& data, const char* file, const char* sourceFile)
+{
+	if (!data) return false;	// 変換済みバイナリなし
+
+	// ヘッダーの確認
+	if (data.size < sizeof(ModelHeader))
+	{
+		printf("[Warning] Model: '%s' is truncated, loading source instead\n", file);
+		return false;
+	}
+	const ModelHeader& header = *reinterpret_cast<const ModelHeader*>(data.pData);
+	if (header.magic != MODEL_MAGIC || header.version != VERSION)
+	{
+		printf("[Warning] Model: '%s' is not a supported cooked model (version %u), loading source instead\n", file, header.version);
+		return false;
+	}
+	if (!IsUpToDate(header.source, sourceFile))
+	{
+		printf("[Info] Model: '%s' is older than its source, loading source instead\n", file);
+		return false;
+	}
+
+	// 各セクションの取得
+	const NodeRecord*		pNodes = GetSection<NodeRecord>(data, header.sections[MODEL_NODES]);
+	const MeshRecord*		pMeshes = GetSection<MeshRecord>(data, header.sections[MODEL_MESHES]);
+	const BoneRecord*		pBones = GetSection<BoneRecord>(data, header.sections[MODEL_BONES]);
+	const PaletteRecord*	pPalettes = GetSection<PaletteRecord>(data, header.sections[MODEL_PALETTES]);
+	const BoneRecord*		pPaletteBones = GetSection<BoneRecord>(data, header.sections[MODEL_PALETTE_BONES]);
+	const MaterialRecord*	pMaterials = GetSection<MaterialRecord>(data, header.sections[MODEL_MATERIALS]);
+	const VertexRecord*		pVertices = GetSection<VertexRecord>(data, header.sections[MODEL_VERTICES]);
+	const std::uint32_t*	pIndices = GetSection<std::uint32_t>(data, header.sections[MODEL_INDICES]);
+	const LodRecord*		pLods = GetSection<LodRecord>(data, header.sections[MODEL_LODS]);
+	const char*				pStrings = GetSection<char>(data, header.sections[MODEL_STRINGS]);
+	const std::uint32_t nodeNum = header.sections[MODEL_NODES].count;
+	const std::uint32_t stringNum = header.sections[MODEL_STRINGS].count;
+	if (!pNodes || !pMeshes || !pBones || !pPalettes || !pPaletteBones || !pMaterials || !pVertices || !pIndices || !pLods ||
+		!IsValidStrings(pStrings, stringNum))
+	{
+		printf("[Warning] Model: '%s' is broken, loading source instead\n", file);
+		return false;
+	}
+	auto getString = [pStrings, stringNum](std::uint32_t offset)
+		{
+			return (offset < stringNum) ? std::string(pStrings + offset) : std::string();
+		};
+	auto isValidBone = [nodeNum](const BoneRecord& bone)
+		{
+			return bone.index == INDEX_NONE || (bone.index >= 0 && static_cast<std::uint32_t>(bone.index) < nodeNum);
+		};
+
+	// ノード (親は必ず子より前に並ぶため、子の一覧は親番号から組み立て直す)
+	m_nodes.resize(nodeNum);
+	m_nodeParents.resize(nodeNum);
+	for (std::uint32_t i = 0; i < nodeNum; ++i)
+	{
+		const NodeRecord& record = pNodes[i];
+		if (record.parent != INDEX_NONE && (record.parent < 0 || static_cast<std::uint32_t>(record.parent) >= i))
+		{
+			printf("[Warning] Model: '%s' has a broken node hierarchy, loading source instead\n", file);
+			return false;
+		}
+		Node& node = m_nodes[i];
+		node.name = getString(record.name);
+		node.parent = record.parent;
+		node.children.clear();
+		node.mat = LoadMatrix(record.mat);
+		m_nodeParents[i] = record.parent;
+		if (record.parent != INDEX_NONE) m_nodes[record.parent].children.push_back(static_cast<NodeIndex>(i));
+	}
+
+	// ボーンパレット
+	const std::uint32_t paletteBoneNum = header.sections[MODEL_PALETTE_BONES].count;
+	m_palettes.resize(header.sections[MODEL_PALETTES].count);
+	for (size_t i = 0; i < m_palettes.size(); ++i)
+	{
+		if (static_cast<std::uint64_t>(pPalettes[i].offset) + pPalettes[i].count > paletteBoneNum)
+		{
+			printf("[Warning] Model: '%s' has a broken palette, loading source instead\n", file);
+			return false;
+		}
+		m_palettes[i].offset = pPalettes[i].offset;
+		m_palettes[i].count = pPalettes[i].count;
+	}
+	m_paletteBones.resize(paletteBoneNum);
+	for (std::uint32_t i = 0; i < paletteBoneNum; ++i)
+	{
+		if (!isValidBone(pPaletteBones[i])) return false;
+		m_paletteBones[i].index = pPaletteBones[i].index;
+		m_paletteBones[i].isSkin = pPaletteBones[i].isSkin != 0;
+		m_paletteBones[i].invOffset = LoadMatrix(pPaletteBones[i].invOffset);
+	}
+
+	// メッシュ
+	const std::uint32_t materialNum = header.sections[MODEL_MATERIALS].count;
+	m_meshes.resize(header.sections[MODEL_MESHES].count);
+	for (size_t i = 0; i < m_meshes.size(); ++i)
+	{
+		const MeshRecord& record = pMeshes[i];
+		Mesh& mesh = m_meshes[i];
+		mesh.pMesh = nullptr;
+		if (static_cast<std::uint64_t>(record.vertexOffset) + record.vertexCount > header.sections[MODEL_VERTICES].count ||
+			static_cast<std::uint64_t>(record.indexOffset) + record.indexCount > header.sections[MODEL_INDICES].count ||
+			static_cast<std::uint64_t>(record.boneOffset) + record.boneCount > header.sections[MODEL_BONES].count ||
+			static_cast<std::uint64_t>(record.lodOffset) + record.lodCount > header.sections[MODEL_LODS].count ||
+			record.materialID >= materialNum || record.paletteNo >= m_palettes.size())
+		{
+			printf("[Warning] Model: '%s' has a broken mesh, loading source instead\n", file);
+			return false;
+		}
+
+		mesh.vertices.resize(record.vertexCount);
+		if (record.vertexCount > 0)
+		{
+			memcpy(mesh.vertices.data(), pVertices + record.vertexOffset, sizeof(Vertex) * record.vertexCount);
+		}
+		mesh.indices.assign(pIndices + record.indexOffset, pIndices + record.indexOffset + record.indexCount);
+		mesh.lods.resize(record.lodCount);
+		for (std::uint32_t l = 0; l < record.lodCount; ++l)
+		{
+			const LodRecord& lod = pLods[record.lodOffset + l];
+			if (static_cast<std::uint64_t>(lod.indexOffset) + lod.indexCount > header.sections[MODEL_INDICES].count)
+			{
+				printf("[Warning] Model: '%s' has a broken LOD, loading source instead\n", file);
+				return false;
+			}
+			mesh.lods[l].indices.assign(pIndices + lod.indexOffset, pIndices + lod.indexOffset + lod.indexCount);
+			mesh.lods[l].error = lod.error;
+			mesh.lods[l].indexStart = 0;
+		}
+		mesh.bones.resize(record.boneCount);
+		for (std::uint32_t b = 0; b < record.boneCount; ++b)
+		{
+			const BoneRecord& bone = pBones[record.boneOffset + b];
+			if (!isValidBone(bone)) return false;
+			mesh.bones[b].index = bone.index;
+			mesh.bones[b].isSkin = bone.isSkin != 0;
+			mesh.bones[b].invOffset = LoadMatrix(bone.invOffset);
+		}
+		mesh.materialID = record.materialID;
+		mesh.paletteNo = record.paletteNo;
+	}
+
+	// マテリアル
+	m_materials.resize(materialNum);
+	m_texturePaths.resize(materialNum);
+	for (std::uint32_t i = 0; i < materialNum; ++i)
+	{
+		const MaterialRecord& record = pMaterials[i];
+		m_materials[i].diffuse = DirectX::XMFLOAT4(record.diffuse);
+		m_materials[i].ambient = DirectX::XMFLOAT4(record.ambient);
+		m_materials[i].specular = DirectX::XMFLOAT4(record.specular);
+		m_materials[i].pTexture = nullptr;
+		m_texturePaths[i] = (record.texturePath == NO_STRING) ? std::string() : getString(record.texturePath);
+	}
+
+	return true;
+}
+
+/*
+* @brief 変換済みアニメーションを読み込む
+* @details 変換時と再サンプリングレート・許容誤差が異なる場合は読み込まない (元ファイルから圧縮し直す)
+* @param[in] file 変換済みバイナリ (.anm) へのパス
+* @param[in] sourceFile 変換元ファイルへのパス
+* @return 割り当てられたアニメーション番号 (読み込まなかった場合は ANIME_NONE)
+*/
+Model::AnimeNo Model::LoadCookedAnimation(const char* file, const char* sourceFile)
+{
+	MappedFile map(file);
+	return LoadCookedAnimation(map.GetView(), file, sourceFile);
+}
+
+/*
+* @brief メモリ上の変換済みアニメーションを読み込む
+* @param[in] data 変換済みバイナリの内容
+* @param[in] file ログ用のパス
+* @param[in] sourceFile 変換元ファイルへのパス (nullptr なら更新の確認をしない)
+*/
+Model::AnimeNo Model::LoadCookedAnimation(const FileView& data, const char* file, const char* sourceFile)
+{
+	if (!data) return ANIME_NONE;	// 変換済みバイナリなし
+
+	// ヘッダーの確認
+	if (data.size < sizeof(AnimeHeader))
+	{
+		printf("[Warning] Animation: '%s' is truncated, loading source instead\n", file);
+		return ANIME_NONE;
+	}
+	const AnimeHeader& header = *reinterpret_cast<const AnimeHeader*>(data.pData);
+	if (header.magic != ANIME_MAGIC || header.version != VERSION)
+	{
+		printf("[Warning] Animation: '%s' is not a supported cooked animation (version %u), loading source instead\n", file, header.version);
+		return ANIME_NONE;
+	}
+	if (!IsUpToDate(header.source, sourceFile))
+	{
+		printf("[Info] Animation: '%s' is older than its source, loading source instead\n", file);
+		return ANIME_NONE;
+	}
+	if (header.sampleRate != m_animeSampleRate ||
+		header.tolerance[0] != m_animeTolerance[0] ||
+		header.tolerance[1] != m_animeTolerance[1] ||
+		header.tolerance[2] != m_animeTolerance[2])
+	{
+		printf("[Info] Animation: '%s' was cooked with different compression settings, loading source instead\n", file);
+		return ANIME_NONE;
+	}
+
+	// 各セクションの取得
+	const ChannelRecord*	pChannels = GetSection<ChannelRecord>(data, header.sections[ANIME_CHANNELS]);
+	const TrackRecord*		pTracks = GetSection<TrackRecord>(data, header.sections[ANIME_TRACKS]);
+	const std::uint16_t*	pFrames = GetSection<std::uint16_t>(data, header.sections[ANIME_FRAMES]);
+	const PackedKey*		pKeys = GetSection<PackedKey>(data, header.sections[ANIME_KEYS]);
+	const char*				pStrings = GetSection<char>(data, header.sections[ANIME_STRINGS]);
+	const std::uint32_t channelNum = header.sections[ANIME_CHANNELS].count;
+	const std::uint32_t stringNum = header.sections[ANIME_STRINGS].count;
+	if (!pChannels || !pTracks || !pFrames || !pKeys || !IsValidStrings(pStrings, stringNum) ||
+		header.sections[ANIME_TRACKS].count != channelNum * 3)
+	{
+		printf("[Warning] Animation: '%s' is broken, loading source instead\n", file);
+		return ANIME_NONE;
+	}
+	for (std::uint32_t i = 0; i < channelNum * 3; ++i)
+	{
+		const TrackRecord& track = pTracks[i];
+		if (static_cast<std::uint64_t>(track.frameOffset) + track.frameCount > header.sections[ANIME_FRAMES].count ||
+			static_cast<std::uint64_t>(track.keyOffset) + track.keyCount > header.sections[ANIME_KEYS].count ||
+			(track.frameCount != 0 && track.frameCount != track.keyCount))
+		{
+			printf("[Warning] Animation: '%s' has a broken track, loading source instead\n", file);
+			return ANIME_NONE;
+		}
+	}
+
+	std::shared_ptr<Animation> pClip = std::make_shared<Animation>();
+	Animation& anime = *pClip;
+	anime.totalTime = header.totalTime;
+	anime.sampleRate = header.sampleRate;
+	anime.rawBytes = header.rawBytes;
+	anime.packedBytes = header.packedBytes;
+	for (int i = 0; i < 3; ++i) anime.maxError[i] = header.maxError[i];
+	anime.channels.resize(channelNum);
+	anime.channelNames.resize(channelNum);
+	for (std::uint32_t i = 0; i < channelNum; ++i)
+	{
+		Channel& channel = anime.channels[i];
+		const std::uint32_t nameOffset = pChannels[i].name;
+		anime.channelNames[i] = (nameOffset < stringNum) ? std::string(pStrings + nameOffset) : std::string();
+		channel.sharedTiming = pChannels[i].sharedTiming != 0;
+
+		KeyTrack* tracks[3] = { &channel.translate, &channel.rotation, &channel.scale };
+		for (int t = 0; t < 3; ++t)
+		{
+			const TrackRecord& record = pTracks[i * 3 + t];
+			KeyTrack& track = *tracks[t];
+			track.startTime = record.startTime;
+			track.keyRate = record.keyRate;
+			track.rangeMin = DirectX::XMFLOAT3(record.rangeMin);
+			track.rangeExtent = DirectX::XMFLOAT3(record.rangeExtent);
+			track.frames.assign(pFrames + record.frameOffset, pFrames + record.frameOffset + record.frameCount);
+			track.values.assign(pKeys + record.keyOffset, pKeys + record.keyOffset + record.keyCount);
+		}
+	}
+
+	// チャンネルはノード名で関連付ける
+	return BindAnimation(pClip);
+}
+
+/*
+* @brief 変換済みモデルを書き出す
+* @details Import 直後 (スケール 1・反転なし、GPU リソースなし) の状態を保存する
+* @param[in] file 出力先
+* @param[in] source 変換元ファイルのサイズと更新日時
+* @return 書き出し結果
+*/
+bool Model::SaveCooked(const char* file, const SourceStamp& source) const
+{
+	BlobWriter writer(sizeof(ModelHeader));
+	ModelHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = MODEL_MAGIC;
+	header.version = VERSION;
+	header.source = source;
+
+	auto toRecord = [](const Bone& bone)
+		{
+			BoneRecord record;
+			record.index = bone.index;
+			record.isSkin = bone.isSkin ? 1u : 0u;
+			StoreMatrix(bone.invOffset, record.invOffset);
+			return record;
+		};
+
+	// ノード
+	std::vector<NodeRecord> nodes(m_nodes.size());
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		nodes[i].name = writer.AddString(m_nodes[i].name);
+		nodes[i].parent = m_nodes[i].parent;
+		StoreMatrix(m_nodes[i].mat, nodes[i].mat);
+	}
+
+	// メッシュ (頂点・インデックス・ボーンは全メッシュ分を連続で保持する)
+	std::vector<MeshRecord> meshes(m_meshes.size());
+	std::vector<BoneRecord> bones;
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	std::vector<LodRecord> lods;
+	for (size_t i = 0; i < m_meshes.size(); ++i)
+	{
+		const Mesh& mesh = m_meshes[i];
+		MeshRecord& record = meshes[i];
+		record.vertexOffset = static_cast<std::uint32_t>(vertices.size());
+		record.vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+		record.indexOffset = static_cast<std::uint32_t>(indices.size());
+		record.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+		record.boneOffset = static_cast<std::uint32_t>(bones.size());
+		record.boneCount = static_cast<std::uint32_t>(mesh.bones.size());
+		record.materialID = mesh.materialID;
+		record.paletteNo = mesh.paletteNo;
+		record.lodOffset = static_cast<std::uint32_t>(lods.size());
+		record.lodCount = static_cast<std::uint32_t>(mesh.lods.size());
+		vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+		indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+		for (const MeshLod& lod : mesh.lods)
+		{
+			LodRecord lodRecord;
+			lodRecord.indexOffset = static_cast<std::uint32_t>(indices.size());
+			lodRecord.indexCount = static_cast<std::uint32_t>(lod.indices.size());
+			lodRecord.error = lod.error;
+			lods.push_back(lodRecord);
+			indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+		}
+		for (const Bone& bone : mesh.bones) bones.push_back(toRecord(bone));
+	}
+
+	// ボーンパレット
+	std::vector<PaletteRecord> palettes(m_palettes.size());
+	for (size_t i = 0; i < m_palettes.size(); ++i)
+	{
+		palettes[i].offset = m_palettes[i].offset;
+		palettes[i].count = m_palettes[i].count;
+	}
+	std::vector<BoneRecord> paletteBones;
+	for (const Bone& bone : m_paletteBones) paletteBones.push_back(toRecord(bone));
+
+	// マテリアル
+	std::vector<MaterialRecord> materials(m_materials.size());
+	for (size_t i = 0; i < m_materials.size(); ++i)
+	{
+		const Material& material = m_materials[i];
+		MaterialRecord& record = materials[i];
+		memcpy(record.diffuse, &material.diffuse, sizeof(record.diffuse));
+		memcpy(record.ambient, &material.ambient, sizeof(record.ambient));
+		memcpy(record.specular, &material.specular, sizeof(record.specular));
+		const bool hasTexture = i < m_texturePaths.size() && !m_texturePaths[i].empty();
+		record.texturePath = hasTexture ? writer.AddString(m_texturePaths[i]) : NO_STRING;
+	}
+
+	header.sections[MODEL_NODES] = writer.Append(nodes);
+	header.sections[MODEL_MESHES] = writer.Append(meshes);
+	header.sections[MODEL_BONES] = writer.Append(bones);
+	header.sections[MODEL_PALETTES] = writer.Append(palettes);
+	header.sections[MODEL_PALETTE_BONES] = writer.Append(paletteBones);
+	header.sections[MODEL_MATERIALS] = writer.Append(materials);
+	header.sections[MODEL_VERTICES] = writer.Append(vertices);
+	header.sections[MODEL_INDICES] = writer.Append(indices);
+	header.sections[MODEL_LODS] = writer.Append(lods);
+	header.sections[MODEL_STRINGS] = writer.Append(writer.GetStrings());
+	return writer.Save(file, &header, sizeof(header));
+}
+
+/*
+* @brief 変換済みアニメーションを書き出す
+* @details 現在の再サンプリングレート・許容誤差をヘッダーに記録する
+* @param[in] file 出力先
+* @param[in] no 書き出すアニメーション番号
+* @param[in] source 変換元ファイルのサイズと更新日時
+* @return 書き出し結果
+*/
+bool Model::SaveCookedAnimation(const char* file, AnimeNo no, const SourceStamp& source) const
+{
+	if (no < 0 || no >= static_cast<AnimeNo>(m_animes.size())) return false;
+	const Animation& anime = *m_animes[no].pClip;
+
+	BlobWriter writer(sizeof(AnimeHeader));
+	AnimeHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = ANIME_MAGIC;
+	header.version = VERSION;
+	header.source = source;
+	header.totalTime = anime.totalTime;
+	header.sampleRate = anime.sampleRate;
+	for (int i = 0; i < 3; ++i)
+	{
+		header.tolerance[i] = m_animeTolerance[i];
+		header.maxError[i] = anime.maxError[i];
+	}
+	header.rawBytes = static_cast<std::uint32_t>(anime.rawBytes);
+	header.packedBytes = static_cast<std::uint32_t>(anime.packedBytes);
+
+	std::vector<ChannelRecord> channels(anime.channels.size());
+	std::vector<TrackRecord> tracks;
+	std::vector<std::uint16_t> frames;
+	std::vector<PackedKey> keys;
+	for (size_t i = 0; i < anime.channels.size(); ++i)
+	{
+		const Channel& channel = anime.channels[i];
+		channels[i].name = writer.AddString(i < anime.channelNames.size() ? anime.channelNames[i] : std::string());
+		channels[i].sharedTiming = channel.sharedTiming ? 1u : 0u;
+
+		const KeyTrack* src[3] = { &channel.translate, &channel.rotation, &channel.scale };
+		for (int t = 0; t < 3; ++t)
+		{
+			TrackRecord record;
+			record.startTime = src[t]->startTime;
+			record.keyRate = src[t]->keyRate;
+			memcpy(record.rangeMin, &src[t]->rangeMin, sizeof(record.rangeMin));
+			memcpy(record.rangeExtent, &src[t]->rangeExtent, sizeof(record.rangeExtent));
+			record.frameOffset = static_cast<std::uint32_t>(frames.size());
+			record.frameCount = static_cast<std::uint32_t>(src[t]->frames.size());
+			record.keyOffset = static_cast<std::uint32_t>(keys.size());
+			record.keyCount = static_cast<std::uint32_t>(src[t]->values.size());
+			frames.insert(frames.end(), src[t]->frames.begin(), src[t]->frames.end());
+			keys.insert(keys.end(), src[t]->values.begin(), src[t]->values.end());
+			tracks.push_back(record);
+		}
+	}
+
+	header.sections[ANIME_CHANNELS] = writer.Append(channels);
+	header.sections[ANIME_TRACKS] = writer.Append(tracks);
+	header.sections[ANIME_FRAMES] = writer.Append(frames);
+	header.sections[ANIME_KEYS] = writer.Append(keys);
+	header.sections[ANIME_STRINGS] = writer.Append(writer.GetStrings());
+	return writer.Save(file, &header, sizeof(header));
+}
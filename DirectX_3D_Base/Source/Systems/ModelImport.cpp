@@ -0,0 +1,978 @@
+﻿/*****************************************************************//**
+ * @file	ModelImport.cpp
+ * @brief	assimp によるモデル・アニメーションの読み込み
+ *
+ * @details	FBX などを assimp で読み込み、Model の共有データ (ノード・メッシュ・ボーン・
+ *			マテリアル・圧縮済みクリップ) を作成する。GPU リソースは作成しないため、
+ *			変換ツール (Tools/ModelCooker) からも同じ処理を使用する。
+ *			スケール・反転は ApplyLoadTransform でまとめて適用する
+ *			(変換済みバイナリはスケール 1・反転なしの状態で保存する)。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：Model.cpp から assimp による読み込み処理を分離。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/Model.h"
+#include "Systems/MeshOptimizer.h"
+#include "Systems/MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#ifndef MODEL_COOKER
+#if _MSC_VER >= 1930
+#ifdef _DEBUG
+#pragma comment(lib, "assimp-vc143-mtd.lib")
+#else
+#pragma comment(lib, "assimp-vc143-mt.lib")
+#endif
+#elif _MSC_VER >= 1920
+#ifdef _DEBUG
+#pragma comment(lib, "assimp-vc142-mtd.lib")
+#else
+#pragma comment(lib, "assimp-vc142-mt.lib")
+#endif
+#elif _MSC_VER >= 1910
+#ifdef _DEBUG
+#pragma comment(lib, "assimp-vc141-mtd.lib")
+#else
+#pragma comment(lib, "assimp-vc141-mt.lib")
+#endif
+#endif
+#endif
+
+float			Model::m_animeSampleRate = 0.0f;
+float			Model::m_animeTolerance[3] = { 1.0e-3f, 1.0e-3f, 1.0e-4f };
+
+/*
+* @brief assimpの行列をXMMATRIX型に変換
+* @param[in] M assimpの行列
+* @return 変換後の行列
+*/
+DirectX::XMMATRIX GetMatrixFromAssimpMatrix(aiMatrix4x4 M)
+{
+	return DirectX::XMMatrixSet(
+		M.a1, M.b1, M.c1, M.d1,
+		M.a2, M.b2, M.c2, M.d2,
+		M.a3, M.b3, M.c3, M.d3,
+		M.a4, M.b4, M.c4, M.d4
+	);
+}
+
+/*
+* @brief assimpでシーンを読み込む (アーカイブ内のファイルは拡張子を形式のヒントとしてメモリから読み込む)
+*/
+static const aiScene* ReadScene(Assimp::Importer& importer, const char* file, const FileView& packed, int flag)
+{
+	if (!packed) return importer.ReadFile(file, flag);
+
+	const char* pExt = strrchr(file, '.');
+	return importer.ReadFileFromMemory(packed.pData, packed.size, flag, pExt ? pExt + 1 : "");
+}
+
+/*
+* @brief assimpでモデルを読み込む
+* @details スケール・反転の適用と GPU リソースの作成は行わない (Load から呼び出す場合は続けて行う)
+* @param[in] file 読み込むファイルへのパス
+* @param[in] packed アセットアーカイブ内のファイルの内容 (空ならファイルから読み込む)
+* @return 読み込み結果
+*/
+bool Model::Import(const char* file, const FileView& packed)
+{
+	// assimpの設定
+	Assimp::Importer importer;
+	int flag = 0;
+	flag |= aiProcess_Triangulate;
+	flag |= aiProcess_FlipUVs;
+	//flag |= aiProcess_MakeLeftHanded;
+
+	// assimpで読み込み
+	const aiScene* pScene = ReadScene(importer, file, packed, flag);
+	if (!pScene) {
+#ifdef _DEBUG
+		m_errorStr = importer.GetErrorString();
+#endif
+		return false;
+	}
+
+	// ノードの作成
+	MakeBoneNodes(pScene);
+	// メッシュの作成
+	MakeMesh(pScene);
+	// マテリアルの作成
+	MakeMaterial(pScene);
+	// 頂点の結合・並び替えと LOD の作成
+	OptimizeMeshes(file);
+	GenerateLods(file);
+
+	return true;
+}
+
+/*
+* @brief 同じ内容の頂点を結合し、三角形・頂点を GPU で処理しやすい順に並び替える
+* @details assimp は面の角ごとに頂点を作るため、結合で頂点数が大きく減る。
+*          変換済みバイナリには並び替え後の状態を保存するため、FBX から読み込んだときだけ行う。
+*          並び替え前後の頂点キャッシュの統計 (ACMR / ATVR) をログに出力する。
+* @param[in] file ログに表示するファイル名
+*/
+void Model::OptimizeMeshes(const char* file)
+{
+	// 頂点はバイト単位で比較するため、詰め物が入らないこと
+	static_assert(sizeof(Vertex) == sizeof(float) * 16 + sizeof(unsigned int) * 4, "Vertex must not contain padding");
+	const float OVERDRAW_THRESHOLD = 1.05f;	// オーバードローの並び替えで許容する頂点キャッシュ効率の悪化
+
+	size_t vertexBefore = 0;
+	size_t vertexAfter = 0;
+	size_t triangleNum = 0;
+	size_t transformedBefore = 0;
+	size_t transformedAfter = 0;
+	std::vector<std::uint32_t> remap;
+	for (auto meshIt = m_meshes.begin(); meshIt != m_meshes.end(); ++meshIt)
+	{
+		Vertices& vertices = meshIt->vertices;
+		Indices& indices = meshIt->indices;
+		if (vertices.empty() || indices.size() < 3) continue;
+		const MeshOptimizer::VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+		vertexBefore += vertices.size();
+
+		// 同じ内容の頂点を結合
+		remap.resize(vertices.size());
+		size_t count = MeshOptimizer::GenerateVertexRemap(remap.data(), indices.data(), indices.size(), vertices.data(), vertices.size(), sizeof(Vertex));
+		MeshOptimizer::RemapIndices(indices.data(), indices.size(), remap.data());
+		MeshOptimizer::RemapVertices(&vertices, remap.data(), count);
+
+		// 三角形の並び替え (頂点キャッシュ → オーバードロー)
+		MeshOptimizer::OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+		MeshOptimizer::OptimizeOverdraw(indices.data(), indices.size(), &vertices[0].pos.x, vertices.size(), sizeof(Vertex), OVERDRAW_THRESHOLD);
+
+		// 頂点を参照される順に並び替え
+		remap.resize(vertices.size());
+		count = MeshOptimizer::GenerateFetchRemap(remap.data(), indices.data(), indices.size(), vertices.size());
+		MeshOptimizer::RemapIndices(indices.data(), indices.size(), remap.data());
+		MeshOptimizer::RemapVertices(&vertices, remap.data(), count);
+
+		const MeshOptimizer::VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+		vertexAfter += vertices.size();
+		triangleNum += indices.size() / 3;
+		transformedBefore += before.transformed;
+		transformedAfter += after.transformed;
+	}
+	if (triangleNum == 0) return;
+
+	printf("[Info] Model '%s': optimized %zu tris, vertex %zu -> %zu, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (FIFO %u)\n",
+		file, triangleNum, vertexBefore, vertexAfter,
+		static_cast<float>(transformedBefore) / triangleNum, static_cast<float>(transformedAfter) / triangleNum,
+		static_cast<float>(transformedBefore) / vertexBefore, static_cast<float>(transformedAfter) / vertexAfter,
+		MeshOptimizer::STATS_CACHE_SIZE);
+}
+
+/*
+* @brief 各メッシュを簡略化した LOD を作成する
+* @details 1つ前の LOD から順に簡略化し、三角形が十分に減らなくなった段で打ち切る。
+*          頂点は LOD0 と共有するため、インデックスだけを頂点キャッシュ向けに並べ替えて保持する。
+*          ボーンを持つメッシュはスキンウェイトの差も誤差に含める。
+* @param[in] file ログに表示するファイル名
+*/
+void Model::GenerateLods(const char* file)
+{
+	// 段毎の目標 (LOD0 に対する三角形の比率と、メッシュの大きさに対する許容誤差)
+	static_assert(MAX_LOD == 3, "LOD_RATIO / LOD_ERROR とログの段数を合わせること");
+	const float LOD_RATIO[MAX_LOD] = { 0.5f, 0.25f, 0.125f };
+	const float LOD_ERROR[MAX_LOD] = { 0.01f, 0.02f, 0.04f };
+	const float MIN_REDUCTION = 0.8f;	// 1つ前の段からこの比率以下に減らなければ打ち切る
+
+	size_t triangleNum[MAX_LOD + 1] = {};
+	float maxError[MAX_LOD + 1] = {};
+	for (auto meshIt = m_meshes.begin(); meshIt != m_meshes.end(); ++meshIt)
+	{
+		Mesh& mesh = *meshIt;
+		mesh.lods.clear();
+		mesh.lods.reserve(MAX_LOD);
+		if (!mesh.vertices.empty() && mesh.indices.size() >= 3)
+		{
+			MeshSimplifier::VertexData data;
+			data.pPositions = &mesh.vertices[0].pos.x;
+			data.pWeights = mesh.bones.empty() ? nullptr : mesh.vertices[0].weight;
+			data.pBoneIndices = mesh.vertices[0].index;
+			data.stride = sizeof(Vertex);
+			data.vertexCount = mesh.vertices.size();
+
+			const Indices* pSource = &mesh.indices;
+			for (int level = 0; level < MAX_LOD; ++level)
+			{
+				MeshLod lod;
+				lod.indices.resize(pSource->size());
+				const size_t target = static_cast<size_t>(mesh.indices.size() / 3 * LOD_RATIO[level]) * 3;
+				const MeshSimplifier::Result result = MeshSimplifier::Simplify(
+					lod.indices.data(), pSource->data(), pSource->size(), data, target, LOD_ERROR[level]);
+				if (result.indexCount > pSource->size() * MIN_REDUCTION) break;
+
+				lod.indices.resize(result.indexCount);
+				MeshOptimizer::OptimizeVertexCache(lod.indices.data(), lod.indices.size(), mesh.vertices.size());
+				lod.error = result.error * result.extent;
+				lod.indexStart = 0;
+				mesh.lods.push_back(std::move(lod));
+				pSource = &mesh.lods.back().indices;
+			}
+		}
+
+		// LOD を持たない段は、そのメッシュの最も粗い LOD を描く
+		triangleNum[0] += mesh.indices.size() / 3;
+		for (int level = 1; level <= MAX_LOD; ++level)
+		{
+			const size_t lodNo = std::min(static_cast<size_t>(level), mesh.lods.size());
+			triangleNum[level] += (lodNo > 0 ? mesh.lods[lodNo - 1].indices.size() : mesh.indices.size()) / 3;
+			if (lodNo > 0) maxError[level] = std::max(maxError[level], mesh.lods[lodNo - 1].error);
+		}
+	}
+	if (triangleNum[1] == triangleNum[0]) return;	// どのメッシュも簡略化できなかった
+
+	printf("[Info] Model '%s': LOD tris %zu / %zu / %zu / %zu, max error %.4f / %.4f / %.4f\n",
+		file, triangleNum[0], triangleNum[1], triangleNum[2], triangleNum[3], maxError[1], maxError[2], maxError[3]);
+}
+
+/*
+* @brief 読み込み時のスケール・反転を適用する
+* @details 頂点座標・法線・面の向きと、スキニングに使うボーンのオフセット行列を変換する。
+*          FBX・変換済みバイナリのどちらから読み込んだ場合も、m_loadScale / m_loadFlip を設定してから一度だけ呼び出す。
+*/
+void Model::ApplyLoadTransform()
+{
+	const float scale = m_loadScale;
+	const Flip flip = m_loadFlip;
+
+	for (auto meshIt = m_meshes.begin(); meshIt != m_meshes.end(); ++meshIt)
+	{
+		// 座標・法線
+		for (auto vtxIt = meshIt->vertices.begin(); vtxIt != meshIt->vertices.end(); ++vtxIt)
+		{
+			vtxIt->pos = DirectX::XMFLOAT3(vtxIt->pos.x * scale, vtxIt->pos.y * scale, vtxIt->pos.z * scale);
+
+			// 反転処理
+			if (flip == XFlip)
+			{
+				vtxIt->pos.x *= -1.0f;
+				vtxIt->normal.x *= -1.0f;
+			}
+			else if (flip == ZFlip || flip == ZFlipUseAnime)
+			{
+				vtxIt->pos.z *= -1.0f;
+				vtxIt->normal.z *= -1.0f;
+			}
+		}
+
+		// 反転すると面の向きが逆になるため、頂点の並びを入れ替える
+		auto swapWinding = [](Indices& indices)
+			{
+				for (size_t i = 0; i + 2 < indices.size(); i += 3)
+				{
+					std::swap(indices[i + 1], indices[i + 2]);
+				}
+			};
+		if (flip != None)
+		{
+			swapWinding(meshIt->indices);
+		}
+		for (auto lodIt = meshIt->lods.begin(); lodIt != meshIt->lods.end(); ++lodIt)
+		{
+			if (flip != None) swapWinding(lodIt->indices);
+			lodIt->error *= scale;
+		}
+	}
+
+	// スキニングするボーンのオフセット行列
+	// (ノードに直接付いたメッシュのボーンはノード行列の逆行列のため変換しない)
+	const DirectX::XMMATRIX flipMat = DirectX::XMMatrixScaling(flip == ZFlipUseAnime ? -1.0f : 1.0f, 1.0f, 1.0f);
+	const DirectX::XMMATRIX invScaleMat = DirectX::XMMatrixScaling(1.f / scale, 1.f / scale, 1.f / scale);
+	const DirectX::XMVECTOR translateScale = DirectX::XMVectorSet(scale, scale, scale, 1.0f);
+	auto transformBone = [&](Bone& bone)
+		{
+			if (!bone.isSkin || bone.index == INDEX_NONE) { return; }
+			bone.invOffset.r[3] = DirectX::XMVectorMultiply(bone.invOffset.r[3], translateScale);
+			bone.invOffset = flipMat * bone.invOffset * invScaleMat;
+		};
+	for (auto meshIt = m_meshes.begin(); meshIt != m_meshes.end(); ++meshIt)
+	{
+		std::for_each(meshIt->bones.begin(), meshIt->bones.end(), transformBone);
+	}
+	std::for_each(m_paletteBones.begin(), m_paletteBones.end(), transformBone);
+}
+
+/*
+* @brief assimpでアニメーションを読み込む
+* @details 全チャンネルを圧縮して保持し、同名のノードがあれば関連付ける
+*          (変換ツールではノードが無いため全て INDEX_NONE になるが、保存するのはクリップ本体のみ)
+* @param[in] file 読み込むアニメーションファイルへのパス
+* @param[in] packed アセットアーカイブ内のファイルの内容 (空ならファイルから読み込む)
+* @return 割り当てられたアニメーション番号 (失敗時は ANIME_NONE)
+*/
+Model::AnimeNo Model::ImportAnimation(const char* file, const FileView& packed)
+{
+	// assimpの設定
+	Assimp::Importer importer;
+	int flag = 0;
+	flag |= aiProcess_Triangulate;
+	flag |= aiProcess_FlipUVs;
+	if (m_loadFlip == Flip::XFlip)  flag |= aiProcess_MakeLeftHanded;
+
+	// assimpで読み込み
+	const aiScene* pScene = ReadScene(importer, file, packed, flag);
+	if (!pScene)
+	{
+#ifdef _DEBUG
+		m_errorStr += importer.GetErrorString();
+#endif
+		return ANIME_NONE;
+	}
+
+	// アニメーションチェック
+	if (!pScene->HasAnimations())
+	{
+#ifdef _DEBUG
+		m_errorStr += "no animation.";
+#endif
+		return ANIME_NONE;
+	}
+
+	// アニメーションデータ確保
+	aiAnimation* assimpAnime = pScene->mAnimations[0];
+	std::shared_ptr<Animation> pClip = std::make_shared<Animation>();
+	Animation& anime = *pClip;
+
+	// アニメーション設定
+	float animeFrame = static_cast<float>(assimpAnime->mTicksPerSecond);
+	anime.totalTime = static_cast<float>(assimpAnime->mDuration) / animeFrame;
+	anime.sampleRate = m_animeSampleRate;
+	anime.rawBytes = 0;
+	anime.packedBytes = 0;
+	anime.maxError[0] = anime.maxError[1] = anime.maxError[2] = 0.0f;
+	anime.channels.resize(assimpAnime->mNumChannels);
+	anime.channelNames.resize(assimpAnime->mNumChannels);
+	Channels::iterator channelIt = anime.channels.begin();
+	while (channelIt != anime.channels.end())
+	{
+		// 対象ノード名 (ノードとの関連付けは BindAnimation で行う)
+		uint32_t channelIdx = static_cast<uint32_t>(channelIt - anime.channels.begin());
+		aiNodeAnim* assimpChannel = assimpAnime->mChannels[channelIdx];
+		anime.channelNames[channelIdx] = assimpChannel->mNodeName.data;
+
+		// 位置・回転・拡縮をそれぞれ作業用の配列に格納 (同時刻のキーは先のものを優先)
+		RawTrack raw[3];
+		for (UINT i = 0; i < assimpChannel->mNumPositionKeys; ++i)
+		{
+			aiVectorKey& key = assimpChannel->mPositionKeys[i];
+			float time = static_cast<float>(key.mTime) / animeFrame;
+			if (!raw[0].times.empty() && time <= raw[0].times.back()) continue;
+			raw[0].times.push_back(time);
+			raw[0].values.push_back(DirectX::XMFLOAT4(key.mValue.x, key.mValue.y, key.mValue.z, 0.0f));
+		}
+		for (UINT i = 0; i < assimpChannel->mNumRotationKeys; ++i)
+		{
+			aiQuatKey& key = assimpChannel->mRotationKeys[i];
+			float time = static_cast<float>(key.mTime) / animeFrame;
+			if (!raw[1].times.empty() && time <= raw[1].times.back()) continue;
+			raw[1].times.push_back(time);
+			raw[1].values.push_back(DirectX::XMFLOAT4(key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w));
+		}
+		for (UINT i = 0; i < assimpChannel->mNumScalingKeys; ++i)
+		{
+			aiVectorKey& key = assimpChannel->mScalingKeys[i];
+			float time = static_cast<float>(key.mTime) / animeFrame;
+			if (!raw[2].times.empty() && time <= raw[2].times.back()) continue;
+			raw[2].times.push_back(time);
+			raw[2].values.push_back(DirectX::XMFLOAT4(key.mValue.x, key.mValue.y, key.mValue.z, 0.0f));
+		}
+
+		// 圧縮して格納し、誤差を記録
+		KeyTrack* tracks[3] = { &channelIt->translate, &channelIt->rotation, &channelIt->scale };
+		for (int i = 0; i < 3; ++i)
+		{
+			CompressTrack(raw[i], i == 1, m_animeTolerance[i], tracks[i]);
+			anime.maxError[i] = std::max(anime.maxError[i], MeasureError(raw[i], *tracks[i], i == 1));
+			anime.rawBytes += raw[i].times.size() * (sizeof(float) + (i == 1 ? sizeof(DirectX::XMFLOAT4) : sizeof(DirectX::XMFLOAT3)));
+			anime.packedBytes += sizeof(KeyTrack) + tracks[i]->frames.size() * sizeof(std::uint16_t) + tracks[i]->values.size() * sizeof(PackedKey);
+		}
+		channelIt->sharedTiming =
+			IsSameTiming(channelIt->translate, channelIt->rotation) &&
+			IsSameTiming(channelIt->translate, channelIt->scale) &&
+			IsSameTiming(channelIt->rotation, channelIt->scale);
+
+		++channelIt;
+	}
+
+	return BindAnimation(pClip);
+}
+
+/*
+* @brief 読み込み済みのクリップをこのモデルのノードへ関連付ける
+* @details ノード名の対応表はモデル毎に一度だけ作るため、関連付けはチャンネル数に比例する処理だけで済む。
+*          クリップ本体は複製せず共有する。
+* @param[in] pClip 関連付けるクリップ
+* @return 割り当てられたアニメーション番号 (失敗時は ANIME_NONE)
+*/
+Model::AnimeNo Model::BindAnimation(const AnimationPtr& pClip)
+{
+	if (!pClip) return ANIME_NONE;
+	BuildNodeNameMap();
+
+	AnimeBinding binding;
+	binding.pClip = pClip;
+	binding.channelNodes.resize(pClip->channels.size());
+	for (size_t i = 0; i < binding.channelNodes.size(); ++i)
+	{
+		binding.channelNodes[i] = (i < pClip->channelNames.size()) ? FindNodeByName(pClip->channelNames[i]) : INDEX_NONE;
+	}
+	m_animes.push_back(std::move(binding));
+	return static_cast<AnimeNo>(m_animes.size() - 1);
+}
+
+/*
+* @brief ノード名から番号への対応表を作る
+* @details 別のスケルトン用に作ったクリップも関連付けられるよう、"mixamorig:Hips" の ':' より前の接頭辞を除いた
+*          名前も登録する (除いた名前が重複するノードは曖昧なため INDEX_NONE とする)
+*/
+void Model::BuildNodeNameMap()
+{
+	if (!m_nodeNameMap.empty() || m_nodes.empty()) return;
+
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		m_nodeNameMap.insert(std::make_pair(m_nodes[i].name, static_cast<NodeIndex>(i)));
+	}
+	std::unordered_map<std::string, NodeIndex> shortNames;
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		const std::string& name = m_nodes[i].name;
+		const size_t colon = name.rfind(':');
+		auto result = shortNames.insert(std::make_pair(colon == std::string::npos ? name : name.substr(colon + 1), static_cast<NodeIndex>(i)));
+		if (!result.second) result.first->second = INDEX_NONE;
+	}
+	// 完全な名前を優先し、接頭辞を除いた名前は ':' 付きのキーで区別して登録する
+	for (auto it = shortNames.begin(); it != shortNames.end(); ++it)
+	{
+		m_nodeNameMap.insert(std::make_pair(":" + it->first, it->second));
+	}
+}
+
+/*
+* @brief ノード名から番号を検索する
+* @param[in] name チャンネルの対象ノード名
+* @return ノード番号 (該当なしは INDEX_NONE)
+*/
+Model::NodeIndex Model::FindNodeByName(const std::string& name) const
+{
+	auto it = m_nodeNameMap.find(name);
+	if (it != m_nodeNameMap.end()) return it->second;
+
+	// 接頭辞の異なるスケルトン ("mixamorig1:Hips" と "mixamorig:Hips" など)
+	const size_t colon = name.rfind(':');
+	it = m_nodeNameMap.find(colon == std::string::npos ? ":" + name : name.substr(colon));
+	return (it != m_nodeNameMap.end()) ? it->second : INDEX_NONE;
+}
+
+/*
+* @brief 2つの回転の差の角度 (ラジアン)
+* @details 小さな角度でも精度が落ちないよう、acos(内積) ではなく差の長さから求める
+*/
+float Model::QuaternionAngle(DirectX::FXMVECTOR a, DirectX::FXMVECTOR b)
+{
+	DirectX::XMVECTOR qa = DirectX::XMQuaternionNormalize(a);
+	DirectX::XMVECTOR qb = DirectX::XMQuaternionNormalize(b);
+	if (DirectX::XMVectorGetX(DirectX::XMVector4Dot(qa, qb)) < 0.0f) { qb = DirectX::XMVectorNegate(qb); }
+	float halfChord = 0.5f * DirectX::XMVectorGetX(DirectX::XMVector4Length(DirectX::XMVectorSubtract(qa, qb)));
+	return 4.0f * std::asin(std::min(1.0f, halfChord));
+}
+
+/*
+* @brief 読み込んだキー列を圧縮する
+* @details 1. キーを等間隔のフレームへ揃える (ベイク済みのクリップはそのまま、不等間隔なら最小のキー間隔で再サンプリング)
+*          2. 許容誤差内で一定なら1キーに、前後のキーからの補間で表せるキーは削除する
+*          3. 位置・拡縮は範囲を16bitに、回転は smallest-three の48bitに量子化する
+* @param[in] raw 時刻順に並んだ読み込み直後のキー列
+* @param[in] isRotation 回転のキー列か
+* @param[in] tolerance 許容誤差 (回転はラジアン)
+* @param[out] pOut 圧縮したキー列
+*/
+void Model::CompressTrack(const RawTrack& raw, bool isRotation, float tolerance, KeyTrack* pOut)
+{
+	*pOut = KeyTrack();
+	const size_t keyNum = raw.values.size();
+	if (keyNum == 0) return;
+
+	// 補間と誤差の計算 (回転は符号を揃えた正規化線形補間、角度で比較)
+	auto lerp = [isRotation](const DirectX::XMFLOAT4& a, const DirectX::XMFLOAT4& b, float rate)
+	{
+		DirectX::XMVECTOR va = DirectX::XMLoadFloat4(&a);
+		DirectX::XMVECTOR vb = DirectX::XMLoadFloat4(&b);
+		if (!isRotation) return DirectX::XMVectorLerp(va, vb, rate);
+		if (DirectX::XMVectorGetX(DirectX::XMVector4Dot(va, vb)) < 0.0f) { vb = DirectX::XMVectorNegate(vb); }
+		return DirectX::XMQuaternionNormalize(DirectX::XMVectorLerp(va, vb, rate));
+	};
+	auto distance = [isRotation](DirectX::FXMVECTOR a, DirectX::FXMVECTOR b)
+	{
+		if (!isRotation) return DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(a, b)));
+		return QuaternionAngle(a, b);
+	};
+
+	//--- 1. 等間隔のフレームへ揃える
+	std::vector<DirectX::XMFLOAT4> samples;
+	if (keyNum == 1)
+	{
+		samples = raw.values;
+	}
+	else
+	{
+		const float startTime = raw.times.front();
+		const float duration = raw.times.back() - startTime;
+		float rate = m_animeSampleRate;
+		if (rate <= 0.0f)
+		{
+			// 最小のキー間隔 (ベイク済みなら全キーの間隔) をフレームの長さとする
+			float minStep = duration;
+			for (size_t i = 1; i < keyNum; ++i)
+			{
+				minStep = std::min(minStep, raw.times[i] - raw.times[i - 1]);
+			}
+			rate = 1.0f / std::max(minStep, 1.0e-4f);
+		}
+		// フレーム番号は16bitで保持する
+		rate = std::min(rate, 65534.0f / std::max(duration, 1.0e-4f));
+
+		const size_t frameNum = static_cast<size_t>(std::ceil(duration * rate - 0.01f)) + 1;
+		samples.resize(frameNum);
+		size_t key = 0;
+		for (size_t frame = 0; frame < frameNum; ++frame)
+		{
+			float time = startTime + static_cast<float>(frame) / rate;
+			while (key + 2 < keyNum && raw.times[key + 1] <= time) { ++key; }
+			float t = (time - raw.times[key]) / (raw.times[key + 1] - raw.times[key]);
+			DirectX::XMStoreFloat4(&samples[frame], lerp(raw.values[key], raw.values[key + 1], std::min(std::max(t, 0.0f), 1.0f)));
+		}
+		pOut->startTime = startTime;
+		pOut->keyRate = rate;
+	}
+
+	// 回転は隣のキーと符号を揃えておく (削除判定の補間を最短経路にするため)
+	if (isRotation)
+	{
+		for (size_t i = 1; i < samples.size(); ++i)
+		{
+			DirectX::XMVECTOR prev = DirectX::XMLoadFloat4(&samples[i - 1]);
+			DirectX::XMVECTOR cur = DirectX::XMLoadFloat4(&samples[i]);
+			if (DirectX::XMVectorGetX(DirectX::XMVector4Dot(prev, cur)) < 0.0f)
+			{
+				DirectX::XMStoreFloat4(&samples[i], DirectX::XMVectorNegate(cur));
+			}
+		}
+	}
+
+	//--- 2. 一定値・冗長キーの削除
+	std::vector<std::uint16_t> kept;
+	bool isConstant = true;
+	for (size_t i = 1; i < samples.size() && isConstant; ++i)
+	{
+		isConstant = distance(DirectX::XMLoadFloat4(&samples[0]), DirectX::XMLoadFloat4(&samples[i])) <= tolerance;
+	}
+	if (isConstant)
+	{
+		kept.push_back(0);
+	}
+	else
+	{
+		// 始点から、途中のキーが全て補間で許容誤差内に収まる限り終点を先へ延ばす
+		size_t start = 0;
+		kept.push_back(0);
+		while (start + 1 < samples.size())
+		{
+			size_t end = start + 1;
+			while (end + 1 < samples.size())
+			{
+				const size_t next = end + 1;
+				bool isRedundant = true;
+				for (size_t i = start + 1; i < next && isRedundant; ++i)
+				{
+					float rate = static_cast<float>(i - start) / static_cast<float>(next - start);
+					isRedundant = distance(lerp(samples[start], samples[next], rate), DirectX::XMLoadFloat4(&samples[i])) <= tolerance;
+				}
+				if (!isRedundant) break;
+				end = next;
+			}
+			kept.push_back(static_cast<std::uint16_t>(end));
+			start = end;
+		}
+	}
+	if (kept.size() == 1)
+	{
+		pOut->keyRate = 0.0f;
+	}
+	else if (kept.size() < samples.size())
+	{
+		pOut->frames = kept;
+	}
+
+	//--- 3. 量子化
+	pOut->values.resize(kept.size());
+	if (isRotation)
+	{
+		const float kHalfSqrt2 = 0.70710678f;
+		for (size_t i = 0; i < kept.size(); ++i)
+		{
+			DirectX::XMFLOAT4 q;
+			DirectX::XMStoreFloat4(&q, DirectX::XMQuaternionNormalize(DirectX::XMLoadFloat4(&samples[kept[i]])));
+			float comp[4] = { q.x, q.y, q.z, q.w };
+
+			// 絶対値が最大の成分を省き、正になるよう符号を揃える
+			int largest = 0;
+			for (int c = 1; c < 4; ++c)
+			{
+				if (std::fabs(comp[c]) > std::fabs(comp[largest])) largest = c;
+			}
+			const float sign = comp[largest] < 0.0f ? -1.0f : 1.0f;
+
+			std::uint64_t bits = static_cast<std::uint64_t>(largest) << 45;
+			int shift = 30;
+			for (int c = 0; c < 4; ++c)
+			{
+				if (c == largest) continue;
+				float n = (comp[c] * sign + kHalfSqrt2) / (2.0f * kHalfSqrt2);
+				std::uint64_t value = static_cast<std::uint64_t>(std::lround(std::min(std::max(n, 0.0f), 1.0f) * 32767.0f));
+				bits |= value << shift;
+				shift -= 15;
+			}
+			pOut->values[i].v[0] = static_cast<std::uint16_t>(bits >> 32);
+			pOut->values[i].v[1] = static_cast<std::uint16_t>(bits >> 16);
+			pOut->values[i].v[2] = static_cast<std::uint16_t>(bits);
+		}
+	}
+	else
+	{
+		// 残したキーの範囲で量子化する
+		DirectX::XMVECTOR minValue = DirectX::XMLoadFloat4(&samples[kept[0]]);
+		DirectX::XMVECTOR maxValue = minValue;
+		for (std::uint16_t frame : kept)
+		{
+			minValue = DirectX::XMVectorMin(minValue, DirectX::XMLoadFloat4(&samples[frame]));
+			maxValue = DirectX::XMVectorMax(maxValue, DirectX::XMLoadFloat4(&samples[frame]));
+		}
+		DirectX::XMStoreFloat3(&pOut->rangeMin, minValue);
+		DirectX::XMStoreFloat3(&pOut->rangeExtent, DirectX::XMVectorSubtract(maxValue, minValue));
+
+		const float extent[3] = { pOut->rangeExtent.x, pOut->rangeExtent.y, pOut->rangeExtent.z };
+		const float minimum[3] = { pOut->rangeMin.x, pOut->rangeMin.y, pOut->rangeMin.z };
+		for (size_t i = 0; i < kept.size(); ++i)
+		{
+			const DirectX::XMFLOAT4& v = samples[kept[i]];
+			const float value[3] = { v.x, v.y, v.z };
+			for (int c = 0; c < 3; ++c)
+			{
+				float n = extent[c] > 0.0f ? (value[c] - minimum[c]) / extent[c] : 0.0f;
+				pOut->values[i].v[c] = static_cast<std::uint16_t>(std::lround(std::min(std::max(n, 0.0f), 1.0f) * 65535.0f));
+			}
+		}
+	}
+}
+
+/*
+* @brief 圧縮後のキー列を元のキー時刻でサンプリングし、最大誤差を求める
+* @param[in] raw 圧縮前のキー列
+* @param[in] track 圧縮後のキー列
+* @param[in] isRotation 回転のキー列か
+* @return 最大誤差 (位置・拡縮は距離、回転はラジアン)
+*/
+float Model::MeasureError(const RawTrack& raw, const KeyTrack& track, bool isRotation)
+{
+	float maxError = 0.0f;
+	std::uint32_t cursor = 0;
+	for (size_t i = 0; i < raw.values.size(); ++i)
+	{
+		const KeySpan span = FindSpan(track, raw.times[i], cursor);
+		DirectX::XMVECTOR src = DirectX::XMLoadFloat4(&raw.values[i]);
+		float error;
+		if (isRotation)
+		{
+			error = QuaternionAngle(SampleQuaternion(track, span), src);
+		}
+		else
+		{
+			DirectX::XMVECTOR v = SampleVector(track, span);
+			error = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(v, src)));
+		}
+		maxError = std::max(maxError, error);
+	}
+	return maxError;
+}
+
+/*
+* @brief 2つのキー列が同じフレームにキーを持つか (1キー以下の列は区間を持たないため常に一致扱い)
+*/
+bool Model::IsSameTiming(const KeyTrack& a, const KeyTrack& b)
+{
+	if (a.values.size() <= 1 || b.values.size() <= 1) return true;
+	return
+		a.values.size() == b.values.size() &&
+		a.keyRate == b.keyRate &&
+		a.startTime == b.startTime &&
+		a.frames == b.frames;
+}
+
+/*
+* @brief assimpのノード階層からボーン(ノード)を作成
+* @param[in] ptr assimpのシーン
+*/
+void Model::MakeBoneNodes(const void* ptr)
+{
+	// 再帰でAssimpのノードを読み取り
+	std::function<NodeIndex(aiNode*, NodeIndex, DirectX::XMMATRIX mat)> FuncAssimpNodeConvert =
+		[&FuncAssimpNodeConvert, this](aiNode* assimpNode, NodeIndex parent, DirectX::XMMATRIX mat)
+		{
+			DirectX::XMMATRIX transform = GetMatrixFromAssimpMatrix(assimpNode->mTransformation);
+			std::string name = assimpNode->mName.data;
+			if (name.find("$AssimpFbx") != std::string::npos)
+			{
+				mat = transform * mat;
+				return FuncAssimpNodeConvert(assimpNode->mChildren[0], parent, mat);
+			}
+			else
+			{
+				// Assimpのノード情報をモデルクラスへ格納
+				Node node;
+				node.name = assimpNode->mName.data;
+				node.parent = parent;
+				node.children.resize(assimpNode->mNumChildren);
+				node.mat = mat;
+
+				// ノードリストに追加
+				m_nodes.push_back(node);
+				NodeIndex nodeIndex = static_cast<NodeIndex>(m_nodes.size() - 1);
+
+				// 子要素も同様に変換
+				for (UINT i = 0; i < assimpNode->mNumChildren; ++i)
+				{
+					m_nodes[nodeIndex].children[i] = FuncAssimpNodeConvert(
+						assimpNode->mChildren[i], nodeIndex, DirectX::XMMatrixIdentity());
+				}
+				return nodeIndex;
+			}
+		};
+
+	// ノード作成
+	m_nodes.clear();
+	FuncAssimpNodeConvert(reinterpret_cast<const aiScene*>(ptr)->mRootNode, INDEX_NONE, DirectX::XMMatrixIdentity());
+
+	// 親番号の配列 (ノードは深さ優先で親→子の順に追加されるため、親番号は常に自身より小さい)
+	m_nodeParents.resize(m_nodes.size());
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		m_nodeParents[i] = m_nodes[i].parent;
+	}
+}
+
+/*
+* @brief メッシュのボーンと頂点ウェイトを作成
+* @details オフセット行列は読み込んだままの値で保持する (スケール・反転は ApplyLoadTransform で適用)
+* @param[in] ptr assimpのシーン
+* @param[in] meshIdx メッシュ番号
+*/
+void Model::MakeWeight(const void* ptr, int meshIdx)
+{
+	const aiScene* pScene = reinterpret_cast<const aiScene*>(ptr);
+
+	// メッシュに対応するボーンがあるか
+	aiMesh* assimpMesh = pScene->mMeshes[meshIdx];
+	Mesh& mesh = m_meshes[meshIdx];
+	if (assimpMesh->HasBones())
+	{
+		// メッシュの頂点毎のウェイト領域を作成
+		struct WeightPair
+		{
+			unsigned int idx;
+			float weight;
+		};
+		std::vector<std::vector<WeightPair>> weights;
+		weights.resize(mesh.vertices.size());
+
+
+		// メッシュに割り当てられているボーン領域を確保
+		mesh.bones.resize(assimpMesh->mNumBones);
+		for (auto boneIt = mesh.bones.begin(); boneIt != mesh.bones.end(); ++boneIt)
+		{
+			UINT boneIdx = static_cast<UINT>(boneIt - mesh.bones.begin());
+			aiBone* assimpBone = assimpMesh->mBones[boneIdx];
+			boneIt->isSkin = true;
+			boneIt->invOffset = DirectX::XMMatrixIdentity();
+			// 構築済みのボーンノードから該当ノードを取得
+			std::string boneName = assimpBone->mName.data;
+			auto nodeIt = std::find_if(m_nodes.begin(), m_nodes.end(),
+				[boneName](const Node& val) {
+					return val.name == boneName;
+				});
+			// メッシュに割り当てられているボーンが、ノードに存在しない
+			if (nodeIt == m_nodes.end())
+			{
+				boneIt->index = INDEX_NONE;
+				continue;
+			}
+
+			// メッシュのボーンとノードの紐づけ
+			boneIt->index = static_cast<NodeIndex>(nodeIt - m_nodes.begin());
+			boneIt->invOffset = GetMatrixFromAssimpMatrix(assimpBone->mOffsetMatrix);
+
+			// ウェイトの設定
+			UINT weightNum = assimpBone->mNumWeights;
+			for (UINT i = 0; i < weightNum; ++i)
+			{
+				aiVertexWeight weight = assimpBone->mWeights[i];
+				weights[weight.mVertexId].push_back({ boneIdx, weight.mWeight });
+			}
+		}
+
+		// 取得した頂点ウェイトを設定
+		for (int i = 0; i < weights.size(); ++i)
+		{
+			if (weights[i].size() >= 4)
+			{
+				std::sort(weights[i].begin(), weights[i].end(), [](WeightPair& a, WeightPair& b) {
+					return a.weight > b.weight;
+					});
+				// ウェイト4つに合わせて正規化
+				float total = 0.0f;
+				for (int j = 0; j < 4; ++j)
+					total += weights[i][j].weight;
+				for (int j = 0; j < 4; ++j)
+					weights[i][j].weight /= total;
+			}
+			for (int j = 0; j < weights[i].size() && j < 4; ++j)
+			{
+				mesh.vertices[i].index[j] = weights[i][j].idx;
+				mesh.vertices[i].weight[j] = weights[i][j].weight;
+			}
+		}
+	}
+	else
+	{
+		// メッシュの親ノードをトランスフォームとして計算
+		std::string nodeName = assimpMesh->mName.data;
+		auto nodeIt = std::find_if(m_nodes.begin(), m_nodes.end(),
+			[nodeName](const Node& val) {
+				return val.name == nodeName;
+			});
+		if (nodeIt == m_nodes.end())
+		{
+			return;	// ボーンデータなし
+		}
+
+		// メッシュでない親ノードを再帰探索
+		std::function<int(int)> FuncFindNode =
+			[&FuncFindNode, this, pScene](NodeIndex parent)
+			{
+				std::string name = m_nodes[parent].name;
+				for (UINT i = 0; i < pScene->mNumMeshes; ++i)
+				{
+					if (name == pScene->mMeshes[i]->mName.data)
+					{
+						return FuncFindNode(m_nodes[parent].parent);
+					}
+				}
+				return parent;
+			};
+
+		Bone bone;
+		bone.index = FuncFindNode(nodeIt->parent);
+		bone.isSkin = false;
+		bone.invOffset = DirectX::XMMatrixInverse(nullptr, m_nodes[bone.index].mat);
+		for (auto vtxIt = mesh.vertices.begin(); vtxIt != mesh.vertices.end(); ++vtxIt)
+		{
+			vtxIt->weight[0] = 1.0f;
+		}
+
+		mesh.bones.resize(1);
+		mesh.bones[0] = bone;
+	}
+}
+
+/*
+* @brief メッシュのボーンをパレットへ割り当て、頂点のボーン番号をパレット上の位置に置き換える
+* @details 同じノード・同じオフセット行列のボーンは既存のエントリを共有するため、
+*          スケルトンを共有するメッシュは1つのパレット (1回の転送) で描画できる。
+*          MAX_BONE を超える場合のみ新しいパレットを作る。
+* @param[in] meshIdx メッシュ番号
+*/
+void Model::AssignPalette(int meshIdx)
+{
+	Mesh& mesh = m_meshes[meshIdx];
+
+	// 現在のパレット内で同じボーンを探す
+	auto findBone = [this](const Palette& palette, const Bone& bone)
+	{
+		for (unsigned int i = 0; i < palette.count; ++i)
+		{
+			const Bone& entry = m_paletteBones[palette.offset + i];
+			if (entry.index != bone.index || entry.isSkin != bone.isSkin) continue;
+			if (bone.index == INDEX_NONE ||
+				memcmp(&entry.invOffset, &bone.invOffset, sizeof(DirectX::XMMATRIX)) == 0)
+			{
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	};
+
+	// 追加が必要なボーン数を数え、入りきらなければ新しいパレットを用意
+	if (m_palettes.empty())
+	{
+		m_palettes.push_back({ 0, 0 });
+	}
+	unsigned int addNum = 0;
+	for (const Bone& bone : mesh.bones)
+	{
+		if (findBone(m_palettes.back(), bone) < 0) ++addNum;
+	}
+	if (m_palettes.back().count > 0 && m_palettes.back().count + addNum > MAX_BONE)
+	{
+		m_palettes.push_back({ static_cast<unsigned int>(m_paletteBones.size()), 0 });
+	}
+
+	// ボーンをパレットへ登録
+	Palette& palette = m_palettes.back();
+	std::vector<unsigned int> remap(mesh.bones.size());
+	for (size_t b = 0; b < mesh.bones.size(); ++b)
+	{
+		int entry = findBone(palette, mesh.bones[b]);
+		if (entry < 0)
+		{
+			entry = static_cast<int>(palette.count);
+			m_paletteBones.push_back(mesh.bones[b]);
+			++palette.count;
+		}
+		remap[b] = static_cast<unsigned int>(entry);
+	}
+	mesh.paletteNo = static_cast<unsigned int>(m_palettes.size() - 1);
+
+	// 頂点のボーン番号をパレット上の位置へ置き換え
+	if (remap.empty()) return;
+	for (Vertex& vertex : mesh.vertices)
+	{
+		for (int j = 0; j < 4; ++j)
+		{
+			if (vertex.index[j] < remap.size())
+			{
+				vertex.index[j] = remap[vertex.index[j]];
+			}
+		}
+	}
+}
@@ -0,0 +1,769 @@
+﻿/*****************************************************************//**
+ * @file	ModelInstance.cpp
+ * @brief	ModelInstanceの実装
+ *
+ * @details	Model.cpp にあった再生・姿勢計算の処理を、エンティティ毎の状態で行うように移したもの。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ModelInstance.cppを作成。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/ModelInstance.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+/*
+* @brief コンストラクタ
+* @param[in] pModel 共有するモデル (AssetManagerが保持するもの)
+*/
+ModelInstance::ModelInstance(Model* pModel)
+	: m_pModel(pModel)
+	, m_playNo(Model::ANIME_NONE)
+	, m_blendNo(Model::ANIME_NONE)
+	, m_parametric{ Model::ANIME_NONE, Model::ANIME_NONE }
+	, m_blendTime(0.0f)
+	, m_blendTotalTime(0.0f)
+	, m_parametricBlend(0.0f)
+	, m_paletteRevision(0)
+{
+	SyncNodeCount();
+}
+
+/*
+* @brief アニメーションの更新
+* @param[in] tick アニメーション経過時間
+*/
+void ModelInstance::Step(float tick)
+{
+	// アニメーションの再生確認
+	if (m_playNo == Model::ANIME_NONE) { return; }
+
+	SampleLayers();
+	CalcBones();
+	Advance(tick);
+}
+
+/*
+* @brief 複数インスタンスのアニメーションをまとめて更新
+* @details 同じモデルを参照するインスタンスが並んでいれば、4体ずつSIMDのレーンに割り当てて姿勢を計算する。
+*          呼び出し側でモデル毎に並べておくと効率が良い。
+* @param[in] ppInstances 更新するインスタンスの配列
+* @param[in] count 配列の要素数
+* @param[in] tick アニメーション経過時間
+*/
+void ModelInstance::StepBatch(ModelInstance* const* ppInstances, size_t count, float tick)
+{
+	// 再生中のものだけを対象にする
+	thread_local std::vector<ModelInstance*> active;
+	active.clear();
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (ppInstances[i] && ppInstances[i]->m_playNo != Model::ANIME_NONE)
+		{
+			active.push_back(ppInstances[i]);
+		}
+	}
+
+	for (ModelInstance* pInstance : active)
+	{
+		pInstance->SampleLayers();
+	}
+
+	size_t index = 0;
+	while (index < active.size())
+	{
+		// 同じモデルが4体続けば、まとめて計算
+		if (index + 4 <= active.size() &&
+			active[index + 1]->m_pModel == active[index]->m_pModel &&
+			active[index + 2]->m_pModel == active[index]->m_pModel &&
+			active[index + 3]->m_pModel == active[index]->m_pModel)
+		{
+			CalcBonesX4(&active[index]);
+			index += 4;
+		}
+		else
+		{
+			active[index]->CalcBones();
+			++index;
+		}
+	}
+
+	for (ModelInstance* pInstance : active)
+	{
+		pInstance->Advance(tick);
+	}
+}
+
+/*
+* @brief 再生中のアニメーションをサンプリングし、合成後のローカル姿勢を求める
+*/
+void ModelInstance::SampleLayers()
+{
+	SyncNodeCount();
+
+	//--- アニメーション行列の更新
+	// パラメトリック
+	const bool isParametric = m_playNo == Model::PARAMETRIC_ANIME || m_blendNo == Model::PARAMETRIC_ANIME;
+	if (isParametric)
+	{
+		CalcAnime(PARAMETRIC0, m_parametric[0]);
+		CalcAnime(PARAMETRIC1, m_parametric[1]);
+	}
+	// メインアニメ
+	if (m_playNo != Model::ANIME_NONE && m_playNo != Model::PARAMETRIC_ANIME)
+	{
+		CalcAnime(MAIN, m_playNo);
+	}
+	// ブレンドアニメ
+	if (m_blendNo != Model::ANIME_NONE && m_blendNo != Model::PARAMETRIC_ANIME)
+	{
+		CalcAnime(BLEND, m_blendNo);
+	}
+
+	//--- アニメーションごとのパラメータを合成
+	const size_t nodeNum = m_localTransforms.size();
+	for (size_t index = 0; index < nodeNum; ++index)
+	{
+		Transform& transform = m_localTransforms[index];
+		// パラメトリック
+		if (isParametric)
+		{
+			LerpTransform(&transform, m_nodeTransform[PARAMETRIC0][index], m_nodeTransform[PARAMETRIC1][index], m_parametricBlend);
+			if (m_playNo == Model::PARAMETRIC_ANIME) m_nodeTransform[MAIN][index] = transform;
+			if (m_blendNo == Model::PARAMETRIC_ANIME) m_nodeTransform[BLEND][index] = transform;
+		}
+		// ブレンドアニメ
+		if (m_blendNo != Model::ANIME_NONE)
+		{
+			LerpTransform(&transform, m_nodeTransform[MAIN][index], m_nodeTransform[BLEND][index], m_blendTime / m_blendTotalTime);
+		}
+		else
+		{
+			// メインアニメのみ
+			transform = m_nodeTransform[MAIN][index];
+		}
+	}
+}
+
+/*
+* @brief アニメーションの時間を進める
+* @param[in] tick アニメーション経過時間
+*/
+void ModelInstance::Advance(float tick)
+{
+	//--- アニメーションの時間更新
+	// メインアニメ
+	if (m_playNo != Model::ANIME_NONE && m_playNo != Model::PARAMETRIC_ANIME) {
+		UpdateAnime(m_playNo, tick);
+	}
+	// ブレンドアニメ
+	if (m_blendNo != Model::ANIME_NONE)
+	{
+		if (m_blendNo != Model::PARAMETRIC_ANIME) {
+			UpdateAnime(m_blendNo, tick);
+		}
+		m_blendTime += tick;
+		if (m_blendTime >= m_blendTotalTime)
+		{
+			// ブレンドアニメの自動終了
+			m_blendTime = 0.0f;
+			m_blendTotalTime = 0.0f;
+			m_playNo = m_blendNo;
+			m_blendNo = Model::ANIME_NONE;
+		}
+	}
+	// パラメトリック
+	if (m_playNo == Model::PARAMETRIC_ANIME || m_blendNo == Model::PARAMETRIC_ANIME)
+	{
+		UpdateAnime(m_parametric[0], tick);
+		UpdateAnime(m_parametric[1], tick);
+	}
+}
+
+/*
+* @brief アニメーションの再生
+* @param[in] no 再生するアニメーション番号
+* @param[in] loop ループ再生フラグ
+* @param[in] speed 再生速度
+*/
+void ModelInstance::Play(AnimeNo no, bool loop, float speed)
+{
+	// 再生チェック
+	if (!AnimeNoCheck(no)) { return; }
+
+	// 同じアニメーションが指定されても最初から再生し直し、前の遷移状態も破棄する
+	m_blendTime = 0.0f;
+	m_blendTotalTime = 0.0f;
+	m_blendNo = Model::ANIME_NONE;
+
+	// 合成アニメーションかチェック
+	if (no != Model::PARAMETRIC_ANIME)
+	{
+		InitAnime(no);
+		GetInfo(no).isLoop = loop;
+		GetInfo(no).speed = speed;
+	}
+	else
+	{
+		// 合成アニメーションの元になっているアニメーションを初期化
+		InitAnime(m_parametric[0]);
+		InitAnime(m_parametric[1]);
+		GetInfo(m_parametric[0]).isLoop = loop;
+		GetInfo(m_parametric[1]).isLoop = loop;
+		SetParametricBlend(0.0f);
+	}
+
+	m_playNo = no;
+}
+
+void ModelInstance::Play(const std::string& animeID, bool loop, float speed)
+{
+	AnimeNo no = m_pModel->FindAnimation(animeID);
+	if (no != Model::ANIME_NONE)
+	{
+		Play(no, loop, speed);
+	}
+	else
+	{
+		std::cerr << "Warning: Animation ID '" << animeID << "' not found in model." << std::endl;
+	}
+}
+
+/*
+* @brief ブレンド再生
+* @param[in] no アニメーション番号
+* @param[in] blendTime ブレンドに掛ける時間
+* @param[in] loop ループフラグ
+* @param[in] speed 再生速度
+*/
+void ModelInstance::PlayBlend(AnimeNo no, float blendTime, bool loop, float speed)
+{
+	// 再生チェック
+	if (!AnimeNoCheck(no)) { return; }
+
+	// 合成アニメーションかチェック
+	if (no != Model::PARAMETRIC_ANIME)
+	{
+		InitAnime(no);
+		GetInfo(no).isLoop = loop;
+		GetInfo(no).speed = speed;
+	}
+	else
+	{
+		// 合成アニメーションの元になっているアニメーションを初期化
+		InitAnime(m_parametric[0]);
+		InitAnime(m_parametric[1]);
+		GetInfo(m_parametric[0]).isLoop = loop;
+		GetInfo(m_parametric[1]).isLoop = loop;
+		SetParametricBlend(0.0f);
+	}
+
+	// ブレンドの設定
+	m_blendTime = 0.0f;
+	m_blendTotalTime = blendTime;
+	m_blendNo = no;
+}
+
+void ModelInstance::PlayBlend(const std::string& animeID, float blendTime, bool loop, float speed)
+{
+	AnimeNo no = m_pModel->FindAnimation(animeID);
+	if (no != Model::ANIME_NONE)
+	{
+		PlayBlend(no, blendTime, loop, speed);
+	}
+	else
+	{
+		std::cerr << "Warning: PlayBlend failed. Animation ID '" << animeID << "' not found." << std::endl;
+	}
+}
+
+/*
+* @brief 合成アニメーションの設定
+* @param[in] no1 合成アニメ1
+* @param[in] no2 合成アニメ2
+*/
+void ModelInstance::SetParametric(AnimeNo no1, AnimeNo no2)
+{
+	// アニメーションチェック
+	if (!AnimeNoCheck(no1)) { return; }
+	if (!AnimeNoCheck(no2)) { return; }
+
+	m_parametric[0] = no1;
+	m_parametric[1] = no2;
+	SetParametricBlend(0.0f);
+}
+
+/*
+* @brief 合成アニメーションの合成割合設定
+* @param[in] blendRate 合成割合
+*/
+void ModelInstance::SetParametricBlend(float blendRate)
+{
+	// 合成アニメが設定されているか確認
+	if (m_parametric[0] == Model::ANIME_NONE || m_parametric[1] == Model::ANIME_NONE) return;
+
+	m_parametricBlend = blendRate;
+
+	// 合成割合に基づいてアニメーションの再生速度を設定
+	const float totalTime1 = m_pModel->m_animes[m_parametric[0]].pClip->totalTime;
+	const float totalTime2 = m_pModel->m_animes[m_parametric[1]].pClip->totalTime;
+	float blendTotalTime = totalTime1 * (1.0f - m_parametricBlend) + totalTime2 * m_parametricBlend;
+	GetInfo(m_parametric[0]).speed = totalTime1 / blendTotalTime;
+	GetInfo(m_parametric[1]).speed = totalTime2 / blendTotalTime;
+}
+
+/*
+* @brief アニメーションの再生時間を変更
+* @param[in] no 変更するアニメ
+* @param[in] time 新しい再生時間
+*/
+void ModelInstance::SetAnimationTime(AnimeNo no, float time)
+{
+	// アニメーションチェック
+	if (!AnimeNoCheck(no) || no == Model::PARAMETRIC_ANIME) { return; }
+
+	const float totalTime = m_pModel->m_animes[no].pClip->totalTime;
+	PlaybackInfo& info = GetInfo(no);
+	info.nowTime = time;
+	while (info.nowTime >= totalTime)
+	{
+		info.nowTime -= totalTime;
+	}
+}
+
+/*
+* @brief 再生フラグの取得
+* @param[in] no 調べるアニメ番号
+* @return 現在再生中ならtrue
+*/
+bool ModelInstance::IsPlay(AnimeNo no) const
+{
+	// アニメーションチェック
+	if (!AnimeNoCheck(no)) { return false; }
+
+	// パラメトリックは合成元のアニメに反映
+	if (no == Model::PARAMETRIC_ANIME) { no = m_parametric[0]; }
+
+	// 再生時間の判定
+	const float nowTime = (no < static_cast<AnimeNo>(m_animeInfo.size())) ? m_animeInfo[no].nowTime : 0.0f;
+	if (m_pModel->m_animes[no].pClip->totalTime < nowTime) { return false; }
+
+	// それぞれの再生番号に設定されているか確認
+	if (m_playNo == no) { return true; }
+	if (m_blendNo == no) { return true; }
+	if (m_playNo == Model::PARAMETRIC_ANIME || m_blendNo == Model::PARAMETRIC_ANIME)
+	{
+		if (m_parametric[0] == no) { return true; }
+		if (m_parametric[1] == no) { return true; }
+	}
+
+	return false;
+}
+
+/*
+* @brief 計算済みのノード行列を取得
+* @param[in] index ボーン番号
+* @return 該当ボーンの変換行列
+*/
+DirectX::XMMATRIX ModelInstance::GetBone(NodeIndex index) const
+{
+	if (0 <= index && index < static_cast<NodeIndex>(m_nodeMatrices.size()))
+	{
+		return m_nodeMatrices[index];
+	}
+	return DirectX::XMMatrixIdentity();
+}
+
+/*
+* @brief このインスタンスの姿勢で描画
+* @param[in] meshNo 描画するメッシュ番号、-1で全て
+* @param[in] lod 詳細度 (Model::SelectLod で選んだもの)
+*/
+void ModelInstance::Draw(int meshNo, int lod)
+{
+	if (m_nodeMatrices.empty())
+	{
+		m_pModel->Draw(meshNo, nullptr, lod);
+		return;
+	}
+
+	// 姿勢が更新されていればパレットを計算し直す
+	if (m_paletteRevision == 0 || m_palette.size() != m_pModel->GetPaletteSize())
+	{
+		m_palette.resize(m_pModel->GetPaletteSize());
+		m_pModel->BuildPalette(m_nodeMatrices.data(), m_palette.data());
+		m_paletteRevision = Model::IssuePaletteRevision();
+	}
+	m_pModel->Draw(meshNo, m_palette.data(), m_paletteRevision, lod);
+}
+
+bool ModelInstance::GetAnimatedTransform(DirectX::XMFLOAT3& outPos, DirectX::XMFLOAT3& outRot, DirectX::XMFLOAT3& outScale) const
+{
+	// 1. スキニングモデル（ボーンあり）の場合はシェーダー側で動くため対象外
+	for (const auto& mesh : m_pModel->m_meshes)
+	{
+		if (!mesh.bones.empty()) return false;
+	}
+
+	// 2. アニメーションが再生されているかチェック
+	if (m_playNo == Model::ANIME_NONE && m_blendNo == Model::ANIME_NONE)
+	{
+		return false;
+	}
+
+	// 3. ルートノード(Index 0)の行列を取得 (Step() で更新済みの前提)
+	if (m_nodeMatrices.empty()) return false;
+
+	DirectX::XMMATRIX rootMat = m_nodeMatrices[0];
+
+	// 4. 行列を分解 (Scale, Rotation, Translation)
+	DirectX::XMVECTOR s, r, t;
+	if (!DirectX::XMMatrixDecompose(&s, &r, &t, rootMat))
+	{
+		return false;
+	}
+
+	// 5. 値の格納
+	DirectX::XMStoreFloat3(&outScale, s);
+	DirectX::XMStoreFloat3(&outPos, t);
+
+	// 6. クォータニオン -> オイラー角(度) 変換
+	DirectX::XMFLOAT4 q;
+	DirectX::XMStoreFloat4(&q, r);
+
+	float sqw = q.w * q.w;
+	float sqx = q.x * q.x;
+	float sqy = q.y * q.y;
+	float sqz = q.z * q.z;
+	float unit = sqx + sqy + sqz + sqw;
+	float test = q.x * q.w - q.y * q.z;
+
+	if (test > 0.4995f * unit) { // 北極 (特異点)
+		outRot.y = 2.0f * atan2f(q.y, q.x);
+		outRot.x = DirectX::XM_PIDIV2;
+		outRot.z = 0;
+	}
+	else if (test < -0.4995f * unit) { // 南極 (特異点)
+		outRot.y = -2.0f * atan2f(q.y, q.x);
+		outRot.x = -DirectX::XM_PIDIV2;
+		outRot.z = 0;
+	}
+	else {
+		outRot.y = atan2f(2.0f * q.w * q.y + 2.0f * q.z * q.x, 1 - 2.0f * (sqx + sqy));
+		outRot.x = asinf(2.0f * (q.w * q.x - q.y * q.z));
+		outRot.z = atan2f(2.0f * q.w * q.z + 2.0f * q.x * q.y, 1 - 2.0f * (sqz + sqx));
+	}
+
+	// ラジアン -> 度 へ変換
+	outRot.x = DirectX::XMConvertToDegrees(outRot.x);
+	outRot.y = DirectX::XMConvertToDegrees(outRot.y);
+	outRot.z = DirectX::XMConvertToDegrees(outRot.z);
+
+	return true;
+}
+
+bool ModelInstance::AnimeNoCheck(AnimeNo no) const
+{
+	// パラメトリックアニメーション確認
+	if (no == Model::PARAMETRIC_ANIME)
+	{
+		// パラメトリックのアニメーションが設定されているか
+		return
+			m_parametric[0] != Model::ANIME_NONE &&
+			m_parametric[1] != Model::ANIME_NONE;
+	}
+	else
+	{
+		// 問題ないアニメーション番号かどうか
+		return 0 <= no && no < static_cast<AnimeNo>(m_pModel->m_animes.size());
+	}
+}
+
+ModelInstance::PlaybackInfo& ModelInstance::GetInfo(AnimeNo no)
+{
+	// インスタンス生成後に共有モデルへクリップが追加されることがあるため、必要に応じて拡張する
+	if (no >= static_cast<AnimeNo>(m_animeInfo.size()))
+	{
+		m_animeInfo.resize(m_pModel->m_animes.size());
+	}
+	return m_animeInfo[no];
+}
+
+void ModelInstance::InitAnime(AnimeNo no)
+{
+	// アニメの設定なし、パラメトリックで設定されていなければ初期化しない
+	if (no == Model::ANIME_NONE || no == Model::PARAMETRIC_ANIME) { return; }
+
+	// カーソルは巻き戻し時に探し直されるため、領域を再利用する
+	PlaybackInfo& info = GetInfo(no);
+	info.nowTime = 0.0f;
+	info.speed = 1.0f;
+	info.isLoop = false;
+	std::fill(info.cursors.begin(), info.cursors.end(), 0u);
+}
+
+void ModelInstance::CalcAnime(AnimeTransform kind, AnimeNo no)
+{
+	const Model::AnimeBinding& binding = m_pModel->m_animes[no];
+	const Model::Animation& anime = *binding.pClip;
+	PlaybackInfo& info = GetInfo(no);
+	const float nowTime = info.nowTime;
+
+	// チャンネル毎に 位置・回転・拡縮 の3つのカーソルを持つ
+	const size_t cursorNum = anime.channels.size() * 3;
+	if (info.cursors.size() != cursorNum)
+	{
+		info.cursors.assign(cursorNum, 0);
+	}
+
+	for (size_t channelIdx = 0; channelIdx < anime.channels.size(); ++channelIdx)
+	{
+		// 一致するボーンがなければスキップ
+		const Model::NodeIndex nodeIndex = binding.channelNodes[channelIdx];
+		if (nodeIndex == Model::INDEX_NONE) continue;
+		const Model::Channel& channel = anime.channels[channelIdx];
+
+		//--- 該当ノードの姿勢をアニメーションで更新 (キーの無い要素は変更しない)
+		Transform& transform = m_nodeTransform[kind][nodeIndex];
+		std::uint32_t* cursor = &info.cursors[channelIdx * 3];
+		Model::KeySpan span[3];
+		if (channel.sharedTiming)
+		{
+			// キー時刻が共通なら、複数キーを持つ要素で区間を1回だけ求めて使い回す
+			span[0] = span[1] = span[2] =
+				channel.rotation.values.size() > 1 ? Model::FindSpan(channel.rotation, nowTime, cursor[1]) :
+				channel.translate.values.size() > 1 ? Model::FindSpan(channel.translate, nowTime, cursor[0]) :
+				Model::FindSpan(channel.scale, nowTime, cursor[2]);
+		}
+		else
+		{
+			span[0] = Model::FindSpan(channel.translate, nowTime, cursor[0]);
+			span[1] = Model::FindSpan(channel.rotation, nowTime, cursor[1]);
+			span[2] = Model::FindSpan(channel.scale, nowTime, cursor[2]);
+		}
+		if (!channel.translate.values.empty()) DirectX::XMStoreFloat3(&transform.translate, Model::SampleVector(channel.translate, span[0]));
+		if (!channel.rotation.values.empty()) DirectX::XMStoreFloat4(&transform.quaternion, Model::SampleQuaternion(channel.rotation, span[1]));
+		if (!channel.scale.values.empty()) DirectX::XMStoreFloat3(&transform.scale, Model::SampleVector(channel.scale, span[2]));
+	}
+}
+
+void ModelInstance::UpdateAnime(AnimeNo no, float tick)
+{
+	if (no == Model::PARAMETRIC_ANIME) { return; }
+
+	const float totalTime = m_pModel->m_animes[no].pClip->totalTime;
+	PlaybackInfo& info = GetInfo(no);
+	info.nowTime += info.speed * tick;
+	if (info.isLoop)
+	{
+		while (info.nowTime >= totalTime)
+		{
+			info.nowTime -= totalTime;
+		}
+	}
+}
+
+/*
+* @brief ローカル姿勢からモデル空間のノード行列を求める
+* @details ノードは親→子の順に並んでいるため、先頭から1回走査するだけで親の行列は計算済みになる
+*/
+void ModelInstance::CalcBones()
+{
+	const std::vector<NodeIndex>& parents = m_pModel->m_nodeParents;
+	const size_t nodeNum = m_localTransforms.size();
+	if (nodeNum == 0 || parents.size() != nodeNum) return;
+
+	// ルートにはモデル読み込み時のスケールを掛ける
+	const float scale = m_pModel->GetLoadScale();
+	const DirectX::XMMATRIX root = DirectX::XMMatrixScaling(scale, scale, scale);
+	for (size_t index = 0; index < nodeNum; ++index)
+	{
+		const DirectX::XMMATRIX local = MakeLocalMatrix(m_localTransforms[index]);
+		const NodeIndex parent = parents[index];
+		m_nodeMatrices[index] = DirectX::XMMatrixMultiply(local, parent == Model::INDEX_NONE ? root : m_nodeMatrices[parent]);
+	}
+	m_paletteRevision = 0;
+}
+
+/*
+* @brief 同じモデルを参照する4体のノード行列をまとめて計算する
+* @details レーン毎に別のインスタンスを割り当て (SoA)、アフィン行列の3x4要素をそれぞれ1本のベクトルで扱う
+* @param[in] ppInstances 4体分のインスタンス (全て同じモデルを参照していること)
+*/
+void ModelInstance::CalcBonesX4(ModelInstance* const* ppInstances)
+{
+	using namespace DirectX;
+
+	const Model* pModel = ppInstances[0]->m_pModel;
+	const std::vector<NodeIndex>& parents = pModel->m_nodeParents;
+	const size_t nodeNum = parents.size();
+	for (int lane = 0; lane < 4; ++lane)
+	{
+		if (ppInstances[lane]->m_localTransforms.size() != nodeNum)
+		{
+			// 姿勢バッファが揃っていなければ個別に計算
+			for (int i = 0; i < 4; ++i) ppInstances[i]->CalcBones();
+			return;
+		}
+	}
+
+	// ノード毎のモデル空間行列 (行0～2の回転・拡縮成分 9 + 平行移動 3)
+	struct AffineX4
+	{
+		XMVECTOR m[4][3];
+	};
+	thread_local std::vector<AffineX4> work;
+	work.resize(nodeNum);
+
+	// ルート (読み込み時のスケール)
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR one = XMVectorReplicate(1.0f);
+	const XMVECTOR two = XMVectorReplicate(2.0f);
+	const XMVECTOR scale = XMVectorReplicate(pModel->GetLoadScale());
+	AffineX4 root;
+	root.m[0][0] = scale; root.m[0][1] = zero;  root.m[0][2] = zero;
+	root.m[1][0] = zero;  root.m[1][1] = scale; root.m[1][2] = zero;
+	root.m[2][0] = zero;  root.m[2][1] = zero;  root.m[2][2] = scale;
+	root.m[3][0] = zero;  root.m[3][1] = zero;  root.m[3][2] = zero;
+
+	const Transform* pLocal[4] = {
+		ppInstances[0]->m_localTransforms.data(), ppInstances[1]->m_localTransforms.data(),
+		ppInstances[2]->m_localTransforms.data(), ppInstances[3]->m_localTransforms.data(),
+	};
+
+	for (size_t index = 0; index < nodeNum; ++index)
+	{
+		const Transform& t0 = pLocal[0][index];
+		const Transform& t1 = pLocal[1][index];
+		const Transform& t2 = pLocal[2][index];
+		const Transform& t3 = pLocal[3][index];
+
+		//--- ローカル行列 (S * R * T) をレーン毎に構築
+		const XMVECTOR qx = XMVectorSet(t0.quaternion.x, t1.quaternion.x, t2.quaternion.x, t3.quaternion.x);
+		const XMVECTOR qy = XMVectorSet(t0.quaternion.y, t1.quaternion.y, t2.quaternion.y, t3.quaternion.y);
+		const XMVECTOR qz = XMVectorSet(t0.quaternion.z, t1.quaternion.z, t2.quaternion.z, t3.quaternion.z);
+		const XMVECTOR qw = XMVectorSet(t0.quaternion.w, t1.quaternion.w, t2.quaternion.w, t3.quaternion.w);
+		const XMVECTOR sx = XMVectorSet(t0.scale.x, t1.scale.x, t2.scale.x, t3.scale.x);
+		const XMVECTOR sy = XMVectorSet(t0.scale.y, t1.scale.y, t2.scale.y, t3.scale.y);
+		const XMVECTOR sz = XMVectorSet(t0.scale.z, t1.scale.z, t2.scale.z, t3.scale.z);
+		const XMVECTOR tx = XMVectorSet(t0.translate.x, t1.translate.x, t2.translate.x, t3.translate.x);
+		const XMVECTOR ty = XMVectorSet(t0.translate.y, t1.translate.y, t2.translate.y, t3.translate.y);
+		const XMVECTOR tz = XMVectorSet(t0.translate.z, t1.translate.z, t2.translate.z, t3.translate.z);
+
+		// XMMatrixRotationQuaternion と同じ式
+		const XMVECTOR xx = XMVectorMultiply(qx, qx), yy = XMVectorMultiply(qy, qy), zz = XMVectorMultiply(qz, qz);
+		const XMVECTOR xy = XMVectorMultiply(qx, qy), xz = XMVectorMultiply(qx, qz), yz = XMVectorMultiply(qy, qz);
+		const XMVECTOR wx = XMVectorMultiply(qw, qx), wy = XMVectorMultiply(qw, qy), wz = XMVectorMultiply(qw, qz);
+		XMVECTOR local[3][3];
+		local[0][0] = XMVectorMultiply(sx, XMVectorNegativeMultiplySubtract(two, XMVectorAdd(yy, zz), one));
+		local[0][1] = XMVectorMultiply(sx, XMVectorMultiply(two, XMVectorAdd(xy, wz)));
+		local[0][2] = XMVectorMultiply(sx, XMVectorMultiply(two, XMVectorSubtract(xz, wy)));
+		local[1][0] = XMVectorMultiply(sy, XMVectorMultiply(two, XMVectorSubtract(xy, wz)));
+		local[1][1] = XMVectorMultiply(sy, XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, zz), one));
+		local[1][2] = XMVectorMultiply(sy, XMVectorMultiply(two, XMVectorAdd(yz, wx)));
+		local[2][0] = XMVectorMultiply(sz, XMVectorMultiply(two, XMVectorAdd(xz, wy)));
+		local[2][1] = XMVectorMultiply(sz, XMVectorMultiply(two, XMVectorSubtract(yz, wx)));
+		local[2][2] = XMVectorMultiply(sz, XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, yy), one));
+
+		//--- 親の行列を掛ける (local * parent)
+		const NodeIndex parentIndex = parents[index];
+		const AffineX4& parent = parentIndex == Model::INDEX_NONE ? root : work[parentIndex];
+		AffineX4& out = work[index];
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int col = 0; col < 3; ++col)
+			{
+				XMVECTOR v = XMVectorMultiply(local[row][0], parent.m[0][col]);
+				v = XMVectorMultiplyAdd(local[row][1], parent.m[1][col], v);
+				out.m[row][col] = XMVectorMultiplyAdd(local[row][2], parent.m[2][col], v);
+			}
+		}
+		for (int col = 0; col < 3; ++col)
+		{
+			XMVECTOR v = XMVectorMultiplyAdd(tx, parent.m[0][col], parent.m[3][col]);
+			v = XMVectorMultiplyAdd(ty, parent.m[1][col], v);
+			out.m[3][col] = XMVectorMultiplyAdd(tz, parent.m[2][col], v);
+		}
+
+		//--- レーンを各インスタンスの行列へ書き戻す (4x4 転置)
+		for (int row = 0; row < 4; ++row)
+		{
+			const XMVECTOR w = row == 3 ? one : zero;
+			const XMVECTOR xy01 = XMVectorMergeXY(out.m[row][0], out.m[row][1]);
+			const XMVECTOR zw01 = XMVectorMergeXY(out.m[row][2], w);
+			const XMVECTOR xy23 = XMVectorMergeZW(out.m[row][0], out.m[row][1]);
+			const XMVECTOR zw23 = XMVectorMergeZW(out.m[row][2], w);
+			ppInstances[0]->m_nodeMatrices[index].r[row] = XMVectorPermute<0, 1, 4, 5>(xy01, zw01);
+			ppInstances[1]->m_nodeMatrices[index].r[row] = XMVectorPermute<2, 3, 6, 7>(xy01, zw01);
+			ppInstances[2]->m_nodeMatrices[index].r[row] = XMVectorPermute<0, 1, 4, 5>(xy23, zw23);
+			ppInstances[3]->m_nodeMatrices[index].r[row] = XMVectorPermute<2, 3, 6, 7>(xy23, zw23);
+		}
+	}
+	for (int lane = 0; lane < 4; ++lane)
+	{
+		ppInstances[lane]->m_paletteRevision = 0;
+	}
+}
+
+void ModelInstance::SyncNodeCount()
+{
+	const size_t nodeNum = m_pModel ? m_pModel->m_nodes.size() : 0;
+	if (m_nodeMatrices.size() == nodeNum) return;
+
+	// 姿勢バッファはバインドポーズで初期化する
+	// (チャンネルを持たないノードの変形情報はこの初期値のまま)
+	const Transform initTransform = {
+		DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f),
+		DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f),
+		DirectX::XMFLOAT3(1.0f, 1.0f, 1.0f)
+	};
+	m_nodeMatrices.resize(nodeNum);
+	for (size_t i = 0; i < nodeNum; ++i)
+	{
+		m_nodeMatrices[i] = m_pModel->m_nodes[i].mat;
+	}
+	for (int i = 0; i < MAX_TRANSFORM; ++i)
+	{
+		m_nodeTransform[i].assign(nodeNum, initTransform);
+	}
+	m_localTransforms.assign(nodeNum, initTransform);
+	m_paletteRevision = 0;
+}
+
+void ModelInstance::LerpTransform(Transform* pOut, const Transform& a, const Transform& b, float rate)
+{
+	DirectX::XMVECTOR vec[][2] = {
+		{ DirectX::XMLoadFloat3(&a.translate),	DirectX::XMLoadFloat3(&b.translate) },
+		{ DirectX::XMLoadFloat4(&a.quaternion),	DirectX::XMLoadFloat4(&b.quaternion) },
+		{ DirectX::XMLoadFloat3(&a.scale),		DirectX::XMLoadFloat3(&b.scale) },
+	};
+	for (int i = 0; i < 3; ++i)
+	{
+		vec[i][0] = DirectX::XMVectorLerp(vec[i][0], vec[i][1], rate);
+	}
+	DirectX::XMStoreFloat3(&pOut->translate, vec[0][0]);
+	DirectX::XMStoreFloat4(&pOut->quaternion, vec[1][0]);
+	DirectX::XMStoreFloat3(&pOut->scale, vec[2][0]);
+}
+
+DirectX::XMMATRIX ModelInstance::MakeLocalMatrix(const Transform& transform)
+{
+	// S * R * T を行列積を使わずに組み立てる (回転の各行を拡縮し、平行移動を4行目に置く)
+	DirectX::XMMATRIX mat = DirectX::XMMatrixRotationQuaternion(DirectX::XMLoadFloat4(&transform.quaternion));
+	mat.r[0] = DirectX::XMVectorScale(mat.r[0], transform.scale.x);
+	mat.r[1] = DirectX::XMVectorScale(mat.r[1], transform.scale.y);
+	mat.r[2] = DirectX::XMVectorScale(mat.r[2], transform.scale.z);
+	mat.r[3] = DirectX::XMVectorSetW(DirectX::XMLoadFloat3(&transform.translate), 1.0f);
+	return mat;
+}
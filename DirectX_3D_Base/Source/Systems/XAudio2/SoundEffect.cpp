@@ -20,9 +20,12 @@
 
 // ===== CN[h =====
 #include "Systems/XAudio2/SoundEffect.h"
+#include <cstring>
 
 namespace Audio
 {
+	static_assert(SoundStream::LOOP_INFINITE == AUDIO_LOOP_INFINITE, "SoundStream::LOOP_INFINITE must match AUDIO_LOOP_INFINITE");
+
 	/**
 	 * @brief fXgN^BReleaseĂяoB
 	 */
@@ -39,7 +42,19 @@ namespace Audio
 	 */
 	bool SoundEffect::Load(const std::string& filePath)
 	{
-		// 1. WAVt@C[h
+		if (!LoadData(filePath)) return false;
+		return CreateVoice();
+	}
+
+	/**
+	 * [bool - LoadData]
+	 * @brief	WAVt@Cǂݍ ({CX͍쐬Ȃ)B
+	 * @param	[in] filePath WAVt@C̃pX
+	 * @return	true: , false: s
+	 */
+	bool SoundEffect::LoadData(const std::string& filePath)
+	{
+		// WAVt@C[h
 		LoadWavData wavData;
 		if (!SoundEngine::GetInstance().LoadWavFile(filePath, wavData))
 		{
@@ -51,30 +66,138 @@ namespace Audio
 		m_format = wavData.format;
 		m_audioData = wavData.audioData;
 		m_audioBytes = wavData.audioBytes;
+		m_isAudioDataOwned = wavData.isAudioDataOwned;
+		m_filePath = filePath;
+		return true;
+	}
+
+	/**
+	 * [bool - LoadData]
+	 * @brief	WAVt@C̓eǂݍ ({CX͍쐬Ȃ)B
+	 * @param	[in] pData WAVt@C̓e
+	 * @param	[in] size pData ̃oCg
+	 * @param	[in] filePath Op̃pX
+	 * @return	true: , false: s
+	 */
+	bool SoundEffect::LoadData(const void* pData, size_t size, const std::string& filePath)
+	{
+		LoadWavData wavData;
+		if (!SoundEngine::GetInstance().LoadWavMemory(pData, size, filePath, wavData))
+		{
+			std::cerr << "Error: Failed to load WAV file data: " << filePath << std::endl;
+			return false;
+		}
+
+		m_format = wavData.format;
+		m_audioData = wavData.audioData;
+		m_audioBytes = wavData.audioBytes;
+		m_isAudioDataOwned = wavData.isAudioDataOwned;
+		m_filePath = filePath;
+		return true;
+	}
 
-		// 2. XAudio2\[X{CX̍쐬
-		HRESULT hr = SoundEngine::GetInstance().GetXAudio2Engine()->CreateSourceVoice(
-			&m_pSourceVoice,
-			m_format,
-			0,							// tO
-			XAUDIO2_DEFAULT_FREQ_RATIO,	// ősb`ω
-			&m_voiceCallback,			// R[obN
-			nullptr,					// Tu~LVO{CX
-			nullptr);					// GtFNg`F[
-
-		if (FAILED(hr))
+	/**
+	 * [bool - LoadStream]
+	 * @brief	WAVt@CXg[ĐpɊJB
+	 * @param	[in] filePath WAVt@C̃pX
+	 * @return	true: , false: s
+	 */
+	bool SoundEffect::LoadStream(const std::string& filePath)
+	{
+		std::unique_ptr<FileStreamReader> pReader(new FileStreamReader());
+		if (!pReader->Open(filePath))
 		{
-			std::cerr << "Error: CreateSourceVoice failed. HRESULT = " << std::hex << hr << std::endl;
+			std::cerr << "Error: Failed to open WAV file for streaming: " << filePath << std::endl;
+			return false;
+		}
+		return OpenStream(std::move(pReader), filePath);
+	}
+
+	/**
+	 * [bool - LoadStream]
+	 * @brief	WAVt@C̓eXg[ĐpɊJB
+	 * @param	[in] pData WAVt@C̓e
+	 * @param	[in] size pData ̃oCg
+	 * @param	[in] filePath Op̃pX
+	 * @return	true: , false: s
+	 */
+	bool SoundEffect::LoadStream(const void* pData, size_t size, const std::string& filePath)
+	{
+		return OpenStream(std::unique_ptr<StreamReader>(new MemoryStreamReader(pData, size)), filePath);
+	}
+
+	bool SoundEffect::OpenStream(std::unique_ptr<StreamReader> pReader, const std::string& filePath)
+	{
+		std::unique_ptr<SoundStream> pStream(new SoundStream());
+		if (!pStream->Open(std::move(pReader), filePath)) return false;
+
+		// {CX̍쐬ɎgtH[}bg LoadData Ɠ new BYTE[] Ŏ (Release ŉ)
+		const std::vector<std::uint8_t>& format = pStream->GetInfo().format;
+		BYTE* pFormat = new BYTE[format.size()];
+		memcpy(pFormat, format.data(), format.size());
+		m_format = reinterpret_cast<WAVEFORMATEX*>(pFormat);
+
+		m_pStream = std::move(pStream);
+		m_filePath = filePath;
+		return true;
+	}
+
+	/**
+	 * [bool - StreamSink::Submit]
+	 * @brief	Xg[̃obt@{CX̃L[֐ς (ǂݍ݃Xbh)B
+	 */
+	bool SoundEffect::StreamSink::Submit(const std::uint8_t* pData, std::uint32_t bytes, bool isEnd)
+	{
+		AudioBuffer buffer;
+		buffer.pData = pData;
+		buffer.bytes = bytes;
+		buffer.isEnd = isEnd;
+		return pVoice->Submit(buffer);
+	}
+
+	/**
+	 * [bool - CreateVoice]
+	 * @brief	LoadData œǂݍ񂾃f[^\[X{CX쐬B
+	 * @return	true: , false: s
+	 */
+	bool SoundEffect::CreateVoice()
+	{
+		if (!m_format || (!m_audioData && !m_pStream)) return false;
+
+		// 1. {CX̍쐬
+		AudioBackend* pBackend = SoundEngine::GetInstance().GetBackend();
+		if (pBackend)
+		{
+			m_pVoice = pBackend->CreateVoice(*reinterpret_cast<const WaveFormat*>(m_format), &m_voiceCallback);
+		}
+		if (!m_pVoice)
+		{
+			std::cerr << "Error: CreateVoice failed: " << m_filePath << std::endl;
 			Release();
 			return false;
 		}
 
-		// 3. XAUDIO2_BUFFER̐ݒ
-		m_buffer.AudioBytes = m_audioBytes;
-		m_buffer.pAudioData = m_audioData;
-		m_buffer.Flags = XAUDIO2_END_OF_STREAM; // K{tO
+		// 2. Xg[Đ̏ꍇ́Aǂݍ݃Xbh֓o^ (obt@͍Đɐς)
+		if (m_pStream)
+		{
+			m_voiceCallback.pStream = m_pStream.get();
+			m_streamSink.pVoice = m_pVoice.get();
+			m_pStream->SetSink(&m_streamSink);
+			SoundEngine::GetInstance().GetStreamer().Add(m_pStream.get());
+
+			std::cout << "SoundEffect opened for streaming and SourceVoice created: " << m_filePath << std::endl;
+			return true;
+		}
 
-		std::cout << "SoundEffect loaded and SourceVoice created: " << filePath << std::endl;
+		// AudioBuffer̐ݒ
+		m_buffer.pData = m_audioData;
+		m_buffer.bytes = m_audioBytes;
+		m_buffer.isEnd = true; // K{tO
+
+		// 3. P SE p̃{CXv[ (ĐɍȂ悤AŗpӂĂ)
+		m_pOneShotPool = SoundEngine::GetInstance().GetVoicePool(m_format);
+
+		std::cout << "SoundEffect loaded and SourceVoice created: " << m_filePath << std::endl;
 		return true;
 	}
 
@@ -86,32 +209,52 @@ namespace Audio
 	 */
 	void SoundEffect::Play(UINT32 loopCount, float volume)
 	{
-		if (!m_pSourceVoice) return;
+		if (!m_pVoice) return;
 
 		// ɍĐ̏ꍇ͈x~ (SEpȑꍇ)
-		m_pSourceVoice->Stop(0);
-		m_pSourceVoice->FlushSourceBuffers();
+		if (m_pStream) m_pStream->Stop();
+		m_pVoice->Stop();
+
+		// Xg[Đ͐擪ǂݒ (ŏ̃obt@ς܂ꎟAo)
+		if (m_pStream)
+		{
+			m_pStream->Start(loopCount);
+			SetVolume(volume);
+			SoundEngine::GetInstance().GetStreamer().Wake();
+			m_pVoice->Start();
+			return;
+		}
 
 		// [vݒ
-		m_buffer.LoopCount = loopCount;
+		m_buffer.loopCount = loopCount;
 
 		// {[ݒ
 		SetVolume(volume);
 
-		// obt@L[ɓ
-		HRESULT hr = m_pSourceVoice->SubmitSourceBuffer(&m_buffer);
-		if (FAILED(hr))
-		{
-			std::cerr << "Error: SubmitSourceBuffer failed. HRESULT = " << std::hex << hr << std::endl;
-			return;
-		}
+		// obt@L[ɓ (s̃O̓{CXŏo)
+		if (!m_pVoice->Submit(m_buffer)) return;
 
 		// ĐJn
-		hr = m_pSourceVoice->Start(0);
-		if (FAILED(hr))
+		m_pVoice->Start();
+	}
+
+	/**
+	 * [bool - PlayOneShot]
+	 * @brief	{CXv[̋󂢂{CXŖ炷B
+	 * @param	[in] volume {[
+	 * @param	[in] pitch Đx̔{
+	 * @param	[in] priority 󂫂ɒDɂ
+	 * @return	false: 炳Ȃ
+	 */
+	bool SoundEffect::PlayOneShot(float volume, float pitch, int priority)
+	{
+		if (!m_pOneShotPool)
 		{
-			std::cerr << "Error: Start voice failed. HRESULT = " << std::hex << hr << std::endl;
+			// Xg[ĐEv[pӂłȂꍇ́Ag̃{CXŖ炷
+			Play(0, volume);
+			return m_pVoice != nullptr;
 		}
+		return m_pOneShotPool->Play(&m_buffer, volume, pitch, priority) != VoicePool::INVALID_VOICE;
 	}
 
 	/**
@@ -120,11 +263,9 @@ namespace Audio
 	 */
 	void SoundEffect::Stop()
 	{
-		if (m_pSourceVoice)
-		{
-			m_pSourceVoice->Stop(0);
-			m_pSourceVoice->FlushSourceBuffers();
-		}
+		// ɓǂݍ݂~߂ĂAς܂Ăobt@̂Ă
+		if (m_pStream) m_pStream->Stop();
+		if (m_pVoice) m_pVoice->Stop();
 	}
 
 	/**
@@ -134,12 +275,10 @@ namespace Audio
 	 */
 	bool SoundEffect::IsPlaying() const
 	{
-		if (!m_pSourceVoice) return false;
-
-		XAUDIO2_VOICE_STATE state;
-		m_pSourceVoice->GetState(&state);
+		if (!m_pVoice) return false;
+		if (m_pStream) return m_pStream->IsPlaying();
 
-		return state.BuffersQueued > 0;
+		return m_pVoice->IsActive();
 	}
 
 	/**
@@ -148,14 +287,25 @@ namespace Audio
 	 */
 	void SoundEffect::Release()
 	{
-		if (m_pSourceVoice)
+		// ǂݍ݃XbhgȂȂĂ{CXj
+		if (m_pStream) SoundEngine::GetInstance().GetStreamer().Remove(m_pStream.get());
+		// g`f[^OɁAv[̃{CXŖĂ镪~߂
+		if (m_pOneShotPool)
+		{
+			m_pOneShotPool->StopSample(&m_buffer);
+			m_pOneShotPool = nullptr;
+		}
+
+		if (m_pVoice)
 		{
 			// Đ~
 			Stop();
 			// {CX
-			m_pSourceVoice->DestroyVoice();
-			m_pSourceVoice = nullptr;
+			m_pVoice.reset();
 		}
+		m_voiceCallback.pStream = nullptr;
+		m_streamSink.pVoice = nullptr;
+		m_pStream.reset();
 
 		// SoundEngine::LoadWavFileŃq[vɊmۂꂽWAVf[^
 		if (m_format)
@@ -163,11 +313,11 @@ namespace Audio
 			delete[] reinterpret_cast<BYTE*>(m_format);
 			m_format = nullptr;
 		}
-		if (m_audioData)
+		if (m_audioData && m_isAudioDataOwned)
 		{
 			delete[] m_audioData;
-			m_audioData = nullptr;
 		}
+		m_audioData = nullptr;
 		m_audioBytes = 0;
 	}
 
@@ -177,11 +327,10 @@ namespace Audio
 	 */
 	void SoundEffect::SetVolume(float volume)
 	{
-		if (m_pSourceVoice)
+		if (m_pVoice)
 		{
-			// XAudio20.0fXAUDIO2_MAX_VOLUME_LEVEL (ʏ4.0f) ܂ł͈̔
 			// 1.0f{
-			m_pSourceVoice->SetVolume(volume);
+			m_pVoice->SetVolume(volume);
 		}
 	}
 }
\ No newline at end of file
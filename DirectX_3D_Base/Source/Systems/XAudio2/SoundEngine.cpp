@@ -21,6 +21,7 @@
 
 // ===== CN[h =====
 #include "Systems/XAudio2/SoundEngine.h"
+#include "Systems/XAudio2/XAudio2Backend.h"
 #include <fstream>
 #include <algorithm>
 #include <shlwapi.h>
@@ -90,6 +91,30 @@ namespace Audio
 		return S_OK;
 	}
 
+	/**
+	 * [bool - FindChunkInMemory]
+	 * @brief	RIFFf[^w肳ꂽ`NTwp[֐ (RIFFwb_[̒ォT)
+	 */
+	bool FindChunkInMemory(const BYTE* pData, size_t size, FOURCC fourcc, DWORD& dwChunkSize, size_t& chunkDataPosition)
+	{
+		size_t position = 12; // 'RIFF' + TCY + 'WAVE'
+		while (position + 8 <= size)
+		{
+			DWORD dwChunkType;
+			memcpy(&dwChunkType, pData + position, sizeof(DWORD));
+			memcpy(&dwChunkSize, pData + position + 4, sizeof(DWORD));
+			position += 8;
+			if (dwChunkType == fourcc)
+			{
+				chunkDataPosition = position;
+				return dwChunkSize <= size - position;
+			}
+			// TCỸ`N1oCg̋lߕ
+			position += static_cast<size_t>(dwChunkSize) + (dwChunkSize & 1);
+		}
+		return false;
+	}
+
 	/**
 	 * [bool - Initialize]
 	 * @brief	XAudio2GWƃ}X^[{CXB
@@ -138,6 +163,12 @@ namespace Audio
 			return false;
 		}
 
+		// 3. {CX̓}X^[{CX֏o͂
+		m_pBackend.reset(new XAudio2Backend(m_pXAudio2, m_pMasteringVoice));
+
+		// 4. Xg[Đ̓ǂݍ݃XbhJn
+		m_streamer.Start();
+
 		std::cout << "SoundEngine initialized successfully." << std::endl;
 		return true;
 	}
@@ -148,6 +179,12 @@ namespace Audio
 	 */
 	void SoundEngine::Terminate()
 	{
+		// {CXɓǂݍ݃Xbh~߂
+		m_streamer.Stop();
+		// P SE p̃{CX̓GWɔj
+		m_oneShotVoices.clear();
+		m_pBackend.reset();
+
 		if (m_pMasteringVoice)
 		{
 			// }X^[{CX́AXAudio2IuWFNgƎIɉ邽߁AIRelease͒ʏsv
@@ -167,6 +204,85 @@ namespace Audio
 		CoUninitialize();
 	}
 
+	/**
+	 * [VoicePool* - GetVoicePool]
+	 * @brief	tH[}bgvP SE p̃{CXv[擾 (΃{CX쐬)B
+	 */
+	VoicePool* SoundEngine::GetVoicePool(const WAVEFORMATEX* pFormat)
+	{
+		if (!m_pBackend || !pFormat) return nullptr;
+
+		// \[X{CX͍쐬̃tH[}bg̃f[^ĐłȂ߁Aǉ (ADPCM ̌WȂ) ܂ňv
+		const size_t formatSize = sizeof(WAVEFORMATEX) + (pFormat->wFormatTag == WAVE_FORMAT_PCM ? 0 : pFormat->cbSize);
+		const BYTE* pBytes = reinterpret_cast<const BYTE*>(pFormat);
+		for (auto& pVoices : m_oneShotVoices)
+		{
+			if (pVoices->format.size() == formatSize && memcmp(pVoices->format.data(), pBytes, formatSize) == 0)
+			{
+				return &pVoices->pool;
+			}
+		}
+
+		std::unique_ptr<OneShotVoices> pVoices(new OneShotVoices());
+		pVoices->format.assign(pBytes, pBytes + formatSize);
+		if (pFormat->wFormatTag == WAVE_FORMAT_PCM)
+		{
+			// PCM  cbSize ͖gpŁAslĂ邱Ƃ
+			reinterpret_cast<WAVEFORMATEX*>(pVoices->format.data())->cbSize = 0;
+		}
+		pVoices->voices.reserve(ONE_SHOT_VOICE_NUM);
+		for (int i = 0; i < ONE_SHOT_VOICE_NUM; ++i)
+		{
+			std::unique_ptr<AudioVoice> pVoice = m_pBackend->CreateVoice(
+				*reinterpret_cast<const WaveFormat*>(pVoices->format.data()), nullptr);
+			if (!pVoice)
+			{
+				std::cerr << "Error: CreateVoice for one-shot pool failed." << std::endl;
+				return nullptr;
+			}
+			pVoices->voices.push_back(std::move(pVoice));
+		}
+
+		m_oneShotVoices.push_back(std::move(pVoices));
+		return &m_oneShotVoices.back()->pool;
+	}
+
+	/**
+	 * [void - StopOneShots]
+	 * @brief	P SE p̃{CXSĎ~߂B
+	 */
+	void SoundEngine::StopOneShots()
+	{
+		for (auto& pVoices : m_oneShotVoices)
+		{
+			pVoices->pool.StopAll();
+		}
+	}
+
+	bool SoundEngine::OneShotVoices::IsVoiceActive(int voice) const
+	{
+		return voices[voice]->IsActive();
+	}
+
+	void SoundEngine::OneShotVoices::StopVoice(int voice)
+	{
+		voices[voice]->Stop();
+	}
+
+	bool SoundEngine::OneShotVoices::StartVoice(int voice, const void* pSample, float volume, float pitch)
+	{
+		AudioVoice* pVoice = voices[voice].get();
+
+		// P SE ̓[vȂ
+		AudioBuffer buffer = *static_cast<const AudioBuffer*>(pSample);
+		buffer.loopCount = 0;
+
+		pVoice->SetVolume(volume);
+		pVoice->SetPitch(pitch);
+		if (!pVoice->Submit(buffer)) return false;
+		return pVoice->Start();
+	}
+
 	/**
 	 * [bool - LoadWavFile]
 	 * @brief	WAVt@Cǂݍ݁ALoadWavData\̂Ɋi[B
@@ -223,8 +339,8 @@ namespace Audio
 			std::cerr << "Error: 'fmt ' chunk not found in " << filePath << std::endl;
 			return false;
 		}
-		// WAVEFORMATEX̃mۂƓǂݍ
-		wavData.format = reinterpret_cast<WAVEFORMATEX*>(new BYTE[dwChunkSize]);
+		// WAVEFORMATEX̃mۂƓǂݍ (cbSize ܂܂Ȃ fmt `Nł WAVEFORMATEX ̑傫͊mۂ)
+		wavData.format = reinterpret_cast<WAVEFORMATEX*>(new BYTE[(std::max)(static_cast<size_t>(dwChunkSize), sizeof(WAVEFORMATEX))]());
 		if (FAILED(ReadChunkData(hFile, wavData.format, dwChunkSize, dwChunkPosition)))
 		{
 			wavData.Release(); // smۂ
@@ -256,4 +372,59 @@ namespace Audio
 		std::cout << "WAV file loaded successfully: " << filePath << std::endl;
 		return true;
 	}
+
+	/**
+	 * [bool - LoadWavMemory]
+	 * @brief	WAVt@C̓e͂ALoadWavData\̂Ɋi[B
+	 *
+	 * @param	[in] pData WAVt@C̓e
+	 * @param	[in] size pData ̃oCg
+	 * @param	[in] filePath Op̃pX
+	 * @param	[out] wavData ǂݍ񂾃f[^󂯎\
+	 * @return	true: , false: s
+	 */
+	bool SoundEngine::LoadWavMemory(const void* pData, size_t size, const std::string& filePath, LoadWavData& wavData)
+	{
+		const BYTE* pBytes = static_cast<const BYTE*>(pData);
+
+		// RIFFwb_[WAVEtH[}bg̊mF
+		DWORD dwRiff = 0;
+		DWORD dwWaveType = 0;
+		if (size >= 12)
+		{
+			memcpy(&dwRiff, pBytes, sizeof(DWORD));
+			memcpy(&dwWaveType, pBytes + 8, sizeof(DWORD));
+		}
+		if (dwRiff != 'FFIR' || dwWaveType != 'EVAW')
+		{
+			std::cerr << "Error: File is not a valid WAVE file: " << filePath << std::endl;
+			return false;
+		}
+
+		// fmt`N (WAVEFORMATEX ̓{CX̍쐬Ɏg߁AmۂăRs[)
+		DWORD dwChunkSize;
+		size_t chunkPosition;
+		if (!FindChunkInMemory(pBytes, size, ' tmf', dwChunkSize, chunkPosition))
+		{
+			std::cerr << "Error: 'fmt ' chunk not found in " << filePath << std::endl;
+			return false;
+		}
+		// PCM  fmt `N cbSize ܂܂ȂƂ邽߁AWAVEFORMATEX ̑傫͊mۂ
+		const size_t formatBytes = (std::max)(static_cast<size_t>(dwChunkSize), sizeof(WAVEFORMATEX));
+		BYTE* pFormat = new BYTE[formatBytes]();
+		memcpy(pFormat, pBytes + chunkPosition, dwChunkSize);
+		wavData.format = reinterpret_cast<WAVEFORMATEX*>(pFormat);
+
+		// data`N (g`f[^̓Rs[ɎQƂ)
+		if (!FindChunkInMemory(pBytes, size, 'atad', dwChunkSize, chunkPosition))
+		{
+			wavData.Release();
+			std::cerr << "Error: 'data' chunk not found in " << filePath << std::endl;
+			return false;
+		}
+		wavData.audioData = const_cast<BYTE*>(pBytes + chunkPosition);
+		wavData.audioBytes = dwChunkSize;
+		wavData.isAudioDataOwned = false;
+		return true;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,312 @@
+﻿/*****************************************************************//**
+ * @file	SoundStream.cpp
+ * @brief	サウンドのストリーム読み込みの実装
+ *
+ * @details	バッファは渡した順に返るため、空きは「渡した数 - 返った数」だけで分かる。
+ *			返ったことは再生スレッドがアトミック変数を増やすだけで知らせ、読み込み中のロックを待たせない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：WAV のストリーム読み込みとバッファの使い回しを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/XAudio2/SoundStream.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+	// WAVE のフォーマットタグ (mmreg.h と同じ値)
+	const std::uint16_t FORMAT_PCM = 0x0001;
+	const std::uint16_t FORMAT_ADPCM = 0x0002;
+	const std::uint16_t FORMAT_IEEE_FLOAT = 0x0003;
+	const std::uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+	const size_t WAVEFORMATEX_SIZE = 18;
+	const size_t MAX_FORMAT_SIZE = 4096;
+
+	std::uint16_t ReadU16(const std::uint8_t* p) { return static_cast<std::uint16_t>(p[0] | (p[1] << 8)); }
+	std::uint32_t ReadU32(const std::uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<std::uint32_t>(p[3]) << 24); }
+}
+
+namespace Audio
+{
+	// ----------------------------------------
+	// 読み込み元
+	// ----------------------------------------
+	FileStreamReader::~FileStreamReader()
+	{
+		if (m_pFile) fclose(m_pFile);
+	}
+
+	bool FileStreamReader::Open(const std::string& filePath)
+	{
+		m_pFile = fopen(filePath.c_str(), "rb");
+		if (!m_pFile) return false;
+#ifdef _WIN32
+		_fseeki64(m_pFile, 0, SEEK_END);
+		m_size = static_cast<std::uint64_t>(_ftelli64(m_pFile));
+#else
+		fseeko(m_pFile, 0, SEEK_END);
+		m_size = static_cast<std::uint64_t>(ftello(m_pFile));
+#endif
+		return true;
+	}
+
+	size_t FileStreamReader::ReadAt(std::uint64_t offset, void* pOut, size_t bytes)
+	{
+		if (!m_pFile || offset >= m_size) return 0;
+#ifdef _WIN32
+		if (_fseeki64(m_pFile, static_cast<__int64>(offset), SEEK_SET) != 0) return 0;
+#else
+		if (fseeko(m_pFile, static_cast<off_t>(offset), SEEK_SET) != 0) return 0;
+#endif
+		return fread(pOut, 1, bytes, m_pFile);
+	}
+
+	size_t MemoryStreamReader::ReadAt(std::uint64_t offset, void* pOut, size_t bytes)
+	{
+		if (offset >= m_size) return 0;
+		bytes = static_cast<size_t>(std::min<std::uint64_t>(bytes, m_size - offset));
+		memcpy(pOut, m_pData + offset, bytes);
+		return bytes;
+	}
+
+	// ----------------------------------------
+	// WAV の解析
+	// ----------------------------------------
+	bool ParseWav(StreamReader& reader, WavInfo* pOut)
+	{
+		const std::uint64_t fileSize = reader.GetSize();
+		std::uint8_t header[12];
+		if (reader.ReadAt(0, header, sizeof(header)) != sizeof(header) ||
+			memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0)
+		{
+			return false;
+		}
+
+		bool isFormatFound = false;
+		bool isDataFound = false;
+		std::uint64_t position = 12;
+		while (position + 8 <= fileSize && !(isFormatFound && isDataFound))
+		{
+			std::uint8_t chunk[8];
+			if (reader.ReadAt(position, chunk, sizeof(chunk)) != sizeof(chunk)) return false;
+			const std::uint32_t chunkSize = ReadU32(chunk + 4);
+			position += 8;
+			if (memcmp(chunk, "fmt ", 4) == 0)
+			{
+				if (chunkSize < 16 || chunkSize > MAX_FORMAT_SIZE) return false;
+				pOut->format.assign(std::max<size_t>(chunkSize, WAVEFORMATEX_SIZE), 0);
+				if (reader.ReadAt(position, pOut->format.data(), chunkSize) != chunkSize) return false;
+				isFormatFound = true;
+			}
+			else if (memcmp(chunk, "data", 4) == 0)
+			{
+				pOut->dataOffset = position;
+				pOut->dataBytes = static_cast<std::uint32_t>(std::min<std::uint64_t>(chunkSize, fileSize - position));
+				isDataFound = true;
+			}
+			// 奇数サイズのチャンクは1バイトの詰め物が続く
+			position += static_cast<std::uint64_t>(chunkSize) + (chunkSize & 1);
+		}
+		if (!isFormatFound || !isDataFound) return false;
+
+		// WAVEFORMATEX : wFormatTag, nChannels, nSamplesPerSec, nAvgBytesPerSec, nBlockAlign, ...
+		const std::uint8_t* pFormat = pOut->format.data();
+		pOut->formatTag = ReadU16(pFormat);
+		pOut->avgBytesPerSec = ReadU32(pFormat + 8);
+		pOut->blockAlign = ReadU16(pFormat + 12);
+		if (pOut->formatTag != FORMAT_PCM && pOut->formatTag != FORMAT_ADPCM &&
+			pOut->formatTag != FORMAT_IEEE_FLOAT && pOut->formatTag != FORMAT_EXTENSIBLE)
+		{
+			return false;
+		}
+		if (pOut->blockAlign == 0 || pOut->avgBytesPerSec == 0) return false;
+
+		// 途中で切れたブロックは再生できないため捨てる
+		pOut->dataBytes -= pOut->dataBytes % pOut->blockAlign;
+		return pOut->dataBytes > 0;
+	}
+
+	// ----------------------------------------
+	// ストリーム
+	// ----------------------------------------
+	bool SoundStream::Open(std::unique_ptr<StreamReader> pReader, const std::string& filePath)
+	{
+		m_filePath = filePath;
+		if (!pReader || !ParseWav(*pReader, &m_info))
+		{
+			printf("[Error] SoundStream: '%s' is not a streamable WAV file\n", filePath.c_str());
+			return false;
+		}
+		m_pReader = std::move(pReader);
+
+		// バッファ1つ分はブロック境界に揃える (短いファイルでも1ブロックは入る)
+		const std::uint32_t bytes = static_cast<std::uint32_t>(static_cast<std::uint64_t>(m_info.avgBytesPerSec) * BUFFER_MS / 1000);
+		m_bufferBytes = std::max<std::uint32_t>(bytes - bytes % m_info.blockAlign, m_info.blockAlign);
+		m_buffers.assign(BUFFER_NUM, std::vector<std::uint8_t>(m_bufferBytes));
+		return true;
+	}
+
+	void SoundStream::Start(std::uint32_t loopCount)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_position = 0;
+		m_loopsLeft = loopCount;
+		m_isActive = true;
+		m_isEndSubmitted = false;
+	}
+
+	void SoundStream::Stop()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isActive = false;
+	}
+
+	bool SoundStream::IsPlaying() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_isActive && (!m_isEndSubmitted || m_returnedNum.load(std::memory_order_acquire) < m_submittedNum);
+	}
+
+	bool SoundStream::Service()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		bool isSubmitted = false;
+		while (m_isActive && !m_isEndSubmitted && m_pSink &&
+			m_submittedNum - m_returnedNum.load(std::memory_order_acquire) < static_cast<std::uint64_t>(BUFFER_NUM))
+		{
+			std::vector<std::uint8_t>& buffer = m_buffers[m_submittedNum % BUFFER_NUM];
+			bool isEnd = false;
+			const std::uint32_t bytes = Fill(buffer.data(), &isEnd);
+			if (bytes == 0)
+			{
+				// 直前のバッファでちょうど読み終えていた (渡すものが無いため、キューが空になれば終わる)
+				m_isEndSubmitted = true;
+				break;
+			}
+			if (!m_pSink->Submit(buffer.data(), bytes, isEnd))
+			{
+				printf("[Error] SoundStream: failed to submit a buffer of '%s'\n", m_filePath.c_str());
+				m_isActive = false;
+				break;
+			}
+			m_submittedNum++;
+			m_isEndSubmitted = isEnd;
+			isSubmitted = true;
+		}
+		return isSubmitted;
+	}
+
+	std::uint32_t SoundStream::Fill(std::uint8_t* pBuffer, bool* pIsEnd)
+	{
+		std::uint32_t filled = 0;
+		while (filled < m_bufferBytes)
+		{
+			if (m_position >= m_info.dataBytes)
+			{
+				if (m_loopsLeft == 0)
+				{
+					*pIsEnd = true;
+					break;
+				}
+				if (m_loopsLeft != LOOP_INFINITE) m_loopsLeft--;
+				m_position = 0;
+			}
+			// dataBytes・バッファの大きさともブロック境界に揃っているため、読む量も揃う
+			const std::uint32_t request = std::min(m_info.dataBytes - m_position, m_bufferBytes - filled);
+			const size_t read = m_pReader->ReadAt(m_info.dataOffset + m_position, pBuffer + filled, request);
+			filled += static_cast<std::uint32_t>(read);
+			m_position += static_cast<std::uint32_t>(read);
+			if (read != request)
+			{
+				printf("[Error] SoundStream: failed to read '%s'\n", m_filePath.c_str());
+				filled -= filled % m_info.blockAlign;
+				*pIsEnd = true;
+				break;
+			}
+		}
+		// ちょうどバッファの終わりで読み終えた場合も、このバッファを最後として渡す
+		if (m_position >= m_info.dataBytes && m_loopsLeft == 0) *pIsEnd = true;
+		return filled;
+	}
+
+	// ----------------------------------------
+	// 読み込みスレッド
+	// ----------------------------------------
+	void SoundStreamer::Start()
+	{
+		if (m_thread.joinable()) return;
+		m_isStopping = false;
+		m_thread = std::thread(&SoundStreamer::ThreadMain, this);
+	}
+
+	void SoundStreamer::Stop()
+	{
+		if (!m_thread.joinable()) return;
+		{
+			std::lock_guard<std::mutex> lock(m_wakeMutex);
+			m_isStopping = true;
+		}
+		m_wakeCv.notify_one();
+		m_thread.join();
+	}
+
+	void SoundStreamer::Add(SoundStream* pStream)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (std::find(m_streams.begin(), m_streams.end(), pStream) == m_streams.end())
+		{
+			m_streams.push_back(pStream);
+		}
+	}
+
+	void SoundStreamer::Remove(SoundStream* pStream)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_streams.erase(std::remove(m_streams.begin(), m_streams.end(), pStream), m_streams.end());
+	}
+
+	void SoundStreamer::Wake()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_wakeMutex);
+			m_isWoken = true;
+		}
+		m_wakeCv.notify_one();
+	}
+
+	void SoundStreamer::ThreadMain()
+	{
+		while (true)
+		{
+			bool isSubmitted = false;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for (SoundStream* pStream : m_streams)
+				{
+					isSubmitted |= pStream->Service();
+				}
+			}
+
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			if (m_isStopping) break;
+			if (!isSubmitted)
+			{
+				m_wakeCv.wait_for(lock, std::chrono::milliseconds(static_cast<int>(POLL_MS)), [this]() { return m_isWoken || m_isStopping; });
+			}
+			m_isWoken = false;
+		}
+	}
+}
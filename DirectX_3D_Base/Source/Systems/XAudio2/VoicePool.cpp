@@ -0,0 +1,111 @@
+﻿/*****************************************************************//**
+ * @file	VoicePool.cpp
+ * @brief	ボイスの割り当ての実装
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ボイスの割り当てと、優先度・古さによる奪い取りを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/XAudio2/VoicePool.h"
+
+namespace Audio
+{
+	VoicePool::VoicePool(Backend* pBackend, int voiceNum)
+		: m_pBackend(pBackend)
+		, m_slots(voiceNum)
+	{
+	}
+
+	int VoicePool::Play(const void* pSample, float volume, float pitch, int priority)
+	{
+		if (!pSample || m_slots.empty()) return INVALID_VOICE;
+
+		// 空きがあればそれを使い、無ければ優先度が最も低く、最も古いボイスを候補にする
+		int target = INVALID_VOICE;
+		int victim = 0;
+		for (int i = 0; i < GetVoiceNum(); ++i)
+		{
+			if (IsFree(i))
+			{
+				target = i;
+				break;
+			}
+			const Slot& slot = m_slots[i];
+			const Slot& worst = m_slots[victim];
+			if (slot.priority < worst.priority || (slot.priority == worst.priority && slot.order < worst.order))
+			{
+				victim = i;
+			}
+		}
+
+		if (target == INVALID_VOICE)
+		{
+			// 鳴っているどの音よりも優先度が低ければ鳴らさない
+			if (m_slots[victim].priority > priority)
+			{
+				m_stats.dropped++;
+				return INVALID_VOICE;
+			}
+			m_pBackend->StopVoice(victim);
+			m_slots[victim].pSample = nullptr;
+			m_stats.stolen++;
+			target = victim;
+		}
+
+		if (!m_pBackend->StartVoice(target, pSample, volume, pitch)) return INVALID_VOICE;
+
+		Slot& slot = m_slots[target];
+		slot.pSample = pSample;
+		slot.priority = priority;
+		slot.order = ++m_order;
+		m_stats.played++;
+		return target;
+	}
+
+	void VoicePool::StopSample(const void* pSample)
+	{
+		for (int i = 0; i < GetVoiceNum(); ++i)
+		{
+			if (m_slots[i].pSample != pSample) continue;
+			m_pBackend->StopVoice(i);
+			m_slots[i].pSample = nullptr;
+		}
+	}
+
+	void VoicePool::StopAll()
+	{
+		for (int i = 0; i < GetVoiceNum(); ++i)
+		{
+			if (!m_slots[i].pSample) continue;
+			m_pBackend->StopVoice(i);
+			m_slots[i].pSample = nullptr;
+		}
+	}
+
+	int VoicePool::GetActiveNum() const
+	{
+		int num = 0;
+		for (int i = 0; i < GetVoiceNum(); ++i)
+		{
+			if (!IsFree(i)) num++;
+		}
+		return num;
+	}
+
+	bool VoicePool::IsFree(int voice) const
+	{
+		Slot& slot = m_slots[voice];
+		if (slot.pSample && !m_pBackend->IsVoiceActive(voice)) slot.pSample = nullptr;
+		return slot.pSample == nullptr;
+	}
+}
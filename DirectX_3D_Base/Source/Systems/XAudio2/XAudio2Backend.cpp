@@ -0,0 +1,181 @@
+﻿/*****************************************************************//**
+ * @file	XAudio2Backend.cpp
+ * @brief	XAudio2 のソースボイスで鳴らす AudioBackend の実装
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：AudioVoice を XAudio2 のソースボイスで実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/XAudio2/XAudio2Backend.h"
+#include <iostream>
+
+namespace Audio
+{
+	static_assert(AUDIO_LOOP_INFINITE == XAUDIO2_LOOP_INFINITE, "AUDIO_LOOP_INFINITE must match XAUDIO2_LOOP_INFINITE");
+	static_assert(sizeof(WaveFormat) == sizeof(WAVEFORMATEX), "WaveFormat must match WAVEFORMATEX");
+
+	namespace
+	{
+		const UINT32 MAX_OUTPUT_CHANNELS = 8;
+
+		/**
+		 * @class	XAudio2Voice
+		 * @brief	1つのソースボイス
+		 */
+		class XAudio2Voice : public AudioVoice, private IXAudio2VoiceCallback
+		{
+		public:
+			XAudio2Voice(Callback* pCallback, UINT32 sourceChannels, UINT32 outputChannels)
+				: m_pCallback(pCallback)
+				, m_sourceChannels(sourceChannels)
+				, m_outputChannels(outputChannels)
+			{
+			}
+
+			~XAudio2Voice() override
+			{
+				if (m_pVoice)
+				{
+					m_pVoice->Stop(0);
+					m_pVoice->FlushSourceBuffers();
+					// DestroyVoice は再生スレッドのコールバックが終わるまで待つ
+					m_pVoice->DestroyVoice();
+				}
+			}
+
+			bool Create(IXAudio2* pXAudio2, const WaveFormat& format)
+			{
+				HRESULT hr = pXAudio2->CreateSourceVoice(
+					&m_pVoice,
+					reinterpret_cast<const WAVEFORMATEX*>(&format),
+					0,							// フラグ
+					XAUDIO2_DEFAULT_FREQ_RATIO,	// 最大ピッチ変化率 (AudioBackend::MAX_PITCH)
+					this,						// コールバック
+					nullptr,					// サブミキシングボイス
+					nullptr);					// エフェクトチェーン
+				if (FAILED(hr))
+				{
+					std::cerr << "Error: CreateSourceVoice failed. HRESULT = " << std::hex << hr << std::endl;
+					m_pVoice = nullptr;
+					return false;
+				}
+				return true;
+			}
+
+			bool Submit(const AudioBuffer& buffer) override
+			{
+				XAUDIO2_BUFFER xbuffer = { 0 };
+				xbuffer.AudioBytes = buffer.bytes;
+				xbuffer.pAudioData = buffer.pData;
+				xbuffer.LoopCount = buffer.loopCount;
+				xbuffer.Flags = buffer.isEnd ? XAUDIO2_END_OF_STREAM : 0;
+				HRESULT hr = m_pVoice->SubmitSourceBuffer(&xbuffer);
+				if (FAILED(hr))
+				{
+					std::cerr << "Error: SubmitSourceBuffer failed. HRESULT = " << std::hex << hr << std::endl;
+					return false;
+				}
+				return true;
+			}
+
+			bool Start() override
+			{
+				HRESULT hr = m_pVoice->Start(0);
+				if (FAILED(hr))
+				{
+					std::cerr << "Error: Start voice failed. HRESULT = " << std::hex << hr << std::endl;
+					return false;
+				}
+				return true;
+			}
+
+			void Stop() override
+			{
+				m_pVoice->Stop(0);
+				m_pVoice->FlushSourceBuffers();
+			}
+
+			bool IsActive() const override
+			{
+				XAUDIO2_VOICE_STATE state;
+				m_pVoice->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+				return state.BuffersQueued > 0;
+			}
+
+			void SetVolume(float volume) override
+			{
+				// XAudio2は0.0fからXAUDIO2_MAX_VOLUME_LEVEL までの範囲 (1.0fが等倍)
+				m_pVoice->SetVolume(volume);
+			}
+
+			void SetPan(float pan) override
+			{
+				// 既定の出力行列はそのままにし、パンを指定した時だけ左右 (出力の 0, 1 チャンネル) へ振り分ける
+				if (m_outputChannels < 2 || m_outputChannels > MAX_OUTPUT_CHANNELS || m_sourceChannels > 2) return;
+
+				float left, right;
+				CalcPanGains(pan, &left, &right);
+				float matrix[2 * MAX_OUTPUT_CHANNELS] = {};
+				// matrix[出力 * 入力のチャンネル数 + 入力]
+				matrix[0 * m_sourceChannels + 0] = left;
+				matrix[1 * m_sourceChannels + (m_sourceChannels - 1)] = right;
+				m_pVoice->SetOutputMatrix(nullptr, m_sourceChannels, m_outputChannels, matrix);
+			}
+
+			void SetPitch(float pitch) override
+			{
+				m_pVoice->SetFrequencyRatio(ClampPitch(pitch));
+			}
+
+		private:
+			// ----- IXAudio2VoiceCallback (再生スレッド) -----
+			STDMETHOD_(void, OnVoiceProcessingPassStart)(THIS_ UINT32 BytesRequired) {}
+			STDMETHOD_(void, OnVoiceProcessingPassEnd)(THIS) {}
+			STDMETHOD_(void, OnStreamEnd)(THIS) {}
+			STDMETHOD_(void, OnBufferStart)(THIS_ void* pBufferContext) {}
+			STDMETHOD_(void, OnBufferEnd)(THIS_ void* pBufferContext)
+			{
+				if (m_pCallback) m_pCallback->OnBufferEnd();
+			}
+			STDMETHOD_(void, OnLoopEnd)(THIS_ void* pBufferContext) {}
+			STDMETHOD_(void, OnVoiceError)(THIS_ void* pBufferContext, HRESULT Error)
+			{
+				std::cerr << "XAudio2 SoundEffect Voice Error: " << std::hex << Error << std::endl;
+			}
+
+		private:
+			IXAudio2SourceVoice* m_pVoice = nullptr;
+			Callback* m_pCallback;
+			UINT32 m_sourceChannels;
+			UINT32 m_outputChannels;
+		};
+	}
+
+	XAudio2Backend::XAudio2Backend(IXAudio2* pXAudio2, IXAudio2MasteringVoice* pMasteringVoice)
+		: m_pXAudio2(pXAudio2)
+	{
+		if (pMasteringVoice)
+		{
+			XAUDIO2_VOICE_DETAILS details;
+			pMasteringVoice->GetVoiceDetails(&details);
+			m_outputChannels = details.InputChannels;
+		}
+	}
+
+	std::unique_ptr<AudioVoice> XAudio2Backend::CreateVoice(const WaveFormat& format, AudioVoice::Callback* pCallback)
+	{
+		std::unique_ptr<XAudio2Voice> pVoice(new XAudio2Voice(pCallback, format.channels, m_outputChannels));
+		if (!m_pXAudio2 || !pVoice->Create(m_pXAudio2, format)) return nullptr;
+		return pVoice;
+	}
+}
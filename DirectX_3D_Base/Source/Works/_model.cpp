@@ -4,7 +4,7 @@
 #include <assimp/postprocess.h>
 
 
-void Model::MakeMesh(const void* ptr, float scale, Flip flip)
+void Model::MakeMesh(const void* ptr)
 {
 	const aiScene* pScene = reinterpret_cast<const aiScene*>(ptr);
 
@@ -24,8 +24,8 @@ void Model::MakeMesh(const void* ptr, float scale, Flip flip)
 			aiVector3D pos = pAssimpMesh->mVertices[v];
 			aiVector3D normal = pAssimpMesh->mNormals[v];
 
-			// WE@
-			vertex.pos = DirectX::XMFLOAT3(pos.x * scale, pos.y * scale, pos.z * scale);
+			// WE@ (XP[E] ApplyLoadTransform œKp)
+			vertex.pos = DirectX::XMFLOAT3(pos.x, pos.y, pos.z);
 			vertex.normal = DirectX::XMFLOAT3(normal.x, normal.y, normal.z);
 
 			// UV
@@ -50,18 +50,6 @@ void Model::MakeMesh(const void* ptr, float scale, Flip flip)
 				vertex.color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 			}
 
-			// ]
-			if (flip == XFlip)
-			{
-				vertex.pos.x *= -1.0f;
-				vertex.normal.x *= -1.0f;
-			}
-			else if (flip == ZFlip || flip == ZFlipUseAnime)
-			{
-				vertex.pos.z *= -1.0f;
-				vertex.normal.z *= -1.0f;
-			}
-
 			// EFCgƃCfbNX̏
 			for (int j = 0; j < 4; ++j) {
 				vertex.weight[j] = 0.0f;
@@ -77,32 +65,22 @@ void Model::MakeMesh(const void* ptr, float scale, Flip flip)
 			mesh.indices[f * 3 + 0] = face.mIndices[0];
 			mesh.indices[f * 3 + 1] = face.mIndices[1];
 			mesh.indices[f * 3 + 2] = face.mIndices[2];
-			if (flip != None) std::swap(mesh.indices[f * 3 + 1], mesh.indices[f * 3 + 2]);
 		}
 
 		// --- 3. }eAID ---
 		mesh.materialID = pAssimpMesh->mMaterialIndex;
+		mesh.pMesh = nullptr;	// GPUobt@ CreateResources ō쐬
 
 		// --- 4. EFCgvZidvj ---
 		MakeWeight(ptr, i);
 
-		// --- 5. GPUobt@̍쐬 ---
-		MeshBuffer::Description desc = {};
-		desc.pVtx = mesh.vertices.data();
-		desc.vtxSize = sizeof(Vertex);
-		desc.vtxCount = static_cast<UINT>(mesh.vertices.size());
-		desc.pIdx = mesh.indices.data();
-		desc.idxSize = sizeof(unsigned long);
-		desc.idxCount = static_cast<UINT>(mesh.indices.size());
-		desc.topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-		desc.isWrite = false;
-
-		mesh.pMesh = new MeshBuffer();
-		mesh.pMesh->Create(desc);
+		// --- 5. {[pbgւ̊蓖 (_̃{[ԍpbg̈ʒu֏) ---
+		AssignPalette(i);
 	}
 }
 
-void Model::MakeMaterial(const void* ptr, std::string directory)
+
+void Model::MakeMaterial(const void* ptr)
 {
 	// O
 	aiColor3D color(0.0f, 0.0f, 0.0f);
@@ -111,6 +89,7 @@ void Model::MakeMaterial(const void* ptr, std::string directory)
 
 	// }eA̍쐬
 	m_materials.resize(pScene->mNumMaterials);
+	m_texturePaths.assign(pScene->mNumMaterials, std::string());
 	for (unsigned int i = 0; i < m_materials.size(); ++i)
 	{
 		//--- e}eAp[^[̓ǂݎ
@@ -133,49 +112,11 @@ void Model::MakeMaterial(const void* ptr, std::string directory)
 		if (pScene->mMaterials[i]->Get(AI_MATKEY_SHININESS, shininess) == AI_SUCCESS)
 			m_materials[i].specular.w = shininess;
 
-		// eNX`ǂݍݏ
-		HRESULT hr;
+		// eNX`̃pXǂݍ (eNX`̍쐬 CreateResources ōs)
 		aiString path;
-
-		// eNX`̃pXǂݍ
 		m_materials[i].pTexture = nullptr;
-		if (pScene->mMaterials[i]->Get(AI_MATKEY_TEXTURE_DIFFUSE(0), path) != AI_SUCCESS) {
-			continue;
+		if (pScene->mMaterials[i]->Get(AI_MATKEY_TEXTURE_DIFFUSE(0), path) == AI_SUCCESS) {
+			m_texturePaths[i] = path.C_Str();
 		}
-
-		// eNX`̈m
-		m_materials[i].pTexture = new Texture;
-
-		// ̂܂ܓǂݍ
-		hr = m_materials[i].pTexture->Create(path.C_Str());
-		if (SUCCEEDED(hr)) { continue; }
-
-		// fBNgƘAĒT
-		hr = m_materials[i].pTexture->Create((directory + path.C_Str()).c_str());
-		if (SUCCEEDED(hr)) { continue; }
-
-		// fƓKwT
-		// pXt@Ĉݎ擾
-		std::string fullPath = path.C_Str();
-		std::string::iterator strIt = fullPath.begin();
-		while (strIt != fullPath.end()) {
-			if (*strIt == '/')
-				*strIt = '\\';
-			++strIt;
-		}
-		size_t find = fullPath.find_last_of("\\");
-		std::string fileName = fullPath;
-		if (find != std::string::npos)
-			fileName = fileName.substr(find + 1);
-		// eNX`̓Ǎ
-		hr = m_materials[i].pTexture->Create((directory + fileName).c_str());
-		if (SUCCEEDED(hr)) { continue; }
-
-		// eNX`Ȃ
-		delete m_materials[i].pTexture;
-		m_materials[i].pTexture = nullptr;
-#ifdef _DEBUG
-		m_errorStr += path.C_Str();
-#endif
 	}
 }
\ No newline at end of file
@@ -0,0 +1,394 @@
+﻿/*****************************************************************//**
+ * @file	main.cpp
+ * @brief	AssetPacker : Assets 以下のファイルを1つのアーカイブ (.pak) にまとめるツール
+ *
+ * @details	Assets 以下の全てのファイルをパスの索引で格納し、
+ *			Assets/CSV の各リストに登録されたアセットには、同じデータを指す ID の索引を追加する。
+ *			AtlasList.csv (AtlasPacker の出力) があれば、アトラスのページにもテクスチャの索引を追加する。
+ *			書き出したアーカイブはマウントし直し、全ての索引の内容を元ファイルと比較する。
+ *
+ *			使い方 : AssetPacker [プロジェクトのディレクトリ] [出力先 (既定 : Assets.pak)]
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：アーカイブの作成と確認を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	変換済みモデル (.mdl / .anm)・テクスチャ (.dds) は先に ModelCooker / TextureCooker で作成しておくこと
+ *			(アーカイブ内の変換済みバイナリは元ファイルの更新を確認せずに使われる)
+ *********************************************************************/
+
+// ===== インクルード =====
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+#include "Systems/AssetArchive.h"
+#include "Systems/TextureCookedFormat.h"
+#include "Utility/CSVLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <vector>
+
+using namespace Asset;
+using namespace Asset::Pack;
+
+namespace
+{
+	/// @brief 格納するファイル
+	struct PackFile
+	{
+		std::string path;		// プロジェクトからの相対パス (区切りは '/')
+		std::uint64_t offset;	// アーカイブ内の位置
+		std::uint64_t size;
+	};
+
+	/// @brief CSV のリストと索引の種類
+	struct AssetList
+	{
+		const char* csvPath;
+		EntryType type;
+	};
+	const char* ATLAS_LIST = "Assets/CSV/AtlasList.csv";
+	const AssetList ASSET_LISTS[] =
+	{
+		{ "Assets/CSV/ModelList.csv",		ENTRY_MODEL },
+		{ "Assets/CSV/TextureList.csv",		ENTRY_TEXTURE },
+		{ "Assets/CSV/SoundList.csv",		ENTRY_SOUND },
+		{ "Assets/CSV/AnimationList.csv",	ENTRY_ANIMATION },
+		{ "Assets/CSV/EffectList.csv",		ENTRY_EFFECT },
+	};
+
+	float ElapsedMs(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/// @brief ディレクトリ以下のファイルを再帰的に列挙する (relDir はプロジェクトからの相対パス)
+	void ListFiles(const std::string& root, const std::string& relDir, std::vector<std::string>& files)
+	{
+#ifdef _WIN32
+		WIN32_FIND_DATAA data;
+		HANDLE hFind = FindFirstFileA((root + relDir + "/*").c_str(), &data);
+		if (hFind == INVALID_HANDLE_VALUE) return;
+		do
+		{
+			const std::string name = data.cFileName;
+			if (name == "." || name == "..") continue;
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ListFiles(root, relDir + "/" + name, files);
+			else files.push_back(relDir + "/" + name);
+		} while (FindNextFileA(hFind, &data));
+		FindClose(hFind);
+#else
+		DIR* pDir = opendir((root + relDir).c_str());
+		if (!pDir) return;
+		while (dirent* pEntry = readdir(pDir))
+		{
+			const std::string name = pEntry->d_name;
+			if (name == "." || name == "..") continue;
+			struct stat st;
+			if (stat((root + relDir + "/" + name).c_str(), &st) != 0) continue;
+			if (S_ISDIR(st.st_mode)) ListFiles(root, relDir + "/" + name, files);
+			else if (S_ISREG(st.st_mode)) files.push_back(relDir + "/" + name);
+		}
+		closedir(pDir);
+#endif
+	}
+
+	/// @brief ファイル全体を読み込む
+	bool ReadFile(const std::string& path, std::vector<std::uint8_t>& out)
+	{
+		FILE* fp = fopen(path.c_str(), "rb");
+		if (!fp) return false;
+		fseek(fp, 0, SEEK_END);
+		const long size = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		out.resize(size > 0 ? static_cast<size_t>(size) : 0);
+		const bool isRead = out.empty() || fread(out.data(), 1, out.size(), fp) == out.size();
+		fclose(fp);
+		return size >= 0 && isRead;
+	}
+
+	/// @brief 画像の変換済みテクスチャ (.dds) が元画像から作り直す必要のないものか
+	bool IsCookedTextureCurrent(const std::string& root, const std::string& path)
+	{
+		const std::string cookedPath = root + TextureCooked::GetCookedPath(path);
+		std::uint8_t head[sizeof(TextureCooked::DDS_MAGIC) + sizeof(TextureCooked::Header)];
+		FILE* fp = fopen(cookedPath.c_str(), "rb");
+		if (!fp) return false;
+		const bool isRead = fread(head, sizeof(head), 1, fp) == 1;
+		fclose(fp);
+		TextureCooked::Header header;
+		TextureCooked::CookTag tag;
+		struct stat st;
+		return isRead && TextureCooked::ReadHeader(head, sizeof(head), &header, &tag) &&
+			stat((root + path).c_str(), &st) == 0 &&
+			tag.source.size == static_cast<std::uint64_t>(st.st_size) && tag.source.time == static_cast<std::int64_t>(st.st_mtime);
+	}
+
+	std::uint64_t AlignUp(std::uint64_t value, std::uint64_t align)
+	{
+		return (value + align - 1) / align * align;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string root = ".";
+	std::string output = "Assets.pak";
+	if (argc > 1) root = argv[1];
+	if (argc > 2) output = argv[2];
+	if (!root.empty() && root.back() != '/' && root.back() != '\\') root += '/';
+	const std::string outputPath = (output.find_first_of("/\\") == std::string::npos) ? root + output : output;
+	const auto startTime = std::chrono::steady_clock::now();
+
+	// 格納するファイル (パスの索引)
+	std::vector<std::string> paths;
+	ListFiles(root, "Assets", paths);
+	std::sort(paths.begin(), paths.end());
+
+	// 変換済みテクスチャ (.dds) が最新の画像は .dds だけを格納する
+	// (実行時は画像のパス・アセットIDのどちらで引いても .dds を読む)
+	std::map<std::string, std::string> cookedTextures;	// 正規化した元画像のパス → .dds のパス
+	for (const std::string& path : paths)
+	{
+		if (TextureCooked::GetCookedPath(path) != path && IsCookedTextureCurrent(root, path))
+		{
+			cookedTextures[NormalizePath(path)] = TextureCooked::GetCookedPath(path);
+		}
+	}
+
+	std::vector<PackFile> files;
+	std::map<std::string, size_t> fileIndex;	// 正規化したパス → files の番号
+	for (const std::string& path : paths)
+	{
+		const std::string normalized = NormalizePath(path);
+		if (cookedTextures.count(normalized)) continue;
+		if (fileIndex.count(normalized))
+		{
+			printf("[Warning] AssetPacker: '%s' differs only in case from another file, skipping\n", path.c_str());
+			continue;
+		}
+		fileIndex[normalized] = files.size();
+		files.push_back({ path, 0, 0 });
+	}
+
+	// 文字列 (正規化したパス)
+	std::vector<char> strings;
+	std::vector<std::uint32_t> pathOffsets(files.size());
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		const std::string normalized = NormalizePath(files[i].path);
+		pathOffsets[i] = static_cast<std::uint32_t>(strings.size());
+		strings.insert(strings.end(), normalized.begin(), normalized.end());
+		strings.push_back('\0');
+	}
+
+	// 索引 (データの位置は後で決める)
+	std::vector<EntryRecord> entries;
+	std::vector<size_t> entryFiles;	// 索引毎の files の番号
+	auto addEntry = [&entries, &entryFiles, &pathOffsets](AssetHash key, EntryType type, size_t fileNo)
+		{
+			EntryRecord entry = {};
+			entry.key = key;
+			entry.type = type;
+			entry.compression = COMPRESSION_NONE;
+			entry.path = pathOffsets[fileNo];
+			entries.push_back(entry);
+			entryFiles.push_back(fileNo);
+		};
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		addEntry(HashAssetID(strings.data() + pathOffsets[i]), ENTRY_FILE, i);
+	}
+
+	// CSV のアセット (同じファイルの索引と同じデータを指す)
+	int errorNum = 0;
+	size_t assetNum = 0;
+	size_t missingNum = 0;
+	auto addAsset = [&](const std::string& assetID, std::string path, EntryType type)
+		{
+			auto cookedIt = cookedTextures.find(NormalizePath(path));
+			if (type == ENTRY_TEXTURE && cookedIt != cookedTextures.end()) path = cookedIt->second;
+			auto fileIt = fileIndex.find(NormalizePath(path));
+			if (fileIt == fileIndex.end())
+			{
+				// 実行時も索引が無ければ元ファイルを探すため、ここでは知らせるだけにする
+				printf("[Warning] AssetPacker: '%s' (%s) not found, skipping\n", path.c_str(), assetID.c_str());
+				++missingNum;
+				return;
+			}
+			addEntry(HashAssetID(assetID), type, fileIt->second);
+			++assetNum;
+		};
+	try
+	{
+		for (const AssetList& list : ASSET_LISTS)
+		{
+			std::map<std::string, bool> found;
+			Utility::CSVLoader::Data data = Utility::CSVLoader::Load(root + list.csvPath);
+			for (size_t i = 1; i < data.size(); ++i)	// 1行目はヘッダー
+			{
+				if (data[i].size() < 3 || data[i][0].empty()) continue;
+				const std::string& assetID = data[i][0];
+				std::string path = data[i][2];
+				if (!path.empty() && path.back() == '\r') path.pop_back();
+				if (found.count(assetID))
+				{
+					printf("[Warning] AssetPacker: duplicate ID '%s' in %s, skipping\n", assetID.c_str(), list.csvPath);
+					continue;
+				}
+				found[assetID] = true;
+				addAsset(assetID, path, list.type);
+			}
+		}
+
+		// アトラスのページ (AtlasList.csv は AtlasPacker を実行した場合だけある。1ページに複数の行がある)
+		if (std::ifstream(root + ATLAS_LIST))
+		{
+			std::map<std::string, bool> found;
+			Utility::CSVLoader::Data data = Utility::CSVLoader::Load(root + ATLAS_LIST);
+			for (size_t i = 1; i < data.size(); ++i)	// 1行目はヘッダー
+			{
+				if (data[i].size() < 3 || data[i][1].empty() || found.count(data[i][1])) continue;
+				found[data[i][1]] = true;
+				addAsset(data[i][1], data[i][2], ENTRY_TEXTURE);
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		printf("[Error] %s\n", e.what());
+		return 1;
+	}
+
+	// 二分探索のため並べ替え、同じキーと種類が無いか確認する
+	std::vector<size_t> order(entries.size());
+	for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+	std::sort(order.begin(), order.end(), [&entries](size_t a, size_t b) { return entries[a] < entries[b]; });
+	for (size_t i = 1; i < order.size(); ++i)
+	{
+		const EntryRecord& prev = entries[order[i - 1]];
+		const EntryRecord& curr = entries[order[i]];
+		if (!(prev < curr))
+		{
+			printf("[Error] AssetPacker: hash collision between '%s' and '%s'\n",
+				strings.data() + prev.path, strings.data() + curr.path);
+			return 1;
+		}
+	}
+
+	// 配置 : ヘッダー → 索引 → 文字列 → データ (起動時に読む索引をファイルの先頭にまとめる)
+	ArchiveHeader header = {};
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.entryNum = static_cast<std::uint32_t>(entries.size());
+	header.stringsSize = static_cast<std::uint32_t>(strings.size());
+	header.indexOffset = AlignUp(sizeof(ArchiveHeader), alignof(EntryRecord));
+	header.stringsOffset = header.indexOffset + entries.size() * sizeof(EntryRecord);
+	std::uint64_t offset = AlignUp(header.stringsOffset + strings.size(), DATA_ALIGN);
+	for (PackFile& file : files)
+	{
+		struct stat st;
+		if (stat((root + file.path).c_str(), &st) != 0)
+		{
+			printf("[Error] AssetPacker: failed to stat '%s'\n", file.path.c_str());
+			return 1;
+		}
+		file.offset = offset;
+		file.size = static_cast<std::uint64_t>(st.st_size);
+		offset = AlignUp(offset + file.size, DATA_ALIGN);
+		header.dataSize += file.size;
+	}
+	std::vector<EntryRecord> sorted;
+	sorted.reserve(entries.size());
+	for (size_t no : order)
+	{
+		EntryRecord entry = entries[no];
+		entry.offset = files[entryFiles[no]].offset;
+		entry.size = files[entryFiles[no]].size;
+		entry.rawSize = entry.size;
+		sorted.push_back(entry);
+	}
+
+	// 書き出し
+	FILE* fp = fopen(outputPath.c_str(), "wb");
+	if (!fp)
+	{
+		printf("[Error] AssetPacker: failed to open '%s'\n", outputPath.c_str());
+		return 1;
+	}
+	auto writeAt = [fp](std::uint64_t position, const void* pData, size_t size)
+		{
+			static const char zero[DATA_ALIGN] = {};
+			long current = ftell(fp);
+			while (static_cast<std::uint64_t>(current) < position)	// 境界までの詰め物
+			{
+				const size_t pad = static_cast<size_t>(std::min<std::uint64_t>(position - current, sizeof(zero)));
+				fwrite(zero, 1, pad, fp);
+				current += static_cast<long>(pad);
+			}
+			return size == 0 || fwrite(pData, 1, size, fp) == size;
+		};
+	bool isWritten = writeAt(0, &header, sizeof(header)) &&
+		writeAt(header.indexOffset, sorted.data(), sorted.size() * sizeof(EntryRecord)) &&
+		writeAt(header.stringsOffset, strings.data(), strings.size());
+	std::vector<std::uint8_t> data;
+	for (const PackFile& file : files)
+	{
+		if (!isWritten) break;
+		if (!ReadFile(root + file.path, data) || data.size() != file.size)
+		{
+			printf("[Error] AssetPacker: failed to read '%s'\n", file.path.c_str());
+			isWritten = false;
+			break;
+		}
+		isWritten = writeAt(file.offset, data.data(), data.size());
+	}
+	isWritten = (fclose(fp) == 0) && isWritten;
+	if (!isWritten)
+	{
+		printf("[Error] AssetPacker: failed to write '%s'\n", outputPath.c_str());
+		return 1;
+	}
+	const float packMs = ElapsedMs(startTime);
+
+	// マウントし直して、全ての索引の内容を元ファイルと比較する
+	Asset::AssetArchive archive;
+	if (!archive.Mount(outputPath.c_str()))
+	{
+		printf("[Error] AssetPacker: '%s' failed verification (mount)\n", outputPath.c_str());
+		return 1;
+	}
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		const PackFile& file = files[entryFiles[i]];
+		const FileView view = (entries[i].type == ENTRY_FILE) ?
+			archive.FindFile(file.path) : archive.Find(entries[i].type, entries[i].key);
+		if (!view || !ReadFile(root + file.path, data) || view.size != data.size() ||
+			(view.size > 0 && memcmp(view.pData, data.data(), view.size) != 0))
+		{
+			printf("[Error] AssetPacker: '%s' failed verification\n", file.path.c_str());
+			++errorNum;
+		}
+	}
+
+	printf("[Info] AssetPacker: '%s' %zu files + %zu assets (%zu missing, %zu images replaced by .dds), %.1fMB (%.2fms)\n",
+		outputPath.c_str(), files.size(), assetNum, missingNum, cookedTextures.size(), archive.GetSize() / (1024.0 * 1024.0), packMs);
+	printf("[Info] AssetPacker finished with %d error(s)\n", errorNum);
+	return errorNum == 0 ? 0 : 1;
+}
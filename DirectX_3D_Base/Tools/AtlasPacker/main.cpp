@@ -0,0 +1,500 @@
+﻿/*****************************************************************//**
+ * @file	main.cpp
+ * @brief	AtlasPacker : UI のテクスチャをアトラス (数枚のページ) にまとめるツール
+ *
+ * @details	Assets/CSV/TextureList.csv のうち、ID が指定の接頭辞 (既定 : UI_ / BTN_ / ICO_ / STAR_) で始まり
+ *			縦横が --max-sprite 以下の画像を MaxRects (短辺優先) で詰め、Assets/Texture/Atlas/ui_atlas_N.png へ書き出す。
+ *			各画像の周囲には端の画素を引き伸ばした余白 (--padding) を付け、配置は 4 画素単位に揃える
+ *			(BC1 / BC3 のブロックが2つの画像にまたがらない)。
+ *			元の ID → ページ・矩形の対応は Assets/CSV/AtlasList.csv へ書き出し、実行時に AssetManager が読み込む。
+ *			書き出したページは読み戻して、全ての画像が元画像と一致することを確認する。
+ *
+ *			使い方 : AtlasPacker [プロジェクトのディレクトリ] [--page-size N] [--padding N] [--max-sprite N]
+ *			                     [--prefix UI_,BTN_,...] [--exclude ID,ID,...]
+ *			  --page-size  : ページの最大の縦横 (既定 : 4096)
+ *			  --padding    : 画像の周囲の余白 (既定 : 8。ミップマップは log2(padding) 段目まで隣の画像が混ざらない)
+ *			  --max-sprite : 縦横がこれを超える画像はまとめない (既定 : 1024)
+ *			  --prefix     : まとめる ID の接頭辞 (カンマ区切り)
+ *			  --exclude    : まとめない ID (カンマ区切り。UV を 0～1 の外まで使う画像など)
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：UI テクスチャのアトラス化と AtlasList.csv の書き出しを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	ページは通常の画像として Assets 以下に置くため、続けて TextureCooker を実行すれば .dds になる。
+ *			画像は回転させない (Sprite の UV は回転を表せない)。
+ *********************************************************************/
+
+// ===== インクルード =====
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+#include "../TextureCooker/CookerTexture.h"
+#include "Utility/CSVLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+using namespace TextureCooker;
+
+namespace
+{
+	const char* ATLAS_DIR = "Assets/Texture/Atlas";
+	const char* ATLAS_LIST = "Assets/CSV/AtlasList.csv";
+	const std::uint32_t CELL_ALIGN = 4;		// ブロック圧縮の単位
+	const std::uint32_t PAGE_ALIGN = 64;	// ページの縦横 (ミップマップの上位 6 段で画素の境界がずれない)
+
+	/// @brief オプション
+	struct Options
+	{
+		std::uint32_t pageSize = 4096;
+		std::uint32_t padding = 8;
+		std::uint32_t maxSprite = 1024;
+		std::vector<std::string> prefixes = { "UI_", "BTN_", "ICO_", "STAR_" };
+		std::vector<std::string> excludes;
+	};
+
+	struct Rect
+	{
+		std::uint32_t x = 0, y = 0, w = 0, h = 0;
+	};
+
+	/// @brief まとめる画像 (同じファイルを指す ID は1つにまとめる)
+	struct Sprite
+	{
+		std::string file;
+		std::vector<std::string> assetIDs;
+		Image image;
+		std::uint32_t page = 0;
+		Rect cell;		// 余白を含む配置 (4 画素単位)
+		Rect rect;		// 画像そのものの位置
+	};
+
+	/**
+	 * @class	MaxRectsPage
+	 * @brief	空き矩形の一覧を持ち、短辺の余りが最も小さい位置へ置く (Best Short Side Fit)
+	 */
+	class MaxRectsPage
+	{
+	public:
+		MaxRectsPage(std::uint32_t width, std::uint32_t height)
+		{
+			Rect all;
+			all.w = width;
+			all.h = height;
+			m_freeRects.push_back(all);
+		}
+
+		/// @brief 置ける位置を探す (見つからなければ false。score は小さいほど良い)
+		bool Find(std::uint32_t w, std::uint32_t h, Rect* pOut, std::uint64_t* pScore) const
+		{
+			bool isFound = false;
+			std::uint64_t best = ~0ull;
+			for (const Rect& free : m_freeRects)
+			{
+				if (free.w < w || free.h < h) continue;
+				const std::uint32_t shortSide = std::min(free.w - w, free.h - h);
+				const std::uint32_t longSide = std::max(free.w - w, free.h - h);
+				const std::uint64_t score = (static_cast<std::uint64_t>(shortSide) << 32) | longSide;
+				if (score < best)
+				{
+					best = score;
+					pOut->x = free.x;
+					pOut->y = free.y;
+					pOut->w = w;
+					pOut->h = h;
+					isFound = true;
+				}
+			}
+			*pScore = best;
+			return isFound;
+		}
+
+		/// @brief 置いた矩形と重なる空き矩形を分割し、他に含まれる空き矩形を取り除く
+		void Place(const Rect& used)
+		{
+			std::vector<Rect> next;
+			for (const Rect& free : m_freeRects)
+			{
+				if (used.x >= free.x + free.w || used.x + used.w <= free.x ||
+					used.y >= free.y + free.h || used.y + used.h <= free.y)
+				{
+					next.push_back(free);
+					continue;
+				}
+				if (used.x > free.x) next.push_back({ free.x, free.y, used.x - free.x, free.h });
+				if (used.x + used.w < free.x + free.w) next.push_back({ used.x + used.w, free.y, free.x + free.w - used.x - used.w, free.h });
+				if (used.y > free.y) next.push_back({ free.x, free.y, free.w, used.y - free.y });
+				if (used.y + used.h < free.y + free.h) next.push_back({ free.x, used.y + used.h, free.w, free.y + free.h - used.y - used.h });
+			}
+			m_freeRects.clear();
+			for (size_t i = 0; i < next.size(); ++i)
+			{
+				bool isContained = false;
+				for (size_t j = 0; j < next.size() && !isContained; ++j)
+				{
+					if (i == j) continue;
+					const Rect& a = next[i];
+					const Rect& b = next[j];
+					// 同じ矩形が2つある場合は後ろの方だけ残す
+					isContained = a.x >= b.x && a.y >= b.y && a.x + a.w <= b.x + b.w && a.y + a.h <= b.y + b.h &&
+						(a.x != b.x || a.y != b.y || a.w != b.w || a.h != b.h || i < j);
+				}
+				if (!isContained) m_freeRects.push_back(next[i]);
+			}
+			m_width = std::max(m_width, used.x + used.w);
+			m_height = std::max(m_height, used.y + used.h);
+		}
+
+		// 使った範囲 (ページはこの大きさまで切り詰める)
+		std::uint32_t GetUsedWidth() const { return m_width; }
+		std::uint32_t GetUsedHeight() const { return m_height; }
+
+	private:
+		std::vector<Rect> m_freeRects;
+		std::uint32_t m_width = 0;
+		std::uint32_t m_height = 0;
+	};
+
+	float ElapsedMs(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	std::uint32_t AlignUp(std::uint32_t value, std::uint32_t align)
+	{
+		return (value + align - 1) / align * align;
+	}
+
+	std::vector<std::string> SplitList(const char* text)
+	{
+		std::vector<std::string> out;
+		std::string item;
+		for (const char* p = text; ; ++p)
+		{
+			if (*p == ',' || *p == '\0')
+			{
+				if (!item.empty()) out.push_back(item);
+				item.clear();
+				if (*p == '\0') break;
+			}
+			else item += *p;
+		}
+		return out;
+	}
+
+	bool IsTarget(const std::string& assetID, const Options& options)
+	{
+		if (std::find(options.excludes.begin(), options.excludes.end(), assetID) != options.excludes.end()) return false;
+		for (const std::string& prefix : options.prefixes)
+		{
+			if (assetID.compare(0, prefix.size(), prefix) == 0) return true;
+		}
+		return false;
+	}
+
+	std::string GetPageFile(std::uint32_t page)
+	{
+		return std::string(ATLAS_DIR) + "/ui_atlas_" + std::to_string(page) + ".png";
+	}
+
+	std::string GetPageID(std::uint32_t page)
+	{
+		return "ATLAS_UI_" + std::to_string(page);
+	}
+
+	/// @brief 画像を余白を含めて貼り付ける (余白は端の画素を引き伸ばす)
+	void Blit(const Sprite& sprite, Image* pPage)
+	{
+		const Image& src = sprite.image;
+		for (std::uint32_t y = sprite.cell.y; y < sprite.cell.y + sprite.cell.h; ++y)
+		{
+			const std::int64_t sy = std::min<std::int64_t>(std::max<std::int64_t>(static_cast<std::int64_t>(y) - sprite.rect.y, 0), src.height - 1);
+			for (std::uint32_t x = sprite.cell.x; x < sprite.cell.x + sprite.cell.w; ++x)
+			{
+				const std::int64_t sx = std::min<std::int64_t>(std::max<std::int64_t>(static_cast<std::int64_t>(x) - sprite.rect.x, 0), src.width - 1);
+				std::memcpy(&pPage->pixels[(static_cast<std::size_t>(y) * pPage->width + x) * 4],
+					&src.pixels[(static_cast<std::size_t>(sy) * src.width + sx) * 4], 4);
+			}
+		}
+	}
+
+	/// @brief ページ上の画像が元画像と一致するか
+	bool IsSameRegion(const Image& page, const Sprite& sprite)
+	{
+		const Image& src = sprite.image;
+		for (std::uint32_t y = 0; y < src.height; ++y)
+		{
+			if (std::memcmp(&page.pixels[(static_cast<std::size_t>(sprite.rect.y + y) * page.width + sprite.rect.x) * 4],
+				&src.pixels[static_cast<std::size_t>(y) * src.width * 4], src.width * 4) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief	1ページ分の画像を、入る中で最も面積の小さい大きさで詰め直す
+	 * @details	最初の配置は空き矩形の角へ散らばるため、最後のページほど使わない領域が残る。
+	 *			縦横を PAGE_ALIGN 単位で変えて全て試す (1ページ分の画像は数十枚のため十分速い)。
+	 */
+	void ShrinkPage(std::vector<Sprite*>& pageSprites, std::uint32_t pageSize, std::uint32_t padding,
+		std::uint32_t* pWidth, std::uint32_t* pHeight)
+	{
+		std::uint64_t bestArea = static_cast<std::uint64_t>(*pWidth) * *pHeight;
+		std::vector<Rect> bestCells;
+		for (std::uint32_t h = PAGE_ALIGN; h <= pageSize; h += PAGE_ALIGN)
+		{
+			for (std::uint32_t w = PAGE_ALIGN; w <= pageSize; w += PAGE_ALIGN)
+			{
+				// 同じ面積なら正方形に近い方を選ぶ
+				const std::uint64_t area = static_cast<std::uint64_t>(w) * h;
+				if (area > bestArea || (area == bestArea && std::max(w, h) >= std::max(*pWidth, *pHeight))) continue;
+				MaxRectsPage page(w, h);
+				std::vector<Rect> cells;
+				for (const Sprite* pSprite : pageSprites)
+				{
+					Rect cell;
+					std::uint64_t score;
+					if (!page.Find(pSprite->cell.w, pSprite->cell.h, &cell, &score)) break;
+					page.Place(cell);
+					cells.push_back(cell);
+				}
+				if (cells.size() != pageSprites.size()) continue;
+				bestArea = area;
+				bestCells = cells;
+				*pWidth = w;
+				*pHeight = h;
+			}
+		}
+		for (size_t i = 0; i < bestCells.size(); ++i)
+		{
+			Sprite& sprite = *pageSprites[i];
+			sprite.cell = bestCells[i];
+			sprite.rect.x = sprite.cell.x + padding;
+			sprite.rect.y = sprite.cell.y + padding;
+		}
+	}
+
+	void MakeDirectory(const std::string& path)
+	{
+#ifdef _WIN32
+		_mkdir(path.c_str());
+#else
+		mkdir(path.c_str(), 0755);
+#endif
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string root = ".";
+	Options options;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--page-size") == 0 && i + 1 < argc) options.pageSize = static_cast<std::uint32_t>(atoi(argv[++i]));
+		else if (strcmp(argv[i], "--padding") == 0 && i + 1 < argc) options.padding = static_cast<std::uint32_t>(atoi(argv[++i]));
+		else if (strcmp(argv[i], "--max-sprite") == 0 && i + 1 < argc) options.maxSprite = static_cast<std::uint32_t>(atoi(argv[++i]));
+		else if (strcmp(argv[i], "--prefix") == 0 && i + 1 < argc) options.prefixes = SplitList(argv[++i]);
+		else if (strcmp(argv[i], "--exclude") == 0 && i + 1 < argc) options.excludes = SplitList(argv[++i]);
+		else root = argv[i];
+	}
+	if (!root.empty() && root.back() != '/' && root.back() != '\\') root += '/';
+	options.pageSize = std::max(AlignUp(options.pageSize, PAGE_ALIGN), PAGE_ALIGN);
+	const auto startTime = std::chrono::steady_clock::now();
+
+	// 対象の画像を集める (同じファイルを指す ID は同じ矩形を共有する)
+	std::vector<Sprite> sprites;
+	std::map<std::string, size_t> fileIndex;
+	std::map<std::string, bool> foundIDs;
+	int errorNum = 0;
+	try
+	{
+		Utility::CSVLoader::Data data = Utility::CSVLoader::Load(root + "Assets/CSV/TextureList.csv");
+		for (size_t i = 1; i < data.size(); ++i)	// 1行目はヘッダー
+		{
+			if (data[i].size() < 3 || data[i][0].empty()) continue;
+			const std::string& assetID = data[i][0];
+			std::string file = data[i][2];
+			if (!file.empty() && file.back() == '\r') file.pop_back();
+			if (!IsTarget(assetID, options) || foundIDs.count(assetID)) continue;
+			foundIDs[assetID] = true;
+
+			auto it = fileIndex.find(file);
+			if (it != fileIndex.end())
+			{
+				sprites[it->second].assetIDs.push_back(assetID);
+				continue;
+			}
+			Sprite sprite;
+			std::string error;
+			if (!LoadImageFile(root + file, &sprite.image, &error))
+			{
+				printf("[Warning] Atlas: '%s' (%s) skipped (%s)\n", file.c_str(), assetID.c_str(), error.c_str());
+				continue;
+			}
+			if (sprite.image.width > options.maxSprite || sprite.image.height > options.maxSprite)
+			{
+				continue;
+			}
+			sprite.file = file;
+			sprite.assetIDs.push_back(assetID);
+			fileIndex[file] = sprites.size();
+			sprites.push_back(std::move(sprite));
+		}
+	}
+	catch (const std::exception& e)
+	{
+		printf("[Error] %s\n", e.what());
+		return 1;
+	}
+
+	// 大きい順に、置ける中で最も余りの少ないページへ置く (どのページにも置けなければページを増やす)
+	std::vector<size_t> order(sprites.size());
+	for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&sprites](size_t a, size_t b)
+		{
+			const Image& ia = sprites[a].image;
+			const Image& ib = sprites[b].image;
+			return std::max(ia.width, ia.height) > std::max(ib.width, ib.height);
+		});
+	std::vector<MaxRectsPage> pages;
+	for (size_t no : order)
+	{
+		Sprite& sprite = sprites[no];
+		const std::uint32_t cellW = AlignUp(sprite.image.width + options.padding * 2, CELL_ALIGN);
+		const std::uint32_t cellH = AlignUp(sprite.image.height + options.padding * 2, CELL_ALIGN);
+		if (cellW > options.pageSize || cellH > options.pageSize)
+		{
+			printf("[Warning] Atlas: '%s' is larger than a page, skipped\n", sprite.file.c_str());
+			sprite.assetIDs.clear();
+			continue;
+		}
+		Rect best;
+		std::uint64_t bestScore = ~0ull;
+		size_t bestPage = pages.size();
+		for (size_t page = 0; page < pages.size(); ++page)
+		{
+			Rect cell;
+			std::uint64_t score;
+			if (pages[page].Find(cellW, cellH, &cell, &score) && score < bestScore)
+			{
+				best = cell;
+				bestScore = score;
+				bestPage = page;
+			}
+		}
+		if (bestPage == pages.size())
+		{
+			pages.emplace_back(options.pageSize, options.pageSize);
+			pages.back().Find(cellW, cellH, &best, &bestScore);
+		}
+		pages[bestPage].Place(best);
+		sprite.page = static_cast<std::uint32_t>(bestPage);
+		sprite.cell = best;
+		sprite.rect = { best.x + options.padding, best.y + options.padding, sprite.image.width, sprite.image.height };
+	}
+
+	// ページを書き出して読み戻す
+	MakeDirectory(root + ATLAS_DIR);
+	std::size_t spritePixels = 0, pagePixels = 0, separateBytes = 0;
+	std::vector<Image> pageImages(pages.size());
+	for (size_t page = 0; page < pages.size(); ++page)
+	{
+		Image& image = pageImages[page];
+		image.width = AlignUp(pages[page].GetUsedWidth(), PAGE_ALIGN);
+		image.height = AlignUp(pages[page].GetUsedHeight(), PAGE_ALIGN);
+		std::vector<Sprite*> pageSprites;	// 配置した順 (大きい順)
+		for (size_t no : order)
+		{
+			if (!sprites[no].assetIDs.empty() && sprites[no].page == page) pageSprites.push_back(&sprites[no]);
+		}
+		ShrinkPage(pageSprites, options.pageSize, options.padding, &image.width, &image.height);
+		image.pixels.assign(static_cast<std::size_t>(image.width) * image.height * 4, 0);
+		std::size_t used = 0;
+		std::uint32_t count = 0;
+		for (const Sprite& sprite : sprites)
+		{
+			if (sprite.assetIDs.empty() || sprite.page != page) continue;
+			Blit(sprite, &image);
+			used += static_cast<std::size_t>(sprite.rect.w) * sprite.rect.h;
+			++count;
+		}
+		spritePixels += used;
+		pagePixels += static_cast<std::size_t>(image.width) * image.height;
+
+		const std::string file = GetPageFile(static_cast<std::uint32_t>(page));
+		std::string error;
+		Image check;
+		if (!SavePNG(root + file, image, &error) || !LoadImageFile(root + file, &check, &error))
+		{
+			printf("[Error] Atlas: failed to write '%s' (%s)\n", file.c_str(), error.c_str());
+			return 1;
+		}
+		for (const Sprite& sprite : sprites)
+		{
+			if (!sprite.assetIDs.empty() && sprite.page == page && !IsSameRegion(check, sprite))
+			{
+				printf("[Error] Atlas: '%s' does not match '%s'\n", file.c_str(), sprite.file.c_str());
+				++errorNum;
+			}
+		}
+		printf("[Info] Atlas: '%s' %ux%u, %u sprites, %.1f%% used\n",
+			file.c_str(), image.width, image.height, count, 100.0 * used / (static_cast<double>(image.width) * image.height));
+	}
+
+	// 前回より減ったページを消す (変換済みの .dds も一緒に)
+	for (std::uint32_t page = static_cast<std::uint32_t>(pages.size()); ; ++page)
+	{
+		const std::string file = root + GetPageFile(page);
+		if (std::remove(file.c_str()) != 0) break;
+		std::remove(TextureCooked::GetCookedPath(file).c_str());
+	}
+
+	// 元の ID → ページ・矩形 (画素単位。UV は実行時に計算する)
+	std::string text = "AssetID,PageID,PageFile,X,Y,Width,Height,PageWidth,PageHeight\n";
+	size_t assetNum = 0;
+	for (const Sprite& sprite : sprites)
+	{
+		if (sprite.assetIDs.empty()) continue;
+		const Image& page = pageImages[sprite.page];
+		separateBytes += sprite.image.pixels.size();
+		for (const std::string& assetID : sprite.assetIDs)
+		{
+			char buffer[128];
+			snprintf(buffer, sizeof(buffer), ",%u,%u,%u,%u,%u,%u\n",
+				sprite.rect.x, sprite.rect.y, sprite.rect.w, sprite.rect.h, page.width, page.height);
+			text += assetID + "," + GetPageID(sprite.page) + "," + GetPageFile(sprite.page) + buffer;
+			++assetNum;
+		}
+	}
+	std::ofstream list(root + ATLAS_LIST, std::ios::binary | std::ios::trunc);
+	list << text;
+	if (!list.good())
+	{
+		printf("[Error] Atlas: failed to write '%s'\n", ATLAS_LIST);
+		return 1;
+	}
+
+	std::uint32_t mipSafeLevels = 0;
+	while ((2u << mipSafeLevels) <= options.padding) ++mipSafeLevels;
+	printf("[Info] AtlasPacker: %u IDs (%u images) -> %u pages, %.1f%% packing efficiency, %.1fMB -> %.1fMB (RGBA, no mips), mips clean up to level %u, in %.1fs\n",
+		static_cast<unsigned>(assetNum), static_cast<unsigned>(fileIndex.size()), static_cast<unsigned>(pages.size()),
+		pagePixels ? 100.0 * spritePixels / pagePixels : 0.0, separateBytes / 1048576.0, pagePixels * 4 / 1048576.0,
+		mipSafeLevels, ElapsedMs(startTime) / 1000.0f);
+	printf("[Info] AtlasPacker finished with %d error(s)\n", errorNum);
+	return errorNum == 0 ? 0 : 1;
+}
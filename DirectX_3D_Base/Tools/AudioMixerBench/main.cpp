@@ -0,0 +1,254 @@
+﻿/*****************************************************************//**
+ * @file	main.cpp
+ * @brief	AudioMixerBench : ソフトウェアミキサーで多数のボイスを混ぜる時間を計測するツール
+ *
+ * @details	フォーマットの異なる3種類の波形 (16bit ステレオ 44.1kHz・16bit モノラル 22.05kHz・float ステレオ 48kHz) を
+ *			ボイスごとにランダムなピッチ (0.8 - 1.2)・音量・パンで繰り返し鳴らし、48kHz のステレオへ混ぜる。
+ *			ボイス数ごとに、足し込みの命令 (Scalar / SSE / AVX) を切り替えて出力 1 フレームあたりの時間を表示し、
+ *			SIMD の出力が Scalar と一致するか (誤差の最大値) も確認する。
+ *			最後に、書き出しスレッドが実時間に合わせて NullAudioSink へ書き続けられるかを確認する。
+ *
+ *			使い方 : AudioMixerBench [--voices N ...] [--seconds S] [--wav 出力先.wav]
+ *			  --voices  混ぜるボイス数 (複数指定可。既定 : 64 256)
+ *			  --seconds 計測する出力の長さ (既定 : 10)
+ *			  --wav     最初のボイス数の出力を WAV ファイルへ書き出す
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ボイス数・命令ごとの計測と出力の比較を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/Audio/SoftwareMixer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Audio;
+
+namespace
+{
+	const std::uint32_t OUTPUT_RATE = 48000;
+	const double PI = 3.14159265358979323846;
+
+	/// @brief 鳴らす波形 (1秒分)
+	struct SourceSound
+	{
+		WaveFormat format;
+		std::vector<std::uint8_t> data;
+	};
+
+	WaveFormat MakeFormat(std::uint16_t formatTag, std::uint16_t channels, std::uint32_t sampleRate, std::uint16_t bitsPerSample)
+	{
+		WaveFormat format = {};
+		format.formatTag = formatTag;
+		format.channels = channels;
+		format.sampleRate = sampleRate;
+		format.blockAlign = static_cast<std::uint16_t>(channels * bitsPerSample / 8);
+		format.avgBytesPerSec = sampleRate * format.blockAlign;
+		format.bitsPerSample = bitsPerSample;
+		format.extraSize = 0;
+		return format;
+	}
+
+	// 倍音を含む音 (左右で周波数を少しずらす)
+	template<typename T>
+	SourceSound MakeSound(std::uint16_t formatTag, std::uint16_t channels, std::uint32_t sampleRate, double frequency, double scale)
+	{
+		SourceSound sound;
+		sound.format = MakeFormat(formatTag, channels, sampleRate, static_cast<std::uint16_t>(sizeof(T) * 8));
+		sound.data.resize(static_cast<size_t>(sampleRate) * sound.format.blockAlign);
+		T* pSamples = reinterpret_cast<T*>(sound.data.data());
+		for (std::uint32_t i = 0; i < sampleRate; ++i)
+		{
+			for (int ch = 0; ch < channels; ++ch)
+			{
+				const double phase = 2.0 * PI * frequency * (1.0 + ch * 0.01) * i / sampleRate;
+				const double value = 0.6 * std::sin(phase) + 0.2 * std::sin(phase * 3.0);
+				pSamples[i * channels + ch] = static_cast<T>(value * scale);
+			}
+		}
+		return sound;
+	}
+
+	/**
+	 * [void - SetupVoices]
+	 * @brief	ボイスを voiceNum 個作って鳴らす (同じ seed なら同じ組み合わせになる)
+	 */
+	void SetupVoices(SoftwareMixer& mixer, const std::vector<SourceSound>& sounds, int voiceNum, std::vector<std::unique_ptr<AudioVoice>>& voices)
+	{
+		std::mt19937 random(12345);
+		std::uniform_real_distribution<float> pitch(0.8f, 1.2f);
+		std::uniform_real_distribution<float> pan(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> volume(0.2f, 1.0f);
+
+		for (int i = 0; i < voiceNum; ++i)
+		{
+			const SourceSound& sound = sounds[i % sounds.size()];
+			std::unique_ptr<AudioVoice> pVoice = mixer.CreateVoice(sound.format, nullptr);
+			if (!pVoice) continue;
+
+			AudioBuffer buffer;
+			buffer.pData = sound.data.data();
+			buffer.bytes = static_cast<std::uint32_t>(sound.data.size());
+			buffer.loopCount = AUDIO_LOOP_INFINITE;
+			pVoice->Submit(buffer);
+			pVoice->SetPitch(pitch(random));
+			pVoice->SetPan(pan(random));
+			// 混ぜた結果が大きくなりすぎないよう、ボイス数で割る
+			pVoice->SetVolume(volume(random) * 2.0f / voiceNum);
+			pVoice->Start();
+			voices.push_back(std::move(pVoice));
+		}
+	}
+
+	const char* GetSimdName(SoftwareMixer::SimdLevel level)
+	{
+		switch (level)
+		{
+		case SoftwareMixer::SimdLevel::AVX:	return "AVX";
+		case SoftwareMixer::SimdLevel::SSE:	return "SSE";
+		default:							return "Scalar";
+		}
+	}
+
+	/// @brief 1回の計測結果
+	struct RunResult
+	{
+		double seconds = 0.0;
+		std::vector<float> output;
+	};
+
+	/**
+	 * [RunResult - Run]
+	 * @brief	frames フレームを BLOCK_FRAMES ずつ混ぜ、時間と出力を返す
+	 */
+	RunResult Run(const std::vector<SourceSound>& sounds, int voiceNum, SoftwareMixer::SimdLevel level, std::uint32_t frames)
+	{
+		SoftwareMixer mixer(OUTPUT_RATE);
+		mixer.SetSimdLevel(level);
+		std::vector<std::unique_ptr<AudioVoice>> voices;
+		SetupVoices(mixer, sounds, voiceNum, voices);
+
+		RunResult result;
+		result.output.resize(static_cast<size_t>(frames) * SoftwareMixer::CHANNEL_NUM);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (std::uint32_t offset = 0; offset < frames; offset += SoftwareMixer::BLOCK_FRAMES)
+		{
+			const std::uint32_t count = (std::min)(frames - offset, static_cast<std::uint32_t>(SoftwareMixer::BLOCK_FRAMES));
+			mixer.Mix(result.output.data() + static_cast<size_t>(offset) * SoftwareMixer::CHANNEL_NUM, count);
+		}
+		result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return result;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<int> voiceNums;
+	double seconds = 10.0;
+	std::string wavPath;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--voices") == 0)
+		{
+			while (i + 1 < argc && argv[i + 1][0] != '-') voiceNums.push_back(atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) seconds = atof(argv[++i]);
+		else if (strcmp(argv[i], "--wav") == 0 && i + 1 < argc) wavPath = argv[++i];
+		else
+		{
+			printf("Usage: AudioMixerBench [--voices N ...] [--seconds S] [--wav out.wav]\n");
+			return 1;
+		}
+	}
+	if (voiceNums.empty()) voiceNums = { 64, 256 };
+	const std::uint32_t frames = static_cast<std::uint32_t>((std::max)(seconds, 0.1) * OUTPUT_RATE);
+
+	std::vector<SourceSound> sounds;
+	sounds.push_back(MakeSound<std::int16_t>(WAVE_TAG_PCM, 2, 44100, 220.0, 32767.0));
+	sounds.push_back(MakeSound<std::int16_t>(WAVE_TAG_PCM, 1, 22050, 330.0, 32767.0));
+	sounds.push_back(MakeSound<float>(WAVE_TAG_IEEE_FLOAT, 2, 48000, 440.0, 1.0));
+
+	const SoftwareMixer::SimdLevel supported = SoftwareMixer::GetSupportedSimdLevel();
+	printf("[Info] output %u Hz stereo, %.1f s per run, CPU supports up to %s\n", OUTPUT_RATE, frames / static_cast<double>(OUTPUT_RATE), GetSimdName(supported));
+
+	bool isMatched = true;
+	for (size_t n = 0; n < voiceNums.size(); ++n)
+	{
+		const int voiceNum = voiceNums[n];
+		RunResult scalar;
+		for (int level = 0; level <= static_cast<int>(supported); ++level)
+		{
+			const SoftwareMixer::SimdLevel simd = static_cast<SoftwareMixer::SimdLevel>(level);
+			RunResult result = Run(sounds, voiceNum, simd, frames);
+
+			// Scalar と同じ順で足しているため、誤差は出ないはず
+			float maxDiff = 0.0f;
+			if (simd == SoftwareMixer::SimdLevel::Scalar)
+			{
+				scalar = result;
+			}
+			else
+			{
+				for (size_t i = 0; i < result.output.size(); ++i)
+				{
+					maxDiff = (std::max)(maxDiff, std::fabs(result.output[i] - scalar.output[i]));
+				}
+				if (maxDiff > 1e-6f) isMatched = false;
+			}
+
+			const double nsPerFrame = result.seconds * 1e9 / frames;
+			printf("[Info] %4d voices  %-6s : %8.1f ns/frame  %6.2f ns/frame/voice  x%.0f realtime  max diff %g\n",
+				voiceNum, GetSimdName(simd), nsPerFrame, nsPerFrame / voiceNum,
+				(frames / static_cast<double>(OUTPUT_RATE)) / result.seconds, maxDiff);
+		}
+
+		if (n == 0 && !wavPath.empty())
+		{
+			WavFileAudioSink sink;
+			if (sink.Open(wavPath, OUTPUT_RATE, SoftwareMixer::CHANNEL_NUM))
+			{
+				sink.Write(scalar.output.data(), frames);
+				sink.Close();
+				printf("[Info] wrote %s\n", wavPath.c_str());
+			}
+		}
+	}
+
+	// 書き出しスレッドを実時間で 0.5 秒動かし、遅れずに書けるか確認する
+	{
+		SoftwareMixer mixer(OUTPUT_RATE);
+		std::vector<std::unique_ptr<AudioVoice>> voices;
+		SetupVoices(mixer, sounds, voiceNums.back(), voices);
+		NullAudioSink sink;
+		mixer.StartOutput(&sink, true);
+		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		mixer.StopOutput();
+		printf("[Info] realtime output (%d voices): %llu frames in 0.5 s (expected about %u)\n",
+			voiceNums.back(), static_cast<unsigned long long>(sink.GetFrames()), OUTPUT_RATE / 2);
+	}
+
+	if (!isMatched)
+	{
+		printf("[Error] SIMD output differs from scalar output\n");
+		return 1;
+	}
+	return 0;
+}
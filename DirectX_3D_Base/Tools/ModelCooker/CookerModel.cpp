@@ -0,0 +1,58 @@
+﻿/*****************************************************************//**
+ * @file	CookerModel.cpp
+ * @brief	変換ツール用の Model の生成・破棄
+ *
+ * @details	ModelCooker は Direct3D を使用しないため、シェーダー・GPU リソースを扱う
+ *			Model.cpp の代わりにこのファイルをリンクする。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：変換ツール用のコンストラクタ・デストラクタ・Resetを実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/Model.h"
+
+std::uint64_t	Model::m_paletteRevision = 0;
+#ifdef _DEBUG
+thread_local std::string	Model::m_errorStr = "";
+#endif
+
+Model::Model()
+	: m_loadScale(1.0f)
+	, m_loadFlip(None)
+	, m_isCooked(false)
+	, m_loadDataMs(0.0f)
+	, m_bufferBytes(0)
+	, m_bindPaletteRevision(0)
+	, m_boundsCenter(0.0f, 0.0f, 0.0f)
+	, m_boundsRadius(0.0f)
+	, m_pVS(nullptr)
+	, m_pPS(nullptr)
+{
+}
+
+Model::~Model()
+{
+	Reset();
+}
+
+void Model::Reset()
+{
+	// GPU リソースは作成しないため、データを破棄するだけでよい
+	m_meshes.clear();
+	m_materials.clear();
+	m_texturePaths.clear();
+	m_palettes.clear();
+	m_paletteBones.clear();
+	m_bindPalette.clear();
+	m_bindPaletteRevision = 0;
+}
@@ -0,0 +1,201 @@
+﻿/*****************************************************************//**
+ * @file	main.cpp
+ * @brief	ModelCooker : FBX を変換済みバイナリ (.mdl / .anm) へ変換するツール
+ *
+ * @details	Assets/CSV/ModelList.csv と AnimationList.csv に登録されたファイルを
+ *			assimp で読み込み、元ファイルと同じ場所へ変換済みバイナリを書き出す。
+ *			書き出したファイルは読み戻して内容を確認する。
+ *
+ *			使い方 : ModelCooker [プロジェクトのディレクトリ] [--force]
+ *			  --force : 元ファイルが更新されていなくても変換し直す
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ModelList / AnimationList の一括変換を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	アニメーションは Model の既定の再サンプリングレート・許容誤差で圧縮する
+ *			(ゲーム側で設定を変えた場合、そのクリップは実行時に FBX から読み込まれる)
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Systems/Model.h"
+#include "Utility/CSVLoader.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <set>
+
+namespace
+{
+	/// @brief 変換済みバイナリのヘッダーに記録された元ファイルの情報が最新か
+	template<class Header>
+	bool IsCookedUpToDate(const std::string& cookedPath, const ModelCooked::SourceStamp& source)
+	{
+		Header header;
+		FILE* fp = fopen(cookedPath.c_str(), "rb");
+		if (!fp) return false;
+		const bool isRead = fread(&header, sizeof(header), 1, fp) == 1;
+		fclose(fp);
+		return isRead && header.version == ModelCooked::VERSION &&
+			header.source.size == source.size && header.source.time == source.time;
+	}
+
+	/// @brief CSV からファイルパスの一覧を取得する (同じファイルは一度だけ)
+	std::vector<std::string> LoadFileList(const std::string& csvPath)
+	{
+		std::vector<std::string> files;
+		std::set<std::string> found;
+		Utility::CSVLoader::Data data = Utility::CSVLoader::Load(csvPath);
+		for (size_t i = 1; i < data.size(); ++i)	// 1行目はヘッダー
+		{
+			if (data[i].size() < 3 || data[i][2].empty()) continue;
+			std::string path = data[i][2];
+			if (!path.empty() && path.back() == '\r') path.pop_back();
+			if (found.insert(path).second) files.push_back(path);
+		}
+		return files;
+	}
+
+	float ElapsedMs(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/// @brief モデルを変換する (成功・スキップ時は true)
+	bool CookModel(const std::string& source, bool isForce)
+	{
+		ModelCooked::SourceStamp stamp;
+		if (!ModelCooked::GetSourceStamp(source.c_str(), &stamp))
+		{
+			printf("[Error] Model: '%s' not found\n", source.c_str());
+			return false;
+		}
+		const std::string cooked = ModelCooked::GetCookedPath(source, false);
+		if (!isForce && IsCookedUpToDate<ModelCooked::ModelHeader>(cooked, stamp))
+		{
+			printf("[Info] Model: '%s' is up to date\n", cooked.c_str());
+			return true;
+		}
+
+		// 読み込み・書き出し
+		const auto importStart = std::chrono::steady_clock::now();
+		Model model;
+		if (!model.Import(source.c_str()))
+		{
+			printf("[Error] Model: failed to import '%s'\n", source.c_str());
+			return false;
+		}
+		const float importMs = ElapsedMs(importStart);
+		if (!model.SaveCooked(cooked.c_str(), stamp))
+		{
+			printf("[Error] Model: failed to write '%s'\n", cooked.c_str());
+			return false;
+		}
+
+		// 読み戻して確認
+		const auto loadStart = std::chrono::steady_clock::now();
+		Model check;
+		if (!check.LoadCooked(cooked.c_str(), source.c_str()) ||
+			check.GetMeshNum() != model.GetMeshNum() || check.GetNodeNum() != model.GetNodeNum() ||
+			check.GetMaterialNum() != model.GetMaterialNum() || check.GetPaletteSize() != model.GetPaletteSize())
+		{
+			printf("[Error] Model: '%s' failed verification\n", cooked.c_str());
+			return false;
+		}
+		const float loadMs = ElapsedMs(loadStart);
+
+		printf("[Info] Model: '%s' -> '%s' (%u meshes, %u nodes, FBX %.2fms / cooked %.2fms)\n",
+			source.c_str(), cooked.c_str(), model.GetMeshNum(), model.GetNodeNum(), importMs, loadMs);
+		return true;
+	}
+
+	/// @brief アニメーションを変換する (成功・スキップ時は true)
+	bool CookAnimation(const std::string& source, bool isForce)
+	{
+		ModelCooked::SourceStamp stamp;
+		if (!ModelCooked::GetSourceStamp(source.c_str(), &stamp))
+		{
+			printf("[Error] Animation: '%s' not found\n", source.c_str());
+			return false;
+		}
+		const std::string cooked = ModelCooked::GetCookedPath(source, true);
+		if (!isForce && IsCookedUpToDate<ModelCooked::AnimeHeader>(cooked, stamp))
+		{
+			printf("[Info] Animation: '%s' is up to date\n", cooked.c_str());
+			return true;
+		}
+
+		// 読み込み・書き出し (ノードが無いため全チャンネルが未関連付けのまま保存される)
+		const auto importStart = std::chrono::steady_clock::now();
+		Model model;
+		Model::AnimeNo no = model.ImportAnimation(source.c_str());
+		if (no == Model::ANIME_NONE)
+		{
+			printf("[Error] Animation: failed to import '%s'\n", source.c_str());
+			return false;
+		}
+		const float importMs = ElapsedMs(importStart);
+		if (!model.SaveCookedAnimation(cooked.c_str(), no, stamp))
+		{
+			printf("[Error] Animation: failed to write '%s'\n", cooked.c_str());
+			return false;
+		}
+
+		// 読み戻して確認
+		const auto loadStart = std::chrono::steady_clock::now();
+		Model check;
+		Model::AnimeNo checkNo = check.LoadCookedAnimation(cooked.c_str(), source.c_str());
+		const Model::Animation* pAnime = model.GetAnimation(no);
+		const Model::Animation* pCheck = check.GetAnimation(checkNo);
+		if (!pCheck || pCheck->channels.size() != pAnime->channels.size() || pCheck->packedBytes != pAnime->packedBytes)
+		{
+			printf("[Error] Animation: '%s' failed verification\n", cooked.c_str());
+			return false;
+		}
+		const float loadMs = ElapsedMs(loadStart);
+
+		printf("[Info] Animation: '%s' -> '%s' (%u channels, %.1fKB, FBX %.2fms / cooked %.2fms)\n",
+			source.c_str(), cooked.c_str(), static_cast<unsigned>(pAnime->channels.size()),
+			pAnime->packedBytes / 1024.0f, importMs, loadMs);
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string root = ".";
+	bool isForce = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--force") == 0) isForce = true;
+		else root = argv[i];
+	}
+	if (!root.empty() && root.back() != '/' && root.back() != '\\') root += '/';
+
+	int errorNum = 0;
+	try
+	{
+		for (const std::string& file : LoadFileList(root + "Assets/CSV/ModelList.csv"))
+		{
+			if (!CookModel(root + file, isForce)) ++errorNum;
+		}
+		for (const std::string& file : LoadFileList(root + "Assets/CSV/AnimationList.csv"))
+		{
+			if (!CookAnimation(root + file, isForce)) ++errorNum;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		printf("[Error] %s\n", e.what());
+		return 1;
+	}
+
+	printf("[Info] ModelCooker finished with %d error(s)\n", errorNum);
+	return errorNum == 0 ? 0 : 1;
+}
@@ -0,0 +1,803 @@
+﻿/*****************************************************************//**
+ * @file	CookerTexture.cpp
+ * @brief	TextureCooker の画像処理 (読み込み・ミップマップ生成・ブロック圧縮・.dds 書き出し)
+ *
+ * @details	BC1 の色ブロックは主成分の軸上の両端を初期値とし、最小二乗法で端点を数回詰める。
+ *			BC3 のアルファブロックは 8 段階 / 6 段階 (+0, 255) の両方を試して誤差の小さい方を使う。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ミップマップ生成 (ボックス / Kaiser) と BC1 / BC3 圧縮を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "CookerTexture.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <png.h>
+#ifdef TEXTURE_COOKER_JPEG
+#include <jpeglib.h>
+#endif
+
+using namespace TextureCooked;
+using namespace TextureCooker;
+
+namespace
+{
+	const float KAISER_RADIUS = 3.0f;	// 縮小後の画素単位の半径
+	const float KAISER_ALPHA = 4.0f;
+	const int SRGB_TABLE_SIZE = 4096;
+
+	//--- 色空間の変換
+	struct ColorTable
+	{
+		float toLinear[256];
+		std::uint8_t toSRGB[SRGB_TABLE_SIZE + 1];
+
+		ColorTable()
+		{
+			for (int i = 0; i < 256; ++i)
+			{
+				const float c = i / 255.0f;
+				toLinear[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+			for (int i = 0; i <= SRGB_TABLE_SIZE; ++i)
+			{
+				const float c = static_cast<float>(i) / SRGB_TABLE_SIZE;
+				const float s = (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+				toSRGB[i] = static_cast<std::uint8_t>(std::min(255.0f, s * 255.0f + 0.5f));
+			}
+		}
+	};
+	const ColorTable& GetColorTable()
+	{
+		static const ColorTable table;
+		return table;
+	}
+
+	std::uint8_t ToUnorm8(float value)
+	{
+		return static_cast<std::uint8_t>(std::min(255.0f, std::max(0.0f, value * 255.0f + 0.5f)));
+	}
+
+	//--- 縮小フィルター
+	struct Tap
+	{
+		std::uint32_t index;
+		float weight;
+	};
+
+	float Sinc(float x)
+	{
+		if (std::fabs(x) < 1e-5f) return 1.0f;
+		const float px = 3.14159265f * x;
+		return std::sin(px) / px;
+	}
+
+	/// @brief 第1種変形ベッセル関数 I0 (級数展開)
+	float BesselI0(float x)
+	{
+		float sum = 1.0f, term = 1.0f;
+		const float q = x * x * 0.25f;
+		for (int k = 1; k < 32; ++k)
+		{
+			term *= q / static_cast<float>(k * k);
+			sum += term;
+			if (term < sum * 1e-8f) break;
+		}
+		return sum;
+	}
+
+	float Kaiser(float t)
+	{
+		if (std::fabs(t) >= 1.0f) return 0.0f;
+		return BesselI0(KAISER_ALPHA * std::sqrt(1.0f - t * t)) / BesselI0(KAISER_ALPHA);
+	}
+
+	/// @brief 縮小後の各画素が参照する元画像の画素と重み (重みの合計は 1)
+	std::vector<std::vector<Tap>> MakeTaps(std::uint32_t srcSize, std::uint32_t dstSize, Filter filter)
+	{
+		std::vector<std::vector<Tap>> taps(dstSize);
+		const float scale = static_cast<float>(srcSize) / dstSize;
+		for (std::uint32_t i = 0; i < dstSize; ++i)
+		{
+			std::vector<Tap>& list = taps[i];
+			if (filter == FILTER_BOX)
+			{
+				// 縮小後の画素が覆う範囲と重なる面積
+				const float lo = i * scale, hi = (i + 1) * scale;
+				for (std::uint32_t j = static_cast<std::uint32_t>(lo); j < srcSize && j < hi; ++j)
+				{
+					const float w = std::min(hi, j + 1.0f) - std::max(lo, static_cast<float>(j));
+					if (w > 0.0f) list.push_back({ j, w });
+				}
+			}
+			else
+			{
+				const float center = (i + 0.5f) * scale;
+				const float support = KAISER_RADIUS * scale;
+				const int first = static_cast<int>(std::floor(center - support));
+				const int last = static_cast<int>(std::ceil(center + support));
+				for (int j = first; j <= last; ++j)
+				{
+					const float x = (j + 0.5f - center) / scale;
+					const float w = Sinc(x) * Kaiser(x / KAISER_RADIUS);
+					if (w == 0.0f) continue;
+					// 端は端の画素を繰り返す
+					const std::uint32_t index = static_cast<std::uint32_t>(std::min(std::max(j, 0), static_cast<int>(srcSize) - 1));
+					list.push_back({ index, w });
+				}
+			}
+			float sum = 0.0f;
+			for (const Tap& tap : list) sum += tap.weight;
+			for (Tap& tap : list) tap.weight /= sum;
+		}
+		return taps;
+	}
+
+	//--- BC1 / BC3
+	struct Color565
+	{
+		std::uint16_t packed;
+		int rgb[3];		// 8bit へ展開した値
+	};
+
+	Color565 Quantize565(const float rgb[3])
+	{
+		const int r = std::min(31, std::max(0, static_cast<int>(rgb[0] * 31.0f / 255.0f + 0.5f)));
+		const int g = std::min(63, std::max(0, static_cast<int>(rgb[1] * 63.0f / 255.0f + 0.5f)));
+		const int b = std::min(31, std::max(0, static_cast<int>(rgb[2] * 31.0f / 255.0f + 0.5f)));
+		Color565 c;
+		c.packed = static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+		c.rgb[0] = (r << 3) | (r >> 2);
+		c.rgb[1] = (g << 2) | (g >> 4);
+		c.rgb[2] = (b << 3) | (b >> 2);
+		return c;
+	}
+
+	Color565 Unpack565(std::uint16_t packed)
+	{
+		const int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+		Color565 c;
+		c.packed = packed;
+		c.rgb[0] = (r << 3) | (r >> 2);
+		c.rgb[1] = (g << 2) | (g >> 4);
+		c.rgb[2] = (b << 3) | (b >> 2);
+		return c;
+	}
+
+	/// @brief 4色モードのパレット (c0, c1, 2/3c0+1/3c1, 1/3c0+2/3c1)
+	void MakeColorPalette(const Color565& c0, const Color565& c1, int palette[4][3])
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			palette[0][k] = c0.rgb[k];
+			palette[1][k] = c1.rgb[k];
+			palette[2][k] = (2 * c0.rgb[k] + c1.rgb[k] + 1) / 3;
+			palette[3][k] = (c0.rgb[k] + 2 * c1.rgb[k] + 1) / 3;
+		}
+	}
+
+	/// @brief 各画素に最も近いパレットの番号を割り当て、二乗誤差の合計を返す
+	int AssignColorIndices(const std::uint8_t block[16][4], const int palette[4][3], int indices[16])
+	{
+		int total = 0;
+		for (int i = 0; i < 16; ++i)
+		{
+			int best = 0, bestError = 0x7FFFFFFF;
+			for (int p = 0; p < 4; ++p)
+			{
+				const int dr = block[i][0] - palette[p][0];
+				const int dg = block[i][1] - palette[p][1];
+				const int db = block[i][2] - palette[p][2];
+				const int error = dr * dr + dg * dg + db * db;
+				if (error < bestError) { bestError = error; best = p; }
+			}
+			indices[i] = best;
+			total += bestError;
+		}
+		return total;
+	}
+
+	/// @brief 色ブロック (8バイト) を作る。BC1 / BC3 の両方で 4色モードだけを使う
+	void EncodeColorBlock(const std::uint8_t block[16][4], std::uint8_t* pOut)
+	{
+		// 平均と共分散
+		float mean[3] = {};
+		for (int i = 0; i < 16; ++i)
+			for (int k = 0; k < 3; ++k) mean[k] += block[i][k];
+		for (int k = 0; k < 3; ++k) mean[k] /= 16.0f;
+		float cov[6] = {};	// rr, rg, rb, gg, gb, bb
+		for (int i = 0; i < 16; ++i)
+		{
+			const float r = block[i][0] - mean[0], g = block[i][1] - mean[1], b = block[i][2] - mean[2];
+			cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+			cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+		}
+
+		// 主成分の軸 (べき乗法)
+		float axis[3] = { 1.0f, 1.0f, 1.0f };
+		for (int iter = 0; iter < 8; ++iter)
+		{
+			const float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+			const float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+			const float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+			const float length = std::max(std::fabs(x), std::max(std::fabs(y), std::fabs(z)));
+			if (length < 1e-6f) break;
+			axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+		}
+
+		// 軸上の両端を端点の初期値にする
+		float minDot = 1e30f, maxDot = -1e30f;
+		int minIndex = 0, maxIndex = 0;
+		for (int i = 0; i < 16; ++i)
+		{
+			const float dot = block[i][0] * axis[0] + block[i][1] * axis[1] + block[i][2] * axis[2];
+			if (dot < minDot) { minDot = dot; minIndex = i; }
+			if (dot > maxDot) { maxDot = dot; maxIndex = i; }
+		}
+		float end0[3], end1[3];
+		for (int k = 0; k < 3; ++k)
+		{
+			end0[k] = block[maxIndex][k];
+			end1[k] = block[minIndex][k];
+		}
+
+		// 量子化した端点で番号を割り当て、その番号から最小二乗法で端点を求め直す
+		static const float WEIGHT0[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+		Color565 best0 = Quantize565(end0), best1 = Quantize565(end1);
+		int bestIndices[16];
+		int palette[4][3];
+		MakeColorPalette(best0, best1, palette);
+		int bestError = AssignColorIndices(block, palette, bestIndices);
+		int indices[16];
+		std::memcpy(indices, bestIndices, sizeof(indices));
+		for (int iter = 0; iter < 3 && bestError > 0; ++iter)
+		{
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f, ax[3] = {}, bx[3] = {};
+			for (int i = 0; i < 16; ++i)
+			{
+				const float a = WEIGHT0[indices[i]], b = 1.0f - a;
+				aa += a * a; ab += a * b; bb += b * b;
+				for (int k = 0; k < 3; ++k)
+				{
+					ax[k] += a * block[i][k];
+					bx[k] += b * block[i][k];
+				}
+			}
+			const float det = aa * bb - ab * ab;
+			if (std::fabs(det) < 1e-6f) break;
+			for (int k = 0; k < 3; ++k)
+			{
+				end0[k] = (ax[k] * bb - bx[k] * ab) / det;
+				end1[k] = (bx[k] * aa - ax[k] * ab) / det;
+			}
+			const Color565 c0 = Quantize565(end0), c1 = Quantize565(end1);
+			MakeColorPalette(c0, c1, palette);
+			const int error = AssignColorIndices(block, palette, indices);
+			if (error >= bestError) break;
+			bestError = error;
+			best0 = c0;
+			best1 = c1;
+			std::memcpy(bestIndices, indices, sizeof(indices));
+		}
+
+		// 4色モードは c0 > c1 (等しい場合は全て c0 を指す)
+		if (best0.packed < best1.packed)
+		{
+			std::swap(best0, best1);
+			static const int SWAP[4] = { 1, 0, 3, 2 };
+			for (int i = 0; i < 16; ++i) bestIndices[i] = SWAP[bestIndices[i]];
+		}
+		else if (best0.packed == best1.packed)
+		{
+			std::fill(bestIndices, bestIndices + 16, 0);
+		}
+
+		std::uint32_t bits = 0;
+		for (int i = 0; i < 16; ++i) bits |= static_cast<std::uint32_t>(bestIndices[i]) << (i * 2);
+		std::memcpy(pOut, &best0.packed, 2);
+		std::memcpy(pOut + 2, &best1.packed, 2);
+		std::memcpy(pOut + 4, &bits, 4);
+	}
+
+	/// @brief アルファブロックのパレット (a0 > a1 : 8段階 / a0 <= a1 : 6段階 + 0, 255)
+	void MakeAlphaPalette(int a0, int a1, int palette[8])
+	{
+		palette[0] = a0;
+		palette[1] = a1;
+		if (a0 > a1)
+		{
+			for (int k = 1; k <= 6; ++k) palette[k + 1] = ((7 - k) * a0 + k * a1 + 3) / 7;
+		}
+		else
+		{
+			for (int k = 1; k <= 4; ++k) palette[k + 1] = ((5 - k) * a0 + k * a1 + 2) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+	}
+
+	int AssignAlphaIndices(const std::uint8_t block[16][4], const int palette[8], int indices[16])
+	{
+		int total = 0;
+		for (int i = 0; i < 16; ++i)
+		{
+			int best = 0, bestError = 0x7FFFFFFF;
+			for (int p = 0; p < 8; ++p)
+			{
+				const int d = block[i][3] - palette[p];
+				if (d * d < bestError) { bestError = d * d; best = p; }
+			}
+			indices[i] = best;
+			total += bestError;
+		}
+		return total;
+	}
+
+	/// @brief アルファブロック (8バイト) を作る
+	void EncodeAlphaBlock(const std::uint8_t block[16][4], std::uint8_t* pOut)
+	{
+		int minAlpha = 255, maxAlpha = 0;			// 全体
+		int minInner = 255, maxInner = 0;			// 0, 255 を除く
+		for (int i = 0; i < 16; ++i)
+		{
+			const int a = block[i][3];
+			minAlpha = std::min(minAlpha, a);
+			maxAlpha = std::max(maxAlpha, a);
+			if (a != 0 && a != 255)
+			{
+				minInner = std::min(minInner, a);
+				maxInner = std::max(maxInner, a);
+			}
+		}
+
+		int palette[8], indices[16], bestIndices[16];
+		int a0 = maxAlpha, a1 = minAlpha;
+		MakeAlphaPalette(a0, a1, palette);
+		int bestError = AssignAlphaIndices(block, palette, bestIndices);
+		if (bestError > 0 && minInner <= maxInner)
+		{
+			// 0, 255 を別に持つ 6段階モード
+			MakeAlphaPalette(minInner, maxInner, palette);
+			const int error = AssignAlphaIndices(block, palette, indices);
+			if (error < bestError)
+			{
+				bestError = error;
+				a0 = minInner;
+				a1 = maxInner;
+				std::memcpy(bestIndices, indices, sizeof(indices));
+			}
+		}
+
+		std::uint64_t bits = 0;
+		for (int i = 0; i < 16; ++i) bits |= static_cast<std::uint64_t>(bestIndices[i]) << (i * 3);
+		pOut[0] = static_cast<std::uint8_t>(a0);
+		pOut[1] = static_cast<std::uint8_t>(a1);
+		for (int k = 0; k < 6; ++k) pOut[2 + k] = static_cast<std::uint8_t>(bits >> (k * 8));
+	}
+
+	/// @brief 4x4 の画素を取り出す (画像の外は端の画素で埋める)
+	void FetchBlock(const Image& image, std::uint32_t bx, std::uint32_t by, std::uint8_t block[16][4])
+	{
+		for (std::uint32_t y = 0; y < 4; ++y)
+		{
+			const std::uint32_t sy = std::min(by * 4 + y, image.height - 1);
+			for (std::uint32_t x = 0; x < 4; ++x)
+			{
+				const std::uint32_t sx = std::min(bx * 4 + x, image.width - 1);
+				std::memcpy(block[y * 4 + x], &image.pixels[(static_cast<std::size_t>(sy) * image.width + sx) * 4], 4);
+			}
+		}
+	}
+
+	std::uint32_t GetBlockBytes(Format format)
+	{
+		return format == FORMAT_BC1 ? 8u : 16u;
+	}
+
+	//--- 画像の読み込み
+	bool ReadFile(const std::string& path, std::vector<std::uint8_t>& out)
+	{
+		FILE* fp = fopen(path.c_str(), "rb");
+		if (!fp) return false;
+		fseek(fp, 0, SEEK_END);
+		const long size = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		out.resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+		const bool isRead = out.empty() || fread(out.data(), 1, out.size(), fp) == out.size();
+		fclose(fp);
+		return size > 0 && isRead;
+	}
+
+	bool DecodePNG(const std::vector<std::uint8_t>& data, Image* pOut, std::string* pError)
+	{
+		png_image png;
+		std::memset(&png, 0, sizeof(png));
+		png.version = PNG_IMAGE_VERSION;
+		if (!png_image_begin_read_from_memory(&png, data.data(), data.size()))
+		{
+			*pError = png.message;
+			return false;
+		}
+		png.format = PNG_FORMAT_RGBA;
+		pOut->width = png.width;
+		pOut->height = png.height;
+		pOut->pixels.resize(PNG_IMAGE_SIZE(png));
+		if (!png_image_finish_read(&png, nullptr, pOut->pixels.data(), 0, nullptr))
+		{
+			*pError = png.message;
+			png_image_free(&png);
+			return false;
+		}
+		return true;
+	}
+
+#ifdef TEXTURE_COOKER_JPEG
+	bool DecodeJPEG(const std::vector<std::uint8_t>& data, Image* pOut, std::string* pError)
+	{
+		jpeg_decompress_struct info;
+		jpeg_error_mgr errorManager;
+		info.err = jpeg_std_error(&errorManager);
+		jpeg_create_decompress(&info);
+		jpeg_mem_src(&info, const_cast<unsigned char*>(data.data()), static_cast<unsigned long>(data.size()));
+		if (jpeg_read_header(&info, TRUE) != JPEG_HEADER_OK)
+		{
+			jpeg_destroy_decompress(&info);
+			*pError = "invalid JPEG header";
+			return false;
+		}
+		info.out_color_space = JCS_RGB;
+		jpeg_start_decompress(&info);
+		pOut->width = info.output_width;
+		pOut->height = info.output_height;
+		pOut->pixels.resize(static_cast<std::size_t>(pOut->width) * pOut->height * 4);
+		std::vector<std::uint8_t> row(static_cast<std::size_t>(pOut->width) * 3);
+		while (info.output_scanline < info.output_height)
+		{
+			std::uint8_t* pRow = row.data();
+			std::uint8_t* pDst = &pOut->pixels[static_cast<std::size_t>(info.output_scanline) * pOut->width * 4];
+			jpeg_read_scanlines(&info, &pRow, 1);
+			for (std::uint32_t x = 0; x < pOut->width; ++x)
+			{
+				pDst[x * 4 + 0] = row[x * 3 + 0];
+				pDst[x * 4 + 1] = row[x * 3 + 1];
+				pDst[x * 4 + 2] = row[x * 3 + 2];
+				pDst[x * 4 + 3] = 255;
+			}
+		}
+		jpeg_finish_decompress(&info);
+		jpeg_destroy_decompress(&info);
+		return true;
+	}
+#endif
+}
+
+/*
+* @brief 画像ファイルを読み込む (PNG / JPEG。拡張子ではなく中身で判定する)
+*/
+bool TextureCooker::LoadImageFile(const std::string& path, Image* pOut, std::string* pError)
+{
+	std::vector<std::uint8_t> data;
+	if (!ReadFile(path, data))
+	{
+		*pError = "cannot read file";
+		return false;
+	}
+	static const std::uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	if (data.size() >= 8 && std::memcmp(data.data(), PNG_SIGNATURE, 8) == 0)
+	{
+		return DecodePNG(data, pOut, pError);
+	}
+	if (data.size() >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF)
+	{
+#ifdef TEXTURE_COOKER_JPEG
+		return DecodeJPEG(data, pOut, pError);
+#else
+		*pError = "JPEG support is not built in";
+		return false;
+#endif
+	}
+	*pError = "unsupported image format";
+	return false;
+}
+
+/*
+* @brief 画像を PNG (8bit RGBA) で書き出す
+*/
+bool TextureCooker::SavePNG(const std::string& path, const Image& image, std::string* pError)
+{
+	png_image png;
+	std::memset(&png, 0, sizeof(png));
+	png.version = PNG_IMAGE_VERSION;
+	png.width = image.width;
+	png.height = image.height;
+	png.format = PNG_FORMAT_RGBA;
+	if (!png_image_write_to_file(&png, path.c_str(), 0, image.pixels.data(), 0, nullptr))
+	{
+		*pError = png.message;
+		return false;
+	}
+	return true;
+}
+
+/*
+* @brief 指定の大きさへ縮小する
+* @details 横方向に縮小した行を、縦方向のフィルターが必要とする分だけ保持しながら処理する
+*          (大きな画像でも全体を浮動小数点で持たない)。
+*/
+TextureCooker::Image TextureCooker::Downsample(const Image& src, std::uint32_t width, std::uint32_t height, Filter filter)
+{
+	const ColorTable& table = GetColorTable();
+	const std::vector<std::vector<Tap>> tapsX = MakeTaps(src.width, width, filter);
+	const std::vector<std::vector<Tap>> tapsY = MakeTaps(src.height, height, filter);
+
+	// 横方向に縮小した行 (線形・乗算済みアルファ)
+	std::vector<std::vector<float>> rows(src.height);
+	std::vector<float> linear(static_cast<std::size_t>(src.width) * 4);
+	auto getRow = [&](std::uint32_t y) -> const std::vector<float>&
+	{
+		std::vector<float>& row = rows[y];
+		if (!row.empty()) return row;
+		const std::uint8_t* pSrc = &src.pixels[static_cast<std::size_t>(y) * src.width * 4];
+		for (std::uint32_t x = 0; x < src.width; ++x)
+		{
+			const float a = pSrc[x * 4 + 3] / 255.0f;
+			linear[x * 4 + 0] = table.toLinear[pSrc[x * 4 + 0]] * a;
+			linear[x * 4 + 1] = table.toLinear[pSrc[x * 4 + 1]] * a;
+			linear[x * 4 + 2] = table.toLinear[pSrc[x * 4 + 2]] * a;
+			linear[x * 4 + 3] = a;
+		}
+		row.assign(static_cast<std::size_t>(width) * 4, 0.0f);
+		for (std::uint32_t x = 0; x < width; ++x)
+		{
+			for (const Tap& tap : tapsX[x])
+			{
+				for (int k = 0; k < 4; ++k) row[x * 4 + k] += linear[tap.index * 4 + k] * tap.weight;
+			}
+		}
+		return row;
+	};
+
+	Image dst;
+	dst.width = width;
+	dst.height = height;
+	dst.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+	std::vector<float> sum(static_cast<std::size_t>(width) * 4);
+	std::uint32_t releasedRows = 0;
+	for (std::uint32_t y = 0; y < height; ++y)
+	{
+		std::fill(sum.begin(), sum.end(), 0.0f);
+		for (const Tap& tap : tapsY[y])
+		{
+			const std::vector<float>& row = getRow(tap.index);
+			for (std::size_t i = 0; i < sum.size(); ++i) sum[i] += row[i] * tap.weight;
+		}
+
+		// 乗算済みアルファを戻して sRGB へ
+		std::uint8_t* pDst = &dst.pixels[static_cast<std::size_t>(y) * width * 4];
+		for (std::uint32_t x = 0; x < width; ++x)
+		{
+			const float a = std::min(1.0f, std::max(0.0f, sum[x * 4 + 3]));
+			for (int k = 0; k < 3; ++k)
+			{
+				const float c = (a > 0.0f) ? std::min(1.0f, std::max(0.0f, sum[x * 4 + k] / a)) : 0.0f;
+				pDst[x * 4 + k] = table.toSRGB[static_cast<int>(c * SRGB_TABLE_SIZE + 0.5f)];
+			}
+			pDst[x * 4 + 3] = ToUnorm8(a);
+		}
+
+		// 以降の行で参照しない行を解放する
+		if (y + 1 < height)
+		{
+			std::uint32_t nextFirst = src.height;
+			for (const Tap& tap : tapsY[y + 1]) nextFirst = std::min(nextFirst, tap.index);
+			for (; releasedRows < nextFirst; ++releasedRows) std::vector<float>().swap(rows[releasedRows]);
+		}
+	}
+	return dst;
+}
+
+/*
+* @brief 1x1 までのミップマップを作る (先頭は src のコピー)
+*/
+std::vector<TextureCooker::Image> TextureCooker::BuildMipChain(const Image& src, Filter filter)
+{
+	std::vector<Image> levels;
+	levels.push_back(src);
+	while (levels.back().width > 1 || levels.back().height > 1)
+	{
+		const Image& prev = levels.back();
+		Image next = Downsample(prev, std::max(1u, prev.width / 2), std::max(1u, prev.height / 2), filter);
+		levels.push_back(std::move(next));
+	}
+	return levels;
+}
+
+/*
+* @brief 全画素が不透明か
+*/
+bool TextureCooker::IsOpaque(const Image& image)
+{
+	for (std::size_t i = 3; i < image.pixels.size(); i += 4)
+	{
+		if (image.pixels[i] != 255) return false;
+	}
+	return true;
+}
+
+/*
+* @brief BC1 / BC3 へ圧縮する
+*/
+void TextureCooker::EncodeBlocks(const Image& image, Format format, std::vector<std::uint8_t>* pOut)
+{
+	const std::uint32_t blocksX = std::max(1u, (image.width + 3) / 4);
+	const std::uint32_t blocksY = std::max(1u, (image.height + 3) / 4);
+	const std::uint32_t blockBytes = GetBlockBytes(format);
+	pOut->resize(static_cast<std::size_t>(blocksX) * blocksY * blockBytes);
+
+	std::uint8_t block[16][4];
+	std::uint8_t* pDst = pOut->data();
+	for (std::uint32_t by = 0; by < blocksY; ++by)
+	{
+		for (std::uint32_t bx = 0; bx < blocksX; ++bx)
+		{
+			FetchBlock(image, bx, by, block);
+			if (format == FORMAT_BC3)
+			{
+				EncodeAlphaBlock(block, pDst);
+				pDst += 8;
+			}
+			EncodeColorBlock(block, pDst);
+			pDst += 8;
+		}
+	}
+}
+
+/*
+* @brief BC1 / BC3 を展開する
+*/
+TextureCooker::Image TextureCooker::DecodeBlocks(const std::uint8_t* pBlocks, std::uint32_t width, std::uint32_t height, Format format)
+{
+	Image image;
+	image.width = width;
+	image.height = height;
+	image.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+	const std::uint32_t blocksX = std::max(1u, (width + 3) / 4);
+	const std::uint32_t blocksY = std::max(1u, (height + 3) / 4);
+	for (std::uint32_t by = 0; by < blocksY; ++by)
+	{
+		for (std::uint32_t bx = 0; bx < blocksX; ++bx)
+		{
+			int alphas[16];
+			std::fill(alphas, alphas + 16, 255);
+			if (format == FORMAT_BC3)
+			{
+				int palette[8];
+				MakeAlphaPalette(pBlocks[0], pBlocks[1], palette);
+				std::uint64_t bits = 0;
+				for (int k = 0; k < 6; ++k) bits |= static_cast<std::uint64_t>(pBlocks[2 + k]) << (k * 8);
+				for (int i = 0; i < 16; ++i) alphas[i] = palette[(bits >> (i * 3)) & 7];
+				pBlocks += 8;
+			}
+
+			std::uint16_t packed0, packed1;
+			std::uint32_t bits;
+			std::memcpy(&packed0, pBlocks, 2);
+			std::memcpy(&packed1, pBlocks + 2, 2);
+			std::memcpy(&bits, pBlocks + 4, 4);
+			pBlocks += 8;
+			int palette[4][3];
+			MakeColorPalette(Unpack565(packed0), Unpack565(packed1), palette);
+			const bool isTransparent = (format == FORMAT_BC1 && packed0 <= packed1);	// BC1 の 3色モード
+			if (isTransparent)
+			{
+				for (int k = 0; k < 3; ++k)
+				{
+					palette[2][k] = (palette[0][k] + palette[1][k]) / 2;
+					palette[3][k] = 0;
+				}
+			}
+
+			for (std::uint32_t i = 0; i < 16; ++i)
+			{
+				const std::uint32_t x = bx * 4 + (i & 3), y = by * 4 + (i >> 2);
+				if (x >= width || y >= height) continue;
+				const std::uint32_t index = (bits >> (i * 2)) & 3;
+				std::uint8_t* pDst = &image.pixels[(static_cast<std::size_t>(y) * width + x) * 4];
+				for (int k = 0; k < 3; ++k) pDst[k] = static_cast<std::uint8_t>(palette[index][k]);
+				pDst[3] = static_cast<std::uint8_t>((isTransparent && index == 3) ? 0 : alphas[i]);
+			}
+		}
+	}
+	return image;
+}
+
+/*
+* @brief 2つの画像の PSNR
+*/
+float TextureCooker::MeasurePSNR(const Image& a, const Image& b)
+{
+	if (a.pixels.size() != b.pixels.size() || a.pixels.empty()) return 0.0f;
+	double sum = 0.0;
+	for (std::size_t i = 0; i < a.pixels.size(); ++i)
+	{
+		const int d = a.pixels[i] - b.pixels[i];
+		sum += d * d;
+	}
+	if (sum == 0.0) return 99.0f;
+	const double mse = sum / a.pixels.size();
+	return static_cast<float>(10.0 * std::log10(255.0 * 255.0 / mse));
+}
+
+/*
+* @brief ミップマップ1段分のバイト数
+*/
+std::size_t TextureCooker::GetLevelSize(std::uint32_t width, std::uint32_t height, Format format)
+{
+	if (format == FORMAT_RGBA8) return static_cast<std::size_t>(width) * height * 4;
+	return static_cast<std::size_t>(std::max(1u, (width + 3) / 4)) * std::max(1u, (height + 3) / 4) * GetBlockBytes(format);
+}
+
+/*
+* @brief .dds の内容を組み立てる
+*/
+std::vector<std::uint8_t> TextureCooker::BuildDDS(const std::vector<Image>& levels, Format format, const CookTag& tag)
+{
+	const Image& top = levels.front();
+	Header header = {};
+	header.size = sizeof(Header);
+	header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT;
+	header.height = top.height;
+	header.width = top.width;
+	header.mipMapCount = static_cast<std::uint32_t>(levels.size());
+	std::memcpy(header.reserved1, &tag, sizeof(tag));
+	header.format.size = sizeof(PixelFormat);
+	if (format == FORMAT_RGBA8)
+	{
+		header.flags |= DDSD_PITCH;
+		header.pitchOrLinearSize = top.width * 4;
+		header.format.flags = DDPF_RGB | DDPF_ALPHAPIXELS;
+		header.format.rgbBitCount = 32;
+		header.format.bitMask[0] = 0x000000FFu;
+		header.format.bitMask[1] = 0x0000FF00u;
+		header.format.bitMask[2] = 0x00FF0000u;
+		header.format.bitMask[3] = 0xFF000000u;
+	}
+	else
+	{
+		header.flags |= DDSD_LINEARSIZE;
+		header.pitchOrLinearSize = static_cast<std::uint32_t>(GetLevelSize(top.width, top.height, format));
+		header.format.flags = DDPF_FOURCC;
+		header.format.fourCC = (format == FORMAT_BC1) ? FOURCC_DXT1 : FOURCC_DXT5;
+	}
+	header.caps[0] = DDSCAPS_TEXTURE | (levels.size() > 1 ? (DDSCAPS_COMPLEX | DDSCAPS_MIPMAP) : 0);
+
+	std::vector<std::uint8_t> data(sizeof(DDS_MAGIC) + sizeof(Header));
+	std::memcpy(data.data(), &DDS_MAGIC, sizeof(DDS_MAGIC));
+	std::memcpy(data.data() + sizeof(DDS_MAGIC), &header, sizeof(Header));
+	std::vector<std::uint8_t> blocks;
+	for (const Image& level : levels)
+	{
+		if (format == FORMAT_RGBA8)
+		{
+			data.insert(data.end(), level.pixels.begin(), level.pixels.end());
+		}
+		else
+		{
+			EncodeBlocks(level, format, &blocks);
+			data.insert(data.end(), blocks.begin(), blocks.end());
+		}
+	}
+	return data;
+}
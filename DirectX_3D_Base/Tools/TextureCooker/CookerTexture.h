@@ -0,0 +1,79 @@
+﻿/*****************************************************************//**
+ * @file	CookerTexture.h
+ * @brief	TextureCooker の画像処理 (読み込み・ミップマップ生成・ブロック圧縮・.dds 書き出し)
+ *
+ * @details	Direct3D / DirectXTex を使わずに Linux でも動作するよう、
+ *			画像の展開は libpng / libjpeg、それ以外は標準ライブラリだけで実装する。
+ *			画素は全て 8bit RGBA (sRGB のまま) で扱い、縮小だけは線形空間・乗算済みアルファで行う。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：ミップマップ生成 (ボックス / Kaiser) と BC1 / BC3 圧縮を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	（省略可）
+ *********************************************************************/
+
+#ifndef ___COOKER_TEXTURE_H___
+#define ___COOKER_TEXTURE_H___
+
+// ===== インクルード =====
+#include "Systems/TextureCookedFormat.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TextureCooker
+{
+	/// @brief 8bit RGBA の画像
+	struct Image
+	{
+		std::uint32_t				width = 0;
+		std::uint32_t				height = 0;
+		std::vector<std::uint8_t>	pixels;		// width * height * 4
+	};
+
+	/// @brief ミップマップの縮小フィルター
+	enum Filter
+	{
+		FILTER_BOX,		// 面積平均 (にじみが出ない。UI 向け)
+		FILTER_KAISER,	// Kaiser 窓付き sinc (細部が残る)
+	};
+
+	/// @brief 画像ファイルを読み込む (PNG / JPEG。拡張子ではなく中身で判定する)
+	bool LoadImageFile(const std::string& path, Image* pOut, std::string* pError);
+
+	/// @brief 画像を PNG (8bit RGBA) で書き出す
+	bool SavePNG(const std::string& path, const Image& image, std::string* pError);
+
+	/// @brief 指定の大きさへ縮小する
+	Image Downsample(const Image& src, std::uint32_t width, std::uint32_t height, Filter filter);
+
+	/// @brief 1x1 までのミップマップを作る (先頭は src のコピー)
+	std::vector<Image> BuildMipChain(const Image& src, Filter filter);
+
+	/// @brief 全画素が不透明か
+	bool IsOpaque(const Image& image);
+
+	/// @brief BC1 / BC3 へ圧縮する (4x4 に満たない端のブロックは端の画素で埋める)
+	void EncodeBlocks(const Image& image, TextureCooked::Format format, std::vector<std::uint8_t>* pOut);
+
+	/// @brief BC1 / BC3 を展開する (画質の確認用)
+	Image DecodeBlocks(const std::uint8_t* pBlocks, std::uint32_t width, std::uint32_t height, TextureCooked::Format format);
+
+	/// @brief 2つの画像の PSNR (dB。アルファを含む全チャンネル。一致していれば 99)
+	float MeasurePSNR(const Image& a, const Image& b);
+
+	/// @brief ミップマップ1段分のバイト数
+	std::size_t GetLevelSize(std::uint32_t width, std::uint32_t height, TextureCooked::Format format);
+
+	/// @brief .dds の内容を組み立てる (levels は BuildMipChain の結果)
+	std::vector<std::uint8_t> BuildDDS(const std::vector<Image>& levels, TextureCooked::Format format, const TextureCooked::CookTag& tag);
+}
+
+#endif // !___COOKER_TEXTURE_H___
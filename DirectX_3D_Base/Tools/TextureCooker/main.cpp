@@ -0,0 +1,383 @@
+﻿/*****************************************************************//**
+ * @file	main.cpp
+ * @brief	TextureCooker : 画像をミップマップ付きの変換済みテクスチャ (.dds) へ変換するツール
+ *
+ * @details	Assets 以下の全ての画像 (.png / .jpg / .tga のうち PNG / JPEG のもの) を読み込み、
+ *			1x1 までのミップマップを作って BC1 (不透明) / BC3 (アルファあり) で圧縮し、
+ *			元ファイルと同じ場所へ .dds を書き出す。書き出したファイルは読み戻して内容を確認する。
+ *			最後に Assets/CSV/TextureList.csv の各行へ、形式・メモリ量・展開時間の列を書き足す。
+ *
+ *			使い方 : TextureCooker [プロジェクトのディレクトリ] [--force] [--filter box|kaiser]
+ *			                       [--max-size N] [--min-psnr dB]
+ *			  --force    : 元ファイルが更新されていなくても変換し直す
+ *			  --filter   : ミップマップの縮小フィルター (既定 : box)
+ *			  --max-size : 縦横がこれを超える画像は縮小して格納する (既定 : 0 = 縮小しない)
+ *			  --min-psnr : ブロック圧縮の PSNR がこれを下回る画像は RGBA のまま格納する (既定 : 35)
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *
+ * @date	2026/10/19	初回作成日
+ * 			作業内容：	- 追加：Assets 以下の画像の一括変換と TextureList.csv への集計を実装。
+ *
+ * @update	2025/xx/xx	最終更新日
+ * 			作業内容：	- XX：
+ *
+ * @note	Direct3D 11 は縦横が 4 の倍数でない画像をブロック圧縮できないため、近い 4 の倍数へ伸縮して格納する。
+ *			SourceDecodeMs は変換時に libpng / libjpeg で計測した値 (実行時の WIC とは異なる)。
+ *********************************************************************/
+
+// ===== インクルード =====
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <dirent.h>
+#endif
+#include <sys/stat.h>
+#include "CookerTexture.h"
+#include "Utility/CSVLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+using namespace TextureCooked;
+using namespace TextureCooker;
+
+namespace
+{
+	/// @brief 変換オプション
+	struct Options
+	{
+		bool isForce = false;
+		Filter filter = FILTER_BOX;
+		std::uint32_t maxSize = 0;
+		float minPSNR = 35.0f;
+	};
+
+	/// @brief 1枚分の変換結果 (TextureList.csv へ書き出す内容)
+	struct Report
+	{
+		Format format = FORMAT_RGBA8;
+		std::uint32_t width = 0;
+		std::uint32_t height = 0;
+		std::uint32_t mipLevels = 0;
+		std::size_t sourceBytes = 0;	// 元画像を RGBA で展開した大きさ (ミップマップなし)
+		std::size_t cookedBytes = 0;	// .dds の画素データ (ミップマップを含む)
+		float sourceDecodeMs = 0.0f;
+		float cookedLoadMs = 0.0f;
+		float psnr = 0.0f;				// 最上段の圧縮前後の PSNR (RGBA は 99)
+	};
+
+	const char* FORMAT_NAMES[] = { "RGBA8", "BC1", "BC3" };
+
+	float ElapsedMs(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/// @brief ファイルのサイズと更新日時 (実行時の ModelCooked::GetSourceStamp と同じ値)
+	bool GetFileStamp(const std::string& file, ModelCooked::SourceStamp* pOut)
+	{
+#ifdef _WIN32
+		struct _stat64 st;
+		if (_stat64(file.c_str(), &st) != 0) return false;
+#else
+		struct stat st;
+		if (stat(file.c_str(), &st) != 0) return false;
+#endif
+		pOut->size = static_cast<std::uint64_t>(st.st_size);
+		pOut->time = static_cast<std::int64_t>(st.st_mtime);
+		return true;
+	}
+
+	/// @brief ディレクトリ以下のファイルを再帰的に列挙する (relDir はプロジェクトからの相対パス)
+	void ListFiles(const std::string& root, const std::string& relDir, std::vector<std::string>& files)
+	{
+#ifdef _WIN32
+		WIN32_FIND_DATAA data;
+		HANDLE hFind = FindFirstFileA((root + relDir + "/*").c_str(), &data);
+		if (hFind == INVALID_HANDLE_VALUE) return;
+		do
+		{
+			const std::string name = data.cFileName;
+			if (name == "." || name == "..") continue;
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ListFiles(root, relDir + "/" + name, files);
+			else files.push_back(relDir + "/" + name);
+		} while (FindNextFileA(hFind, &data));
+		FindClose(hFind);
+#else
+		DIR* pDir = opendir((root + relDir).c_str());
+		if (!pDir) return;
+		while (dirent* pEntry = readdir(pDir))
+		{
+			const std::string name = pEntry->d_name;
+			if (name == "." || name == "..") continue;
+			struct stat st;
+			if (stat((root + relDir + "/" + name).c_str(), &st) != 0) continue;
+			if (S_ISDIR(st.st_mode)) ListFiles(root, relDir + "/" + name, files);
+			else if (S_ISREG(st.st_mode)) files.push_back(relDir + "/" + name);
+		}
+		closedir(pDir);
+#endif
+	}
+
+	bool IsImageFile(const std::string& path)
+	{
+		const size_t dot = path.find_last_of('.');
+		if (dot == std::string::npos) return false;
+		std::string ext = path.substr(dot);
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+		return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga";
+	}
+
+	/// @brief 4 の倍数へ丸める (4 未満の画像はそのまま。ブロックより小さく圧縮の意味がない)
+	std::uint32_t RoundToBlock(float size)
+	{
+		const std::uint32_t rounded = static_cast<std::uint32_t>(size + 0.5f);
+		if (rounded < 4) return std::max(1u, rounded);
+		return (rounded + 2) / 4 * 4;
+	}
+
+	/// @brief ファイル全体を読み込み、読み込みにかかった時間を返す
+	bool ReadFile(const std::string& path, std::vector<std::uint8_t>& out, float* pMs)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		FILE* fp = fopen(path.c_str(), "rb");
+		if (!fp) return false;
+		fseek(fp, 0, SEEK_END);
+		const long size = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		out.resize(size > 0 ? static_cast<size_t>(size) : 0);
+		const bool isRead = out.empty() || fread(out.data(), 1, out.size(), fp) == out.size();
+		fclose(fp);
+		*pMs = ElapsedMs(startTime);
+		return size > 0 && isRead;
+	}
+
+	/// @brief 書き出し済みの .dds から集計を作る (読み込み時間も計測する)
+	bool ReadReport(const std::string& cookedPath, Report* pReport)
+	{
+		std::vector<std::uint8_t> data;
+		float loadMs = 0.0f;
+		if (!ReadFile(cookedPath, data, &loadMs)) return false;
+		Header header;
+		CookTag tag;
+		if (!ReadHeader(data.data(), data.size(), &header, &tag)) return false;
+		pReport->format = static_cast<Format>(tag.format);
+		pReport->width = header.width;
+		pReport->height = header.height;
+		pReport->mipLevels = header.mipMapCount;
+		pReport->sourceBytes = static_cast<std::size_t>(tag.sourceWidth) * tag.sourceHeight * 4;
+		pReport->cookedBytes = data.size() - sizeof(DDS_MAGIC) - sizeof(Header);
+		pReport->sourceDecodeMs = tag.sourceDecodeMs;
+		pReport->cookedLoadMs = loadMs;
+		pReport->psnr = tag.psnr;
+		return true;
+	}
+
+	/// @brief 画像を変換する (成功・スキップ時は true。未対応の形式は警告のみ)
+	bool CookTexture(const std::string& root, const std::string& file, const Options& options, Report* pReport)
+	{
+		const std::string source = root + file;
+		const std::string cooked = GetCookedPath(source);
+		ModelCooked::SourceStamp stamp;
+		if (!GetFileStamp(source, &stamp))
+		{
+			printf("[Error] Texture: '%s' not found\n", file.c_str());
+			return false;
+		}
+
+		// 元ファイルが更新されていなければ集計だけ読み直す
+		if (!options.isForce)
+		{
+			std::vector<std::uint8_t> head(sizeof(DDS_MAGIC) + sizeof(Header));
+			FILE* fp = fopen(cooked.c_str(), "rb");
+			Header header;
+			CookTag tag;
+			const bool isRead = fp && fread(head.data(), head.size(), 1, fp) == 1;
+			if (fp) fclose(fp);
+			if (isRead && ReadHeader(head.data(), head.size(), &header, &tag) &&
+				tag.source.size == stamp.size && tag.source.time == stamp.time)
+			{
+				return ReadReport(cooked, pReport);
+			}
+		}
+
+		// 読み込み
+		const auto decodeStart = std::chrono::steady_clock::now();
+		Image image;
+		std::string error;
+		if (!LoadImageFile(source, &image, &error))
+		{
+			printf("[Warning] Texture: '%s' skipped (%s), loaded from the source at runtime\n", file.c_str(), error.c_str());
+			return true;
+		}
+		const float decodeMs = ElapsedMs(decodeStart);
+		const std::uint32_t sourceWidth = image.width, sourceHeight = image.height;
+
+		// 大きすぎる画像は縦横比を保って縮小し、ブロック圧縮できるよう縦横を 4 の倍数へ合わせる
+		// (UV は 0～1 のため、数画素の伸縮は見た目に影響しない)
+		const auto cookStart = std::chrono::steady_clock::now();
+		float scale = 1.0f;
+		if (options.maxSize > 0 && std::max(image.width, image.height) > options.maxSize)
+		{
+			scale = static_cast<float>(options.maxSize) / std::max(image.width, image.height);
+		}
+		const std::uint32_t width = RoundToBlock(image.width * scale);
+		const std::uint32_t height = RoundToBlock(image.height * scale);
+		Image resized;
+		if (width != image.width || height != image.height)
+		{
+			resized = Downsample(image, width, height, options.filter);
+		}
+		const Image& top = resized.pixels.empty() ? image : resized;
+
+		// 形式の決定 (最上段を圧縮して画質を確認する)
+		Format format = FORMAT_RGBA8;
+		float psnr = 99.0f;
+		if (top.width % 4 == 0 && top.height % 4 == 0)
+		{
+			format = IsOpaque(top) ? FORMAT_BC1 : FORMAT_BC3;
+			std::vector<std::uint8_t> blocks;
+			EncodeBlocks(top, format, &blocks);
+			psnr = MeasurePSNR(top, DecodeBlocks(blocks.data(), top.width, top.height, format));
+			if (psnr < options.minPSNR)
+			{
+				format = FORMAT_RGBA8;
+			}
+		}
+
+		// ミップマップを作って書き出す
+		CookTag tag = {};
+		tag.magic = TAG_MAGIC;
+		tag.version = VERSION;
+		tag.format = format;
+		tag.sourceDecodeMs = decodeMs;
+		tag.sourceWidth = static_cast<std::uint16_t>(sourceWidth);
+		tag.sourceHeight = static_cast<std::uint16_t>(sourceHeight);
+		tag.psnr = (format == FORMAT_RGBA8) ? 99.0f : psnr;
+		tag.source = stamp;
+		const std::vector<Image> levels = BuildMipChain(top, options.filter);
+		const std::vector<std::uint8_t> data = BuildDDS(levels, format, tag);
+		const float cookMs = ElapsedMs(cookStart);
+		FILE* fp = fopen(cooked.c_str(), "wb");
+		const bool isWritten = fp && fwrite(data.data(), 1, data.size(), fp) == data.size();
+		if (fp) fclose(fp);
+		if (!isWritten)
+		{
+			printf("[Error] Texture: failed to write '%s'\n", cooked.c_str());
+			return false;
+		}
+
+		// 読み戻して確認
+		std::vector<std::uint8_t> check;
+		float loadMs = 0.0f;
+		if (!ReadFile(cooked, check, &loadMs) || check != data || !ReadReport(cooked, pReport))
+		{
+			printf("[Error] Texture: '%s' failed verification\n", cooked.c_str());
+			return false;
+		}
+
+		printf("[Info] Texture: '%s' %ux%u -> %s %ux%u x%u mips (%.1fKB -> %.1fKB, PSNR %.1fdB, decode %.2fms / cooked %.2fms, cook %.0fms)\n",
+			file.c_str(), sourceWidth, sourceHeight, FORMAT_NAMES[format], top.width, top.height, pReport->mipLevels,
+			pReport->sourceBytes / 1024.0f, pReport->cookedBytes / 1024.0f, psnr, decodeMs, pReport->cookedLoadMs, cookMs);
+		return true;
+	}
+
+	/// @brief TextureList.csv の各行へ集計の列を書き足す (4列目以降は毎回書き直す)
+	bool WriteTextureList(const std::string& csvPath, const std::map<std::string, Report>& reports)
+	{
+		Utility::CSVLoader::Data data = Utility::CSVLoader::Load(csvPath);
+		std::string text = "AssetID,AssetType,FilePath,Format,Size,Mips,SourceKB,CookedKB,SourceDecodeMs,CookedLoadMs,PSNR\n";
+		for (size_t i = 1; i < data.size(); ++i)	// 1行目はヘッダー
+		{
+			Utility::CSVLoader::Row& row = data[i];
+			for (std::string& field : row)
+			{
+				if (!field.empty() && field.back() == '\r') field.pop_back();
+			}
+			row.resize(std::max<size_t>(row.size(), 3));
+			text += row[0] + "," + row[1] + "," + row[2];
+			auto reportIt = reports.find(row[2]);
+			if (reportIt != reports.end())
+			{
+				const Report& report = reportIt->second;
+				char buffer[256];
+				snprintf(buffer, sizeof(buffer), ",%s,%ux%u,%u,%.1f,%.1f,%.2f,%.2f,%.1f",
+					FORMAT_NAMES[report.format], report.width, report.height, report.mipLevels,
+					report.sourceBytes / 1024.0f, report.cookedBytes / 1024.0f,
+					report.sourceDecodeMs, report.cookedLoadMs, report.psnr);
+				text += buffer;
+			}
+			text += "\n";
+		}
+		std::ofstream file(csvPath, std::ios::binary | std::ios::trunc);
+		file << text;
+		return file.good();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string root = ".";
+	Options options;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--force") == 0) options.isForce = true;
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) options.filter = (strcmp(argv[++i], "kaiser") == 0) ? FILTER_KAISER : FILTER_BOX;
+		else if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) options.maxSize = static_cast<std::uint32_t>(atoi(argv[++i]));
+		else if (strcmp(argv[i], "--min-psnr") == 0 && i + 1 < argc) options.minPSNR = static_cast<float>(atof(argv[++i]));
+		else root = argv[i];
+	}
+	if (!root.empty() && root.back() != '/' && root.back() != '\\') root += '/';
+
+	const auto startTime = std::chrono::steady_clock::now();
+	std::vector<std::string> files;
+	ListFiles(root, "Assets", files);
+	std::sort(files.begin(), files.end());
+
+	int errorNum = 0;
+	std::map<std::string, Report> reports;
+	std::size_t sourceTotal = 0, cookedTotal = 0;
+	for (const std::string& file : files)
+	{
+		if (!IsImageFile(file)) continue;
+		Report report;
+		if (!CookTexture(root, file, options, &report))
+		{
+			++errorNum;
+			continue;
+		}
+		if (report.mipLevels == 0) continue;	// 未対応の形式
+		sourceTotal += report.sourceBytes;
+		cookedTotal += report.cookedBytes;
+		reports[file] = report;
+	}
+
+	try
+	{
+		if (!WriteTextureList(root + "Assets/CSV/TextureList.csv", reports))
+		{
+			printf("[Error] TextureCooker: failed to write TextureList.csv\n");
+			++errorNum;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		printf("[Error] %s\n", e.what());
+		++errorNum;
+	}
+
+	printf("[Info] TextureCooker: %u textures, %.1fMB (RGBA, no mips) -> %.1fMB (with mips) in %.1fs\n",
+		static_cast<unsigned>(reports.size()), sourceTotal / 1048576.0f, cookedTotal / 1048576.0f, ElapsedMs(startTime) / 1000.0f);
+	printf("[Info] TextureCooker finished with %d error(s)\n", errorNum);
+	return errorNum == 0 ? 0 : 1;
+}